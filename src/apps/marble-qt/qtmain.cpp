@@ -22,6 +22,7 @@
 #include "MarbleWidgetInputHandler.h"
 #include "MarbleDirs.h"
 #include "MarbleDebug.h"
+#include "FrameProfiler.h"
 #include "MarbleTest.h"
 #include "MarbleLocale.h"
 #include "GeoUriParser.h"
@@ -135,6 +136,7 @@ int main(int argc, char *argv[])
     QString coordinatesString;
     QString distanceString;
     QString geoUriString;
+    QString profileFile;
     MarbleGlobal::Profiles profiles = MarbleGlobal::getInstance()->profiles();
 
     QStringList args = QApplication::arguments();
@@ -160,6 +162,8 @@ int main(int argc, char *argv[])
         qWarning() << "  --timedemo ................. Measure the paint performance while moving the map and quit";
         qWarning() << "  --debug-polygons ........... Display the polygon nodes and their index for debugging";
         qWarning() << "  --debug-levels ............. Display OSM placemarks according to the level selected";
+        qWarning() << "  --profile=<file> ........... Record layer timings and cache counters of each frame and write them to the given file on exit (Chrome trace JSON, or CSV if the file name ends in .csv)";
+        qWarning() << "  --profile-frames=<n> ....... Keep only the last n frames in the profile (default: 1000)";
         qWarning();
         qWarning() << "profile options (note that marble should automatically detect which profile to use. Override that with the options below):";
         qWarning() << "  --highresolution ........... Enforce the profile for devices with high resolution (e.g. desktop computers)";
@@ -230,6 +234,19 @@ int main(int argc, char *argv[])
             ++i;
             tour = args.value( i );
         }
+        else if ( arg.startsWith( QLatin1String( "--profile=" ), Qt::CaseInsensitive ) )
+        {
+            profileFile = arg.mid(10);
+            FrameProfiler::setEnabled( true );
+        }
+        else if ( arg.startsWith( QLatin1String( "--profile-frames=" ), Qt::CaseInsensitive ) )
+        {
+            bool success = false;
+            const int frames = arg.mid(17).toInt(&success);
+            if ( success && frames > 0 ) {
+                FrameProfiler::setCapacity( frames );
+            }
+        }
     }
     MarbleGlobal::getInstance()->setProfiles( profiles );
 
@@ -277,6 +294,9 @@ int main(int argc, char *argv[])
             window->resize(900, 640);
             MarbleTest marbleTest( window->marbleWidget() );
             marbleTest.timeDemo();
+            if ( !profileFile.isEmpty() ) {
+                FrameProfiler::save( profileFile );
+            }
             return 0;
         }
 
@@ -305,5 +325,10 @@ int main(int argc, char *argv[])
             marbleWidget->debugLevelTags() || MarbleDebug::isEnabled();
     marbleWidget->inputHandler()->setDebugModeEnabled(debugModeEnabled);
 
-    return app.exec();
+    const int result = app.exec();
+    if ( !profileFile.isEmpty() ) {
+        FrameProfiler::save( profileFile );
+    }
+
+    return result;
 }
@@ -122,6 +122,16 @@ void DownloadQueueSet::purgeJobs()
     emit progressChanged( m_activeJobs.size(), m_jobs.count() );
 }
 
+int DownloadQueueSet::activeJobCount() const
+{
+    return m_activeJobs.count();
+}
+
+int DownloadQueueSet::queuedJobCount() const
+{
+    return m_jobs.count();
+}
+
 void DownloadQueueSet::finishJob( HttpJob * job, const QByteArray& data )
 {
     mDebug() << "finishJob: " << job->sourceUrl() << job->destinationFileName();
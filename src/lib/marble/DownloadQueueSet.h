@@ -90,6 +90,9 @@ class DownloadQueueSet: public QObject
     void retryJobs();
     void purgeJobs();
 
+    int activeJobCount() const;
+    int queuedJobCount() const;
+
  Q_SIGNALS:
     void jobAdded();
     void jobRemoved();
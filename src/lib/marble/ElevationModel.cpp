@@ -9,6 +9,7 @@
 //
 
 #include "ElevationModel.h"
+#include "GeoDataLineString.h"
 #include "GeoSceneHead.h"
 #include "GeoSceneLayer.h"
 #include "GeoSceneMap.h"
@@ -27,9 +28,26 @@
 #include <QImage>
 #include <qmath.h>
 
+#include <algorithm>
+
 namespace Marble
 {
 
+namespace
+{
+    // invalidElevationData as stored in decoded tiles
+    const qint16 noElevationData = static_cast<qint16>( invalidElevationData );
+
+    /** One of the four pixels interpolated for a point */
+    struct ElevationSample
+    {
+        int tileX;
+        int tileY;
+        int pixel;
+        int index;
+    };
+}
+
 class ElevationModelPrivate
 {
 public:
@@ -37,9 +55,14 @@ public:
         : q( _q ),
           m_tileLoader( downloadManager, pluginManager ),
           m_textureLayer( nullptr ),
-          m_srtmTheme(nullptr)
+          m_srtmTheme(nullptr),
+          m_tileLevel( 0 ),
+          m_tileWidth( 0 ),
+          m_tileHeight( 0 ),
+          m_numTilesX( 0 ),
+          m_numTilesY( 0 )
     {
-        m_cache.setMaxCost( 10 ); //keep 10 tiles in memory (~17MB)
+        m_cache.setMaxCost( 20 ); //keep 20 decoded tiles in memory (~17MB)
 
         m_srtmTheme = MapThemeManager::loadMapTheme( "earth/srtm2/srtm2.dgml" );
         if ( !m_srtmTheme ) {
@@ -58,6 +81,17 @@ public:
 
         m_textureLayer = dynamic_cast<GeoSceneTextureTileDataset*>( sceneLayer->datasets().first() );
         Q_ASSERT( m_textureLayer );
+
+        // Detecting the maximum level may scan the tile directories, so do it only once
+        m_tileLevel = TileLoader::maximumTileLevel( *m_textureLayer );
+        Q_ASSERT( m_tileLevel == 9 );
+
+        m_tileWidth = m_textureLayer->tileSize().width();
+        m_tileHeight = m_textureLayer->tileSize().height();
+        m_numTilesX = TileLoaderHelper::levelToColumn( m_textureLayer->levelZeroColumns(), m_tileLevel );
+        m_numTilesY = TileLoaderHelper::levelToRow( m_textureLayer->levelZeroRows(), m_tileLevel );
+        Q_ASSERT( m_numTilesX > 0 );
+        Q_ASSERT( m_numTilesY > 0 );
     }
 
     ~ElevationModelPrivate()
@@ -67,19 +101,63 @@ public:
 
     void tileCompleted( const TileId & tileId, const QImage &image )
     {
-        m_cache.insert( tileId, new QImage( image ) );
+        m_cache.insert( tileId, decodeTile( image ) );
         emit q->updateAvailable();
     }
 
+    const QVector<qint16> *tile( const TileId &id );
+    QVector<qint16> *decodeTile( const QImage &image ) const;
+
 public:
     ElevationModel *q;
 
     TileLoader m_tileLoader;
     const GeoSceneTextureTileDataset *m_textureLayer;
-    QCache<TileId, const QImage> m_cache;
+    QCache<TileId, const QVector<qint16> > m_cache;
     GeoSceneDocument *m_srtmTheme;
+    int m_tileLevel;
+    int m_tileWidth;
+    int m_tileHeight;
+    int m_numTilesX;
+    int m_numTilesY;
 };
 
+const QVector<qint16> *ElevationModelPrivate::tile( const TileId &id )
+{
+    const QVector<qint16> *tile = m_cache[id];
+    if ( tile == nullptr ) {
+        tile = decodeTile( m_tileLoader.loadTileImage( m_textureLayer, id, DownloadBrowse ) );
+        m_cache.insert( id, tile );
+    }
+    return tile;
+}
+
+QVector<qint16> *ElevationModelPrivate::decodeTile( const QImage &image ) const
+{
+    QVector<qint16> *tile = new QVector<qint16>( m_tileWidth * m_tileHeight, noElevationData );
+    if ( image.width() != m_tileWidth || image.height() != m_tileHeight ) {
+        mDebug() << "Elevation tile of unexpected size" << image.size();
+        return tile;
+    }
+
+    // Read 32 bit pixels as they are, like QImage::pixel() does
+    const bool rgb32 = image.format() == QImage::Format_RGB32
+                       || image.format() == QImage::Format_ARGB32
+                       || image.format() == QImage::Format_ARGB32_Premultiplied;
+    const QImage rgbImage = rgb32 ? image : image.convertToFormat( QImage::Format_ARGB32 );
+
+    qint16 *data = tile->data();
+    for ( int y = 0; y < m_tileHeight; ++y ) {
+        const QRgb *line = reinterpret_cast<const QRgb *>( rgbImage.constScanLine( y ) );
+        for ( int x = 0; x < m_tileWidth; ++x ) {
+            // 16 valid bits and signed type, so just cast it
+            data[y * m_tileWidth + x] = static_cast<qint16>( line[x] & 0xffff );
+        }
+    }
+
+    return tile;
+}
+
 ElevationModel::ElevationModel( HttpDownloadManager *downloadManager, PluginManager* pluginManager, QObject *parent ) :
     QObject( parent ),
     d( new ElevationModelPrivate( this, downloadManager, pluginManager ) )
@@ -95,81 +173,108 @@ ElevationModel::~ElevationModel()
 
 
 qreal ElevationModel::height( qreal lon, qreal lat ) const
+{
+    qreal result;
+    heights( &lon, &lat, 1, &result );
+    return result;
+}
+
+void ElevationModel::heights( const qreal *lon, const qreal *lat, int count, qreal *heights ) const
 {
     if ( !d->m_textureLayer ) {
-        return invalidElevationData;
+        std::fill( heights, heights + count, qreal( invalidElevationData ) );
+        return;
     }
 
-    const int tileZoomLevel = TileLoader::maximumTileLevel( *( d->m_textureLayer ) );
-    Q_ASSERT( tileZoomLevel == 9 );
-
-    const int width = d->m_textureLayer->tileSize().width();
-    const int height = d->m_textureLayer->tileSize().height();
-
-    const int numTilesX = TileLoaderHelper::levelToColumn( d->m_textureLayer->levelZeroColumns(), tileZoomLevel );
-    const int numTilesY = TileLoaderHelper::levelToRow( d->m_textureLayer->levelZeroRows(), tileZoomLevel );
-    Q_ASSERT( numTilesX > 0 );
-    Q_ASSERT( numTilesY > 0 );
-
-    qreal textureX = 180 + lon;
-    textureX *= numTilesX * width / 360;
-
-    qreal textureY = 90 - lat;
-    textureY *= numTilesY * height / 180;
-
-    qreal ret = 0;
-    bool hasHeight = false;
-    qreal noData = 0;
-
-    for ( int i = 0; i < 4; ++i ) {
-        const int x = static_cast<int>( textureX + ( i % 2 ) );
-        const int y = static_cast<int>( textureY + ( i / 2 ) );
-
-        //mDebug() << "x" << x << ( x / width );
-        //mDebug() << "y" << y << ( y / height );
-
-        const TileId id( 0, tileZoomLevel, ( x % ( numTilesX * width ) ) / width, ( y % ( numTilesY * height ) ) / height );
-        //mDebug() << "LAT" << lat << "LON" << lon << "tile" << ( x % ( numTilesX * width ) ) / width << ( y % ( numTilesY * height ) ) / height;
-
-        const QImage *image = d->m_cache[id];
-        if ( image == nullptr ) {
-            image = new QImage( d->m_tileLoader.loadTileImage( d->m_textureLayer, id, DownloadBrowse ) );
-            d->m_cache.insert( id, image );
+    const int width = d->m_tileWidth;
+    const int height = d->m_tileHeight;
+    const int textureWidth = d->m_numTilesX * width;
+    const int textureHeight = d->m_numTilesY * height;
+
+    // Collect the four pixels around each point along with their interpolation weights
+    QVector<ElevationSample> samples( 4 * count );
+    QVector<qreal> weights( 4 * count );
+    for ( int p = 0; p < count; ++p ) {
+        const qreal textureX = ( 180 + lon[p] ) * ( textureWidth / 360 );
+        const qreal textureY = ( 90 - lat[p] ) * ( textureHeight / 180 );
+
+        for ( int i = 0; i < 4; ++i ) {
+            const int x = static_cast<int>( textureX + ( i % 2 ) );
+            const int y = static_cast<int>( textureY + ( i / 2 ) );
+
+            ElevationSample &sample = samples[4 * p + i];
+            sample.index = 4 * p + i;
+            if ( x < 0 || y < 0 ) {
+                sample.tileX = -1;
+                sample.tileY = -1;
+                sample.pixel = -1;
+            } else {
+                sample.tileX = ( x % textureWidth ) / width;
+                sample.tileY = ( y % textureHeight ) / height;
+                sample.pixel = ( y % height ) * width + x % width;
+            }
+
+            const qreal dx = qAbs( textureX - x );
+            const qreal dy = qAbs( textureY - y );
+            Q_ASSERT( 0 <= dx && dx <= 1 );
+            Q_ASSERT( 0 <= dy && dy <= 1 );
+            weights[4 * p + i] = ( 1 - dx ) * ( 1 - dy );
         }
-        Q_ASSERT( image );
-        Q_ASSERT( !image->isNull() );
-        Q_ASSERT( width == image->width() );
-        Q_ASSERT( height == image->height() );
-
-        const qreal dx = ( textureX > ( qreal )x ) ? textureX - ( qreal )x : ( qreal )x - textureX;
-        const qreal dy = ( textureY > ( qreal )y ) ? textureY - ( qreal )y : ( qreal )y - textureY;
-
-        Q_ASSERT( 0 <= dx && dx <= 1 );
-        Q_ASSERT( 0 <= dy && dy <= 1 );
-        unsigned int pixel = image->pixel( x % width, y % height ) & 0xffff; // 16 valid bits
-        short int elevation = (short int) pixel; // and signed type, so just cast it
-        //mDebug() << "(1-dx)" << (1-dx) << "(1-dy)" << (1-dy);
-        if ( pixel != invalidElevationData ) { //no data?
-            //mDebug() << "got at x" << x % width << "y" << y % height << "a height of" << pixel << "** RGB" << qRed(pixel) << qGreen(pixel) << qBlue(pixel);
-            ret += ( qreal )elevation * ( 1 - dx ) * ( 1 - dy );
-            hasHeight = true;
-        } else {
-            //mDebug() << "no data at" <<  x % width << "y" << y % height;
-            noData += ( 1 - dx ) * ( 1 - dy );
+    }
+
+    // Visit each tile once, no matter how often the points cross tile borders
+    std::sort( samples.begin(), samples.end(), []( const ElevationSample &a, const ElevationSample &b ) {
+        return a.tileY < b.tileY || ( a.tileY == b.tileY && a.tileX < b.tileX );
+    } );
+
+    QVector<qint16> values( 4 * count );
+    for ( int i = 0; i < samples.size(); ) {
+        const int tileX = samples[i].tileX;
+        const int tileY = samples[i].tileY;
+        const QVector<qint16> *tile = tileX < 0 ? nullptr : d->tile( TileId( 0, d->m_tileLevel, tileX, tileY ) );
+        for ( ; i < samples.size() && samples[i].tileX == tileX && samples[i].tileY == tileY; ++i ) {
+            values[samples[i].index] = tile ? tile->at( samples[i].pixel ) : noElevationData;
         }
     }
 
-    if ( !hasHeight ) {
-        ret = invalidElevationData; //no data
-    } else {
-        if ( noData ) {
-            //mDebug() << "NO DATA" << noData;
+    for ( int p = 0; p < count; ++p ) {
+        qreal ret = 0;
+        bool hasHeight = false;
+        qreal noData = 0;
+
+        for ( int i = 4 * p; i < 4 * p + 4; ++i ) {
+            if ( values[i] != noElevationData ) {
+                ret += values[i] * weights[i];
+                hasHeight = true;
+            } else {
+                noData += weights[i];
+            }
+        }
+
+        if ( !hasHeight ) {
+            ret = invalidElevationData; //no data
+        } else if ( noData ) {
             ret += ( ret / ( 1 - noData ) ) * noData;
         }
+
+        heights[p] = ret;
     }
+}
 
-    //mDebug() << ">>>" << lat << lon << "returning an elevation of" << ret;
-    return ret;
+QVector<qreal> ElevationModel::heights( const GeoDataLineString &path ) const
+{
+    QVector<qreal> lon;
+    QVector<qreal> lat;
+    lon.reserve( path.size() );
+    lat.reserve( path.size() );
+    for ( const GeoDataCoordinates &coordinates: path ) {
+        lon << coordinates.longitude( GeoDataCoordinates::Degree );
+        lat << coordinates.latitude( GeoDataCoordinates::Degree );
+    }
+
+    QVector<qreal> result( path.size() );
+    heights( lon.constData(), lat.constData(), lon.size(), result.data() );
+    return result;
 }
 
 QVector<GeoDataCoordinates> ElevationModel::heightProfile( qreal fromLon, qreal fromLat, qreal toLon, qreal toLat ) const
@@ -178,11 +283,7 @@ QVector<GeoDataCoordinates> ElevationModel::heightProfile( qreal fromLon, qreal
         return QVector<GeoDataCoordinates>();
     }
 
-    const int tileZoomLevel = TileLoader::maximumTileLevel( *( d->m_textureLayer ) );
-    const int width = d->m_textureLayer->tileSize().width();
-    const int numTilesX = TileLoaderHelper::levelToColumn( d->m_textureLayer->levelZeroColumns(), tileZoomLevel );
-
-    qreal distPerPixel = ( qreal )360 / ( width * numTilesX );
+    qreal distPerPixel = ( qreal )360 / ( d->m_tileWidth * d->m_numTilesX );
     //mDebug() << "heightProfile" << fromLat << fromLon << toLat << toLon << "distPerPixel" << distPerPixel;
 
     qreal lat = fromLat;
@@ -193,13 +294,12 @@ QVector<GeoDataCoordinates> ElevationModel::heightProfile( qreal fromLon, qreal
     //mDebug() << "fromLon" << fromLon << "fromLat" << fromLat;
     //mDebug() << "diff lon" << ( fromLon - toLon ) << "diff lat" << ( fromLat - toLat );
     //mDebug() << "dirLon" << QString::number(dirLon) << "dirLat" << QString::number(dirLat) << "k" << k;
-    QVector<GeoDataCoordinates> ret;
+    QVector<qreal> lons;
+    QVector<qreal> lats;
     while ( lat*dirLat <= toLat*dirLat && lon*dirLon <= toLon * dirLon ) {
         //mDebug() << lat << lon;
-        qreal h = height( lon, lat );
-        if ( h < 32000 ) {
-            ret << GeoDataCoordinates( lon, lat, h, GeoDataCoordinates::Degree );
-        }
+        lons << lon;
+        lats << lat;
         if ( k < 0.5 ) {
             //mDebug() << "lon(x) += distPerPixel";
             lat += distPerPixel * k * dirLat;
@@ -210,6 +310,16 @@ QVector<GeoDataCoordinates> ElevationModel::heightProfile( qreal fromLon, qreal
             lon += distPerPixel / k * dirLon;
         }
     }
+
+    QVector<qreal> h( lons.size() );
+    heights( lons.constData(), lats.constData(), lons.size(), h.data() );
+
+    QVector<GeoDataCoordinates> ret;
+    for ( int i = 0; i < h.size(); ++i ) {
+        if ( h[i] < 32000 ) {
+            ret << GeoDataCoordinates( lons[i], lats[i], h[i], GeoDataCoordinates::Degree );
+        }
+    }
     //mDebug() << ret;
     return ret;
 }
@@ -21,6 +21,7 @@ class QImage;
 namespace Marble
 {
 class GeoDataCoordinates;
+class GeoDataLineString;
 
 namespace {
     unsigned int const invalidElevationData = 32768;
@@ -39,6 +40,19 @@ public:
     ~ElevationModel() override;
 
     qreal height( qreal lon, qreal lat ) const;
+
+    /**
+     * Stores the heights of @p count points given in degrees in @p heights.
+     * The points are grouped by elevation tile, so each tile is looked up and
+     * decoded only once. Points without data get invalidElevationData.
+     **/
+    void heights( const qreal *lon, const qreal *lat, int count, qreal *heights ) const;
+
+    /**
+     * Returns the heights of all points of @p path, see above.
+     **/
+    QVector<qreal> heights( const GeoDataLineString &path ) const;
+
     QVector<GeoDataCoordinates> heightProfile( qreal fromLon, qreal fromLat, qreal toLon, qreal toLat ) const;
 
 Q_SIGNALS:
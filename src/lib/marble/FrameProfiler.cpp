@@ -0,0 +1,349 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "FrameProfiler.h"
+
+#include "MarbleDebug.h"
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+namespace Marble
+{
+
+namespace
+{
+
+/** Checked by the recording methods in any thread, hence atomic */
+QAtomicInt s_enabled( 0 );
+
+struct ProfilerEvent
+{
+    QString category;
+    QString name;
+    Qt::HANDLE thread;
+    qint64 start;
+    qint64 end;
+};
+
+struct ProfilerFrame
+{
+    ProfilerFrame() : index( 0 ), start( 0 ), end( 0 ) {}
+
+    qint64 index;
+    qint64 start;
+    qint64 end;
+    QVector<ProfilerEvent> events;
+    QMap<QString, qreal> counters;
+};
+
+class ProfilerData
+{
+public:
+    ProfilerData() :
+        m_capacity( 1000 ),
+        m_next( 0 ),
+        m_frameCount( 0 )
+    {
+        m_clock.start();
+    }
+
+    /** Returns the recorded frames, oldest first. Caller must hold the mutex. */
+    QVector<ProfilerFrame> frames() const
+    {
+        QVector<ProfilerFrame> result;
+        if ( m_frames.size() < m_capacity ) {
+            result = m_frames;
+        } else {
+            result.reserve( m_frames.size() );
+            for ( int i = 0; i < m_frames.size(); ++i ) {
+                result << m_frames.at( ( m_next + i ) % m_frames.size() );
+            }
+        }
+        return result;
+    }
+
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    int m_capacity;
+
+    /** Ring buffer of finished frames, m_next is the slot to overwrite next */
+    QVector<ProfilerFrame> m_frames;
+    int m_next;
+    qint64 m_frameCount;
+
+    ProfilerFrame m_currentFrame;
+    QMap<QString, int> m_counts;
+    QMap<QString, qreal> m_gauges;
+};
+
+ProfilerData *profilerData()
+{
+    static ProfilerData data;
+    return &data;
+}
+
+}
+
+bool FrameProfiler::isEnabled()
+{
+    return s_enabled.loadAcquire() != 0;
+}
+
+void FrameProfiler::setEnabled( bool enabled )
+{
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    if ( enabled && !isEnabled() ) {
+        data->m_frames.clear();
+        data->m_next = 0;
+        data->m_frameCount = 0;
+        data->m_currentFrame = ProfilerFrame();
+        data->m_counts.clear();
+        data->m_clock.restart();
+    }
+    s_enabled.storeRelease( enabled ? 1 : 0 );
+}
+
+int FrameProfiler::capacity()
+{
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    return data->m_capacity;
+}
+
+void FrameProfiler::setCapacity( int frames )
+{
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    QVector<ProfilerFrame> const recorded = data->frames();
+    data->m_capacity = qMax( 1, frames );
+    data->m_frames = recorded.mid( qMax( 0, recorded.size() - data->m_capacity ) );
+    data->m_next = data->m_frames.size() % data->m_capacity;
+}
+
+qint64 FrameProfiler::timestamp()
+{
+    if ( !isEnabled() ) {
+        return 0;
+    }
+
+    // setEnabled() restarts the clock only before publishing the enabled state,
+    // so reading it needs no lock once that state was observed
+    return profilerData()->m_clock.nsecsElapsed();
+}
+
+void FrameProfiler::beginFrame()
+{
+    if ( !isEnabled() ) {
+        return;
+    }
+
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    data->m_currentFrame.start = data->m_clock.nsecsElapsed();
+}
+
+void FrameProfiler::endFrame()
+{
+    if ( !isEnabled() ) {
+        return;
+    }
+
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    ProfilerFrame &frame = data->m_currentFrame;
+    frame.index = data->m_frameCount++;
+    frame.end = data->m_clock.nsecsElapsed();
+
+    QMap<QString, int>::const_iterator count = data->m_counts.constBegin();
+    for ( ; count != data->m_counts.constEnd(); ++count ) {
+        frame.counters[count.key()] = count.value();
+    }
+    QMap<QString, qreal>::const_iterator gauge = data->m_gauges.constBegin();
+    for ( ; gauge != data->m_gauges.constEnd(); ++gauge ) {
+        frame.counters[gauge.key()] = gauge.value();
+    }
+
+    if ( data->m_frames.size() < data->m_capacity ) {
+        data->m_frames << frame;
+    } else {
+        data->m_frames[data->m_next] = frame;
+    }
+    data->m_next = ( data->m_next + 1 ) % data->m_capacity;
+
+    data->m_currentFrame = ProfilerFrame();
+    data->m_counts.clear();
+}
+
+void FrameProfiler::addEvent( const QString &category, const QString &name, qint64 start, qint64 end )
+{
+    if ( !isEnabled() ) {
+        return;
+    }
+
+    ProfilerEvent const event = { category, name, QThread::currentThreadId(), start, end };
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    data->m_currentFrame.events << event;
+}
+
+void FrameProfiler::count( const QString &name, int increment )
+{
+    if ( !isEnabled() ) {
+        return;
+    }
+
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    data->m_counts[name] += increment;
+}
+
+void FrameProfiler::setGauge( const QString &name, qreal value )
+{
+    if ( !isEnabled() ) {
+        return;
+    }
+
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    data->m_gauges[name] = value;
+}
+
+void FrameProfiler::clear()
+{
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+    data->m_frames.clear();
+    data->m_next = 0;
+    data->m_currentFrame = ProfilerFrame();
+    data->m_counts.clear();
+}
+
+QByteArray FrameProfiler::toChromeTrace()
+{
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+
+    // Chrome expects small integer thread ids
+    QHash<Qt::HANDLE, int> threadIds;
+    threadIds.insert( QThread::currentThreadId(), 0 );
+
+    QJsonArray events;
+    for( const ProfilerFrame &frame: data->frames() ) {
+        QJsonObject frameEvent;
+        frameEvent.insert( QStringLiteral( "name" ), QStringLiteral( "Frame %1" ).arg( frame.index ) );
+        frameEvent.insert( QStringLiteral( "cat" ), QStringLiteral( "frame" ) );
+        frameEvent.insert( QStringLiteral( "ph" ), QStringLiteral( "X" ) );
+        frameEvent.insert( QStringLiteral( "ts" ), frame.start / 1000.0 );
+        frameEvent.insert( QStringLiteral( "dur" ), ( frame.end - frame.start ) / 1000.0 );
+        frameEvent.insert( QStringLiteral( "pid" ), 1 );
+        frameEvent.insert( QStringLiteral( "tid" ), 0 );
+        events.append( frameEvent );
+
+        for( const ProfilerEvent &event: frame.events ) {
+            if ( !threadIds.contains( event.thread ) ) {
+                threadIds.insert( event.thread, threadIds.size() );
+            }
+
+            QJsonObject object;
+            object.insert( QStringLiteral( "name" ), event.name );
+            object.insert( QStringLiteral( "cat" ), event.category );
+            object.insert( QStringLiteral( "ph" ), QStringLiteral( "X" ) );
+            object.insert( QStringLiteral( "ts" ), event.start / 1000.0 );
+            object.insert( QStringLiteral( "dur" ), ( event.end - event.start ) / 1000.0 );
+            object.insert( QStringLiteral( "pid" ), 1 );
+            object.insert( QStringLiteral( "tid" ), threadIds.value( event.thread ) );
+            events.append( object );
+        }
+
+        QMap<QString, qreal>::const_iterator counter = frame.counters.constBegin();
+        for ( ; counter != frame.counters.constEnd(); ++counter ) {
+            QJsonObject args;
+            args.insert( QStringLiteral( "value" ), counter.value() );
+
+            QJsonObject object;
+            object.insert( QStringLiteral( "name" ), counter.key() );
+            object.insert( QStringLiteral( "ph" ), QStringLiteral( "C" ) );
+            object.insert( QStringLiteral( "ts" ), frame.end / 1000.0 );
+            object.insert( QStringLiteral( "pid" ), 1 );
+            object.insert( QStringLiteral( "args" ), args );
+            events.append( object );
+        }
+    }
+
+    QJsonObject trace;
+    trace.insert( QStringLiteral( "traceEvents" ), events );
+    trace.insert( QStringLiteral( "displayTimeUnit" ), QStringLiteral( "ms" ) );
+    return QJsonDocument( trace ).toJson( QJsonDocument::Compact );
+}
+
+QByteArray FrameProfiler::toCsv()
+{
+    ProfilerData *const data = profilerData();
+    QMutexLocker locker( &data->m_mutex );
+
+    QHash<Qt::HANDLE, int> threadIds;
+    threadIds.insert( QThread::currentThreadId(), 0 );
+
+    QByteArray result = "frame,category,name,thread,start_us,duration_us,value\n";
+    for( const ProfilerFrame &frame: data->frames() ) {
+        QByteArray const index = QByteArray::number( frame.index );
+        result += index + ",frame,frame,0," + QByteArray::number( frame.start / 1000.0, 'f', 1 ) + ','
+                + QByteArray::number( ( frame.end - frame.start ) / 1000.0, 'f', 1 ) + ",\n";
+
+        for( const ProfilerEvent &event: frame.events ) {
+            if ( !threadIds.contains( event.thread ) ) {
+                threadIds.insert( event.thread, threadIds.size() );
+            }
+
+            QString name = event.name;
+            name.replace( QLatin1Char( '"' ), QLatin1String( "\"\"" ) );
+            result += index + ',' + event.category.toUtf8() + ",\"" + name.toUtf8() + "\","
+                    + QByteArray::number( threadIds.value( event.thread ) ) + ','
+                    + QByteArray::number( event.start / 1000.0, 'f', 1 ) + ','
+                    + QByteArray::number( ( event.end - event.start ) / 1000.0, 'f', 1 ) + ",\n";
+        }
+
+        QMap<QString, qreal>::const_iterator counter = frame.counters.constBegin();
+        for ( ; counter != frame.counters.constEnd(); ++counter ) {
+            result += index + ",counter,\"" + counter.key().toUtf8() + "\",0,"
+                    + QByteArray::number( frame.end / 1000.0, 'f', 1 ) + ",,"
+                    + QByteArray::number( counter.value() ) + '\n';
+        }
+    }
+
+    return result;
+}
+
+bool FrameProfiler::save( const QString &fileName )
+{
+    QFile file( fileName );
+    if ( !file.open( QFile::WriteOnly | QFile::Truncate ) ) {
+        mDebug() << "Cannot write frame profile to" << fileName << file.errorString();
+        return false;
+    }
+
+    bool const csv = fileName.endsWith( QLatin1String( ".csv" ), Qt::CaseInsensitive );
+    QByteArray const content = csv ? toCsv() : toChromeTrace();
+    return file.write( content ) == content.size();
+}
+
+}
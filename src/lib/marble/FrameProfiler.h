@@ -0,0 +1,107 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_FRAMEPROFILER_H
+#define MARBLE_FRAMEPROFILER_H
+
+#include "marble_export.h"
+
+#include <QtGlobal>
+
+class QByteArray;
+class QString;
+
+namespace Marble
+{
+
+/**
+  * @short Records timings and counters of rendered frames for later analysis.
+  *
+  * When enabled, each frame rendered by MarbleMap is stored with the timings
+  * of the layers and render positions involved, along with counters like tile
+  * cache hits and download queue depths. Only the most recent frames are kept
+  * (see setCapacity()). The recorded frames can be exported as a Chrome trace
+  * (chrome://tracing) or as CSV to compare different builds.
+  *
+  * All methods are thread-safe. When the profiler is disabled, recording
+  * methods return immediately.
+  */
+class MARBLE_EXPORT FrameProfiler
+{
+public:
+    /**
+     * @brief isEnabled returns whether frames are recorded
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief setEnabled Toggle frame recording. Enabling the profiler discards
+     * previously recorded frames and restarts the clock used for timestamps.
+     */
+    static void setEnabled( bool enabled );
+
+    /**
+     * @brief Returns the maximum number of frames kept (default: 1000)
+     */
+    static int capacity();
+
+    static void setCapacity( int frames );
+
+    /**
+     * @brief Returns the number of nanoseconds elapsed since the profiler was enabled,
+     * or 0 if it is disabled
+     */
+    static qint64 timestamp();
+
+    static void beginFrame();
+
+    static void endFrame();
+
+    /**
+     * @brief Records a timed event of the current frame on the calling thread
+     * @param category  event group, e.g. "layer"
+     * @param name  event name, e.g. the layer name
+     * @param start  start of the event, see timestamp()
+     * @param end  end of the event, see timestamp()
+     */
+    static void addEvent( const QString &category, const QString &name, qint64 start, qint64 end );
+
+    /**
+     * @brief Increments a counter which is reset for each frame, e.g. tile cache misses
+     */
+    static void count( const QString &name, int increment = 1 );
+
+    /**
+     * @brief Sets a value which is sampled at the end of each frame, e.g. a queue depth
+     */
+    static void setGauge( const QString &name, qreal value );
+
+    static void clear();
+
+    /**
+     * @brief Returns the recorded frames in the Chrome trace event format (JSON)
+     */
+    static QByteArray toChromeTrace();
+
+    /**
+     * @brief Returns the recorded frames as comma separated values, one line per
+     * event or counter
+     */
+    static QByteArray toCsv();
+
+    /**
+     * @brief Writes the recorded frames to the given file. Files ending in .csv
+     * are written as CSV, all others as Chrome trace.
+     * @return true if the file was written successfully
+     */
+    static bool save( const QString &fileName );
+};
+
+}
+
+#endif
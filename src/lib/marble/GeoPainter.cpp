@@ -11,6 +11,7 @@
 #include "GeoPainter.h"
 #include "GeoPainter_p.h"
 
+#include <QImage>
 #include <QList>
 #include <QPainterPath>
 #include <QPixmapCache>
@@ -28,6 +29,8 @@
 
 #include "MarbleGlobal.h"
 #include "ViewportParams.h"
+#include "LabelAtlas.h"
+#include "ScreenPolygonPool.h"
 #include "AbstractProjection.h"
 
 // #define MARBLE_DEBUG
@@ -38,6 +41,8 @@ GeoPainterPrivate::GeoPainterPrivate( GeoPainter* q, const ViewportParams *viewp
         : m_viewport( viewport ),
         m_mapQuality( mapQuality ),
         m_x( new qreal[100] ),
+        m_labelAtlas( nullptr ),
+        m_labelBatchDepth( 0 ),
         m_parent(q)
 {
 }
@@ -186,6 +191,16 @@ qreal GeoPainterPrivate::normalizeAngle(qreal angle)
 
 void GeoPainterPrivate::drawTextRotated( const QPointF &startPoint, qreal angle, const QString &text )
 {
+    if ( m_labelAtlas ) {
+        // The text starts at startPoint and is vertically centered on the rotated baseline
+        const qreal halfWidth = 0.5 * m_parent->fontMetrics().width( text );
+        const qreal radians = angle * DEG2RAD;
+        const QPointF center = startPoint + halfWidth * QPointF( cos( radians ), sin( radians ) );
+        if ( drawAtlasText( center, angle, text ) ) {
+            return;
+        }
+    }
+
     QRectF textRect(startPoint, m_parent->fontMetrics().size( 0, text));
     QTransform const oldTransform = m_parent->transform();
     m_parent->translate(startPoint);
@@ -196,6 +211,85 @@ void GeoPainterPrivate::drawTextRotated( const QPointF &startPoint, qreal angle,
     m_parent->setTransform(oldTransform);
 }
 
+bool GeoPainterPrivate::drawAtlasText( const QPointF &center, qreal angle, const QString &text )
+{
+    const QFont font = m_parent->font();
+    const QColor color = m_parent->pen().color();
+    const QString key = LabelAtlas::key( text, font, color );
+
+    if ( !m_labelAtlas->contains( key ) ) {
+        const QSize size = m_parent->fontMetrics().size( 0, text );
+        if ( size.isEmpty() ) {
+            return false;
+        }
+
+        // Render at the resolution of the target so that fonts get the same pixel size
+        QImage image( size, QImage::Format_ARGB32_Premultiplied );
+        if ( const QPaintDevice *device = m_parent->device() ) {
+            image.setDotsPerMeterX( qRound( device->logicalDpiX() / 0.0254 ) );
+            image.setDotsPerMeterY( qRound( device->logicalDpiY() / 0.0254 ) );
+        }
+        image.fill( Qt::transparent );
+
+        QPainter painter( &image );
+        painter.setRenderHints( m_parent->renderHints() );
+        painter.setFont( font );
+        painter.setPen( color );
+        painter.drawText( QRect( QPoint( 0, 0 ), size ), text );
+        painter.end();
+
+        if ( !m_labelAtlas->insert( key, image ) ) {
+            return false;
+        }
+    }
+
+    drawAtlasLabel( key, center, angle );
+    return true;
+}
+
+void GeoPainterPrivate::drawAtlasLabel( const QString &key, const QPointF &center, qreal angle )
+{
+    m_labelAtlas->draw( key, center, angle );
+    if ( m_labelBatchDepth == 0 ) {
+        m_labelAtlas->flush( m_parent );
+    }
+}
+
+QImage GeoPainterPrivate::textFragmentImage( const QString &text, qreal fontSize,
+                                             const QColor &color, bool hasRoundFrame )
+{
+    QFont textFont;
+    textFont.setPointSizeF( fontSize );
+    const QFontMetrics metrics( textFont );
+
+    const int width = metrics.width( text );
+    const int height = metrics.height();
+    const QSize size = hasRoundFrame
+                          ? QSize( qRound( qMax( 1.2 * width, 1.1 * height ) ), qRound( 1.2 * height ) )
+                          : QSize( width, height );
+
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+    const QRect labelRect( QPoint(), size );
+
+    QPainter textPainter( &image );
+    textPainter.setFont( textFont );
+    textPainter.setRenderHint( QPainter::Antialiasing, true );
+
+    if ( hasRoundFrame ) {
+        QColor lighterColor = color.lighter( 110 );
+        lighterColor.setAlphaF( 0.9 );
+        textPainter.setBrush( lighterColor );
+        textPainter.drawRoundedRect( labelRect, 3, 3 );
+    }
+
+    textPainter.setBrush( color );
+    textPainter.drawText( labelRect, Qt::AlignHCenter, text );
+    textPainter.end();
+
+    return image;
+}
+
 // -------------------------------------------------------------------------------------------------
 
 GeoPainter::GeoPainter( QPaintDevice* pd, const ViewportParams *viewport, MapQuality mapQuality )
@@ -220,6 +314,36 @@ MapQuality GeoPainter::mapQuality() const
 }
 
 
+void GeoPainter::setLabelAtlas( LabelAtlas *atlas )
+{
+    if ( d->m_labelAtlas && d->m_labelAtlas != atlas ) {
+        d->m_labelAtlas->flush( this );
+    }
+    d->m_labelAtlas = atlas;
+}
+
+
+LabelAtlas *GeoPainter::labelAtlas() const
+{
+    return d->m_labelAtlas;
+}
+
+
+void GeoPainter::beginLabelBatch()
+{
+    ++d->m_labelBatchDepth;
+}
+
+
+void GeoPainter::endLabelBatch()
+{
+    Q_ASSERT( d->m_labelBatchDepth > 0 );
+    if ( --d->m_labelBatchDepth == 0 && d->m_labelAtlas ) {
+        d->m_labelAtlas->flush( this );
+    }
+}
+
+
 void GeoPainter::drawAnnotation( const GeoDataCoordinates & position,
                                  const QString & text, QSizeF bubbleSize,
                                  qreal bubbleOffsetX, qreal bubbleOffsetY,
@@ -592,7 +716,7 @@ void GeoPainter::drawPolyline ( const GeoDataLineString & lineString,
                           labelPositionFlags,
                           labelColor);
 
-    qDeleteAll( polygons );
+    d->m_viewport->polygonPool()->release( polygons );
 }
 
 void GeoPainter::drawLabelsForPolygons( const QVector<QPolygonF*> &polygons,
@@ -707,7 +831,10 @@ void GeoPainter::drawLabelsForPolygons( const QVector<QPolygonF*> &polygons,
                     qreal ymax = viewport().height() - 10.0 - labelAscent;
                     if ( labelPosition.y() > ymax ) labelPosition.setY( ymax );
 
-                    drawText( QRectF( labelPosition, fontMetrics().size( 0, labelText) ), labelText );
+                    const QRectF labelRect( labelPosition, fontMetrics().size( 0, labelText ) );
+                    if ( !d->m_labelAtlas || !d->drawAtlasText( labelRect.center(), 0.0, labelText ) ) {
+                        drawText( labelRect, labelText );
+                    }
                 }
             }
         }
@@ -725,7 +852,7 @@ void GeoPainter::drawPolyline(const GeoDataLineString& lineString)
         ClipPainter::drawPolyline(*itPolygon);
     }
 
-    qDeleteAll(polygons);
+    d->m_viewport->polygonPool()->release( polygons );
 }
 
 
@@ -752,7 +879,7 @@ QRegion GeoPainter::regionFromPolyline ( const GeoDataLineString & lineString,
         painterPath.addPolygon( *itPolygon );
     }
 
-    qDeleteAll( polygons );
+    d->m_viewport->polygonPool()->release( polygons );
 
     QPainterPathStroker stroker;
     stroker.setWidth( strokeWidth );
@@ -783,7 +910,7 @@ void GeoPainter::drawPolygon ( const GeoDataLinearRing & linearRing,
         ClipPainter::drawPolygon( *itPolygon, fillRule );
     }
 
-    qDeleteAll( polygons );
+    d->m_viewport->polygonPool()->release( polygons );
 }
 
 
@@ -824,7 +951,7 @@ QRegion GeoPainter::regionFromPolygon ( const GeoDataLinearRing & linearRing,
         regions = QRegion( painterPath.toFillPolygon().toPolygon() );
     }
 
-    qDeleteAll( polygons );
+    d->m_viewport->polygonPool()->release( polygons );
 
     return regions;
 }
@@ -894,7 +1021,7 @@ void GeoPainter::drawPolygon ( const GeoDataPolygon & polygon,
                 ClipPainter::drawPolyline( *innerPolygon );
             }
 
-            qDeleteAll(fillPolygons);
+            d->m_viewport->polygonPool()->release( fillPolygons );
         }
     }
 
@@ -902,8 +1029,8 @@ void GeoPainter::drawPolygon ( const GeoDataPolygon & polygon,
         drawPolygon( polygon.outerBoundary(), fillRule );
     }
 
-    qDeleteAll(outerPolygons);
-    qDeleteAll(innerPolygons);
+    d->m_viewport->polygonPool()->release( outerPolygons );
+    d->m_viewport->polygonPool()->release( innerPolygons );
 }
 
 QVector<QPolygonF*> GeoPainter::createFillPolygons( const QVector<QPolygonF*> & outerPolygons,
@@ -913,7 +1040,7 @@ QVector<QPolygonF*> GeoPainter::createFillPolygons( const QVector<QPolygonF*> &
     fillPolygons.reserve(outerPolygons.size());
 
     for( const QPolygonF* outerPolygon: outerPolygons ) {
-        QPolygonF* fillPolygon = new QPolygonF;
+        QPolygonF* fillPolygon = d->m_viewport->polygonPool()->acquire();
         *fillPolygon << *outerPolygon;
         *fillPolygon << outerPolygon->first();
 
@@ -1023,50 +1150,26 @@ void GeoPainter::drawTextFragment(const QPoint &position, const QString &text,
                                   const qreal fontSize, const QColor &color,
                                   const Frames &flags)
 {
-    const QString key = text + ":" + QString::number(static_cast<int>(flags));
+    const bool hasRoundFrame = flags.testFlag(RoundFrame);
+
+    // The color only shows in the frame, the text itself is always black.
+    // Style 0 is taken by the plain text of drawAtlasText().
+    QFont textFont;
+    textFont.setPointSizeF(fontSize);
+    const QString key = LabelAtlas::key(text, textFont, hasRoundFrame ? color : QColor(Qt::black),
+                                        1 + static_cast<int>(flags));
+
+    if (d->m_labelAtlas) {
+        if (d->m_labelAtlas->contains(key)
+                || d->m_labelAtlas->insert(key, GeoPainterPrivate::textFragmentImage(text, fontSize, color, hasRoundFrame))) {
+            d->drawAtlasLabel(key, position, 0.0);
+            return;
+        }
+    }
 
     QPixmap pixmap;
-
     if (!QPixmapCache::find(key, &pixmap)) {
-        const bool hasRoundFrame = flags.testFlag(RoundFrame);
-
-        QPixmap pixmap(10,10);
-        QPainter textPainter;
-
-        textPainter.begin(&pixmap);
-        const QFontMetrics metrics = textPainter.fontMetrics();
-        textPainter.end();
-
-        const int width = metrics.width(text);
-        const int height = metrics.height();
-        const QSize size = hasRoundFrame
-                              ? QSize(qMax(1.2*width, 1.1*height), 1.2*height)
-                              : QSize(width, height);
-        pixmap = QPixmap(size);
-        pixmap.fill(Qt::transparent);
-        const QRect labelRect(QPoint(), size);
-        textPainter.begin(&pixmap);
-        QFont textFont = textPainter.font();
-        textFont.setPointSize(fontSize);
-        textPainter.setFont(textFont);
-        textPainter.setRenderHint(QPainter::Antialiasing, true);
-
-        const QColor brushColor = color;
-        if (hasRoundFrame) {
-            QColor lighterColor = brushColor.lighter(110);
-            lighterColor.setAlphaF(0.9);
-            textPainter.setBrush(lighterColor);
-            textPainter.drawRoundedRect(labelRect, 3, 3);
-        }
-
-        textPainter.setBrush(brushColor);
-        textPainter.drawText(labelRect, Qt::AlignHCenter , text);
-
-        if (hasRoundFrame) {
-            textPainter.setBrush(brushColor);
-        }
-
-        textPainter.end();
+        pixmap = QPixmap::fromImage(GeoPainterPrivate::textFragmentImage(text, fontSize, color, hasRoundFrame));
         QPixmapCache::insert(key, pixmap);
     }
 
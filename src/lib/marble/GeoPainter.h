@@ -35,6 +35,7 @@ class GeoDataLineString;
 class GeoDataLinearRing;
 class GeoDataPoint;
 class GeoDataPolygon;
+class LabelAtlas;
 
 
 /*!
@@ -125,6 +126,37 @@ class MARBLE_EXPORT GeoPainter : public ClipPainter
     MapQuality mapQuality() const;
 
 
+/*!
+    \brief Sets the atlas used to cache and batch the labels drawn by the painter.
+
+    Line labels and text fragments are rendered once into \a atlas and blitted
+    from there afterwards. Without an atlas, the default, text is drawn directly.
+    The painter does not take ownership.
+
+    \see beginLabelBatch()
+*/
+    void setLabelAtlas( LabelAtlas *atlas );
+
+/*!
+    \brief Returns the label atlas of the painter, or nullptr if there is none.
+*/
+    LabelAtlas *labelAtlas() const;
+
+/*!
+    \brief Starts collecting the labels drawn through the label atlas.
+
+    Until the matching endLabelBatch() call, labels are only queued and then
+    drawn with one call per atlas page. Calls may be nested. Only labels which
+    don't need to appear on top of other drawings in between should be batched.
+*/
+    void beginLabelBatch();
+
+/*!
+    \brief Draws all labels queued since the outermost beginLabelBatch() call.
+*/
+    void endLabelBatch();
+
+
 /*!
     \brief Draws a text annotation that points to a geodesic position.
 
@@ -316,7 +348,8 @@ class MARBLE_EXPORT GeoPainter : public ClipPainter
     In general drawPolyline() should be used instead. However
     in situations where the same linestring is supposed to be
     drawn multiple times it's a good idea to cache the
-    screen polygons using this method.
+    screen polygons using this method. Once no longer needed,
+    release the polygons to ViewportParams::polygonPool().
 
     \see GeoDataLineString
 */
@@ -14,7 +14,11 @@
 #include "MarbleGlobal.h"
 //#include "GeoPainter.h"
 
+class QColor;
+class QImage;
+class QPointF;
 class QPolygonF;
+class QString;
 class QSizeF;
 class QPainterPath;
 class QRectF;
@@ -25,6 +29,7 @@ namespace Marble
 class ViewportParams;
 class GeoDataCoordinates;
 class GeoPainter;
+class LabelAtlas;
 
 class GeoPainterPrivate
 {
@@ -49,9 +54,18 @@ class GeoPainterPrivate
 
     void drawTextRotated( const QPointF &startPoint, qreal angle, const QString &text );
 
+    bool drawAtlasText( const QPointF &center, qreal angle, const QString &text );
+
+    void drawAtlasLabel( const QString &key, const QPointF &center, qreal angle );
+
+    static QImage textFragmentImage( const QString &text, qreal fontSize,
+                                     const QColor &color, bool hasRoundFrame );
+
     const ViewportParams *const m_viewport;
     const MapQuality       m_mapQuality;
     qreal             *const m_x;
+    LabelAtlas        *m_labelAtlas;
+    int                m_labelBatchDepth;
 
 private:
     GeoPainter* m_parent;
@@ -19,6 +19,7 @@
 
 #include "DownloadPolicy.h"
 #include "DownloadQueueSet.h"
+#include "FrameProfiler.h"
 #include "HttpJob.h"
 #include "MarbleDebug.h"
 #include "StoragePolicy.h"
@@ -40,6 +41,7 @@ class Q_DECL_HIDDEN HttpDownloadManager::Private
     void finishJob( const QByteArray&, const QString&, const QString& id );
     void requeue();
     void startRetryTimer();
+    void updateQueueDepths();
 
     DownloadQueueSet *findQueues( const QString& hostName, const DownloadUsage usage );
 
@@ -208,6 +210,28 @@ void HttpDownloadManager::Private::connectQueueSet( DownloadQueueSet * queueSet
     connect( queueSet, SIGNAL(jobAdded()), m_downloadManager, SIGNAL(jobAdded()));
     connect( queueSet, SIGNAL(jobRemoved()), m_downloadManager, SIGNAL(jobRemoved()));
     connect( queueSet, SIGNAL(progressChanged(int,int)), m_downloadManager, SIGNAL(progressChanged(int,int)) );
+    connect( queueSet, SIGNAL(progressChanged(int,int)), m_downloadManager, SLOT(updateQueueDepths()) );
+}
+
+void HttpDownloadManager::Private::updateQueueDepths()
+{
+    if ( !FrameProfiler::isEnabled() ) {
+        return;
+    }
+
+    int active = 0;
+    int queued = 0;
+    for( const auto &queueSet: m_queueSets ) {
+        active += queueSet.second->activeJobCount();
+        queued += queueSet.second->queuedJobCount();
+    }
+    for( const DownloadQueueSet *queueSet: m_defaultQueueSets ) {
+        active += queueSet->activeJobCount();
+        queued += queueSet->queuedJobCount();
+    }
+
+    FrameProfiler::setGauge( QStringLiteral( "Active downloads" ), active );
+    FrameProfiler::setGauge( QStringLiteral( "Queued downloads" ), queued );
 }
 
 bool HttpDownloadManager::Private::hasDownloadPolicy( const DownloadPolicy& policy ) const
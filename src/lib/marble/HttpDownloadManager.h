@@ -111,6 +111,7 @@ class MARBLE_EXPORT HttpDownloadManager : public QObject
     Q_PRIVATE_SLOT( d, void finishJob( const QByteArray&, const QString&, const QString& id ) )
     Q_PRIVATE_SLOT( d, void requeue() )
     Q_PRIVATE_SLOT( d, void startRetryTimer() )
+    Q_PRIVATE_SLOT( d, void updateQueueDepths() )
 };
 
 }
@@ -0,0 +1,341 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "LabelAtlas.h"
+
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QString>
+#include <QVector>
+
+namespace Marble
+{
+
+namespace
+{
+
+/** A row of labels of similar height */
+struct Shelf
+{
+    int y;
+    int height;
+    int x;
+};
+
+struct Entry
+{
+    int page;
+    QRect rect;
+};
+
+}
+
+class LabelAtlasPage
+{
+public:
+    LabelAtlasPage();
+
+    void reset();
+
+    bool allocate( const QSize &size, QPoint &position );
+
+    QPixmap m_pixmap;
+    QVector<Shelf> m_shelves;
+    int m_bottom;
+    QVector<QString> m_keys;
+    quint64 m_lastUse;
+    QVector<QPainter::PixmapFragment> m_fragments;
+};
+
+class LabelAtlasPrivate
+{
+public:
+    explicit LabelAtlasPrivate( qint64 budget ) :
+        m_budget( budget ),
+        m_useCount( 0 ),
+        m_pendingCount( 0 ),
+        m_evictionCount( 0 )
+    {
+    }
+
+    int maximumPageCount() const;
+    LabelAtlasPage *evictablePage();
+    void evict( LabelAtlasPage *page );
+
+    // Labels are sampled with smooth pixmap transforms when rotated, so each
+    // one keeps a transparent border to avoid bleeding of its neighbours
+    static const int s_padding = 1;
+    static const int s_pageSize = 1024;
+
+    qint64 m_budget;
+    QVector<LabelAtlasPage*> m_pages;
+    QHash<QString, Entry> m_entries;
+    quint64 m_useCount;
+    int m_pendingCount;
+    qint64 m_evictionCount;
+};
+
+LabelAtlasPage::LabelAtlasPage() :
+    m_pixmap( LabelAtlasPrivate::s_pageSize, LabelAtlasPrivate::s_pageSize ),
+    m_bottom( 0 ),
+    m_lastUse( 0 )
+{
+    m_pixmap.fill( Qt::transparent );
+}
+
+void LabelAtlasPage::reset()
+{
+    m_pixmap.fill( Qt::transparent );
+    m_shelves.clear();
+    m_bottom = 0;
+    m_keys.clear();
+}
+
+bool LabelAtlasPage::allocate( const QSize &size, QPoint &position )
+{
+    for ( int i = 0; i < m_shelves.size(); ++i ) {
+        Shelf &shelf = m_shelves[i];
+        // Don't waste more than a quarter of a shelf on smaller labels
+        const bool fitsHeight = size.height() <= shelf.height && 4 * size.height() >= 3 * shelf.height;
+        if ( fitsHeight && shelf.x + size.width() <= LabelAtlasPrivate::s_pageSize ) {
+            position = QPoint( shelf.x, shelf.y );
+            shelf.x += size.width();
+            return true;
+        }
+    }
+
+    if ( m_bottom + size.height() > LabelAtlasPrivate::s_pageSize ) {
+        return false;
+    }
+
+    Shelf shelf;
+    shelf.y = m_bottom;
+    shelf.height = size.height();
+    shelf.x = size.width();
+    m_shelves << shelf;
+    m_bottom += size.height();
+    position = QPoint( 0, shelf.y );
+    return true;
+}
+
+int LabelAtlasPrivate::maximumPageCount() const
+{
+    const qint64 pageBytes = qint64( s_pageSize ) * s_pageSize * 4;
+    return qMax( 1, int( m_budget / pageBytes ) );
+}
+
+LabelAtlasPage *LabelAtlasPrivate::evictablePage()
+{
+    LabelAtlasPage *result = nullptr;
+    for( LabelAtlasPage *page: m_pages ) {
+        if ( page->m_fragments.isEmpty() && ( !result || page->m_lastUse < result->m_lastUse ) ) {
+            result = page;
+        }
+    }
+    return result;
+}
+
+void LabelAtlasPrivate::evict( LabelAtlasPage *page )
+{
+    for( const QString &key: page->m_keys ) {
+        m_entries.remove( key );
+    }
+    page->reset();
+    ++m_evictionCount;
+}
+
+LabelAtlas::LabelAtlas( qint64 budget ) :
+    d( new LabelAtlasPrivate( budget ) )
+{
+}
+
+LabelAtlas::~LabelAtlas()
+{
+    qDeleteAll( d->m_pages );
+    delete d;
+}
+
+QString LabelAtlas::key( const QString &text, const QFont &font, const QColor &color, int style )
+{
+    return text + QLatin1Char( '\t' ) + font.key() + QLatin1Char( '\t' )
+            + QString::number( color.rgba(), 16 ) + QLatin1Char( '\t' ) + QString::number( style );
+}
+
+QSize LabelAtlas::pageSize()
+{
+    return QSize( LabelAtlasPrivate::s_pageSize, LabelAtlasPrivate::s_pageSize );
+}
+
+bool LabelAtlas::contains( const QString &key ) const
+{
+    return d->m_entries.contains( key );
+}
+
+bool LabelAtlas::insert( const QString &key, const QImage &image )
+{
+    if ( d->m_entries.contains( key ) ) {
+        return true;
+    }
+
+    const QSize size = image.size() + QSize( 2 * LabelAtlasPrivate::s_padding, 2 * LabelAtlasPrivate::s_padding );
+    if ( image.isNull() || size.width() > LabelAtlasPrivate::s_pageSize || size.height() > LabelAtlasPrivate::s_pageSize ) {
+        return false;
+    }
+
+    int pageIndex = -1;
+    QPoint position;
+    for ( int i = d->m_pages.size() - 1; i >= 0 && pageIndex < 0; --i ) {
+        if ( d->m_pages[i]->allocate( size, position ) ) {
+            pageIndex = i;
+        }
+    }
+
+    if ( pageIndex < 0 ) {
+        LabelAtlasPage *page = nullptr;
+        if ( d->m_pages.size() < d->maximumPageCount() ) {
+            page = new LabelAtlasPage;
+            d->m_pages << page;
+        } else {
+            page = d->evictablePage();
+            if ( !page ) {
+                return false;
+            }
+            d->evict( page );
+        }
+
+        page->allocate( size, position );
+        pageIndex = d->m_pages.indexOf( page );
+    }
+
+    LabelAtlasPage *const page = d->m_pages[pageIndex];
+    const QPoint topLeft = position + QPoint( LabelAtlasPrivate::s_padding, LabelAtlasPrivate::s_padding );
+
+    QPainter painter( &page->m_pixmap );
+    painter.setCompositionMode( QPainter::CompositionMode_Source );
+    painter.drawImage( topLeft, image );
+    painter.end();
+
+    Entry entry;
+    entry.page = pageIndex;
+    entry.rect = QRect( topLeft, image.size() );
+    d->m_entries.insert( key, entry );
+    page->m_keys << key;
+    page->m_lastUse = ++d->m_useCount;
+
+    return true;
+}
+
+bool LabelAtlas::draw( const QString &key, const QPointF &center, qreal rotation )
+{
+    const auto iter = d->m_entries.constFind( key );
+    if ( iter == d->m_entries.constEnd() ) {
+        return false;
+    }
+
+    QPointF position = center;
+    if ( rotation == 0.0 ) {
+        // Keep unrotated labels on the pixel grid, they would get blurred otherwise
+        const QPointF halfSize( 0.5 * iter->rect.width(), 0.5 * iter->rect.height() );
+        const QPointF topLeft = center - halfSize;
+        position = QPointF( qRound( topLeft.x() ), qRound( topLeft.y() ) ) + halfSize;
+    }
+
+    LabelAtlasPage *const page = d->m_pages[iter->page];
+    page->m_fragments << QPainter::PixmapFragment::create( position, QRectF( iter->rect ), 1.0, 1.0, rotation );
+    page->m_lastUse = ++d->m_useCount;
+    ++d->m_pendingCount;
+
+    return true;
+}
+
+void LabelAtlas::flush( QPainter *painter )
+{
+    if ( d->m_pendingCount == 0 ) {
+        return;
+    }
+
+    for( LabelAtlasPage *page: d->m_pages ) {
+        if ( !page->m_fragments.isEmpty() ) {
+            painter->drawPixmapFragments( page->m_fragments.constData(), page->m_fragments.size(), page->m_pixmap );
+            // Reserving first keeps older Qt versions from freeing the buffer in resize()
+            page->m_fragments.reserve( page->m_fragments.capacity() );
+            page->m_fragments.resize( 0 );
+        }
+    }
+    d->m_pendingCount = 0;
+}
+
+void LabelAtlas::clear()
+{
+    qDeleteAll( d->m_pages );
+    d->m_pages.clear();
+    d->m_entries.clear();
+    d->m_pendingCount = 0;
+}
+
+void LabelAtlas::setBudget( qint64 budget )
+{
+    d->m_budget = budget;
+
+    // A smaller budget drops the least recently used pages along with their labels
+    bool removed = false;
+    while ( d->m_pages.size() > d->maximumPageCount() ) {
+        LabelAtlasPage *const page = d->evictablePage();
+        if ( !page ) {
+            break;
+        }
+        d->evict( page );
+        d->m_pages.remove( d->m_pages.indexOf( page ) );
+        delete page;
+        removed = true;
+    }
+
+    if ( removed ) {
+        for ( int i = 0; i < d->m_pages.size(); ++i ) {
+            for( const QString &key: d->m_pages[i]->m_keys ) {
+                d->m_entries[key].page = i;
+            }
+        }
+    }
+}
+
+qint64 LabelAtlas::budget() const
+{
+    return d->m_budget;
+}
+
+qint64 LabelAtlas::byteCount() const
+{
+    return qint64( d->m_pages.size() ) * LabelAtlasPrivate::s_pageSize * LabelAtlasPrivate::s_pageSize * 4;
+}
+
+int LabelAtlas::pageCount() const
+{
+    return d->m_pages.size();
+}
+
+int LabelAtlas::labelCount() const
+{
+    return d->m_entries.size();
+}
+
+int LabelAtlas::pendingCount() const
+{
+    return d->m_pendingCount;
+}
+
+qint64 LabelAtlas::evictionCount() const
+{
+    return d->m_evictionCount;
+}
+
+}
@@ -0,0 +1,122 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_LABELATLAS_H
+#define MARBLE_LABELATLAS_H
+
+#include "marble_export.h"
+
+#include <QtGlobal>
+
+class QColor;
+class QFont;
+class QImage;
+class QPainter;
+class QPointF;
+class QSize;
+class QString;
+
+namespace Marble
+{
+
+class LabelAtlasPrivate;
+
+/**
+  * @short Caches rendered labels in a few large pixmaps and draws them in batches.
+  *
+  * Every label is rendered once into a free spot of an atlas page. Drawing a
+  * label only queues a pixmap fragment; flush() then draws all queued
+  * fragments with a single QPainter::drawPixmapFragments() call per page
+  * instead of one text or pixmap draw call per label.
+  *
+  * The memory used by the pages is limited by an explicit budget. Once it is
+  * exhausted, the least recently used page is emptied and reused. Pages with
+  * fragments waiting for the next flush() are never evicted.
+  *
+  * Labels queued on different pages are not drawn in queuing order, so
+  * batching is meant for labels which do not overlap each other.
+  *
+  * The atlas holds QPixmaps and must only be used by the GUI thread.
+  */
+class MARBLE_EXPORT LabelAtlas
+{
+public:
+    /**
+     * @brief Creates an empty atlas which allocates at most @p budget bytes of
+     * pixmap pages. One page is always allowed, even if it exceeds the budget.
+     */
+    explicit LabelAtlas( qint64 budget = 16 * 1024 * 1024 );
+
+    ~LabelAtlas();
+
+    /**
+     * @brief Returns a key identifying the rendering of @p text in @p font
+     * and @p color. Renderers with several looks pass a distinct @p style.
+     */
+    static QString key( const QString &text, const QFont &font, const QColor &color, int style = 0 );
+
+    /**
+     * @brief Returns the size of a single page. Larger labels can't be cached.
+     */
+    static QSize pageSize();
+
+    bool contains( const QString &key ) const;
+
+    /**
+     * @brief Copies @p image into the atlas. Returns false if the image does
+     * not fit into a page or if all pages have pending fragments.
+     */
+    bool insert( const QString &key, const QImage &image );
+
+    /**
+     * @brief Queues the label @p key centered at @p center, rotated clockwise by
+     * @p rotation degrees around its center. Unrotated labels are aligned to
+     * full pixels. Returns false for unknown keys.
+     */
+    bool draw( const QString &key, const QPointF &center, qreal rotation = 0.0 );
+
+    /**
+     * @brief Draws all queued labels with @p painter
+     */
+    void flush( QPainter *painter );
+
+    /**
+     * @brief Removes all labels and pages. Pending fragments are dropped.
+     */
+    void clear();
+
+    void setBudget( qint64 budget );
+    qint64 budget() const;
+
+    /**
+     * @brief Returns the number of bytes used by the allocated pages
+     */
+    qint64 byteCount() const;
+
+    int pageCount() const;
+
+    int labelCount() const;
+
+    /**
+     * @brief Returns the number of labels queued since the last flush()
+     */
+    int pendingCount() const;
+
+    /**
+     * @brief Returns the number of pages which were emptied to make room
+     */
+    qint64 evictionCount() const;
+
+private:
+    Q_DISABLE_COPY( LabelAtlas )
+    LabelAtlasPrivate * const d;
+};
+
+}
+
+#endif
@@ -26,6 +26,16 @@ qreal LayerInterface::zValue() const
     return 0.0;
 }
 
+bool LayerInterface::supportsRetainedRendering() const
+{
+    return false;
+}
+
+bool LayerInterface::supportsConcurrentRendering() const
+{
+    return false;
+}
+
 RenderState LayerInterface::renderState() const
 {
     return RenderState();
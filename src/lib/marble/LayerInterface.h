@@ -72,6 +72,28 @@ public:
       */
     virtual qreal zValue() const;
 
+    /**
+      * @brief Returns whether the layer can be rendered into a retained offscreen buffer
+      * (default: false).
+      *
+      * Retained layers are only re-rendered when the viewport changes or when they request
+      * a repaint through a repaintNeeded() signal. Otherwise the buffer of the previous frame
+      * is composited again. A layer returning true must paint the same content as long as
+      * it does not request a repaint, and must not depend on pixels painted by other layers.
+      */
+    virtual bool supportsRetainedRendering() const;
+
+    /**
+      * @brief Returns whether the layer can be rendered on a worker thread (default: false).
+      *
+      * When concurrent rendering is enabled in the LayerManager, such layers are painted in
+      * parallel into their own image, which is composited according to the layer order.
+      * A layer returning true must only paint on QImage-compatible paint devices (no QPixmap),
+      * must not modify its own state in render() and must not depend on pixels painted by
+      * other layers.
+      */
+    virtual bool supportsConcurrentRendering() const;
+
     virtual RenderState renderState() const;
 
     /**
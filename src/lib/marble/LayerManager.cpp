@@ -18,12 +18,22 @@
 #include "MarbleDebug.h"
 #include "AbstractDataPlugin.h"
 #include "AbstractDataPluginItem.h"
+#include "FrameProfiler.h"
 #include "GeoPainter.h"
 #include "RenderPlugin.h"
 #include "LayerInterface.h"
 #include "RenderState.h"
+#include "ViewportParams.h"
 
+#include <QFuture>
+#include <QHash>
+#include <QImage>
+#include <QMetaObject>
+#include <QSet>
 #include <QTime>
+#include <QtConcurrentRun>
+
+#include <algorithm>
 
 namespace Marble
 {
@@ -31,40 +41,448 @@ namespace Marble
 class Q_DECL_HIDDEN LayerManager::Private
 {
  public:
+    /** A layer taking part in rendering at a certain render position */
+    struct LayerEntry
+    {
+        LayerInterface *layer;
+        RenderPlugin *renderPlugin;
+    };
+
+    /** Offscreen buffer of a layer supporting retained rendering */
+    struct LayerBuffer
+    {
+        LayerBuffer() : isDirty( true ) {}
+
+        QImage image;
+        bool isDirty;
+        QRegion dirtyRegion;
+    };
+
+    typedef QPair<const LayerInterface *, QString> LayerBufferKey;
+
+    /** A layer painted into its buffer image on a worker thread */
+    struct ConcurrentJob
+    {
+        LayerInterface *layer;
+        QString renderPosition;
+        QString name;
+        ViewportParams *viewport;
+        MapQuality mapQuality;
+        QImage image;
+        bool fullRepaint;
+        QRegion dirtyRegion;
+    };
+
     Private(LayerManager *parent);
     ~Private();
 
     void updateVisibility( bool visible, const QString &nameId );
 
+    void invalidateLayerBuffer( const QRegion &dirtyRegion );
+
+    void invalidateLayerBuffer();
+
+    void invalidateLayerBuffer( const LayerInterface *layer, const QRegion &dirtyRegion );
+
+    void invalidateLayerOrder();
+
+    void connectLayer( LayerInterface *layer );
+
+    void updateLayers();
+
+    bool updateViewportState( const GeoPainter *painter, const ViewportParams *viewport );
+
+    LayerBuffer &layerBuffer( const LayerBufferKey &key, const ViewportParams *viewport, bool viewportChanged );
+
+    void renderRetained( LayerInterface *layer, GeoPainter *painter, ViewportParams *viewport,
+                         const QString &renderPosition, bool viewportChanged );
+
+    void startConcurrentJobs( GeoPainter *painter, ViewportParams *viewport,
+                              const QStringList &renderPositions, bool viewportChanged );
+
+    void renderConcurrent( LayerInterface *layer, GeoPainter *painter, const QString &renderPosition );
+
+    void finishConcurrentJobs();
+
+    static void renderJob( ConcurrentJob *job );
+
+    static void paintLayerBuffer( QImage *image, bool fullRepaint, const QRegion &dirtyRegion,
+                                  LayerInterface *layer, ViewportParams *viewport,
+                                  const QString &renderPosition, MapQuality mapQuality );
+
+    static ViewportParams *copyViewport( const ViewportParams *viewport );
+
+    static bool isRenderable( const LayerEntry &entry );
+
+    static QString layerName( const LayerEntry &entry );
+
     LayerManager *const q;
 
     QList<RenderPlugin *> m_renderPlugins;
     QList<AbstractDataPlugin *> m_dataPlugins;
     QList<LayerInterface *> m_internalLayers;
 
+    /** Render positions in paint order, with and without background */
+    QStringList m_renderPositions;
+    QStringList m_foregroundRenderPositions;
+
+    /** Layers of each render position sorted by their zValue(), updated lazily */
+    QHash<QString, QVector<LayerEntry> > m_layers;
+    bool m_layersDirty;
+
+    QHash<LayerBufferKey, LayerBuffer> m_layerBuffers;
+
+    /** Jobs of the current frame; m_jobs must not be resized while the futures are running */
+    QVector<ConcurrentJob> m_jobs;
+    QVector<QFuture<void> > m_jobFutures;
+    QHash<LayerBufferKey, int> m_jobIndex;
+
+    /** Viewport properties of the last frame, any change invalidates all layer buffers */
+    Projection m_projection;
+    qreal m_centerLongitude;
+    qreal m_centerLatitude;
+    qreal m_heading;
+    int m_radius;
+    QSize m_size;
+    MapQuality m_mapQuality;
+    int m_devicePixelRatio;
+
     RenderState m_renderState;
 
     bool m_showBackground;
     bool m_showRuntimeTrace;
+    bool m_concurrentRendering;
 };
 
 LayerManager::Private::Private(LayerManager *parent) :
     q(parent),
     m_renderPlugins(),
+    m_layersDirty(true),
+    m_projection(Spherical),
+    m_centerLongitude(0.0),
+    m_centerLatitude(0.0),
+    m_heading(0.0),
+    m_radius(0),
+    m_mapQuality(NormalQuality),
+    m_devicePixelRatio(1),
     m_showBackground(true),
-    m_showRuntimeTrace(false)
+    m_showRuntimeTrace(false),
+    m_concurrentRendering(false)
 {
+    m_foregroundRenderPositions
+        << QStringLiteral("SURFACE")
+        << QStringLiteral("HOVERS_ABOVE_SURFACE")
+        << QStringLiteral("GRATICULE")
+        << QStringLiteral("PLACEMARKS")
+        << QStringLiteral("ATMOSPHERE")
+        << QStringLiteral("ORBIT")
+        << QStringLiteral("ALWAYS_ON_TOP")
+        << QStringLiteral("FLOAT_ITEM")
+        << QStringLiteral("USER_TOOLS");
+
+    m_renderPositions
+        << QStringLiteral("STARS")
+        << QStringLiteral("BEHIND_TARGET")
+        << m_foregroundRenderPositions;
 }
 
 LayerManager::Private::~Private()
 {
+    finishConcurrentJobs();
 }
 
 void LayerManager::Private::updateVisibility( bool visible, const QString &nameId )
 {
+    m_layersDirty = true;
     emit q->visibilityChanged( nameId, visible );
 }
 
+void LayerManager::Private::invalidateLayerBuffer( const QRegion &dirtyRegion )
+{
+    invalidateLayerBuffer( dynamic_cast<const LayerInterface *>( q->sender() ), dirtyRegion );
+}
+
+void LayerManager::Private::invalidateLayerBuffer()
+{
+    invalidateLayerBuffer( dynamic_cast<const LayerInterface *>( q->sender() ), QRegion() );
+}
+
+void LayerManager::Private::invalidateLayerBuffer( const LayerInterface *layer, const QRegion &dirtyRegion )
+{
+    // A layer changing its renderPosition() or zValue() asks for a repaint to get it shown
+    m_layersDirty = true;
+
+    if ( !layer ) {
+        return;
+    }
+
+    QHash<LayerBufferKey, LayerBuffer>::iterator iter = m_layerBuffers.begin();
+    for ( ; iter != m_layerBuffers.end(); ++iter ) {
+        if ( iter.key().first == layer ) {
+            if ( dirtyRegion.isEmpty() ) {
+                iter->isDirty = true;
+            } else {
+                iter->dirtyRegion += dirtyRegion;
+            }
+        }
+    }
+}
+
+void LayerManager::Private::invalidateLayerOrder()
+{
+    m_layersDirty = true;
+}
+
+void LayerManager::Private::connectLayer( LayerInterface *layer )
+{
+    // Layers request repaints through a repaintNeeded() signal, if any
+    QObject *object = dynamic_cast<QObject *>( layer );
+    if ( !object ) {
+        return;
+    }
+
+    const QMetaObject *metaObject = object->metaObject();
+    if ( metaObject->indexOfSignal( "repaintNeeded(QRegion)" ) >= 0 ) {
+        QObject::connect( object, SIGNAL(repaintNeeded(QRegion)),
+                          q, SLOT(invalidateLayerBuffer(QRegion)) );
+    } else if ( metaObject->indexOfSignal( "repaintNeeded()" ) >= 0 ) {
+        QObject::connect( object, SIGNAL(repaintNeeded()),
+                          q, SLOT(invalidateLayerBuffer()) );
+    }
+}
+
+void LayerManager::Private::updateLayers()
+{
+    m_layers.clear();
+
+    for( const auto &renderPosition: m_renderPositions ) {
+        QVector<LayerEntry> layers;
+
+        // collect all RenderPlugins of current renderPosition
+        for( auto *renderPlugin: m_renderPlugins ) {
+            if ( renderPlugin && renderPlugin->renderPosition().contains( renderPosition ) ) {
+                LayerEntry const entry = { renderPlugin, renderPlugin };
+                layers.push_back( entry );
+            }
+        }
+
+        // collect all internal LayerInterfaces of current renderPosition
+        for( auto *layer: m_internalLayers ) {
+            if ( layer && layer->renderPosition().contains( renderPosition ) ) {
+                LayerEntry const entry = { layer, nullptr };
+                layers.push_back( entry );
+            }
+        }
+
+        // sort them according to their zValue()s
+        std::stable_sort( layers.begin(), layers.end(), [] ( const LayerEntry &one, const LayerEntry &two ) -> bool {
+            Q_ASSERT( one.layer && two.layer );
+            return one.layer->zValue() < two.layer->zValue();
+        } );
+
+        m_layers.insert( renderPosition, layers );
+    }
+
+    m_layersDirty = false;
+}
+
+QString LayerManager::Private::layerName( const LayerEntry &entry )
+{
+    if ( entry.renderPlugin ) {
+        return entry.renderPlugin->nameId();
+    }
+
+    const QObject *object = dynamic_cast<const QObject *>( entry.layer );
+    if ( object ) {
+        return QString::fromLatin1( object->metaObject()->className() ).remove( QStringLiteral( "Marble::" ) );
+    }
+
+    return QStringLiteral( "Layer" );
+}
+
+bool LayerManager::Private::updateViewportState( const GeoPainter *painter, const ViewportParams *viewport )
+{
+    int const devicePixelRatio = painter->device()->devicePixelRatio();
+    bool const changed = m_projection != viewport->projection()
+            || m_centerLongitude != viewport->centerLongitude()
+            || m_centerLatitude != viewport->centerLatitude()
+            || m_heading != viewport->heading()
+            || m_radius != viewport->radius()
+            || m_size != viewport->size()
+            || m_mapQuality != painter->mapQuality()
+            || m_devicePixelRatio != devicePixelRatio;
+
+    m_projection = viewport->projection();
+    m_centerLongitude = viewport->centerLongitude();
+    m_centerLatitude = viewport->centerLatitude();
+    m_heading = viewport->heading();
+    m_radius = viewport->radius();
+    m_size = viewport->size();
+    m_mapQuality = painter->mapQuality();
+    m_devicePixelRatio = devicePixelRatio;
+
+    return changed;
+}
+
+LayerManager::Private::LayerBuffer &LayerManager::Private::layerBuffer( const LayerBufferKey &key, const ViewportParams *viewport,
+                                                                        bool viewportChanged )
+{
+    LayerBuffer &buffer = m_layerBuffers[key];
+
+    const QSize neededImageSize = viewport->size() * m_devicePixelRatio;
+    if ( buffer.image.size() != neededImageSize ) {
+        buffer.image = QImage( neededImageSize, QImage::Format_ARGB32_Premultiplied );
+        buffer.image.setDevicePixelRatio( m_devicePixelRatio );
+        buffer.isDirty = true;
+    }
+
+    if ( viewportChanged || !key.first->supportsRetainedRendering() ) {
+        buffer.isDirty = true;
+    }
+
+    return buffer;
+}
+
+void LayerManager::Private::paintLayerBuffer( QImage *image, bool fullRepaint, const QRegion &dirtyRegion,
+                                              LayerInterface *layer, ViewportParams *viewport,
+                                              const QString &renderPosition, MapQuality mapQuality )
+{
+    if ( fullRepaint ) {
+        image->fill( Qt::transparent );
+        GeoPainter bufferPainter( image, viewport, mapQuality );
+        layer->render( &bufferPainter, viewport, renderPosition, nullptr );
+    } else if ( !dirtyRegion.isEmpty() ) {
+        // Only repaint the part of the layer that asked for it
+        GeoPainter bufferPainter( image, viewport, mapQuality );
+        bufferPainter.setClipRegion( dirtyRegion );
+        bufferPainter.setCompositionMode( QPainter::CompositionMode_Source );
+        bufferPainter.fillRect( dirtyRegion.boundingRect(), Qt::transparent );
+        bufferPainter.setCompositionMode( QPainter::CompositionMode_SourceOver );
+        layer->render( &bufferPainter, viewport, renderPosition, nullptr );
+    }
+}
+
+void LayerManager::Private::renderRetained( LayerInterface *layer, GeoPainter *painter, ViewportParams *viewport,
+                                            const QString &renderPosition, bool viewportChanged )
+{
+    LayerBuffer &buffer = layerBuffer( qMakePair( static_cast<const LayerInterface *>( layer ), renderPosition ),
+                                       viewport, viewportChanged );
+
+    paintLayerBuffer( &buffer.image, buffer.isDirty, buffer.dirtyRegion,
+                      layer, viewport, renderPosition, painter->mapQuality() );
+
+    buffer.isDirty = false;
+    buffer.dirtyRegion = QRegion();
+
+    painter->drawImage( QPoint( 0, 0 ), buffer.image );
+}
+
+ViewportParams *LayerManager::Private::copyViewport( const ViewportParams *viewport )
+{
+    ViewportParams *copy = new ViewportParams( viewport->projection(),
+                                               viewport->centerLongitude(), viewport->centerLatitude(),
+                                               viewport->radius(), viewport->size() );
+    copy->setHeading( viewport->heading() );
+    copy->setFocusPoint( viewport->focusPoint() );
+    return copy;
+}
+
+bool LayerManager::Private::isRenderable( const LayerEntry &entry )
+{
+    return !entry.renderPlugin || ( entry.renderPlugin->enabled() && entry.renderPlugin->visible() );
+}
+
+void LayerManager::Private::startConcurrentJobs( GeoPainter *painter, ViewportParams *viewport,
+                                                 const QStringList &renderPositions, bool viewportChanged )
+{
+    Q_ASSERT( m_jobs.isEmpty() );
+
+    bool const profile = FrameProfiler::isEnabled();
+
+    for( const auto &renderPosition: renderPositions ) {
+        for( const auto &entry: m_layers.value( renderPosition ) ) {
+            if ( !entry.layer->supportsConcurrentRendering() || !isRenderable( entry ) ) {
+                continue;
+            }
+
+            // Plugins must be initialized in the GUI thread
+            RenderPlugin *renderPlugin = entry.renderPlugin;
+            if ( renderPlugin && !renderPlugin->isInitialized() ) {
+                renderPlugin->initialize();
+                emit q->renderPluginInitialized( renderPlugin );
+            }
+
+            const LayerBufferKey key = qMakePair( static_cast<const LayerInterface *>( entry.layer ), renderPosition );
+            LayerBuffer &buffer = layerBuffer( key, viewport, viewportChanged );
+            if ( !buffer.isDirty && buffer.dirtyRegion.isEmpty() ) {
+                continue;
+            }
+
+            // Each job gets its own viewport as ViewportParams computes some properties lazily
+            ConcurrentJob job;
+            job.layer = entry.layer;
+            job.renderPosition = renderPosition;
+            job.name = profile ? layerName( entry ) : QString();
+            job.viewport = copyViewport( viewport );
+            job.mapQuality = painter->mapQuality();
+            job.image = buffer.image;
+            job.fullRepaint = buffer.isDirty;
+            job.dirtyRegion = buffer.dirtyRegion;
+
+            // Leave the job as the only owner of the image to avoid a deep copy when painting
+            buffer.image = QImage();
+
+            m_jobIndex.insert( key, m_jobs.size() );
+            m_jobs.append( job );
+        }
+    }
+
+    m_jobFutures.reserve( m_jobs.size() );
+    for ( int i = 0; i < m_jobs.size(); ++i ) {
+        m_jobFutures << QtConcurrent::run( &Private::renderJob, &m_jobs[i] );
+    }
+}
+
+void LayerManager::Private::renderJob( ConcurrentJob *job )
+{
+    const qint64 start = FrameProfiler::timestamp();
+
+    paintLayerBuffer( &job->image, job->fullRepaint, job->dirtyRegion,
+                      job->layer, job->viewport, job->renderPosition, job->mapQuality );
+
+    if ( !job->name.isEmpty() ) {
+        FrameProfiler::addEvent( QStringLiteral( "layer" ), job->name, start, FrameProfiler::timestamp() );
+    }
+}
+
+void LayerManager::Private::renderConcurrent( LayerInterface *layer, GeoPainter *painter, const QString &renderPosition )
+{
+    const LayerBufferKey key = qMakePair( static_cast<const LayerInterface *>( layer ), renderPosition );
+    LayerBuffer &buffer = m_layerBuffers[key];
+
+    const int jobIndex = m_jobIndex.value( key, -1 );
+    if ( jobIndex >= 0 ) {
+        m_jobFutures[jobIndex].waitForFinished();
+        buffer.image = m_jobs.at( jobIndex ).image;
+        buffer.isDirty = false;
+        buffer.dirtyRegion = QRegion();
+    }
+
+    painter->drawImage( QPoint( 0, 0 ), buffer.image );
+}
+
+void LayerManager::Private::finishConcurrentJobs()
+{
+    for ( int i = 0; i < m_jobFutures.size(); ++i ) {
+        m_jobFutures[i].waitForFinished();
+        delete m_jobs[i].viewport;
+    }
+
+    m_jobs.clear();
+    m_jobFutures.clear();
+    m_jobIndex.clear();
+}
+
 
 LayerManager::LayerManager(QObject *parent) :
     QObject(parent),
@@ -93,10 +511,14 @@ void LayerManager::addRenderPlugin(RenderPlugin *renderPlugin)
 
     QObject::connect(renderPlugin, SIGNAL(settingsChanged(QString)),
                      this, SIGNAL(pluginSettingsChanged()));
+    QObject::connect(renderPlugin, SIGNAL(settingsChanged(QString)),
+                     this, SLOT(invalidateLayerOrder()));
     QObject::connect(renderPlugin, SIGNAL(repaintNeeded(QRegion)),
                      this, SIGNAL(repaintNeeded(QRegion)));
     QObject::connect(renderPlugin, SIGNAL(visibilityChanged(bool,QString)),
                      this, SLOT(updateVisibility(bool,QString)));
+    d->connectLayer(renderPlugin);
+    d->m_layersDirty = true;
 
     // get data plugins
     AbstractDataPlugin *const dataPlugin = qobject_cast<AbstractDataPlugin *>(renderPlugin);
@@ -125,63 +547,80 @@ void LayerManager::renderLayers( GeoPainter *painter, ViewportParams *viewport )
     d->m_renderState = RenderState(QStringLiteral("Marble"));
     const QTime totalTime = QTime::currentTime();
 
-    QStringList renderPositions;
-
-    if ( d->m_showBackground ) {
-        renderPositions
-        << QStringLiteral("STARS")
-        << QStringLiteral("BEHIND_TARGET");
+    if ( d->m_layersDirty ) {
+        d->updateLayers();
     }
 
-    renderPositions
-        << QStringLiteral("SURFACE")
-        << QStringLiteral("HOVERS_ABOVE_SURFACE")
-        << QStringLiteral("GRATICULE")
-        << QStringLiteral("PLACEMARKS")
-        << QStringLiteral("ATMOSPHERE")
-        << QStringLiteral("ORBIT")
-        << QStringLiteral("ALWAYS_ON_TOP")
-        << QStringLiteral("FLOAT_ITEM")
-        << QStringLiteral("USER_TOOLS");
+    bool const viewportChanged = d->updateViewportState( painter, viewport );
+    QSet<Private::LayerBufferKey> usedBuffers;
+
+    const QStringList &renderPositions = d->m_showBackground ? d->m_renderPositions : d->m_foregroundRenderPositions;
+
+    bool const profile = FrameProfiler::isEnabled();
+
+    // Layers rendered concurrently are painted in the background while
+    // the others are painted below, and composited when their turn comes
+    if ( d->m_concurrentRendering ) {
+        d->startConcurrentJobs( painter, viewport, renderPositions, viewportChanged );
+    }
 
     QStringList traceList;
     for( const auto& renderPosition: renderPositions ) {
-        QList<LayerInterface*> layers;
+        const qint64 positionStart = profile ? FrameProfiler::timestamp() : 0;
 
-        // collect all RenderPlugins of current renderPosition
-        for( auto *renderPlugin: d->m_renderPlugins ) {
-            if ( renderPlugin && renderPlugin->renderPosition().contains( renderPosition ) ) {
-                if ( renderPlugin->enabled() && renderPlugin->visible() ) {
-                    if ( !renderPlugin->isInitialized() ) {
-                        renderPlugin->initialize();
-                        emit renderPluginInitialized( renderPlugin );
-                    }
-                    layers.push_back( renderPlugin );
-                }
+        // render the layers of the current renderPosition
+        QTime timer;
+        for( const auto &entry: d->m_layers.value( renderPosition ) ) {
+            if ( !Private::isRenderable( entry ) ) {
+                continue;
             }
-        }
 
-        // collect all internal LayerInterfaces of current renderPosition
-        for( auto *layer: d->m_internalLayers ) {
-            if ( layer && layer->renderPosition().contains( renderPosition ) ) {
-                layers.push_back( layer );
+            RenderPlugin *renderPlugin = entry.renderPlugin;
+            if ( renderPlugin ) {
+                if ( !renderPlugin->isInitialized() ) {
+                    renderPlugin->initialize();
+                    emit renderPluginInitialized( renderPlugin );
+                }
             }
-        }
-
-        // sort them according to their zValue()s
-        std::sort( layers.begin(), layers.end(), [] ( const LayerInterface * const one, const LayerInterface * const two ) -> bool {
-            Q_ASSERT( one && two );
-            return one->zValue() < two->zValue();
-        } );
 
-        // render the layers of the current renderPosition
-        QTime timer;
-        for( auto *layer: layers ) {
+            LayerInterface *layer = entry.layer;
             timer.start();
-            layer->render( painter, viewport, renderPosition, nullptr );
+            const qint64 layerStart = profile ? FrameProfiler::timestamp() : 0;
+            bool const concurrent = d->m_concurrentRendering && layer->supportsConcurrentRendering();
+            if ( concurrent ) {
+                usedBuffers << qMakePair( static_cast<const LayerInterface *>( layer ), renderPosition );
+                d->renderConcurrent( layer, painter, renderPosition );
+            } else if ( layer->supportsRetainedRendering() ) {
+                usedBuffers << qMakePair( static_cast<const LayerInterface *>( layer ), renderPosition );
+                d->renderRetained( layer, painter, viewport, renderPosition, viewportChanged );
+            } else {
+                layer->render( painter, viewport, renderPosition, nullptr );
+            }
+            if ( profile ) {
+                // The painting of concurrent layers is recorded by their worker thread
+                FrameProfiler::addEvent( concurrent ? QStringLiteral( "composite" ) : QStringLiteral( "layer" ),
+                                         Private::layerName( entry ), layerStart, FrameProfiler::timestamp() );
+            }
             d->m_renderState.addChild( layer->renderState() );
             traceList.append( QString("%2 ms %3").arg( timer.elapsed(),3 ).arg( layer->runtimeTrace() ) );
         }
+
+        if ( profile ) {
+            FrameProfiler::addEvent( QStringLiteral( "renderPosition" ), renderPosition,
+                                     positionStart, FrameProfiler::timestamp() );
+        }
+    }
+
+    d->finishConcurrentJobs();
+
+    // Buffers of layers that were hidden or removed are outdated once they are shown again
+    QHash<Private::LayerBufferKey, Private::LayerBuffer>::iterator iter = d->m_layerBuffers.begin();
+    while ( iter != d->m_layerBuffers.end() ) {
+        if ( usedBuffers.contains( iter.key() ) ) {
+            ++iter;
+        } else {
+            iter = d->m_layerBuffers.erase( iter );
+        }
     }
 
     if ( d->m_showRuntimeTrace ) {
@@ -218,16 +657,34 @@ void LayerManager::setShowRuntimeTrace( bool show )
     d->m_showRuntimeTrace = show;
 }
 
+bool LayerManager::concurrentRendering() const
+{
+    return d->m_concurrentRendering;
+}
+
+void LayerManager::setConcurrentRendering( bool enabled )
+{
+    d->m_concurrentRendering = enabled;
+}
+
 void LayerManager::addLayer(LayerInterface *layer)
 {
     if (!d->m_internalLayers.contains(layer)) {
         d->m_internalLayers.push_back(layer);
+        d->connectLayer(layer);
+        d->m_layersDirty = true;
     }
 }
 
 void LayerManager::removeLayer(LayerInterface *layer)
 {
-    d->m_internalLayers.removeAll(layer);
+    if (d->m_internalLayers.removeAll(layer) > 0) {
+        QObject *object = dynamic_cast<QObject *>(layer);
+        if (object) {
+            object->disconnect(this);
+        }
+        d->m_layersDirty = true;
+    }
 }
 
 QList<LayerInterface *> LayerManager::internalLayers() const
@@ -235,6 +692,14 @@ QList<LayerInterface *> LayerManager::internalLayers() const
     return d->m_internalLayers;
 }
 
+void LayerManager::invalidateLayerBuffers()
+{
+    QHash<Private::LayerBufferKey, Private::LayerBuffer>::iterator iter = d->m_layerBuffers.begin();
+    for ( ; iter != d->m_layerBuffers.end(); ++iter ) {
+        iter->isDirty = true;
+    }
+}
+
 RenderState LayerManager::renderState() const
 {
     return d->m_renderState;
@@ -50,6 +50,12 @@ class LayerManager : public QObject
 
     bool showRuntimeTrace() const;
 
+    /**
+     * @brief Returns whether layers supporting it are rendered concurrently (default: false)
+     * @see LayerInterface::supportsConcurrentRendering()
+     */
+    bool concurrentRendering() const;
+
     void addRenderPlugin(RenderPlugin *renderPlugin);
 
     /**
@@ -75,6 +81,12 @@ class LayerManager : public QObject
 
     QList<LayerInterface *> internalLayers() const;
 
+    /**
+     * @brief Repaint all retained layers in the next frame, e.g. after a change
+     * of global settings like the default notation that layers do not notice.
+     */
+    void invalidateLayerBuffers();
+
     RenderState renderState() const;
 
  Q_SIGNALS:
@@ -102,9 +114,17 @@ class LayerManager : public QObject
 
     void setShowRuntimeTrace( bool show );
 
+    void setConcurrentRendering( bool enabled );
+
  private:
     Q_PRIVATE_SLOT( d, void updateVisibility( bool, const QString & ) )
 
+    Q_PRIVATE_SLOT( d, void invalidateLayerBuffer( const QRegion & ) )
+
+    Q_PRIVATE_SLOT( d, void invalidateLayerBuffer() )
+
+    Q_PRIVATE_SLOT( d, void invalidateLayerOrder() )
+
  private:
     Q_DISABLE_COPY( LayerManager )
 
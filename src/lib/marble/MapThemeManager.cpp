@@ -14,10 +14,15 @@
 #include "MapThemeManager.h"
 
 // Qt
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QFileSystemWatcher>
+#include <QHash>
+#include <QImage>
+#include <QSaveFile>
 #include <QScopedPointer>
 #include <QString>
 #include <QStringList>
@@ -48,6 +53,10 @@ namespace
 {
     static const QString mapDirName = "maps";
     static const int columnRelativePath = 1;
+
+    // Increase when changing the layout of the theme index file
+    static const quint32 themeIndexMagic = 0x4d544958; // "MTIX"
+    static const quint32 themeIndexVersion = 2;
 }
 
 namespace Marble
@@ -90,10 +99,52 @@ public:
 
     static GeoSceneDocument* loadMapThemeFile( const QString& mapThemeId );
 
+    /**
+     * @brief The parts of a map theme needed to list it, as stored in the theme index.
+     */
+    struct ThemeInfo
+    {
+        ThemeInfo() : size( -1 ), modified( 0 ), visible( false ), iconModified( 0 ) {}
+
+        QString path;
+        qint64 size;
+        qint64 modified;
+        bool visible;
+        QString name;
+        QString description;
+        QString target;
+        // The scaled preview; a null image for themes without one
+        QImage icon;
+        // Relative to the data directories, so an icon installed locally later is noticed
+        QString iconPath;
+        qint64 iconModified;
+    };
+
+    /**
+     * @brief Returns the index entry of the theme, parsing its .dgml file
+     *        only if it was not indexed yet or it or its preview changed since.
+     */
+    const ThemeInfo *themeInfo( const QString &mapThemeId );
+
+    /**
+     * @brief Fills @p info from the .dgml file at @p dgmlPath.
+     */
+    static bool readThemeInfo( const QString &mapThemeId, const QString &dgmlPath, ThemeInfo &info );
+
+    /**
+     * @brief Returns the modification time of the preview at @p iconPath in ms
+     *        since the epoch, or 0 if there is none.
+     */
+    static qint64 iconModified( const QString &iconPath );
+
+    static QString themeIndexPath();
+    void loadThemeIndex();
+    void saveThemeIndex();
+
     /**
      * @brief Helper method for updateMapThemeModel().
      */
-    static QList<QStandardItem *> createMapThemeRow( const QString& mapThemeID );
+    QList<QStandardItem *> createMapThemeRow( const QString& mapThemeID );
 
     /**
      * @brief Deletes any directory with its contents.
@@ -108,6 +159,12 @@ public:
     QFileSystemWatcher m_fileSystemWatcher;
     bool m_isInitialized;
 
+    // Persistent index of the installed themes, so listing them does not need
+    // to parse every .dgml file and load its preview on startup
+    QHash<QString, ThemeInfo> m_themeIndex;
+    bool m_themeIndexLoaded;
+    bool m_themeIndexChanged;
+
 private:
     /**
      * @brief Returns all directory paths and .dgml file paths below local and
@@ -121,7 +178,9 @@ MapThemeManager::Private::Private( MapThemeManager *parent )
       m_mapThemeModel( 0, 3 ),
       m_celestialList(),
       m_fileSystemWatcher(),
-      m_isInitialized( false )
+      m_isInitialized( false ),
+      m_themeIndexLoaded( false ),
+      m_themeIndexChanged( false )
 {
 }
 
@@ -348,43 +407,179 @@ QStandardItemModel *MapThemeManager::celestialBodiesModel()
     return &d->m_celestialList;
 }
 
-QList<QStandardItem *> MapThemeManager::Private::createMapThemeRow( QString const& mapThemeID )
+QString MapThemeManager::Private::themeIndexPath()
 {
-    QList<QStandardItem *> itemList;
+    // Not below the watched map directories, writing it would trigger a reload
+    return MarbleDirs::localPath() + QLatin1String("/mapthemes.index");
+}
 
-    QScopedPointer<GeoSceneDocument> mapTheme( loadMapThemeFile( mapThemeID ) );
-    if ( !mapTheme || !mapTheme->head()->visible() ) {
-        return itemList;
+void MapThemeManager::Private::loadThemeIndex()
+{
+    m_themeIndexLoaded = true;
+    m_themeIndex.clear();
+
+    QFile file( themeIndexPath() );
+    if ( !file.open( QIODevice::ReadOnly ) ) {
+        return;
     }
 
-    QPixmap themeIconPixmap;
+    QDataStream stream( &file );
+    stream.setVersion( QDataStream::Qt_5_3 );
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if ( magic != themeIndexMagic || version != themeIndexVersion ) {
+        mDebug() << "Ignoring theme index of another version:" << file.fileName();
+        return;
+    }
 
-    QString relativePath = mapDirName + QLatin1Char('/')
-        + mapTheme->head()->target() + QLatin1Char('/') + mapTheme->head()->theme() + QLatin1Char('/')
-        + mapTheme->head()->icon()->pixmap();
-    themeIconPixmap.load( MarbleDirs::path( relativePath ) );
+    qint32 count = 0;
+    stream >> count;
+    for ( qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i ) {
+        QString mapThemeId;
+        ThemeInfo info;
+        stream >> mapThemeId >> info.path >> info.size >> info.modified >> info.visible
+               >> info.name >> info.description >> info.target >> info.icon
+               >> info.iconPath >> info.iconModified;
+        m_themeIndex.insert( mapThemeId, info );
+    }
 
-    if ( themeIconPixmap.isNull() ) {
-        relativePath = "svg/application-x-marble-gray.png";
-        themeIconPixmap.load( MarbleDirs::path( relativePath ) );
+    if ( stream.status() != QDataStream::Ok ) {
+        mDebug() << "Ignoring corrupt theme index:" << file.fileName();
+        m_themeIndex.clear();
+    }
+}
+
+void MapThemeManager::Private::saveThemeIndex()
+{
+    if ( !m_themeIndexChanged ) {
+        return;
+    }
+
+    QSaveFile file( themeIndexPath() );
+    if ( !file.open( QIODevice::WriteOnly ) ) {
+        mDebug() << "Cannot write theme index:" << file.fileName();
+        return;
+    }
+
+    QDataStream stream( &file );
+    stream.setVersion( QDataStream::Qt_5_3 );
+    stream << themeIndexMagic << themeIndexVersion << qint32( m_themeIndex.size() );
+    for ( auto iter = m_themeIndex.constBegin(), end = m_themeIndex.constEnd(); iter != end; ++iter ) {
+        const ThemeInfo &info = iter.value();
+        stream << iter.key() << info.path << info.size << info.modified << info.visible
+               << info.name << info.description << info.target << info.icon
+               << info.iconPath << info.iconModified;
+    }
+
+    if ( file.commit() ) {
+        m_themeIndexChanged = false;
+    }
+}
+
+bool MapThemeManager::Private::readThemeInfo( const QString &mapThemeId, const QString &dgmlPath, ThemeInfo &info )
+{
+    QScopedPointer<GeoSceneDocument> mapTheme( loadMapThemeFile( mapThemeId ) );
+    if ( !mapTheme ) {
+        return false;
     }
-    else {
+
+    const QFileInfo fileInfo( dgmlPath );
+    info.path = dgmlPath;
+    info.size = fileInfo.size();
+    info.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+    info.visible = mapTheme->head()->visible();
+    info.name = mapTheme->head()->name();
+    info.description = mapTheme->head()->description();
+    info.target = mapTheme->head()->target();
+    info.icon = QImage();
+    info.iconPath.clear();
+    info.iconModified = 0;
+
+    if ( info.visible ) {
+        info.iconPath = mapDirName + QLatin1Char('/')
+            + mapTheme->head()->target() + QLatin1Char('/') + mapTheme->head()->theme() + QLatin1Char('/')
+            + mapTheme->head()->icon()->pixmap();
+        info.iconModified = iconModified( info.iconPath );
+        info.icon.load( MarbleDirs::path( info.iconPath ) );
+
         // Make sure we don't keep excessively large previews in memory
         // TODO: Scale the icon down to the default icon size in MarbleSelectView.
         //       For now maxIconSize already equals what's expected by the listview.
         QSize maxIconSize( 136, 136 );
-        if ( themeIconPixmap.size() != maxIconSize ) {
+        if ( !info.icon.isNull() && info.icon.size() != maxIconSize ) {
             mDebug() << "Smooth scaling theme icon";
-            themeIconPixmap = themeIconPixmap.scaled( maxIconSize,
-                                                      Qt::KeepAspectRatio,
-                                                      Qt::SmoothTransformation );
+            info.icon = info.icon.scaled( maxIconSize,
+                                          Qt::KeepAspectRatio,
+                                          Qt::SmoothTransformation );
         }
     }
 
+    return true;
+}
+
+qint64 MapThemeManager::Private::iconModified( const QString &iconPath )
+{
+    if ( iconPath.isEmpty() ) {
+        return 0;
+    }
+
+    const QFileInfo fileInfo( MarbleDirs::path( iconPath ) );
+    return fileInfo.exists() ? fileInfo.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+const MapThemeManager::Private::ThemeInfo *MapThemeManager::Private::themeInfo( const QString &mapThemeId )
+{
+    if ( !m_themeIndexLoaded ) {
+        loadThemeIndex();
+    }
+
+    const QString dgmlPath = MarbleDirs::path( mapDirName + QLatin1Char('/') + mapThemeId );
+    const QFileInfo fileInfo( dgmlPath );
+    if ( !fileInfo.exists() ) {
+        if ( m_themeIndex.remove( mapThemeId ) > 0 ) {
+            m_themeIndexChanged = true;
+        }
+        return nullptr;
+    }
+
+    auto iter = m_themeIndex.find( mapThemeId );
+    if ( iter != m_themeIndex.end()
+         && iter->path == dgmlPath
+         && iter->size == fileInfo.size()
+         && iter->modified == fileInfo.lastModified().toMSecsSinceEpoch()
+         && iter->iconModified == iconModified( iter->iconPath ) ) {
+        return &iter.value();
+    }
+
+    ThemeInfo info;
+    m_themeIndexChanged = true;
+    if ( !readThemeInfo( mapThemeId, dgmlPath, info ) ) {
+        m_themeIndex.remove( mapThemeId );
+        return nullptr;
+    }
+
+    return &m_themeIndex.insert( mapThemeId, info ).value();
+}
+
+QList<QStandardItem *> MapThemeManager::Private::createMapThemeRow( QString const& mapThemeID )
+{
+    QList<QStandardItem *> itemList;
+
+    const ThemeInfo *info = themeInfo( mapThemeID );
+    if ( !info || !info->visible ) {
+        return itemList;
+    }
+
+    QPixmap themeIconPixmap = QPixmap::fromImage( info->icon );
+    if ( themeIconPixmap.isNull() ) {
+        themeIconPixmap.load( MarbleDirs::path( "svg/application-x-marble-gray.png" ) );
+    }
+
     QIcon mapThemeIcon =  QIcon( themeIconPixmap );
 
-    QString name = mapTheme->head()->name();
-    const QString translatedDescription = QCoreApplication::translate("DGML", mapTheme->head()->description().toUtf8().constData());
+    QString name = info->name;
+    const QString translatedDescription = QCoreApplication::translate("DGML", info->description.toUtf8().constData());
     const QString toolTip = QLatin1String("<span style=\" max-width: 150 px;\"> ") + translatedDescription + QLatin1String(" </span>");
 
     QStandardItem *item = new QStandardItem( name );
@@ -418,6 +613,17 @@ void MapThemeManager::Private::updateMapThemeModel()
         }
     }
 
+    // Forget about themes which got uninstalled
+    for ( auto iter = m_themeIndex.begin(); iter != m_themeIndex.end(); ) {
+        if ( stringlist.contains( iter.key() ) ) {
+            ++iter;
+        } else {
+            iter = m_themeIndex.erase( iter );
+            m_themeIndexChanged = true;
+        }
+    }
+    saveThemeIndex();
+
     for ( const QString &mapThemeId: stringlist ) {
         const QString celestialBodyId = mapThemeId.section(QLatin1Char('/'), 0, 0);
         QString celestialBodyName = PlanetFactory::localizedName( celestialBodyId );
@@ -489,7 +695,10 @@ void MapThemeManager::Private::fileChanged( const QString& path )
         if ( !newMapThemeRow.empty() ) {
             m_mapThemeModel.insertRow( insertAtRow, newMapThemeRow );
         }
+    } else if ( m_themeIndex.remove( mapThemeId ) > 0 ) {
+        m_themeIndexChanged = true;
     }
+    saveThemeIndex();
 
     emit q->themesChanged();
 }
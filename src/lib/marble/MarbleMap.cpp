@@ -37,6 +37,7 @@
 #include "AbstractFloatItem.h"
 #include "DgmlAuxillaryDictionary.h"
 #include "FileManager.h"
+#include "FrameProfiler.h"
 #include "GeoDataTreeModel.h"
 #include "GeoPainter.h"
 #include "GeoSceneDocument.h"
@@ -55,6 +56,7 @@
 #include "GeoDataFeature.h"
 #include "GeoDataStyle.h"
 #include "GeoDataStyleMap.h"
+#include "LabelAtlas.h"
 #include "LayerManager.h"
 #include "MapThemeManager.h"
 #include "MarbleDebug.h"
@@ -127,6 +129,8 @@ public:
 
     void updateTileLevel();
 
+    void updateTileCacheLimits();
+
     void addPlugins();
 
     MarbleMap *const q;
@@ -143,6 +147,7 @@ public:
     bool             m_showDebugBatchRender;
     GeoDataRelation::RelationTypes m_visibleRelationTypes;
     StyleBuilder     m_styleBuilder;
+    LabelAtlas       m_labelAtlas;
 
     QList<RenderPlugin *> m_renderPlugins;
 
@@ -159,6 +164,7 @@ public:
 
     bool m_isLockedToSubSolarPoint;
     bool m_isSubSolarPointIconVisible;
+    quint64 m_volatileTileCacheLimit;
     RenderState m_renderState;
 };
 
@@ -171,15 +177,17 @@ MarbleMapPrivate::MarbleMapPrivate( MarbleMap *parent, MarbleModel *model ) :
     m_showDebugBatchRender( false ),
     m_visibleRelationTypes(GeoDataRelation::RouteFerry),
     m_styleBuilder(),
+    m_labelAtlas( 8 * 1024 * 1024 ),
     m_layerManager( parent ),
     m_customPaintLayer( parent ),
     m_geometryLayer(model->treeModel(), &m_styleBuilder),
     m_floatItemsLayer(parent),
     m_textureLayer( model->downloadManager(), model->pluginManager(), model->sunLocator(), model->groundOverlayModel() ),
     m_placemarkLayer( model->placemarkModel(), model->placemarkSelectionModel(), model->clock(), &m_styleBuilder ),
-    m_vectorTileLayer( model->downloadManager(), model->pluginManager(), model->treeModel() ),
+    m_vectorTileLayer( model->downloadManager(), model->pluginManager(), &m_geometryLayer, &m_placemarkLayer ),
     m_isLockedToSubSolarPoint( false ),
-    m_isSubSolarPointIconVisible( false )
+    m_isSubSolarPointIconVisible( false ),
+    m_volatileTileCacheLimit( 100 * 1024 )
 {
     m_layerManager.addLayer(&m_floatItemsLayer);
     m_layerManager.addLayer( &m_fogLayer );
@@ -244,6 +252,8 @@ MarbleMapPrivate::MarbleMapPrivate( MarbleMap *parent, MarbleModel *model ) :
     QObject::connect( parent, SIGNAL(visibleLatLonAltBoxChanged(GeoDataLatLonAltBox)),
                       parent, SIGNAL(repaintNeeded()) );
 
+    updateTileCacheLimits();
+
     addPlugins();
     QObject::connect(model->pluginManager(), SIGNAL(renderPluginsChanged()),
                      parent, SLOT(addPlugins()));
@@ -720,7 +730,7 @@ GeoDataRelation::RelationTypes MarbleMap::visibleRelationTypes() const
 
 quint64 MarbleMap::volatileTileCacheLimit() const
 {
-    return d->m_textureLayer.volatileCacheLimit();
+    return d->m_volatileTileCacheLimit;
 }
 
 
@@ -857,9 +867,12 @@ void MarbleMap::paint( GeoPainter &painter, const QRect &dirtyRect )
 
     QTime t;
     t.start();
+    FrameProfiler::beginFrame();
 
     RenderStatus const oldRenderStatus = d->m_renderState.status();
+    painter.setLabelAtlas( &d->m_labelAtlas );
     d->m_layerManager.renderLayers( &painter, &d->m_viewport );
+    painter.setLabelAtlas( nullptr );
     d->m_renderState = d->m_layerManager.renderState();
     bool const parsing = d->m_model->fileManager()->pendingFiles() > 0;
     d->m_renderState.addChild(RenderState(QStringLiteral("Files"), parsing ? WaitingForData : Complete));
@@ -874,6 +887,8 @@ void MarbleMap::paint( GeoPainter &painter, const QRect &dirtyRect )
         fpsPainter.paint( &painter );
     }
 
+    FrameProfiler::endFrame();
+
     const qreal fps = 1000.0 / (qreal)( t.elapsed() );
     emit framesPerSecond( fps );
 }
@@ -893,6 +908,19 @@ void MarbleMap::setMapThemeId( const QString& mapThemeId )
     d->m_model->setMapThemeId( mapThemeId );
 }
 
+void MarbleMapPrivate::updateTileCacheLimits()
+{
+    // Texture tiles and parsed vector tiles share the volatile cache budget
+    const bool hasTextures = m_textureLayer.textureLayerCount() > 0;
+    const bool hasVectorTiles = m_vectorTileLayer.layerCount() > 0;
+    const quint64 vectorTileLimit = !hasVectorTiles ? 0
+                                  : hasTextures ? m_volatileTileCacheLimit / 2
+                                  : m_volatileTileCacheLimit;
+
+    m_textureLayer.setVolatileCacheLimit( m_volatileTileCacheLimit - vectorTileLimit );
+    m_vectorTileLayer.setVolatileCacheLimit( vectorTileLimit );
+}
+
 void MarbleMapPrivate::updateMapTheme()
 {
     m_layerManager.removeLayer( &m_textureLayer );
@@ -1062,6 +1090,8 @@ void MarbleMapPrivate::updateMapTheme()
         m_vectorTileLayer.setMapTheme( QVector<const GeoSceneVectorTileDataset *>(), nullptr );
     }
 
+    updateTileCacheLimits();
+
     // earth
     m_placemarkLayer.setShowPlaces( q->showPlaces() );
 
@@ -1262,6 +1292,19 @@ bool MarbleMap::showRuntimeTrace() const
     return d->m_layerManager.showRuntimeTrace();
 }
 
+void MarbleMap::setConcurrentRendering( bool enabled )
+{
+    if (enabled != d->m_layerManager.concurrentRendering()) {
+        d->m_layerManager.setConcurrentRendering(enabled);
+        emit repaintNeeded();
+    }
+}
+
+bool MarbleMap::concurrentRendering() const
+{
+    return d->m_layerManager.concurrentRendering();
+}
+
 void MarbleMap::setShowDebugPolygons( bool visible)
 {
     if (visible != d->m_showDebugPolygons) {
@@ -1364,7 +1407,8 @@ void MarbleMap::clearVolatileTileCache()
 void MarbleMap::setVolatileTileCacheLimit( quint64 kilobytes )
 {
     mDebug() << "kiloBytes" << kilobytes;
-    d->m_textureLayer.setVolatileCacheLimit( kilobytes );
+    d->m_volatileTileCacheLimit = kilobytes;
+    d->updateTileCacheLimits();
 }
 
 AngleUnit MarbleMap::defaultAngleUnit() const
@@ -1380,15 +1424,22 @@ AngleUnit MarbleMap::defaultAngleUnit() const
 
 void MarbleMap::setDefaultAngleUnit( AngleUnit angleUnit )
 {
+    GeoDataCoordinates::Notation notation = GeoDataCoordinates::DMS;
     if ( angleUnit == DecimalDegree ) {
-        GeoDataCoordinates::setDefaultNotation( GeoDataCoordinates::Decimal );
-        return;
+        notation = GeoDataCoordinates::Decimal;
     } else if ( angleUnit == UTM ) {
-        GeoDataCoordinates::setDefaultNotation( GeoDataCoordinates::UTM );
+        notation = GeoDataCoordinates::UTM;
+    }
+
+    if ( notation == GeoDataCoordinates::defaultNotation() ) {
         return;
     }
 
-    GeoDataCoordinates::setDefaultNotation( GeoDataCoordinates::DMS );
+    GeoDataCoordinates::setDefaultNotation( notation );
+
+    // Retained layers like the graticule still show labels in the old notation
+    d->m_layerManager.invalidateLayerBuffers();
+    emit repaintNeeded();
 }
 
 QFont MarbleMap::defaultFont() const
@@ -647,6 +647,15 @@ class MARBLE_EXPORT MarbleMap : public QObject
 
     bool showRuntimeTrace() const;
 
+    /**
+     * @brief Set whether layers supporting it are rendered in parallel
+     * into their own buffers (default: false)
+     * @see LayerInterface::supportsConcurrentRendering()
+     */
+    void setConcurrentRendering( bool enabled );
+
+    bool concurrentRendering() const;
+
     /**
      * @brief Set whether to enter the debug mode for
      * polygon node drawing
@@ -702,6 +711,8 @@ class MARBLE_EXPORT MarbleMap : public QObject
     void clearVolatileTileCache();
     /**
      * @brief  Set the limit of the volatile (in RAM) tile cache.
+     * The limit is split between texture tiles and parsed vector tiles
+     * if the map theme has both.
      * @param  bytes The limit in kilobytes.
      */
     void setVolatileTileCacheLimit( quint64 kiloBytes );
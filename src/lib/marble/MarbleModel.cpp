@@ -196,6 +196,10 @@ MarbleModel::MarbleModel( QObject *parent )
 
     d->m_pluginManager.addPositionProviderPlugin(new PlacemarkPositionProviderPlugin(this, this));
     d->m_pluginManager.addPositionProviderPlugin(new RouteSimulationPositionProviderPlugin(this, this));
+
+    // Parse runner plugins are first asked for by the file and tile loading threads,
+    // load them here in the thread of the model instead
+    d->m_pluginManager.parsingRunnerPlugins();
 }
 
 MarbleModel::~MarbleModel()
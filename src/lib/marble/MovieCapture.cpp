@@ -13,22 +13,205 @@
 #include "MarbleWidget.h"
 #include "MarbleDebug.h"
 
+#include <QImage>
 #include <QProcess>
 #include <QMessageBox>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
 #include <QTimer>
 #include <QTime>
 #include <QFile>
+#include <QWaitCondition>
 
 namespace Marble
 {
 
+/**
+ * Converts queued frames to RGB888 and pipes them into the encoder process
+ * on a thread of its own, keeping the GUI thread free for rendering.
+ */
+class MovieEncoder : public QThread
+{
+public:
+    MovieEncoder(MovieCapture *capture, const QString &program, const QStringList &arguments) :
+        m_capture(capture),
+        m_program(program),
+        m_arguments(arguments),
+        m_finishing(false),
+        m_canceled(false)
+    {}
+
+    /**
+     * @brief Queues @p frame. If the queue is full, waits for the encoder
+     * if @p wait is set or drops the frame otherwise.
+     * @return the number of frames queued before, or -1 if the frame was dropped
+     */
+    int enqueue(const QImage &frame, bool wait);
+
+    /**
+     * @brief Finishes the movie once all queued frames are written
+     */
+    void finish();
+
+    /**
+     * @brief Stops the encoder, dropping all queued frames
+     */
+    void cancel();
+
+protected:
+    void run() override;
+
+private:
+    void writeFrame(QProcess &process, const QImage &frame);
+
+    // Raw 1080p frames take about 8 MB each
+    static const int s_capacity = 8;
+
+    MovieCapture *const m_capture;
+    const QString m_program;
+    const QStringList m_arguments;
+    QMutex m_mutex;
+    QWaitCondition m_frameQueued;
+    QWaitCondition m_frameTaken;
+    QQueue<QImage> m_frames;
+    bool m_finishing;
+    bool m_canceled;
+};
+
+int MovieEncoder::enqueue(const QImage &frame, bool wait)
+{
+    QMutexLocker locker(&m_mutex);
+    while (wait && m_frames.size() >= s_capacity && !m_canceled) {
+        m_frameTaken.wait(&m_mutex);
+    }
+    if (m_frames.size() >= s_capacity || m_canceled) {
+        return -1;
+    }
+
+    const int lag = m_frames.size();
+    m_frames.enqueue(frame);
+    m_frameQueued.wakeOne();
+    return lag;
+}
+
+void MovieEncoder::finish()
+{
+    QMutexLocker locker(&m_mutex);
+    m_finishing = true;
+    m_frameQueued.wakeOne();
+}
+
+void MovieEncoder::cancel()
+{
+    QMutexLocker locker(&m_mutex);
+    m_canceled = true;
+    m_frames.clear();
+    m_frameQueued.wakeOne();
+    m_frameTaken.wakeAll();
+}
+
+void MovieEncoder::run()
+{
+    QProcess process;
+    process.start(m_program, m_arguments);
+    if (!process.waitForStarted()) {
+        cancel();
+        QMetaObject::invokeMethod(m_capture, "processWrittenMovie", Qt::QueuedConnection, Q_ARG(int, -1));
+        return;
+    }
+
+    while (true) {
+        QImage frame;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_frames.isEmpty() && !m_finishing && !m_canceled) {
+                m_frameQueued.wait(&m_mutex);
+            }
+            if (m_canceled || m_frames.isEmpty()) {
+                break;
+            }
+            frame = m_frames.dequeue();
+            m_frameTaken.wakeAll();
+        }
+
+        writeFrame(process, frame);
+    }
+
+    QMutexLocker locker(&m_mutex);
+    if (m_canceled) {
+        process.kill();
+        process.waitForFinished();
+        return;
+    }
+    // Don't let the GUI thread wait for frames which will never be written
+    m_canceled = true;
+    m_frameTaken.wakeAll();
+    locker.unlock();
+
+    process.closeWriteChannel();
+    process.waitForFinished(-1);
+    const int exitCode = process.exitStatus() == QProcess::NormalExit ? process.exitCode() : -1;
+    QMetaObject::invokeMethod(m_capture, "processWrittenMovie", Qt::QueuedConnection, Q_ARG(int, exitCode));
+}
+
+void MovieEncoder::writeFrame(QProcess &process, const QImage &frame)
+{
+    QTime t;
+    t.start();
+
+    const QImage image = frame.convertToFormat(QImage::Format_RGB888);
+    const int lineLength = 3 * image.width();
+    qint64 bytesWritten = 0;
+    if (image.bytesPerLine() == lineLength) {
+        bytesWritten += process.write(reinterpret_cast<const char*>(image.constBits()), qint64(lineLength) * image.height());
+    } else {
+        // Scan lines are padded to 32 bit, rawvideo expects them without padding
+        for (int y = 0; y < image.height(); ++y) {
+            bytesWritten += process.write(reinterpret_cast<const char*>(image.constScanLine(y)), lineLength);
+        }
+    }
+
+    while (process.bytesToWrite() > 0 && process.waitForBytesWritten(1000)) {
+        // keep going until the encoder took the whole frame
+    }
+
+    const double rate = ( bytesWritten * 1000.0 ) / ( qMax(1, t.elapsed()) * 1024 );
+    QMetaObject::invokeMethod(m_capture, "rateCalculated", Qt::QueuedConnection, Q_ARG(double, rate));
+}
+
 class MovieCapturePrivate
 {
 public:
     explicit MovieCapturePrivate(MarbleWidget *widget) :
-        marbleWidget(widget), method(MovieCapture::TimeDriven)
+        marbleWidget(widget),
+        encoder(nullptr),
+        method(MovieCapture::TimeDriven),
+        recordedFrames(0),
+        droppedFrames(0),
+        maximumLag(0)
     {}
 
+    ~MovieCapturePrivate()
+    {
+        stopEncoder(false);
+    }
+
+    void stopEncoder(bool cancel)
+    {
+        if (!encoder) {
+            return;
+        }
+        if (cancel) {
+            encoder->cancel();
+        } else {
+            encoder->finish();
+        }
+        encoder->wait();
+        delete encoder;
+        encoder = nullptr;
+    }
+
     /**
      * @brief This gets called when user doesn't have avconv/ffmpeg installed
      */
@@ -46,9 +229,13 @@ public:
     MarbleWidget *marbleWidget;
     QString encoderExec;
     QString destinationFile;
-    QProcess process;
+    MovieEncoder *encoder;
+    QSize frameSize;
     MovieCapture::SnapshotMethod method;
     int fps;
+    int recordedFrames;
+    int droppedFrames;
+    int maximumLag;
 };
 
 MovieCapture::MovieCapture(MarbleWidget *widget, QObject *parent) :
@@ -160,35 +347,58 @@ bool MovieCapture::checkToolsAvailability()
     return toolsAvailable;
 }
 
+int MovieCapture::recordedFrames() const
+{
+    Q_D(const MovieCapture);
+    return d->recordedFrames;
+}
+
+int MovieCapture::droppedFrames() const
+{
+    Q_D(const MovieCapture);
+    return d->droppedFrames;
+}
+
+int MovieCapture::maximumLag() const
+{
+    Q_D(const MovieCapture);
+    return d->maximumLag;
+}
+
 void MovieCapture::recordFrame()
 {
     Q_D(MovieCapture);
-    QImage const screenshot = d->marbleWidget->mapScreenShot().toImage().convertToFormat(QImage::Format_RGB888);
-    if (d->process.state() == QProcess::NotRunning) {
+
+    // Render offscreen into an image instead of grabbing the widget into a pixmap
+    QImage frame(d->frameSize.isValid() ? d->frameSize : d->marbleWidget->size(), QImage::Format_RGB32);
+    if (frame.size() != d->marbleWidget->size()) {
+        // The encoder needs a fixed frame size even if the widget was resized
+        frame.fill(Qt::black);
+    }
+    d->marbleWidget->render(&frame, QPoint(), QRegion(QRect(QPoint(), frame.size())));
+
+    if (!d->encoder) {
+        d->frameSize = frame.size();
         QStringList const arguments = QStringList()
                 << "-y"
                 << "-r" << QString::number(fps())
                 << "-f" << "rawvideo"
                 << "-pix_fmt" << "rgb24"
-                << "-s" << QString("%1x%2").arg( screenshot.width() ).arg( screenshot.height() )
+                << "-s" << QString("%1x%2").arg( frame.width() ).arg( frame.height() )
                 << "-i" << "pipe:"
                 << "-b" << "2000k"
                 << d->destinationFile;
-        d->process.start( d->encoderExec, arguments );
-        connect(&d->process, SIGNAL(finished(int)), this, SLOT(processWrittenMovie(int)));
+        d->encoder = new MovieEncoder(this, d->encoderExec, arguments);
+        d->encoder->start();
     }
-    d->process.write( (char*) screenshot.bits(), screenshot.byteCount() );
 
-    for (int i=0; i<30 && d->process.bytesToWrite()>0; ++i) {
-        QTime t;
-        int then = d->process.bytesToWrite();
-        t.start();
-        d->process.waitForBytesWritten( 100 );
-        int span = t.elapsed();
-        int now = d->process.bytesToWrite();
-        int bytesWritten = then - now;
-        double rate = ( bytesWritten * 1000.0 ) / ( qMax(1, span) * 1024 );
-        emit rateCalculated( rate );
+    // Data driven recording waits for the encoder, the timer does not
+    const int lag = d->encoder->enqueue(frame, d->method == DataDriven);
+    if (lag < 0) {
+        ++d->droppedFrames;
+    } else {
+        ++d->recordedFrames;
+        d->maximumLag = qMax(d->maximumLag, lag);
     }
 }
 
@@ -201,6 +411,13 @@ bool MovieCapture::startRecording()
         return false;
     }
 
+    // A previous movie may still be written
+    d->stopEncoder(false);
+    d->frameSize = QSize();
+    d->recordedFrames = 0;
+    d->droppedFrames = 0;
+    d->maximumLag = 0;
+
     if( d->method == MovieCapture::TimeDriven ){
         d->frameTimer.start();
     }
@@ -213,7 +430,12 @@ void MovieCapture::stopRecording()
     Q_D(MovieCapture);
 
     d->frameTimer.stop();
-    d->process.closeWriteChannel();
+    if (d->encoder) {
+        // Writing the remaining frames continues in the background
+        d->encoder->finish();
+    }
+    mDebug() << "Recorded" << d->recordedFrames << "frames, dropped" << d->droppedFrames
+             << "frames, at most" << d->maximumLag << "frames behind";
 }
 
 void MovieCapture::cancelRecording()
@@ -221,12 +443,17 @@ void MovieCapture::cancelRecording()
     Q_D(MovieCapture);
 
     d->frameTimer.stop();
-    d->process.close();
+    d->stopEncoder(true);
     QFile::remove( d->destinationFile );
 }
 
 void MovieCapture::processWrittenMovie(int exitCode)
 {
+    Q_D(MovieCapture);
+    if (d->encoder && d->encoder->isFinished()) {
+        d->stopEncoder(false);
+    }
+
     if (exitCode != 0) {
         mDebug() << "[*] avconv finished with" << exitCode;
         emit errorOccured();
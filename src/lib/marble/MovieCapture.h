@@ -56,6 +56,22 @@ public:
     MovieCapture::SnapshotMethod snapshotMethod() const;
     bool checkToolsAvailability();
 
+    /**
+     * @brief Returns the number of frames passed to the encoder since recording started
+     */
+    int recordedFrames() const;
+
+    /**
+     * @brief Returns the number of frames dropped because the encoder fell behind.
+     * Time driven recording drops frames, data driven recording waits instead.
+     */
+    int droppedFrames() const;
+
+    /**
+     * @brief Returns the largest number of frames which waited for the encoder at once
+     */
+    int maximumLag() const;
+
 public Q_SLOTS:
     void setFps(int fps);
     void setFilename(const QString &path);
@@ -21,8 +21,11 @@
 #include <QItemSelectionModel>
 #include <qmath.h>
 
+#include <algorithm>
+
 #include "GeoDataLatLonAltBox.h"
 #include "GeoDataLatLonBox.h"
+#include "GeoDataDocument.h"
 #include "GeoDataPlacemark.h"
 #include "GeoDataStyle.h"
 #include "GeoDataIconStyle.h"
@@ -57,6 +60,64 @@ namespace
         }
         return true;
     }
+
+    /**
+     * Merges the pre-sorted placemark lists of several tiles into a single
+     * sequence ordered by GeoDataPlacemark::placemarkLayoutOrderCompare.
+     * Placemarks are only visited as far as the layout asks for them.
+     */
+    class PlacemarkMerge
+    {
+    public:
+        void addBucket( const QList<const Marble::GeoDataPlacemark*> &bucket )
+        {
+            if ( !bucket.isEmpty() ) {
+                Cursor cursor;
+                cursor.position = bucket.constBegin();
+                cursor.end = bucket.constEnd();
+                m_cursors << cursor;
+                std::push_heap( m_cursors.begin(), m_cursors.end(), &PlacemarkMerge::comesLater );
+            }
+        }
+
+        const Marble::GeoDataPlacemark *peek() const
+        {
+            return m_cursors.isEmpty() ? nullptr : *m_cursors.first().position;
+        }
+
+        const Marble::GeoDataPlacemark *next()
+        {
+            if ( m_cursors.isEmpty() ) {
+                return nullptr;
+            }
+
+            std::pop_heap( m_cursors.begin(), m_cursors.end(), &PlacemarkMerge::comesLater );
+            Cursor &cursor = m_cursors.last();
+            const Marble::GeoDataPlacemark *placemark = *cursor.position;
+            ++cursor.position;
+            if ( cursor.position == cursor.end ) {
+                m_cursors.removeLast();
+            } else {
+                std::push_heap( m_cursors.begin(), m_cursors.end(), &PlacemarkMerge::comesLater );
+            }
+            return placemark;
+        }
+
+    private:
+        struct Cursor
+        {
+            QList<const Marble::GeoDataPlacemark*>::const_iterator position;
+            QList<const Marble::GeoDataPlacemark*>::const_iterator end;
+        };
+
+        // std::push_heap() and friends keep the largest element on top
+        static bool comesLater( const Cursor &left, const Cursor &right )
+        {
+            return Marble::GeoDataPlacemark::placemarkLayoutOrderCompare( *right.position, *left.position );
+        }
+
+        QVector<Cursor> m_cursors;
+    };
 }
 
 namespace Marble
@@ -124,7 +185,11 @@ PlacemarkLayout::PlacemarkLayout( QAbstractItemModel  *placemarkModel,
       m_maxLabelHeight(maxLabelHeight()),
       m_styleResetRequested( true ),
       m_styleBuilder(styleBuilder),
-      m_lastPlacemarkAvailable(false)
+      m_lastPlacemarkAvailable(false),
+      m_temporalCoherence(true),
+      m_lastProjection(Spherical),
+      m_lastRadius(0),
+      m_lastTileLevel(-1)
 {
     Q_ASSERT(m_placemarkModel);
 
@@ -182,6 +247,17 @@ void PlacemarkLayout::setShowMaria( bool show )
     m_showMaria = show;
 }
 
+void PlacemarkLayout::setTemporalCoherence( bool enabled )
+{
+    m_temporalCoherence = enabled;
+    m_layoutSeeds.clear();
+}
+
+bool PlacemarkLayout::temporalCoherence() const
+{
+    return m_temporalCoherence;
+}
+
 void PlacemarkLayout::requestStyleReset()
 {
     mDebug() << "Style reset requested.";
@@ -204,6 +280,7 @@ void PlacemarkLayout::clearCache()
     m_labelArea = 0;
     qDeleteAll( m_visiblePlacemarks );
     m_visiblePlacemarks.clear();
+    m_layoutSeeds.clear();
 }
 
 QVector<const GeoDataFeature*> PlacemarkLayout::whichPlacemarkAt( const QPoint& curpos )
@@ -239,27 +316,34 @@ void PlacemarkLayout::addPlacemarks( const QModelIndex& parent, int first, int l
         Q_ASSERT( index.isValid() );
         auto const object = qvariant_cast<GeoDataObject*>(index.data(MarblePlacemarkModel::ObjectPointerRole));
         if (const GeoDataPlacemark *placemark = geodata_cast<GeoDataPlacemark>(object)) {
-            const GeoDataCoordinates coordinates = placemarkIconCoordinates( placemark );
-            if ( !coordinates.isValid() ) {
-                continue;
-            }
+            addPlacemark( placemark );
+        }
+    }
+    emit repaintNeeded();
+}
 
-            if (placemark->hasOsmData()) {
-                qint64 const osmId = placemark->osmData().id();
-                if (osmId > 0) {
-                    if (m_osmIds.contains(osmId)) {
-                        continue; // placemark is already shown
-                    }
-                    m_osmIds << osmId;
-                }
-            }
+void PlacemarkLayout::addPlacemark( const GeoDataPlacemark *placemark )
+{
+    const GeoDataCoordinates coordinates = placemarkIconCoordinates( placemark );
+    if ( !coordinates.isValid() ) {
+        return;
+    }
 
-            int zoomLevel = placemark->zoomLevel();
-            TileId key = TileId::fromCoordinates( coordinates, zoomLevel );
-            m_placemarkCache[key].append( placemark );
+    if (placemark->hasOsmData()) {
+        qint64 const osmId = placemark->osmData().id();
+        if (osmId > 0) {
+            if (m_osmIds.contains(osmId)) {
+                return; // placemark is already shown
+            }
+            m_osmIds << osmId;
         }
     }
-    emit repaintNeeded();
+
+    int zoomLevel = placemark->zoomLevel();
+    TileId key = TileId::fromCoordinates( coordinates, zoomLevel );
+    m_placemarkCache[key].append( placemark );
+    // Sorted once the tile becomes visible, adding many placemarks stays cheap
+    m_unsortedTiles << key;
 }
 
 void PlacemarkLayout::removePlacemarks( const QModelIndex& parent, int first, int last )
@@ -270,36 +354,85 @@ void PlacemarkLayout::removePlacemarks( const QModelIndex& parent, int first, in
         QModelIndex index = m_placemarkModel->index( i, 0, parent );
         Q_ASSERT( index.isValid() );
         const GeoDataPlacemark *placemark = static_cast<GeoDataPlacemark*>(qvariant_cast<GeoDataObject*>( index.data( MarblePlacemarkModel::ObjectPointerRole ) ));
-        const GeoDataCoordinates coordinates = placemarkIconCoordinates( placemark );
-        if ( !coordinates.isValid() ) {
-            continue;
-        }
+        removePlacemark( placemark );
+    }
+    emit repaintNeeded();
+}
 
-        int zoomLevel = placemark->zoomLevel();
-        TileId key = TileId::fromCoordinates( coordinates, zoomLevel );
-        delete m_visiblePlacemarks[placemark];
-        m_visiblePlacemarks.remove(placemark);
-        m_placemarkCache[key].removeAll( placemark );
-        if (placemark->hasOsmData()) {
-            qint64 const osmId = placemark->osmData().id();
-            if (osmId > 0) {
-                m_osmIds.remove(osmId);
-            }
+void PlacemarkLayout::removePlacemark( const GeoDataPlacemark *placemark )
+{
+    const GeoDataCoordinates coordinates = placemarkIconCoordinates( placemark );
+    if ( !coordinates.isValid() ) {
+        return;
+    }
+
+    int zoomLevel = placemark->zoomLevel();
+    TileId key = TileId::fromCoordinates( coordinates, zoomLevel );
+    delete m_visiblePlacemarks.take( placemark );
+    m_placemarkCache[key].removeAll( placemark );
+    if (placemark->hasOsmData()) {
+        qint64 const osmId = placemark->osmData().id();
+        if (osmId > 0) {
+            m_osmIds.remove(osmId);
         }
     }
+}
+
+void PlacemarkLayout::addTileDocument( const GeoDataDocument *document )
+{
+    Q_ASSERT( !m_tileDocuments.contains( document ) );
+    m_tileDocuments << document;
+    addTilePlacemarks( document );
     emit repaintNeeded();
 }
 
+void PlacemarkLayout::removeTileDocument( const GeoDataDocument *document )
+{
+    if ( m_tileDocuments.remove( document ) ) {
+        removeTilePlacemarks( document );
+        emit repaintNeeded();
+    }
+}
+
+void PlacemarkLayout::addTilePlacemarks( const GeoDataContainer *container )
+{
+    for( const GeoDataFeature *feature: container->featureList() ) {
+        if ( const GeoDataPlacemark *placemark = geodata_cast<GeoDataPlacemark>( feature ) ) {
+            addPlacemark( placemark );
+        } else if ( const GeoDataContainer *child = dynamic_cast<const GeoDataContainer*>( feature ) ) {
+            addTilePlacemarks( child );
+        }
+    }
+}
+
+void PlacemarkLayout::removeTilePlacemarks( const GeoDataContainer *container )
+{
+    for( const GeoDataFeature *feature: container->featureList() ) {
+        if ( const GeoDataPlacemark *placemark = geodata_cast<GeoDataPlacemark>( feature ) ) {
+            removePlacemark( placemark );
+        } else if ( const GeoDataContainer *child = dynamic_cast<const GeoDataContainer*>( feature ) ) {
+            removeTilePlacemarks( child );
+        }
+    }
+}
+
 void PlacemarkLayout::resetCacheData()
 {
     const int rowCount = m_placemarkModel->rowCount();
 
     m_osmIds.clear();
     m_placemarkCache.clear();
+    m_unsortedTiles.clear();
     qDeleteAll(m_visiblePlacemarks);
     m_visiblePlacemarks.clear();
+    m_layoutSeeds.clear();
     requestStyleReset();
-    addPlacemarks( m_placemarkModel->index( 0, 0 ), 0, rowCount );
+    if ( rowCount > 0 ) {
+        addPlacemarks( QModelIndex(), 0, rowCount - 1 );
+    }
+    for( const GeoDataDocument *document: m_tileDocuments ) {
+        addTilePlacemarks( document );
+    }
     emit repaintNeeded();
 }
 
@@ -371,7 +504,46 @@ QVector<VisiblePlacemark *> PlacemarkLayout::generateLayout( const ViewportParam
         return QVector<VisiblePlacemark *>();
     }
 
-    QList<const GeoDataPlacemark*> placemarkList;
+    // Only pure panning keeps the previously placed labels, any other change
+    // of the view gets a fresh layout ordered by priority
+    const bool useSeeds = m_temporalCoherence
+            && viewport->projection() == m_lastProjection
+            && viewport->radius() == m_lastRadius
+            && viewport->size() == m_lastViewportSize
+            && tileLevel == m_lastTileLevel;
+    m_lastProjection = viewport->projection();
+    m_lastRadius = viewport->radius();
+    m_lastViewportSize = viewport->size();
+    m_lastTileLevel = tileLevel;
+    QVector<const GeoDataPlacemark*> layoutSeeds;
+    QSet<const GeoDataPlacemark*> seeds;
+    if ( useSeeds ) {
+        // Removed placemarks lost their visible placemark, don't touch them
+        for ( const GeoDataPlacemark *placemark: m_layoutSeeds ) {
+            if ( m_visiblePlacemarks.contains( placemark ) ) {
+                layoutSeeds << placemark;
+                seeds << placemark;
+            }
+        }
+        std::sort( layoutSeeds.begin(), layoutSeeds.end(), GeoDataPlacemark::placemarkLayoutOrderCompare );
+    }
+    m_layoutSeeds.clear();
+
+    // Visible tiles keep their placemarks in layout order, so they only need to be merged
+    QVector<const QList<const GeoDataPlacemark*> *> buckets;
+    int placemarkCount = 0;
+    for (const TileId &tileId: visibleTiles(*viewport, tileLevel)) {
+        auto const iter = m_placemarkCache.find( tileId );
+        if ( iter == m_placemarkCache.end() || iter->isEmpty() ) {
+            continue;
+        }
+        if ( m_unsortedTiles.remove( tileId ) ) {
+            std::sort(iter->begin(), iter->end(), GeoDataPlacemark::placemarkLayoutOrderCompare);
+        }
+        buckets << &iter.value();
+        placemarkCount += iter->size();
+    }
+
     int currentMaxLabelHeight;
     do {
         currentMaxLabelHeight = m_maxLabelHeight;
@@ -420,17 +592,31 @@ QVector<VisiblePlacemark *> PlacemarkLayout::generateLayout( const ViewportParam
         // Now handle all other placemarks...
 
         const QItemSelection selection = m_selectionModel->selection();
+        const QModelIndexList selectionIndexes = selection.indexes();
 
-        placemarkList.clear();
-        for (const TileId &tileId: visibleTiles(*viewport, tileLevel)) {
-            placemarkList += m_placemarkCache.value( tileId );
+        PlacemarkMerge placemarks;
+        for ( const QList<const GeoDataPlacemark*> *bucket: buckets ) {
+            placemarks.addBucket( *bucket );
         }
-        std::sort(placemarkList.begin(), placemarkList.end(), GeoDataPlacemark::placemarkLayoutOrderCompare);
 
-        for ( const GeoDataPlacemark *placemark: placemarkList ) {
-            const GeoDataCoordinates coordinates = placemarkIconCoordinates( placemark );
-            if ( !coordinates.isValid() ) {
-                continue;
+        // Placemarks shown in the previous frame are laid out before the others
+        // of their zoom level, so their labels don't jump around or vanish while
+        // panning. Placemarks of a lower zoom level scrolling into view still
+        // take precedence.
+        int seedIndex = 0;
+        while ( true ) {
+            const GeoDataPlacemark *placemark = placemarks.peek();
+            if ( seedIndex < layoutSeeds.size()
+                 && ( !placemark || layoutSeeds[seedIndex]->zoomLevel() <= placemark->zoomLevel() ) ) {
+                placemark = layoutSeeds[seedIndex];
+                ++seedIndex;
+            } else if ( placemark ) {
+                placemarks.next();
+                if ( seeds.contains( placemark ) ) {
+                    continue;
+                }
+            } else {
+                break;
             }
 
             int zoomLevel = placemark->zoomLevel();
@@ -438,6 +624,11 @@ QVector<VisiblePlacemark *> PlacemarkLayout::generateLayout( const ViewportParam
                 break;
             }
 
+            const GeoDataCoordinates coordinates = placemarkIconCoordinates( placemark );
+            if ( !coordinates.isValid() ) {
+                continue;
+            }
+
             qreal x = 0;
             qreal y = 0;
 
@@ -446,66 +637,17 @@ QVector<VisiblePlacemark *> PlacemarkLayout::generateLayout( const ViewportParam
                     continue;
                 }
 
-            if ( !placemark->isGloballyVisible() ) {
+            if ( !isShown( placemark ) ) {
                 continue;
             }
 
-            const GeoDataPlacemark::GeoDataVisualCategory visualCategory = placemark->visualCategory();
-
-            // Skip city marks if we're not showing cities.
-            if ( !m_showCities
-                 && visualCategory >= GeoDataPlacemark::SmallCity
-                 && visualCategory <= GeoDataPlacemark::Nation )
-                continue;
-
-            // Skip terrain marks if we're not showing terrain.
-            if ( !m_showTerrain
-                 && visualCategory >= GeoDataPlacemark::Mountain
-                 && visualCategory <= GeoDataPlacemark::OtherTerrain )
-                continue;
-
-            // Skip other places if we're not showing other places.
-            if ( !m_showOtherPlaces
-                 && visualCategory >= GeoDataPlacemark::GeographicPole
-                 && visualCategory <= GeoDataPlacemark::Observatory )
-                continue;
-
-            // Skip landing sites if we're not showing landing sites.
-            if ( !m_showLandingSites
-                 && visualCategory >= GeoDataPlacemark::MannedLandingSite
-                 && visualCategory <= GeoDataPlacemark::UnmannedHardLandingSite )
-                continue;
-
-            // Skip craters if we're not showing craters.
-            if ( !m_showCraters
-                 && visualCategory == GeoDataPlacemark::Crater )
-                continue;
-
-            // Skip maria if we're not showing maria.
-            if ( !m_showMaria
-                 && visualCategory == GeoDataPlacemark::Mare )
-                continue;
-
-            if ( !m_showPlaces
-                 && visualCategory >= GeoDataPlacemark::GeographicPole
-                 && visualCategory <= GeoDataPlacemark::Observatory )
-                continue;
-
             // We handled selected placemarks already, so we skip them here...
             // Assuming that only a small amount of places is selected
             // we check for the selected state after all other filters
-            bool isSelected = false;
-            for ( const QModelIndex &index: selection.indexes() ) {
-                const GeoDataPlacemark *mark = static_cast<GeoDataPlacemark*>(qvariant_cast<GeoDataObject*>(index.data( MarblePlacemarkModel::ObjectPointerRole ) ));
-                if (mark == placemark ) {
-                    isSelected = true;
-                    break;
-                }
-            }
-            if ( isSelected )
+            if ( isSelected( placemark, selectionIndexes ) )
                 continue;
 
-            if( layoutPlacemark( placemark, coordinates, x, y, isSelected ) ) {
+            if( layoutPlacemark( placemark, coordinates, x, y, false ) ) {
                 // Make sure not to draw more placemarks on the screen than
                 // specified by placemarksOnScreenLimit().
                 if ( placemarksOnScreenLimit( viewport->size() ) )
@@ -527,10 +669,80 @@ QVector<VisiblePlacemark *> PlacemarkLayout::generateLayout( const ViewportParam
         }
     } while (currentMaxLabelHeight != m_maxLabelHeight);
 
-    m_runtimeTrace = QStringLiteral("Placemarks: %1 Drawn: %2").arg(placemarkList.count()).arg(m_paintOrder.size());
+    if ( m_temporalCoherence ) {
+        m_layoutSeeds.reserve( m_paintOrder.size() );
+        for ( const VisiblePlacemark *mark: m_paintOrder ) {
+            if ( !mark->selected() ) {
+                m_layoutSeeds << mark->placemark();
+            }
+        }
+    }
+
+    m_runtimeTrace = QStringLiteral("Placemarks: %1 Drawn: %2").arg(placemarkCount).arg(m_paintOrder.size());
     return m_paintOrder;
 }
 
+bool PlacemarkLayout::isShown( const GeoDataPlacemark *placemark ) const
+{
+    if ( !placemark->isGloballyVisible() ) {
+        return false;
+    }
+
+    const GeoDataPlacemark::GeoDataVisualCategory visualCategory = placemark->visualCategory();
+
+    // Skip city marks if we're not showing cities.
+    if ( !m_showCities
+         && visualCategory >= GeoDataPlacemark::SmallCity
+         && visualCategory <= GeoDataPlacemark::Nation )
+        return false;
+
+    // Skip terrain marks if we're not showing terrain.
+    if ( !m_showTerrain
+         && visualCategory >= GeoDataPlacemark::Mountain
+         && visualCategory <= GeoDataPlacemark::OtherTerrain )
+        return false;
+
+    // Skip other places if we're not showing other places.
+    if ( !m_showOtherPlaces
+         && visualCategory >= GeoDataPlacemark::GeographicPole
+         && visualCategory <= GeoDataPlacemark::Observatory )
+        return false;
+
+    // Skip landing sites if we're not showing landing sites.
+    if ( !m_showLandingSites
+         && visualCategory >= GeoDataPlacemark::MannedLandingSite
+         && visualCategory <= GeoDataPlacemark::UnmannedHardLandingSite )
+        return false;
+
+    // Skip craters if we're not showing craters.
+    if ( !m_showCraters
+         && visualCategory == GeoDataPlacemark::Crater )
+        return false;
+
+    // Skip maria if we're not showing maria.
+    if ( !m_showMaria
+         && visualCategory == GeoDataPlacemark::Mare )
+        return false;
+
+    if ( !m_showPlaces
+         && visualCategory >= GeoDataPlacemark::GeographicPole
+         && visualCategory <= GeoDataPlacemark::Observatory )
+        return false;
+
+    return true;
+}
+
+bool PlacemarkLayout::isSelected( const GeoDataPlacemark *placemark, const QModelIndexList &selection )
+{
+    for ( const QModelIndex &index: selection ) {
+        const GeoDataPlacemark *mark = static_cast<GeoDataPlacemark*>(qvariant_cast<GeoDataObject*>(index.data( MarblePlacemarkModel::ObjectPointerRole ) ));
+        if (mark == placemark ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 QString PlacemarkLayout::runtimeTrace() const
 {
     return m_runtimeTrace;
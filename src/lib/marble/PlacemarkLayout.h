@@ -21,22 +21,25 @@
 #include <QRect>
 #include <QSet>
 #include <QMap>
+#include <QModelIndex>
 #include <QVector>
 #include <QPointer>
 
 #include "GeoDataPlacemark.h"
+#include "MarbleGlobal.h"
 #include <GeoDataStyle.h>
 
 class QAbstractItemModel;
 class QItemSelectionModel;
 class QPoint;
-class QModelIndex;
 
 
 namespace Marble
 {
 
+class GeoDataContainer;
 class GeoDataCoordinates;
+class GeoDataDocument;
 class GeoPainter;
 class MarbleClock;
 class PlacemarkPainter;
@@ -51,7 +54,7 @@ class StyleBuilder;
 
 
 
-class PlacemarkLayout : public QObject
+class MARBLE_EXPORT PlacemarkLayout : public QObject
 {
     Q_OBJECT
 
@@ -86,6 +89,22 @@ class PlacemarkLayout : public QObject
 
     bool hasPlacemarkAt(const QPoint &pos);
 
+    /**
+     * Lays out the placemarks of a vector tile, which is not part of the placemark model.
+     * The document must outlive its removal by removeTileDocument().
+     */
+    void addTileDocument( const GeoDataDocument *document );
+    void removeTileDocument( const GeoDataDocument *document );
+
+    /**
+     * While panning, placemarks shown in the previous frame are laid out
+     * before the others of their zoom level to keep labels from flickering.
+     * Any other change of the view lays out all placemarks by priority.
+     * Enabled by default.
+     */
+    void setTemporalCoherence( bool enabled );
+    bool temporalCoherence() const;
+
  public Q_SLOTS:
     // earth
     void setShowPlaces( bool show );
@@ -119,9 +138,20 @@ class PlacemarkLayout : public QObject
     void styleReset();
     void clearCache();
 
+    void addPlacemark( const GeoDataPlacemark *placemark );
+    void removePlacemark( const GeoDataPlacemark *placemark );
+    void addTilePlacemarks( const GeoDataContainer *container );
+    void removeTilePlacemarks( const GeoDataContainer *container );
+
     static QSet<TileId> visibleTiles(const ViewportParams &viewport, int tileLevel);
     bool layoutPlacemark(const GeoDataPlacemark *placemark, const GeoDataCoordinates &coordinates, qreal x, qreal y, bool selected );
 
+    /**
+     * Returns whether the @p placemark is visible and its category is enabled.
+     */
+    bool isShown( const GeoDataPlacemark *placemark ) const;
+    static bool isSelected( const GeoDataPlacemark *placemark, const QModelIndexList &selection );
+
     /**
      * Returns the coordinates at which an icon should be drawn for the @p placemark.
      * @p ok is set to true if the coordinates are valid and should be used for drawing,
@@ -148,9 +178,12 @@ class PlacemarkLayout : public QObject
     QHash<const GeoDataPlacemark*, VisiblePlacemark*> m_visiblePlacemarks;
     QVector< QVector< VisiblePlacemark* > >  m_rowsection;
 
-    /// map providing the list of placemark belonging in TileId as key
+    /// map providing the list of placemark belonging in TileId as key,
+    /// sorted by GeoDataPlacemark::placemarkLayoutOrderCompare unless in m_unsortedTiles
     QMap<TileId, QList<const GeoDataPlacemark*> > m_placemarkCache;
+    QSet<TileId> m_unsortedTiles;
     QSet<qint64> m_osmIds;
+    QSet<const GeoDataDocument*> m_tileDocuments;
 
     const QSet<GeoDataPlacemark::GeoDataVisualCategory> m_acceptedVisualCategories;
 
@@ -173,6 +206,14 @@ class PlacemarkLayout : public QObject
     bool m_lastPlacemarkAvailable;
     QRectF m_lastPlacemarkLabelRect;
     QRectF m_lastPlacemarkSymbolRect;
+
+    bool m_temporalCoherence;
+    /// the placemarks laid out in the last frame, only used as hash keys
+    QVector<const GeoDataPlacemark*> m_layoutSeeds;
+    Projection m_lastProjection;
+    int m_lastRadius;
+    QSize m_lastViewportSize;
+    int m_lastTileLevel;
 };
 
 }
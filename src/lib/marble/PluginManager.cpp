@@ -14,14 +14,24 @@
 #include "PluginManager.h"
 
 // Qt
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
 #include <QList>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPluginLoader>
+#include <QSaveFile>
+#include <QThread>
 #include <QTime>
 #include <QMessageBox>
 
 // Local dir
 #include "MarbleDirs.h"
 #include "MarbleDebug.h"
+#include "MarbleGlobal.h"
 #include "RenderPlugin.h"
 #include "PositionProviderPlugin.h"
 #include "ParseRunnerPlugin.h"
@@ -33,20 +43,69 @@
 namespace Marble
 {
 
+namespace
+{
+    // Increase when changing the layout of the plugin index file
+    const quint32 pluginIndexMagic = 0x4d504958; // "MPIX"
+    const quint32 pluginIndexVersion = 1;
+}
+
 class PluginManagerPrivate
 {
  public:
+    enum PluginType {
+        UnknownPlugin = 0,
+        RenderPluginType,
+        PositionProviderPluginType,
+        SearchRunnerPluginType,
+        ReverseGeocodingRunnerPluginType,
+        RoutingRunnerPluginType,
+        ParseRunnerPluginType
+    };
+
+    /**
+     * A plugin file found in the plugin directories. Its type and name are
+     * cached across runs, so the library only needs to be loaded once
+     * plugins of its type are asked for.
+     */
+    struct PluginEntry
+    {
+        PluginEntry() : size( -1 ), modified( 0 ), type( UnknownPlugin ), loaded( false ) {}
+
+        QString path;
+        qint64 size;
+        qint64 modified;
+        int type;
+        QString nameId;
+        bool loaded;
+    };
+
     PluginManagerPrivate(PluginManager* parent)
-            : m_pluginsLoaded(false),
+            : m_pluginsDiscovered(false),
+              m_pluginIndexChanged(false),
+              m_loadedTypes(0),
               m_parent(parent)
     {
     }
 
     ~PluginManagerPrivate();
 
-    void loadPlugins();
-
-    bool m_pluginsLoaded;
+    void discoverPlugins();
+    void loadPlugins( PluginType type );
+    bool loadPlugin( PluginEntry &entry );
+
+    static QString pluginIndexPath();
+    QHash<QString, PluginEntry> readPluginIndex() const;
+    void writePluginIndex();
+
+    // Parse runner plugins are asked for by file and tile loading threads
+    QMutex m_mutex;
+    bool m_pluginsDiscovered;
+    bool m_pluginIndexChanged;
+    int m_loadedTypes;
+    // Not children of m_parent, they may be created in another thread
+    QList<QPluginLoader *> m_loaders;
+    QList<PluginEntry> m_pluginEntries;
     QList<const RenderPlugin *> m_renderPluginTemplates;
     QList<const PositionProviderPlugin *> m_positionProviderPluginTemplates;
     QList<const SearchRunnerPlugin *> m_searchRunnerPlugins;
@@ -56,6 +115,7 @@ class PluginManagerPrivate
     PluginManager* m_parent;
     static QStringList m_blacklist;
     static QStringList m_whitelist;
+    static bool m_lazyLoading;
 
 #ifdef Q_OS_ANDROID
     QStringList m_pluginPaths;
@@ -64,10 +124,11 @@ class PluginManagerPrivate
 
 QStringList PluginManagerPrivate::m_blacklist;
 QStringList PluginManagerPrivate::m_whitelist;
+bool PluginManagerPrivate::m_lazyLoading = true;
 
 PluginManagerPrivate::~PluginManagerPrivate()
 {
-    // nothing to do
+    qDeleteAll( m_loaders );
 }
 
 PluginManager::PluginManager( QObject *parent ) : QObject( parent ),
@@ -86,79 +147,103 @@ PluginManager::~PluginManager()
 
 QList<const RenderPlugin *> PluginManager::renderPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker( &d->m_mutex );
+    d->loadPlugins( PluginManagerPrivate::RenderPluginType );
     return d->m_renderPluginTemplates;
 }
 
 void PluginManager::addRenderPlugin( const RenderPlugin *plugin )
 {
-    d->loadPlugins();
-    d->m_renderPluginTemplates << plugin;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        d->loadPlugins( PluginManagerPrivate::RenderPluginType );
+        d->m_renderPluginTemplates << plugin;
+    }
     emit renderPluginsChanged();
 }
 
 QList<const PositionProviderPlugin *> PluginManager::positionProviderPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker( &d->m_mutex );
+    d->loadPlugins( PluginManagerPrivate::PositionProviderPluginType );
     return d->m_positionProviderPluginTemplates;
 }
 
 void PluginManager::addPositionProviderPlugin( const PositionProviderPlugin *plugin )
 {
-    d->loadPlugins();
-    d->m_positionProviderPluginTemplates << plugin;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        d->loadPlugins( PluginManagerPrivate::PositionProviderPluginType );
+        d->m_positionProviderPluginTemplates << plugin;
+    }
     emit positionProviderPluginsChanged();
 }
 
 QList<const SearchRunnerPlugin *> PluginManager::searchRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker( &d->m_mutex );
+    d->loadPlugins( PluginManagerPrivate::SearchRunnerPluginType );
     return d->m_searchRunnerPlugins;
 }
 
 void PluginManager::addSearchRunnerPlugin( const SearchRunnerPlugin *plugin )
 {
-    d->loadPlugins();
-    d->m_searchRunnerPlugins << plugin;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        d->loadPlugins( PluginManagerPrivate::SearchRunnerPluginType );
+        d->m_searchRunnerPlugins << plugin;
+    }
     emit searchRunnerPluginsChanged();
 }
 
 QList<const ReverseGeocodingRunnerPlugin *> PluginManager::reverseGeocodingRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker( &d->m_mutex );
+    d->loadPlugins( PluginManagerPrivate::ReverseGeocodingRunnerPluginType );
     return d->m_reverseGeocodingRunnerPlugins;
 }
 
 void PluginManager::addReverseGeocodingRunnerPlugin( const ReverseGeocodingRunnerPlugin *plugin )
 {
-    d->loadPlugins();
-    d->m_reverseGeocodingRunnerPlugins << plugin;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        d->loadPlugins( PluginManagerPrivate::ReverseGeocodingRunnerPluginType );
+        d->m_reverseGeocodingRunnerPlugins << plugin;
+    }
     emit reverseGeocodingRunnerPluginsChanged();
 }
 
 QList<RoutingRunnerPlugin *> PluginManager::routingRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker( &d->m_mutex );
+    d->loadPlugins( PluginManagerPrivate::RoutingRunnerPluginType );
     return d->m_routingRunnerPlugins;
 }
 
 void PluginManager::addRoutingRunnerPlugin( RoutingRunnerPlugin *plugin )
 {
-    d->loadPlugins();
-    d->m_routingRunnerPlugins << plugin;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        d->loadPlugins( PluginManagerPrivate::RoutingRunnerPluginType );
+        d->m_routingRunnerPlugins << plugin;
+    }
     emit routingRunnerPluginsChanged();
 }
 
 QList<const ParseRunnerPlugin *> PluginManager::parsingRunnerPlugins() const
 {
-    d->loadPlugins();
+    QMutexLocker locker( &d->m_mutex );
+    d->loadPlugins( PluginManagerPrivate::ParseRunnerPluginType );
     return d->m_parsingRunnerPlugins;
 }
 
 void PluginManager::addParseRunnerPlugin( const ParseRunnerPlugin *plugin )
 {
-    d->loadPlugins();
-    d->m_parsingRunnerPlugins << plugin;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        d->loadPlugins( PluginManagerPrivate::ParseRunnerPluginType );
+        d->m_parsingRunnerPlugins << plugin;
+    }
     emit parseRunnerPluginsChanged();
 }
 
@@ -172,6 +257,16 @@ void PluginManager::whitelistPlugin(const QString &filename)
     PluginManagerPrivate::m_whitelist << MARBLE_SHARED_LIBRARY_PREFIX + filename;
 }
 
+void PluginManager::setLazyLoading( bool enabled )
+{
+    PluginManagerPrivate::m_lazyLoading = enabled;
+}
+
+bool PluginManager::lazyLoading()
+{
+    return PluginManagerPrivate::m_lazyLoading;
+}
+
 /** Append obj to the given plugins list if it inherits both T and U */
 template<class T, class U>
 bool appendPlugin( QObject * obj, QPluginLoader* &loader, QList<T*> &plugins )
@@ -206,16 +301,153 @@ bool appendPlugin( QObject * obj, QPluginLoader* &loader, QList<const T*> &plugi
     return false;
 }
 
-void PluginManagerPrivate::loadPlugins()
+QString PluginManagerPrivate::pluginIndexPath()
 {
-    if (m_pluginsLoaded)
-    {
+    return MarbleDirs::localPath() + QLatin1String("/plugins.index");
+}
+
+QHash<QString, PluginManagerPrivate::PluginEntry> PluginManagerPrivate::readPluginIndex() const
+{
+    QHash<QString, PluginEntry> index;
+
+    QFile file( pluginIndexPath() );
+    if ( !file.open( QIODevice::ReadOnly ) ) {
+        return index;
+    }
+
+    QDataStream stream( &file );
+    stream.setVersion( QDataStream::Qt_5_3 );
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString marbleVersion;
+    stream >> magic >> version >> marbleVersion;
+    // Plugins of another Marble version are rejected when loading, don't trust their types
+    if ( magic != pluginIndexMagic || version != pluginIndexVersion || marbleVersion != MARBLE_VERSION_STRING ) {
+        return index;
+    }
+
+    qint32 count = 0;
+    stream >> count;
+    for ( qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i ) {
+        PluginEntry entry;
+        stream >> entry.path >> entry.size >> entry.modified >> entry.type >> entry.nameId;
+        index.insert( entry.path, entry );
+    }
+
+    if ( stream.status() != QDataStream::Ok ) {
+        mDebug() << "Ignoring corrupt plugin index:" << file.fileName();
+        index.clear();
+    }
+
+    return index;
+}
+
+void PluginManagerPrivate::writePluginIndex()
+{
+    if ( !m_pluginIndexChanged || !m_lazyLoading ) {
+        return;
+    }
+
+    QSaveFile file( pluginIndexPath() );
+    if ( !file.open( QIODevice::WriteOnly ) ) {
+        mDebug() << "Cannot write plugin index:" << file.fileName();
+        return;
+    }
+
+    QDataStream stream( &file );
+    stream.setVersion( QDataStream::Qt_5_3 );
+    stream << pluginIndexMagic << pluginIndexVersion << MARBLE_VERSION_STRING;
+
+    QList<PluginEntry> entries;
+    for( const PluginEntry &entry: m_pluginEntries ) {
+        if ( entry.type != UnknownPlugin ) {
+            entries << entry;
+        }
+    }
+
+    stream << qint32( entries.size() );
+    for( const PluginEntry &entry: entries ) {
+        stream << entry.path << entry.size << entry.modified << entry.type << entry.nameId;
+    }
+
+    if ( file.commit() ) {
+        m_pluginIndexChanged = false;
+    }
+}
+
+bool PluginManagerPrivate::loadPlugin( PluginEntry &entry )
+{
+    entry.loaded = true;
+
+    QPluginLoader* loader = new QPluginLoader( entry.path );
+
+    QObject * obj = loader->instance();
+    if ( obj && obj->thread() == QThread::currentThread() && obj->thread() != m_parent->thread() ) {
+        // Plugins live in the thread of the manager, no matter which thread loaded them first
+        obj->moveToThread( m_parent->thread() );
+    }
+
+    int type = UnknownPlugin;
+    QString nameId;
+    if ( obj ) {
+        if ( appendPlugin<RenderPlugin, RenderPluginInterface>
+             ( obj, loader, m_renderPluginTemplates ) ) {
+            type = RenderPluginType;
+            nameId = m_renderPluginTemplates.last()->nameId();
+        } else if ( appendPlugin<PositionProviderPlugin, PositionProviderPluginInterface>
+                    ( obj, loader, m_positionProviderPluginTemplates ) ) {
+            type = PositionProviderPluginType;
+            nameId = m_positionProviderPluginTemplates.last()->nameId();
+        } else if ( appendPlugin<SearchRunnerPlugin, SearchRunnerPlugin>
+                    ( obj, loader, m_searchRunnerPlugins ) ) { // intentionally T==U
+            type = SearchRunnerPluginType;
+            nameId = m_searchRunnerPlugins.last()->nameId();
+        } else if ( appendPlugin<ReverseGeocodingRunnerPlugin, ReverseGeocodingRunnerPlugin>
+                    ( obj, loader, m_reverseGeocodingRunnerPlugins ) ) { // intentionally T==U
+            type = ReverseGeocodingRunnerPluginType;
+            nameId = m_reverseGeocodingRunnerPlugins.last()->nameId();
+        } else if ( appendPlugin<RoutingRunnerPlugin, RoutingRunnerPlugin>
+                    ( obj, loader, m_routingRunnerPlugins ) ) { // intentionally T==U
+            type = RoutingRunnerPluginType;
+            nameId = m_routingRunnerPlugins.last()->nameId();
+        } else if ( appendPlugin<ParseRunnerPlugin, ParseRunnerPlugin>
+                    ( obj, loader, m_parsingRunnerPlugins ) ) { // intentionally T==U
+            type = ParseRunnerPluginType;
+            nameId = m_parsingRunnerPlugins.last()->nameId();
+        }
+
+        if ( type == UnknownPlugin ) {
+            qWarning() << "Ignoring the following plugin since it couldn't be loaded:" << entry.path;
+            mDebug() << "Plugin failure:" << entry.path << "is a plugin, but it does not implement the "
+                    << "right interfaces or it was compiled against an old version of Marble. Ignoring it.";
+            delete loader;
+        } else {
+            m_loaders << loader;
+        }
+    } else {
+        qWarning() << "Ignoring to load the following file since it doesn't look like a valid Marble plugin:" << entry.path << endl
+                   << "Reason:" << loader->errorString();
+        delete loader;
+    }
+
+    if ( type != entry.type || nameId != entry.nameId ) {
+        entry.type = type;
+        entry.nameId = nameId;
+        m_pluginIndexChanged = true;
+    }
+
+    return type != UnknownPlugin;
+}
+
+void PluginManagerPrivate::discoverPlugins()
+{
+    if ( m_pluginsDiscovered ) {
         return;
     }
 
     QTime t;
     t.start();
-    mDebug() << "Starting to load Plugins.";
+    mDebug() << "Starting to discover Plugins.";
 
     QStringList pluginFileNameList = MarbleDirs::pluginEntryList( "", QDir::Files );
 
@@ -228,6 +460,8 @@ void PluginManagerPrivate::loadPlugins()
     Q_ASSERT( m_routingRunnerPlugins.isEmpty() );
     Q_ASSERT( m_parsingRunnerPlugins.isEmpty() );
 
+    const QHash<QString, PluginEntry> index = m_lazyLoading ? readPluginIndex() : QHash<QString, PluginEntry>();
+
     bool foundPlugin = false;
     for( const QString &fileName: pluginFileNameList ) {
         QString const baseName = QFileInfo(fileName).baseName();
@@ -250,36 +484,27 @@ void PluginManagerPrivate::loadPlugins()
             continue;
         }
 #endif
-        QPluginLoader* loader = new QPluginLoader( path, m_parent );
-
-        QObject * obj = loader->instance();
-
-        if ( obj ) {
-            bool isPlugin = appendPlugin<RenderPlugin, RenderPluginInterface>
-                       ( obj, loader, m_renderPluginTemplates );
-            isPlugin = isPlugin || appendPlugin<PositionProviderPlugin, PositionProviderPluginInterface>
-                       ( obj, loader, m_positionProviderPluginTemplates );
-            isPlugin = isPlugin || appendPlugin<SearchRunnerPlugin, SearchRunnerPlugin>
-                       ( obj, loader, m_searchRunnerPlugins ); // intentionally T==U
-            isPlugin = isPlugin || appendPlugin<ReverseGeocodingRunnerPlugin, ReverseGeocodingRunnerPlugin>
-                       ( obj, loader, m_reverseGeocodingRunnerPlugins ); // intentionally T==U
-            isPlugin = isPlugin || appendPlugin<RoutingRunnerPlugin, RoutingRunnerPlugin>
-                       ( obj, loader, m_routingRunnerPlugins ); // intentionally T==U
-            isPlugin = isPlugin || appendPlugin<ParseRunnerPlugin, ParseRunnerPlugin>
-                       ( obj, loader, m_parsingRunnerPlugins ); // intentionally T==U
-            if ( !isPlugin ) {
-                qWarning() << "Ignoring the following plugin since it couldn't be loaded:" << path;
-                mDebug() << "Plugin failure:" << path << "is a plugin, but it does not implement the "
-                        << "right interfaces or it was compiled against an old version of Marble. Ignoring it.";
-                delete loader;
-            } else {
-                foundPlugin = true;
-            }
-        } else {
-            qWarning() << "Ignoring to load the following file since it doesn't look like a valid Marble plugin:" << path << endl
-                       << "Reason:" << loader->errorString();
-            delete loader;
+        const QFileInfo fileInfo( path );
+        PluginEntry entry = index.value( path );
+        if ( entry.path.isEmpty()
+             || entry.size != fileInfo.size()
+             || entry.modified != fileInfo.lastModified().toMSecsSinceEpoch() ) {
+            // A new or changed plugin, its type is only known after loading it
+            entry = PluginEntry();
+            entry.path = path;
+            entry.size = fileInfo.size();
+            entry.modified = fileInfo.lastModified().toMSecsSinceEpoch();
+            m_pluginIndexChanged = true;
+        }
+
+        if ( entry.type == UnknownPlugin || !m_lazyLoading ) {
+            loadPlugin( entry );
+        }
+
+        if ( entry.type != UnknownPlugin ) {
+            foundPlugin = true;
         }
+        m_pluginEntries << entry;
     }
 
     if ( !foundPlugin ) {
@@ -300,11 +525,33 @@ void PluginManagerPrivate::loadPlugins()
 #endif
     }
 
-    m_pluginsLoaded = true;
+    m_pluginsDiscovered = true;
+    writePluginIndex();
 
     mDebug() << Q_FUNC_INFO << "Time elapsed:" << t.elapsed() << "ms";
 }
 
+void PluginManagerPrivate::loadPlugins( PluginType type )
+{
+    discoverPlugins();
+
+    if ( m_loadedTypes & ( 1 << type ) ) {
+        return;
+    }
+
+    for ( int i = 0; i < m_pluginEntries.size(); ++i ) {
+        PluginEntry &entry = m_pluginEntries[i];
+        if ( entry.type == type && !entry.loaded ) {
+            mDebug() << "Loading deferred plugin" << entry.nameId << "from" << entry.path;
+            loadPlugin( entry );
+        }
+    }
+    m_loadedTypes |= 1 << type;
+
+    // Loading may reveal a plugin whose type differs from the cached one
+    writePluginIndex();
+}
+
 #ifdef Q_OS_ANDROID
     void PluginManager::installPluginsFromAssets() const
     {
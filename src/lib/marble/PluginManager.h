@@ -39,6 +39,11 @@ class ParseRunnerPlugin;
  * the objects, the PluginManager internally has a list of the plugins
  * which are owned by the PluginManager and destroyed by it.
  *
+ * Plugins are loaded on demand: the first call of e.g. renderPlugins() only
+ * loads the libraries providing render plugins. The type of each plugin file
+ * is remembered across runs, so only new or changed plugin files have to be
+ * loaded to find out what they provide.
+ *
  */
 
 class MARBLE_EXPORT PluginManager : public QObject
@@ -150,6 +155,17 @@ class MARBLE_EXPORT PluginManager : public QObject
      */
     static void whitelistPlugin(const QString &filename);
 
+    /**
+     * @brief setLazyLoading Enable or disable loading plugins on demand. When disabled,
+     * all plugins are loaded on the first request for any of them and the cached
+     * plugin types are ignored. Only affects PluginManager instances which did not load
+     * any plugins yet.
+     * Enabled by default.
+     */
+    static void setLazyLoading( bool enabled );
+
+    static bool lazyLoading();
+
 Q_SIGNALS:
     void renderPluginsChanged();
 
@@ -35,6 +35,10 @@
 namespace Marble
 {
 
+// Long recordings are split into segments of this many points, so that a new
+// point only invalidates the cached geometry of the last segment
+static const int maximumSegmentSize = 10000;
+
 class PositionTrackingPrivate
 {
  public:
@@ -87,6 +91,15 @@ void PositionTrackingPrivate::updatePosition()
             if ( m_currentTrack->size() ) {
                 m_length += m_currentTrack->coordinatesAt(m_currentTrack->size() - 1).sphericalDistanceTo(position);
             }
+            if ( m_currentTrack->size() >= maximumSegmentSize ) {
+                // Continue at the last point to keep the drawn track connected
+                GeoDataTrack *const previousTrack = m_currentTrack;
+                m_currentTrack = new GeoDataTrack;
+                m_currentTrack->addPoint( previousTrack->lastWhen(), previousTrack->coordinatesAt( previousTrack->size() - 1 ) );
+                m_treeModel->removeFeature( m_currentTrackPlacemark );
+                m_trackSegments->append( m_currentTrack );
+                m_treeModel->addFeature( &m_document, m_currentTrackPlacemark );
+            }
             m_currentTrack->addPoint( timestamp, position );
         }
 
@@ -0,0 +1,139 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "ScreenPolygonPool.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPolygonF>
+
+namespace Marble
+{
+
+class ScreenPolygonPoolPrivate
+{
+public:
+    ScreenPolygonPoolPrivate() :
+        m_availablePoints( 0 ),
+        m_allocationCount( 0 )
+    {
+    }
+
+    void recycle( QPolygonF *polygon );
+
+    // A busy frame of a dense city map needs a few thousand polygons of a few
+    // hundred points each. The total bounds the memory held back between frames
+    // to 16 MB of points, however large the frames before were.
+    static const int s_maxAvailable = 16384;
+    static const int s_maxCapacity = 65536;
+    static const qint64 s_maxAvailablePoints = 1 << 20;
+
+    mutable QMutex m_mutex;
+    QVector<QPolygonF*> m_available;
+    qint64 m_availablePoints;
+    qint64 m_allocationCount;
+};
+
+void ScreenPolygonPoolPrivate::recycle( QPolygonF *polygon )
+{
+    if ( !polygon ) {
+        return;
+    }
+
+    const int capacity = polygon->capacity();
+    if ( m_available.size() >= s_maxAvailable || capacity > s_maxCapacity
+         || m_availablePoints + capacity > s_maxAvailablePoints ) {
+        delete polygon;
+        return;
+    }
+
+    // Reserving first keeps older Qt versions from shrinking the buffer in resize()
+    polygon->reserve( capacity );
+    polygon->resize( 0 );
+    m_available << polygon;
+    m_availablePoints += capacity;
+}
+
+ScreenPolygonPool::ScreenPolygonPool() :
+    d( new ScreenPolygonPoolPrivate )
+{
+}
+
+ScreenPolygonPool::~ScreenPolygonPool()
+{
+    qDeleteAll( d->m_available );
+    delete d;
+}
+
+QPolygonF *ScreenPolygonPool::acquire()
+{
+    {
+        QMutexLocker locker( &d->m_mutex );
+        if ( !d->m_available.isEmpty() ) {
+            QPolygonF *const polygon = d->m_available.last();
+            d->m_available.removeLast();
+            d->m_availablePoints -= polygon->capacity();
+            return polygon;
+        }
+        ++d->m_allocationCount;
+    }
+
+    return new QPolygonF;
+}
+
+void ScreenPolygonPool::release( QPolygonF *polygon )
+{
+    QMutexLocker locker( &d->m_mutex );
+    d->recycle( polygon );
+}
+
+void ScreenPolygonPool::release( QVector<QPolygonF*> &polygons )
+{
+    if ( polygons.isEmpty() ) {
+        return;
+    }
+
+    {
+        QMutexLocker locker( &d->m_mutex );
+        for( QPolygonF *polygon: polygons ) {
+            d->recycle( polygon );
+        }
+    }
+    polygons.clear();
+}
+
+void ScreenPolygonPool::clear()
+{
+    QVector<QPolygonF*> available;
+    {
+        QMutexLocker locker( &d->m_mutex );
+        available.swap( d->m_available );
+        d->m_availablePoints = 0;
+    }
+    qDeleteAll( available );
+}
+
+int ScreenPolygonPool::availableCount() const
+{
+    QMutexLocker locker( &d->m_mutex );
+    return d->m_available.size();
+}
+
+qint64 ScreenPolygonPool::availablePointCount() const
+{
+    QMutexLocker locker( &d->m_mutex );
+    return d->m_availablePoints;
+}
+
+qint64 ScreenPolygonPool::allocationCount() const
+{
+    QMutexLocker locker( &d->m_mutex );
+    return d->m_allocationCount;
+}
+
+}
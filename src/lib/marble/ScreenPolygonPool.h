@@ -0,0 +1,92 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_SCREENPOLYGONPOOL_H
+#define MARBLE_SCREENPOLYGONPOOL_H
+
+#include "marble_export.h"
+
+#include <QVector>
+
+class QPolygonF;
+
+namespace Marble
+{
+
+class ScreenPolygonPoolPrivate;
+
+/**
+  * @short Recycles the screen polygons of projected line strings.
+  *
+  * Projecting a line string creates one heap allocated QPolygonF per visible
+  * fragment. Releasing those polygons to the pool of the viewport instead of
+  * deleting them keeps both the objects and their point buffers for the next
+  * frame, so that steady state rendering does not allocate polygons at all.
+  *
+  * Polygons handed out by the pool are ordinary QPolygonF objects: deleting
+  * them instead of releasing them is always safe, e.g. in destructors of
+  * objects which do not know the viewport anymore.
+  *
+  * All methods are thread-safe.
+  */
+class MARBLE_EXPORT ScreenPolygonPool
+{
+public:
+    ScreenPolygonPool();
+
+    /**
+     * Deletes all available polygons. Polygons in use are not affected.
+     */
+    ~ScreenPolygonPool();
+
+    /**
+     * @brief Returns an empty polygon, reusing a released one if possible
+     */
+    QPolygonF *acquire();
+
+    /**
+     * @brief Returns @p polygon to the pool. The pool takes ownership.
+     */
+    void release( QPolygonF *polygon );
+
+    /**
+     * @brief Returns all @p polygons to the pool and clears the vector
+     */
+    void release( QVector<QPolygonF*> &polygons );
+
+    /**
+     * @brief Deletes all available polygons, e.g. after rendering a huge frame
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of polygons ready for reuse
+     */
+    int availableCount() const;
+
+    /**
+     * @brief Returns the number of points the available polygons have room for.
+     * It is bounded, so a single huge frame does not hold back memory for good.
+     */
+    qint64 availablePointCount() const;
+
+    /**
+     * @brief Returns the number of polygons the pool had to allocate because
+     * none could be reused. Stays constant while rendering frames of similar
+     * complexity.
+     */
+    qint64 allocationCount() const;
+
+private:
+    Q_DISABLE_COPY( ScreenPolygonPool )
+    ScreenPolygonPoolPrivate * const d;
+};
+
+}
+
+#endif
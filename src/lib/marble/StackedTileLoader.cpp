@@ -24,6 +24,7 @@
 
 #include "StackedTileLoader.h"
 
+#include "FrameProfiler.h"
 #include "MarbleDebug.h"
 #include "MergedLayerDecorator.h"
 #include "StackedTile.h"
@@ -123,6 +124,7 @@ const StackedTile* StackedTileLoader::loadTile( TileId const & stackedTileId )
     d->m_cacheLock.unlock();
     if ( stackedTile ) {
         stackedTile->setUsed( true );
+        FrameProfiler::count( QStringLiteral( "Tile cache hits" ) );
         return stackedTile;
     }
     // here ends the performance critical section of this method
@@ -134,6 +136,7 @@ const StackedTile* StackedTileLoader::loadTile( TileId const & stackedTileId )
     if ( stackedTile ) {
         Q_ASSERT( stackedTile->used() && "other thread should have marked tile as used" );
         d->m_cacheLock.unlock();
+        FrameProfiler::count( QStringLiteral( "Tile cache hits" ) );
         return stackedTile;
     }
 
@@ -144,6 +147,7 @@ const StackedTile* StackedTileLoader::loadTile( TileId const & stackedTileId )
         stackedTile->setUsed( true );
         d->m_tilesOnDisplay[ stackedTileId ] = stackedTile;
         d->m_cacheLock.unlock();
+        FrameProfiler::count( QStringLiteral( "Tile cache hits" ) );
         return stackedTile;
     }
 
@@ -151,6 +155,7 @@ const StackedTile* StackedTileLoader::loadTile( TileId const & stackedTileId )
     // and place it in the hash from where it will get transferred to the cache
 
     mDebug() << "load tile from disk:" << stackedTileId;
+    FrameProfiler::count( QStringLiteral( "Tile cache misses" ) );
 
     stackedTile = d->m_layerDecorator->loadTile( stackedTileId );
     Q_ASSERT( stackedTile );
@@ -31,6 +31,7 @@
 #include <QFont>
 #include <QImage>
 #include <QDate>
+#include <QElapsedTimer>
 #include <QSet>
 #include <QScreen>
 #include <QHash>
@@ -39,6 +40,53 @@
 namespace Marble
 {
 
+namespace
+{
+
+enum StyleGeometryType {
+    OtherGeometry,
+    PointGeometry,
+    LineStringGeometry,
+    LinearRingGeometry,
+    PolygonGeometry
+};
+
+/**
+ * Identifies the style of a placemark: the visual category plus everything
+ * else createStyle() looks at. Placemarks with equal keys share their style.
+ */
+struct StyleKey
+{
+    GeoDataPlacemark::GeoDataVisualCategory visualCategory;
+    StyleGeometryType geometryType;
+    int tileLevel;
+    int variant;
+    GeoDataRelation::RelationType relationType;
+    QString tags;
+
+    bool operator==(const StyleKey &other) const
+    {
+        return visualCategory == other.visualCategory
+                && geometryType == other.geometryType
+                && tileLevel == other.tileLevel
+                && variant == other.variant
+                && relationType == other.relationType
+                && tags == other.tags;
+    }
+};
+
+inline uint qHash(const StyleKey &key, uint seed = 0)
+{
+    uint hash = qHash(key.tags, seed);
+    hash = 31 * hash + uint(key.visualCategory);
+    hash = 31 * hash + uint(key.geometryType);
+    hash = 31 * hash + uint(key.tileLevel);
+    hash = 31 * hash + uint(key.variant);
+    return 31 * hash + uint(key.relationType);
+}
+
+}
+
 class StyleBuilder::Private
 {
 public:
@@ -82,6 +130,18 @@ public:
                                      const QString& texturePath = QString()) const;
     static GeoDataStyle::Ptr createIconWayStyle(const QColor& color, const QFont &font, const QColor &textColor, double lineWidth=1.0, const QString& iconPath = QString());
 
+    GeoDataStyle::ConstPtr cachedStyle(const StyleParameters &parameters);
+    StyleKey styleKey(const StyleParameters &parameters);
+    static void appendTag(const OsmPlacemarkData &osmData, const QString &key, QString &tags);
+
+    enum TreeSeason {
+        Summer,
+        Autumn,
+        Winter
+    };
+    TreeSeason treeSeason(const GeoDataPlacemark *placemark);
+    int currentMonth();
+
     GeoDataStyle::ConstPtr createRelationStyle(const StyleParameters &parameters);
     GeoDataStyle::ConstPtr createPlacemarkStyle(const StyleParameters &parameters);
     GeoDataStyle::ConstPtr adjustPisteStyle(const StyleParameters &parameters, const GeoDataStyle::ConstPtr &style);
@@ -94,8 +154,18 @@ public:
 
     static QString createPaintLayerItem(const QString &itemType, GeoDataPlacemark::GeoDataVisualCategory visualCategory, const QString &subType = QString());
 
+    /**
+     * Initialize the static lookup tables once. Safe to call from several threads,
+     * e.g. when vector tiles are parsed concurrently.
+     */
     static void initializeOsmVisualCategories();
     static void initializeMinimumZoomLevels();
+    static void initializePopularities();
+
+    static void createOsmVisualCategories();
+    static void createMinimumZoomLevels();
+    static void createPopularities();
+    static QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> createVisualCategoryNames();
 
     int m_maximumZoomLevel;
     QColor m_defaultLabelColor;
@@ -105,7 +175,13 @@ public:
     GeoDataStyle::Ptr m_styleTreeWinter;
     bool m_defaultStyleInitialized;
 
-    QHash<QString, GeoDataStyle::Ptr> m_styleCache;
+    // Vector tiles of a city contain thousands of placemarks sharing a few
+    // hundred distinct styles. Cleared with the default styles.
+    QHash<StyleKey, GeoDataStyle::ConstPtr> m_styleCache;
+    static const int s_maxCachedStyles = 65536;
+
+    int m_currentMonth;
+    QElapsedTimer m_currentMonthTimer;
     QHash<GeoDataPlacemark::GeoDataVisualCategory, GeoDataStyle::Ptr> m_buildingStyles;
     QSet<QLocale::Country> m_oceanianCountries;
 
@@ -114,13 +190,11 @@ public:
      */
     static QHash<OsmTag, GeoDataPlacemark::GeoDataVisualCategory> s_visualCategories;
     static int s_defaultMinZoomLevels[GeoDataPlacemark::LastIndex];
-    static bool s_defaultMinZoomLevelsInitialized;
     static QHash<GeoDataPlacemark::GeoDataVisualCategory, qint64> s_popularities;
 };
 
 QHash<StyleBuilder::OsmTag, GeoDataPlacemark::GeoDataVisualCategory> StyleBuilder::Private::s_visualCategories;
 int StyleBuilder::Private::s_defaultMinZoomLevels[GeoDataPlacemark::LastIndex];
-bool StyleBuilder::Private::s_defaultMinZoomLevelsInitialized = false;
 QHash<GeoDataPlacemark::GeoDataVisualCategory, qint64> StyleBuilder::Private::s_popularities;
 
 StyleBuilder::Private::Private() :
@@ -129,6 +203,7 @@ StyleBuilder::Private::Private() :
     m_defaultFont(QStringLiteral("Sans Serif")),
     m_defaultStyle(),
     m_defaultStyleInitialized(false),
+    m_currentMonth(0),
     m_oceanianCountries(
 {
     QLocale::Australia, QLocale::NewZealand, QLocale::Fiji,
@@ -209,6 +284,174 @@ GeoDataStyle::Ptr StyleBuilder::Private::createIconWayStyle(const QColor &color,
     return style;
 }
 
+GeoDataStyle::ConstPtr StyleBuilder::Private::cachedStyle(const StyleParameters &parameters)
+{
+    // Resetting the default styles also clears the cache
+    if (!m_defaultStyleInitialized) {
+        initializeDefaultStyles();
+    }
+
+    StyleKey const key = styleKey(parameters);
+    auto const iter = m_styleCache.constFind(key);
+    if (iter != m_styleCache.constEnd()) {
+        return iter.value();
+    }
+
+    GeoDataStyle::ConstPtr style;
+    if (parameters.relation) {
+        style = createRelationStyle(parameters);
+    }
+    if (!style) {
+        style = createPlacemarkStyle(parameters);
+    }
+
+    if (m_styleCache.size() >= s_maxCachedStyles) {
+        m_styleCache.clear();
+    }
+    m_styleCache.insert(key, style);
+    return style;
+}
+
+StyleKey StyleBuilder::Private::styleKey(const StyleParameters &parameters)
+{
+    // Needs to cover every input of createRelationStyle() and createPlacemarkStyle()
+    const GeoDataPlacemark *const placemark = parameters.placemark;
+    OsmPlacemarkData const & osmData = placemark->osmData();
+    auto const visualCategory = placemark->visualCategory();
+    const GeoDataGeometry *const geometry = placemark->geometry();
+
+    StyleKey key;
+    key.visualCategory = visualCategory;
+    key.geometryType = OtherGeometry;
+    key.tileLevel = 0;
+    key.variant = 0;
+    key.relationType = GeoDataRelation::UnknownType;
+
+    if (visualCategory == GeoDataPlacemark::Building) {
+        auto const tagMap = osmTagMapping();
+        auto const buildingTag = QStringLiteral("building");
+        for (auto iter = osmData.tagsBegin(), end = osmData.tagsEnd(); iter != end; ++iter) {
+            auto const osmTag = StyleBuilder::OsmTag(iter.key(), iter.value());
+            if (iter.key() != buildingTag && tagMap.contains(osmTag)) {
+                key.variant = tagMap.value(osmTag);
+                return key;
+            }
+        }
+    }
+
+    bool const isHighway = visualCategory >= GeoDataPlacemark::HighwaySteps && visualCategory <= GeoDataPlacemark::HighwayMotorway;
+    bool const isRailway = visualCategory >= GeoDataPlacemark::RailwayRail && visualCategory <= GeoDataPlacemark::RailwayFunicular;
+    if (parameters.relation && (isHighway || isRailway)) {
+        key.relationType = parameters.relation->relationType();
+        appendTag(parameters.relation->osmData(), QStringLiteral("osmc:symbol"), key.tags);
+        appendTag(parameters.relation->osmData(), QStringLiteral("colour"), key.tags);
+        if (isHighway) {
+            key.tileLevel = parameters.tileLevel;
+            appendTag(osmData, QStringLiteral("width"), key.tags);
+            appendTag(osmData, QStringLiteral("oneway"), key.tags);
+        }
+    }
+
+    bool const isPiste = visualCategory == GeoDataPlacemark::PisteDownhill;
+    if (geodata_cast<GeoDataPoint>(geometry)) {
+        key.geometryType = PointGeometry;
+        if (visualCategory == GeoDataPlacemark::NaturalTree) {
+            key.variant = treeSeason(placemark);
+        }
+    } else if (geodata_cast<GeoDataLinearRing>(geometry)) {
+        key.geometryType = LinearRingGeometry;
+        if (visualCategory == GeoDataPlacemark::NaturalWater) {
+            appendTag(osmData, QStringLiteral("salt"), key.tags);
+        } else if (visualCategory == GeoDataPlacemark::Bathymetry) {
+            appendTag(osmData, QStringLiteral("ele"), key.tags);
+        } else if (visualCategory == GeoDataPlacemark::AmenityGraveyard || visualCategory == GeoDataPlacemark::LanduseCemetery) {
+            appendTag(osmData, QStringLiteral("religion"), key.tags);
+        } else if (isPiste) {
+            appendTag(osmData, QStringLiteral("piste:difficulty"), key.tags);
+        }
+        if (presetStyle(visualCategory)->iconStyle().iconPath().isEmpty()) {
+            key.variant = determineVisualCategory(osmData);
+        }
+    } else if (geodata_cast<GeoDataLineString>(geometry)) {
+        key.geometryType = LineStringGeometry;
+        if (visualCategory == GeoDataPlacemark::AdminLevel2) {
+            appendTag(osmData, QStringLiteral("maritime"), key.tags);
+            appendTag(osmData, QStringLiteral("marble:disputed"), key.tags);
+        } else if ((visualCategory >= GeoDataPlacemark::HighwayService &&
+                    visualCategory <= GeoDataPlacemark::HighwayMotorway) ||
+                   visualCategory == GeoDataPlacemark::TransportAirportRunway) {
+            key.tileLevel = parameters.tileLevel;
+            appendTag(osmData, QStringLiteral("access"), key.tags);
+            appendTag(osmData, QStringLiteral("tunnel"), key.tags);
+            if (parameters.tileLevel > 12) {
+                appendTag(osmData, QStringLiteral("width"), key.tags);
+                appendTag(osmData, QStringLiteral("oneway"), key.tags);
+            }
+        } else if (visualCategory >= GeoDataPlacemark::WaterwayCanal && visualCategory <= GeoDataPlacemark::WaterwayStream) {
+            key.tileLevel = parameters.tileLevel;
+            if (parameters.tileLevel > 7) {
+                appendTag(osmData, QStringLiteral("width"), key.tags);
+            }
+        } else if (isPiste) {
+            appendTag(osmData, QStringLiteral("piste:difficulty"), key.tags);
+        }
+    } else if (geodata_cast<GeoDataPolygon>(geometry)) {
+        key.geometryType = PolygonGeometry;
+        if (visualCategory == GeoDataPlacemark::Bathymetry) {
+            appendTag(osmData, QStringLiteral("ele"), key.tags);
+        } else if (isPiste) {
+            appendTag(osmData, QStringLiteral("piste:difficulty"), key.tags);
+        }
+    }
+
+    return key;
+}
+
+void StyleBuilder::Private::appendTag(const OsmPlacemarkData &osmData, const QString &key, QString &tags)
+{
+    auto const iter = osmData.findTag(key);
+    if (iter != osmData.tagsEnd()) {
+        tags += key + QLatin1Char('=') + iter.value() + QLatin1Char('\n');
+    }
+}
+
+StyleBuilder::Private::TreeSeason StyleBuilder::Private::treeSeason(const GeoDataPlacemark *placemark)
+{
+    GeoDataCoordinates const coordinates = placemark->coordinate();
+    qreal const lat = coordinates.latitude(GeoDataCoordinates::Degree);
+    if (qAbs(lat) <= 15) {
+        return Summer;
+    }
+
+    /** @todo Should maybe auto-adjust to MarbleClock at some point */
+    int const month = currentMonth();
+    bool const southernHemisphere = lat < 0;
+    if (southernHemisphere) {
+        if (month >= 3 && month <= 5) {
+            return Autumn;
+        } else if (month >= 6 && month <= 8) {
+            return Winter;
+        }
+    } else {
+        if (month >= 9 && month <= 11) {
+            return Autumn;
+        } else if (month == 12 || month == 1 || month == 2) {
+            return Winter;
+        }
+    }
+    return Summer;
+}
+
+int StyleBuilder::Private::currentMonth()
+{
+    // Looking up the date for each tree of a forest is surprisingly expensive
+    if (!m_currentMonthTimer.isValid() || m_currentMonthTimer.elapsed() > 60 * 1000) {
+        m_currentMonth = QDate::currentDate().month();
+        m_currentMonthTimer.start();
+    }
+    return m_currentMonth;
+}
+
 GeoDataStyle::ConstPtr StyleBuilder::Private::createRelationStyle(const StyleParameters &parameters)
 {
     Q_ASSERT(parameters.relation);
@@ -220,12 +463,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createRelationStyle(const StylePar
         if (parameters.relation->relationType() == GeoDataRelation::RouteHiking &&
             parameters.relation->osmData().containsTagKey(QStringLiteral("osmc:symbol"))) {
             QString const osmcSymbolValue = parameters.relation->osmData().tagValue(QStringLiteral("osmc:symbol"));
-            // Take cached Style instance if possible
-            QString const cacheKey = QStringLiteral("/route/hiking/%1").arg(osmcSymbolValue);
-            if (m_styleCache.contains(cacheKey)) {
-                return m_styleCache[cacheKey];
-            }
-
             auto style = presetStyle(visualCategory);
             auto lineStyle = style->lineStyle();
             if (isHighway) {
@@ -239,7 +476,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createRelationStyle(const StylePar
             newStyle->setLineStyle(lineStyle);
             newStyle->setIconStyle(iconStyle);
             style = newStyle;
-            m_styleCache.insert(cacheKey, newStyle);
             return style;
         }
 
@@ -276,12 +512,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createRelationStyle(const StylePar
                     color = QString(); break;
                 }
             }
-            // Take cached Style instance if possible
-            QString const cacheKey = QStringLiteral("/route/%1/%2").arg(parameters.relation->relationType()).arg(color);
-            if (m_styleCache.contains(cacheKey)) {
-                return m_styleCache[cacheKey];
-            }
-
             auto style = presetStyle(visualCategory);
             auto lineStyle = style->lineStyle();
             if (isHighway) {
@@ -296,7 +526,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createRelationStyle(const StylePar
             }
             newStyle->setLineStyle(lineStyle);
             style = newStyle;
-            m_styleCache.insert(cacheKey, newStyle);
             return style;
         }
     }
@@ -306,7 +535,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createRelationStyle(const StylePar
 GeoDataStyle::ConstPtr StyleBuilder::Private::createPlacemarkStyle(const StyleParameters &parameters)
 {
     const GeoDataPlacemark *const placemark = parameters.placemark;
-    QString styleCacheKey;
 
     OsmPlacemarkData const & osmData = placemark->osmData();
     auto const visualCategory = placemark->visualCategory();
@@ -326,25 +554,15 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createPlacemarkStyle(const StylePa
 
     if (geodata_cast<GeoDataPoint>(placemark->geometry())) {
         if (visualCategory == GeoDataPlacemark::NaturalTree) {
-            GeoDataCoordinates const coordinates = placemark->coordinate();
-            qreal const lat = coordinates.latitude(GeoDataCoordinates::Degree);
-            if (qAbs(lat) > 15) {
-                /** @todo Should maybe auto-adjust to MarbleClock at some point */
-                int const month = QDate::currentDate().month();
-                bool const southernHemisphere = lat < 0;
-                if (southernHemisphere) {
-                    if (month >= 3 && month <= 5) {
-                        style = m_styleTreeAutumn;
-                    } else if (month >= 6 && month <= 8) {
-                        style = m_styleTreeWinter;
-                    }
-                } else {
-                    if (month >= 9 && month <= 11) {
-                        style = m_styleTreeAutumn;
-                    } else if (month == 12 || month == 1 || month == 2) {
-                        style = m_styleTreeWinter;
-                    }
-                }
+            switch (treeSeason(placemark)) {
+            case Autumn:
+                style = m_styleTreeAutumn;
+                break;
+            case Winter:
+                style = m_styleTreeWinter;
+                break;
+            case Summer:
+                break;
             }
         }
     } else if (geodata_cast<GeoDataLinearRing>(placemark->geometry())) {
@@ -425,15 +643,7 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createPlacemarkStyle(const StylePa
         } else if ((visualCategory >= GeoDataPlacemark::HighwayService &&
                     visualCategory <= GeoDataPlacemark::HighwayMotorway) ||
                    visualCategory == GeoDataPlacemark::TransportAirportRunway) {
-            // Take cached Style instance if possible
-            styleCacheKey = QStringLiteral("%1/%2").arg(parameters.tileLevel).arg(visualCategory);
-            if (m_styleCache.contains(styleCacheKey)) {
-                style = m_styleCache[styleCacheKey];
-                return style;
-            }
-
             adjustStyle = true;
-            styleCacheKey = QStringLiteral("%1/%2").arg(parameters.tileLevel).arg(visualCategory);
             adjustWayWidth(parameters, lineStyle);
 
             QString const accessValue = osmData.tagValue(QStringLiteral("access"));
@@ -463,22 +673,12 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createPlacemarkStyle(const StylePa
 
             adjustStyle = true;
 
-            // Take cached Style instance if possible
-            styleCacheKey = QStringLiteral("%1/%2").arg(parameters.tileLevel).arg(visualCategory);
-            if (m_styleCache.contains(styleCacheKey)) {
-                style = m_styleCache[styleCacheKey];
-                return style;
-            }
-
-
             if (parameters.tileLevel <= 3) {
                 lineStyle.setWidth(1);
                 lineStyle.setPhysicalWidth(0.0);
-                styleCacheKey = QStringLiteral("%1/%2").arg(parameters.tileLevel).arg(visualCategory);
             } else if (parameters.tileLevel <= 7) {
                 lineStyle.setWidth(2);
                 lineStyle.setPhysicalWidth(0.0);
-                styleCacheKey = QStringLiteral("%1/%2").arg(parameters.tileLevel).arg(visualCategory);
             } else {
                 QString const widthValue = osmData.tagValue(QStringLiteral("width")).remove(QStringLiteral(" meters")).remove(QStringLiteral(" m"));
                 bool ok;
@@ -496,9 +696,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createPlacemarkStyle(const StylePa
             newStyle->setLabelStyle(labelStyle);
             newStyle->setIconStyle(iconStyle);
             style = newStyle;
-            if (!styleCacheKey.isEmpty()) {
-                m_styleCache.insert(styleCacheKey, newStyle);
-            }
         }
 
 
@@ -534,15 +731,8 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::createPlacemarkStyle(const StylePa
 
 GeoDataStyle::ConstPtr StyleBuilder::Private::adjustPisteStyle(const StyleParameters &parameters, const GeoDataStyle::ConstPtr &style)
 {
-    // Take cached Style instance if possible
     auto const & osmData = parameters.placemark->osmData();
-    auto const visualCategory = parameters.placemark->visualCategory();
     auto const difficulty = osmData.tagValue("piste:difficulty");
-    QString styleCacheKey = QStringLiteral("piste/%1/%2").arg(visualCategory).arg(difficulty);
-    if (m_styleCache.contains(styleCacheKey)) {
-        return m_styleCache[styleCacheKey];
-    }
-
     GeoDataLineStyle lineStyle = style->lineStyle();
 
     auto green = QColor("#006600");;
@@ -607,7 +797,6 @@ GeoDataStyle::ConstPtr StyleBuilder::Private::adjustPisteStyle(const StyleParame
     GeoDataStyle::Ptr newStyle(new GeoDataStyle(*style));
     newStyle->setPolyStyle(polyStyle);
     newStyle->setLineStyle(lineStyle);
-    m_styleCache.insert(styleCacheKey, newStyle);
     return newStyle;
 }
 
@@ -679,6 +868,7 @@ void StyleBuilder::Private::initializeDefaultStyles()
     }
 
     m_defaultStyleInitialized = true;
+    m_styleCache.clear();
 
     QString defaultFamily = m_defaultFont.family();
 
@@ -1334,11 +1524,13 @@ QString StyleBuilder::Private::createPaintLayerItem(const QString &itemType, Geo
 
 void StyleBuilder::Private::initializeOsmVisualCategories()
 {
-    // Only initialize the map once
-    if (!s_visualCategories.isEmpty()) {
-        return;
-    }
+    // Parser threads get here concurrently, the static initializer runs only once
+    static const bool initialized = (createOsmVisualCategories(), true);
+    Q_UNUSED(initialized);
+}
 
+void StyleBuilder::Private::createOsmVisualCategories()
+{
     s_visualCategories[OsmTag("admin_level", "1")]              = GeoDataPlacemark::AdminLevel1;
     s_visualCategories[OsmTag("admin_level", "2")]              = GeoDataPlacemark::AdminLevel2;
     s_visualCategories[OsmTag("admin_level", "3")]              = GeoDataPlacemark::AdminLevel3;
@@ -1715,11 +1907,12 @@ void StyleBuilder::Private::initializeOsmVisualCategories()
 
 void StyleBuilder::Private::initializeMinimumZoomLevels()
 {
-    if (s_defaultMinZoomLevelsInitialized) {
-        return;
-    }
+    static const bool initialized = (createMinimumZoomLevels(), true);
+    Q_UNUSED(initialized);
+}
 
-    s_defaultMinZoomLevelsInitialized = true;
+void StyleBuilder::Private::createMinimumZoomLevels()
+{
     for (int i = 0; i < GeoDataPlacemark::LastIndex; i++) {
         s_defaultMinZoomLevels[i] = -1;
     }
@@ -2075,14 +2268,7 @@ GeoDataStyle::ConstPtr StyleBuilder::createStyle(const StyleParameters &paramete
         return placemark->customStyle();
     }
 
-    if (parameters.relation) {
-        auto style = d->createRelationStyle(parameters);
-        if (style) {
-            return style;
-        }
-    }
-
-    return d->createPlacemarkStyle(parameters);
+    return d->cachedStyle(parameters);
 }
 
 GeoDataStyle::ConstPtr StyleBuilder::Private::presetStyle(GeoDataPlacemark::GeoDataVisualCategory visualCategory) const
@@ -2246,7 +2432,6 @@ void StyleBuilder::reset()
 
 int StyleBuilder::minimumZoomLevel(const GeoDataPlacemark &placemark) const
 {
-    Q_ASSERT(Private::s_defaultMinZoomLevelsInitialized);
     return Private::s_defaultMinZoomLevels[placemark.visualCategory()];
 }
 
@@ -2256,215 +2441,226 @@ int StyleBuilder::minimumZoomLevel(const GeoDataPlacemark::GeoDataVisualCategory
     return Private::s_defaultMinZoomLevels[visualCategory];
 }
 
-qint64 StyleBuilder::popularity(const GeoDataPlacemark *placemark)
+void StyleBuilder::Private::initializePopularities()
+{
+    static const bool initialized = (createPopularities(), true);
+    Q_UNUSED(initialized);
+}
+
+void StyleBuilder::Private::createPopularities()
 {
     qint64 const defaultValue = 100;
     int const offset = 10;
-    if (StyleBuilder::Private::s_popularities.isEmpty()) {
-        QVector<GeoDataPlacemark::GeoDataVisualCategory> popularities;
-        popularities << GeoDataPlacemark::PlaceCityNationalCapital;
-        popularities << GeoDataPlacemark::PlaceTownNationalCapital;
-        popularities << GeoDataPlacemark::PlaceCityCapital;
-        popularities << GeoDataPlacemark::PlaceTownCapital;
-        popularities << GeoDataPlacemark::PlaceCity;
-        popularities << GeoDataPlacemark::PlaceTown;
-        popularities << GeoDataPlacemark::PlaceSuburb;
-        popularities << GeoDataPlacemark::PlaceVillageNationalCapital;
-        popularities << GeoDataPlacemark::PlaceVillageCapital;
-        popularities << GeoDataPlacemark::PlaceVillage;
-        popularities << GeoDataPlacemark::PlaceHamlet;
-        popularities << GeoDataPlacemark::PlaceLocality;
-
-        popularities << GeoDataPlacemark::AmenityEmergencyPhone;
-        popularities << GeoDataPlacemark::AmenityMountainRescue;
-        popularities << GeoDataPlacemark::HealthHospital;
-        popularities << GeoDataPlacemark::AmenityToilets;
-        popularities << GeoDataPlacemark::MoneyAtm;
-        popularities << GeoDataPlacemark::TransportSpeedCamera;
-
-        popularities << GeoDataPlacemark::NaturalPeak;
-        popularities << GeoDataPlacemark::NaturalVolcano;
-
-        popularities << GeoDataPlacemark::AccomodationHotel;
-        popularities << GeoDataPlacemark::AccomodationMotel;
-        popularities << GeoDataPlacemark::AccomodationGuestHouse;
-        popularities << GeoDataPlacemark::AccomodationYouthHostel;
-        popularities << GeoDataPlacemark::AccomodationHostel;
-        popularities << GeoDataPlacemark::AccomodationCamping;
-
-        popularities << GeoDataPlacemark::HealthDentist;
-        popularities << GeoDataPlacemark::HealthDoctors;
-        popularities << GeoDataPlacemark::HealthPharmacy;
-        popularities << GeoDataPlacemark::HealthVeterinary;
-
-        popularities << GeoDataPlacemark::AmenityLibrary;
-        popularities << GeoDataPlacemark::EducationCollege;
-        popularities << GeoDataPlacemark::EducationSchool;
-        popularities << GeoDataPlacemark::EducationUniversity;
-
-        popularities << GeoDataPlacemark::FoodBar;
-        popularities << GeoDataPlacemark::FoodBiergarten;
-        popularities << GeoDataPlacemark::FoodCafe;
-        popularities << GeoDataPlacemark::FoodFastFood;
-        popularities << GeoDataPlacemark::FoodPub;
-        popularities << GeoDataPlacemark::FoodRestaurant;
-
-        popularities << GeoDataPlacemark::MoneyBank;
-
-        popularities << GeoDataPlacemark::HistoricArchaeologicalSite;
-        popularities << GeoDataPlacemark::AmenityCarWash;
-        popularities << GeoDataPlacemark::AmenityEmbassy;
-        popularities << GeoDataPlacemark::LeisureWaterPark;
-        popularities << GeoDataPlacemark::AmenityCommunityCentre;
-        popularities << GeoDataPlacemark::AmenityFountain;
-        popularities << GeoDataPlacemark::AmenityNightClub;
-        popularities << GeoDataPlacemark::AmenityCourtHouse;
-        popularities << GeoDataPlacemark::AmenityFireStation;
-        popularities << GeoDataPlacemark::AmenityShelter;
-        popularities << GeoDataPlacemark::AmenityHuntingStand;
-        popularities << GeoDataPlacemark::AmenityPolice;
-        popularities << GeoDataPlacemark::AmenityPostBox;
-        popularities << GeoDataPlacemark::AmenityPostOffice;
-        popularities << GeoDataPlacemark::AmenityPrison;
-        popularities << GeoDataPlacemark::AmenityRecycling;
-        popularities << GeoDataPlacemark::AmenitySocialFacility;
-        popularities << GeoDataPlacemark::AmenityTelephone;
-        popularities << GeoDataPlacemark::AmenityTownHall;
-        popularities << GeoDataPlacemark::AmenityDrinkingWater;
-        popularities << GeoDataPlacemark::AmenityGraveyard;
-
-        popularities << GeoDataPlacemark::ManmadeBridge;
-        popularities << GeoDataPlacemark::ManmadeLighthouse;
-        popularities << GeoDataPlacemark::ManmadePier;
-        popularities << GeoDataPlacemark::ManmadeWaterTower;
-        popularities << GeoDataPlacemark::ManmadeWindMill;
-        popularities << GeoDataPlacemark::ManmadeCommunicationsTower;
-
-        popularities << GeoDataPlacemark::TourismAttraction;
-        popularities << GeoDataPlacemark::TourismArtwork;
-        popularities << GeoDataPlacemark::HistoricCastle;
-        popularities << GeoDataPlacemark::AmenityCinema;
-        popularities << GeoDataPlacemark::TourismInformation;
-        popularities << GeoDataPlacemark::HistoricMonument;
-        popularities << GeoDataPlacemark::TourismMuseum;
-        popularities << GeoDataPlacemark::HistoricRuins;
-        popularities << GeoDataPlacemark::AmenityTheatre;
-        popularities << GeoDataPlacemark::TourismThemePark;
-        popularities << GeoDataPlacemark::TourismViewPoint;
-        popularities << GeoDataPlacemark::TourismZoo;
-        popularities << GeoDataPlacemark::TourismAlpineHut;
-        popularities << GeoDataPlacemark::TourismWildernessHut;
-
-        popularities << GeoDataPlacemark::HistoricMemorial;
-
-        popularities << GeoDataPlacemark::TransportAerodrome;
-        popularities << GeoDataPlacemark::TransportHelipad;
-        popularities << GeoDataPlacemark::TransportAirportTerminal;
-        popularities << GeoDataPlacemark::TransportBusStation;
-        popularities << GeoDataPlacemark::TransportBusStop;
-        popularities << GeoDataPlacemark::TransportCarShare;
-        popularities << GeoDataPlacemark::TransportFuel;
-        popularities << GeoDataPlacemark::TransportParking;
-        popularities << GeoDataPlacemark::TransportParkingSpace;
-        popularities << GeoDataPlacemark::TransportPlatform;
-        popularities << GeoDataPlacemark::TransportRentalBicycle;
-        popularities << GeoDataPlacemark::TransportRentalCar;
-        popularities << GeoDataPlacemark::TransportRentalSki;
-        popularities << GeoDataPlacemark::TransportTaxiRank;
-        popularities << GeoDataPlacemark::TransportTrainStation;
-        popularities << GeoDataPlacemark::TransportTramStop;
-        popularities << GeoDataPlacemark::TransportBicycleParking;
-        popularities << GeoDataPlacemark::TransportMotorcycleParking;
-        popularities << GeoDataPlacemark::TransportSubwayEntrance;
-        popularities << GeoDataPlacemark::AerialwayStation;
-
-        popularities << GeoDataPlacemark::ShopBeverages;
-        popularities << GeoDataPlacemark::ShopHifi;
-        popularities << GeoDataPlacemark::ShopSupermarket;
-        popularities << GeoDataPlacemark::ShopAlcohol;
-        popularities << GeoDataPlacemark::ShopBakery;
-        popularities << GeoDataPlacemark::ShopButcher;
-        popularities << GeoDataPlacemark::ShopConfectionery;
-        popularities << GeoDataPlacemark::ShopConvenience;
-        popularities << GeoDataPlacemark::ShopGreengrocer;
-        popularities << GeoDataPlacemark::ShopSeafood;
-        popularities << GeoDataPlacemark::ShopDepartmentStore;
-        popularities << GeoDataPlacemark::ShopKiosk;
-        popularities << GeoDataPlacemark::ShopBag;
-        popularities << GeoDataPlacemark::ShopClothes;
-        popularities << GeoDataPlacemark::ShopFashion;
-        popularities << GeoDataPlacemark::ShopJewelry;
-        popularities << GeoDataPlacemark::ShopShoes;
-        popularities << GeoDataPlacemark::ShopVarietyStore;
-        popularities << GeoDataPlacemark::ShopBeauty;
-        popularities << GeoDataPlacemark::ShopChemist;
-        popularities << GeoDataPlacemark::ShopCosmetics;
-        popularities << GeoDataPlacemark::ShopHairdresser;
-        popularities << GeoDataPlacemark::ShopOptician;
-        popularities << GeoDataPlacemark::ShopPerfumery;
-        popularities << GeoDataPlacemark::ShopDoitYourself;
-        popularities << GeoDataPlacemark::ShopFlorist;
-        popularities << GeoDataPlacemark::ShopHardware;
-        popularities << GeoDataPlacemark::ShopFurniture;
-        popularities << GeoDataPlacemark::ShopElectronics;
-        popularities << GeoDataPlacemark::ShopMobilePhone;
-        popularities << GeoDataPlacemark::ShopBicycle;
-        popularities << GeoDataPlacemark::ShopCar;
-        popularities << GeoDataPlacemark::ShopCarRepair;
-        popularities << GeoDataPlacemark::ShopCarParts;
-        popularities << GeoDataPlacemark::ShopMotorcycle;
-        popularities << GeoDataPlacemark::ShopOutdoor;
-        popularities << GeoDataPlacemark::ShopSports;
-        popularities << GeoDataPlacemark::ShopCopy;
-        popularities << GeoDataPlacemark::ShopArt;
-        popularities << GeoDataPlacemark::ShopMusicalInstrument;
-        popularities << GeoDataPlacemark::ShopPhoto;
-        popularities << GeoDataPlacemark::ShopBook;
-        popularities << GeoDataPlacemark::ShopGift;
-        popularities << GeoDataPlacemark::ShopStationery;
-        popularities << GeoDataPlacemark::ShopLaundry;
-        popularities << GeoDataPlacemark::ShopPet;
-        popularities << GeoDataPlacemark::ShopToys;
-        popularities << GeoDataPlacemark::ShopTravelAgency;
-        popularities << GeoDataPlacemark::ShopDeli;
-        popularities << GeoDataPlacemark::ShopTobacco;
-        popularities << GeoDataPlacemark::ShopTea;
-        popularities << GeoDataPlacemark::ShopComputer;
-        popularities << GeoDataPlacemark::ShopGardenCentre;
-        popularities << GeoDataPlacemark::Shop;
-
-        popularities << GeoDataPlacemark::LeisureGolfCourse;
-        popularities << GeoDataPlacemark::LeisureMinigolfCourse;
-        popularities << GeoDataPlacemark::LeisurePark;
-        popularities << GeoDataPlacemark::LeisurePlayground;
-        popularities << GeoDataPlacemark::LeisurePitch;
-        popularities << GeoDataPlacemark::LeisureSportsCentre;
-        popularities << GeoDataPlacemark::LeisureStadium;
-        popularities << GeoDataPlacemark::LeisureTrack;
-        popularities << GeoDataPlacemark::LeisureSwimmingPool;
-
-        popularities << GeoDataPlacemark::CrossingIsland;
-        popularities << GeoDataPlacemark::CrossingRailway;
-        popularities << GeoDataPlacemark::CrossingSignals;
-        popularities << GeoDataPlacemark::CrossingZebra;
-        popularities << GeoDataPlacemark::HighwayTrafficSignals;
-        popularities << GeoDataPlacemark::HighwayElevator;
-
-        popularities << GeoDataPlacemark::BarrierGate;
-        popularities << GeoDataPlacemark::BarrierLiftGate;
-        popularities << GeoDataPlacemark::AmenityBench;
-        popularities << GeoDataPlacemark::NaturalTree;
-        popularities << GeoDataPlacemark::NaturalCave;
-        popularities << GeoDataPlacemark::AmenityWasteBasket;
-        popularities << GeoDataPlacemark::AerialwayPylon;
-        popularities << GeoDataPlacemark::PowerTower;
-
-        int value = defaultValue + offset * popularities.size();
-        for (auto popularity : popularities) {
-            StyleBuilder::Private::s_popularities[popularity] = value;
-            value -= offset;
-        }
+    QVector<GeoDataPlacemark::GeoDataVisualCategory> popularities;
+    popularities << GeoDataPlacemark::PlaceCityNationalCapital;
+    popularities << GeoDataPlacemark::PlaceTownNationalCapital;
+    popularities << GeoDataPlacemark::PlaceCityCapital;
+    popularities << GeoDataPlacemark::PlaceTownCapital;
+    popularities << GeoDataPlacemark::PlaceCity;
+    popularities << GeoDataPlacemark::PlaceTown;
+    popularities << GeoDataPlacemark::PlaceSuburb;
+    popularities << GeoDataPlacemark::PlaceVillageNationalCapital;
+    popularities << GeoDataPlacemark::PlaceVillageCapital;
+    popularities << GeoDataPlacemark::PlaceVillage;
+    popularities << GeoDataPlacemark::PlaceHamlet;
+    popularities << GeoDataPlacemark::PlaceLocality;
+
+    popularities << GeoDataPlacemark::AmenityEmergencyPhone;
+    popularities << GeoDataPlacemark::AmenityMountainRescue;
+    popularities << GeoDataPlacemark::HealthHospital;
+    popularities << GeoDataPlacemark::AmenityToilets;
+    popularities << GeoDataPlacemark::MoneyAtm;
+    popularities << GeoDataPlacemark::TransportSpeedCamera;
+
+    popularities << GeoDataPlacemark::NaturalPeak;
+    popularities << GeoDataPlacemark::NaturalVolcano;
+
+    popularities << GeoDataPlacemark::AccomodationHotel;
+    popularities << GeoDataPlacemark::AccomodationMotel;
+    popularities << GeoDataPlacemark::AccomodationGuestHouse;
+    popularities << GeoDataPlacemark::AccomodationYouthHostel;
+    popularities << GeoDataPlacemark::AccomodationHostel;
+    popularities << GeoDataPlacemark::AccomodationCamping;
+
+    popularities << GeoDataPlacemark::HealthDentist;
+    popularities << GeoDataPlacemark::HealthDoctors;
+    popularities << GeoDataPlacemark::HealthPharmacy;
+    popularities << GeoDataPlacemark::HealthVeterinary;
+
+    popularities << GeoDataPlacemark::AmenityLibrary;
+    popularities << GeoDataPlacemark::EducationCollege;
+    popularities << GeoDataPlacemark::EducationSchool;
+    popularities << GeoDataPlacemark::EducationUniversity;
+
+    popularities << GeoDataPlacemark::FoodBar;
+    popularities << GeoDataPlacemark::FoodBiergarten;
+    popularities << GeoDataPlacemark::FoodCafe;
+    popularities << GeoDataPlacemark::FoodFastFood;
+    popularities << GeoDataPlacemark::FoodPub;
+    popularities << GeoDataPlacemark::FoodRestaurant;
+
+    popularities << GeoDataPlacemark::MoneyBank;
+
+    popularities << GeoDataPlacemark::HistoricArchaeologicalSite;
+    popularities << GeoDataPlacemark::AmenityCarWash;
+    popularities << GeoDataPlacemark::AmenityEmbassy;
+    popularities << GeoDataPlacemark::LeisureWaterPark;
+    popularities << GeoDataPlacemark::AmenityCommunityCentre;
+    popularities << GeoDataPlacemark::AmenityFountain;
+    popularities << GeoDataPlacemark::AmenityNightClub;
+    popularities << GeoDataPlacemark::AmenityCourtHouse;
+    popularities << GeoDataPlacemark::AmenityFireStation;
+    popularities << GeoDataPlacemark::AmenityShelter;
+    popularities << GeoDataPlacemark::AmenityHuntingStand;
+    popularities << GeoDataPlacemark::AmenityPolice;
+    popularities << GeoDataPlacemark::AmenityPostBox;
+    popularities << GeoDataPlacemark::AmenityPostOffice;
+    popularities << GeoDataPlacemark::AmenityPrison;
+    popularities << GeoDataPlacemark::AmenityRecycling;
+    popularities << GeoDataPlacemark::AmenitySocialFacility;
+    popularities << GeoDataPlacemark::AmenityTelephone;
+    popularities << GeoDataPlacemark::AmenityTownHall;
+    popularities << GeoDataPlacemark::AmenityDrinkingWater;
+    popularities << GeoDataPlacemark::AmenityGraveyard;
+
+    popularities << GeoDataPlacemark::ManmadeBridge;
+    popularities << GeoDataPlacemark::ManmadeLighthouse;
+    popularities << GeoDataPlacemark::ManmadePier;
+    popularities << GeoDataPlacemark::ManmadeWaterTower;
+    popularities << GeoDataPlacemark::ManmadeWindMill;
+    popularities << GeoDataPlacemark::ManmadeCommunicationsTower;
+
+    popularities << GeoDataPlacemark::TourismAttraction;
+    popularities << GeoDataPlacemark::TourismArtwork;
+    popularities << GeoDataPlacemark::HistoricCastle;
+    popularities << GeoDataPlacemark::AmenityCinema;
+    popularities << GeoDataPlacemark::TourismInformation;
+    popularities << GeoDataPlacemark::HistoricMonument;
+    popularities << GeoDataPlacemark::TourismMuseum;
+    popularities << GeoDataPlacemark::HistoricRuins;
+    popularities << GeoDataPlacemark::AmenityTheatre;
+    popularities << GeoDataPlacemark::TourismThemePark;
+    popularities << GeoDataPlacemark::TourismViewPoint;
+    popularities << GeoDataPlacemark::TourismZoo;
+    popularities << GeoDataPlacemark::TourismAlpineHut;
+    popularities << GeoDataPlacemark::TourismWildernessHut;
+
+    popularities << GeoDataPlacemark::HistoricMemorial;
+
+    popularities << GeoDataPlacemark::TransportAerodrome;
+    popularities << GeoDataPlacemark::TransportHelipad;
+    popularities << GeoDataPlacemark::TransportAirportTerminal;
+    popularities << GeoDataPlacemark::TransportBusStation;
+    popularities << GeoDataPlacemark::TransportBusStop;
+    popularities << GeoDataPlacemark::TransportCarShare;
+    popularities << GeoDataPlacemark::TransportFuel;
+    popularities << GeoDataPlacemark::TransportParking;
+    popularities << GeoDataPlacemark::TransportParkingSpace;
+    popularities << GeoDataPlacemark::TransportPlatform;
+    popularities << GeoDataPlacemark::TransportRentalBicycle;
+    popularities << GeoDataPlacemark::TransportRentalCar;
+    popularities << GeoDataPlacemark::TransportRentalSki;
+    popularities << GeoDataPlacemark::TransportTaxiRank;
+    popularities << GeoDataPlacemark::TransportTrainStation;
+    popularities << GeoDataPlacemark::TransportTramStop;
+    popularities << GeoDataPlacemark::TransportBicycleParking;
+    popularities << GeoDataPlacemark::TransportMotorcycleParking;
+    popularities << GeoDataPlacemark::TransportSubwayEntrance;
+    popularities << GeoDataPlacemark::AerialwayStation;
+
+    popularities << GeoDataPlacemark::ShopBeverages;
+    popularities << GeoDataPlacemark::ShopHifi;
+    popularities << GeoDataPlacemark::ShopSupermarket;
+    popularities << GeoDataPlacemark::ShopAlcohol;
+    popularities << GeoDataPlacemark::ShopBakery;
+    popularities << GeoDataPlacemark::ShopButcher;
+    popularities << GeoDataPlacemark::ShopConfectionery;
+    popularities << GeoDataPlacemark::ShopConvenience;
+    popularities << GeoDataPlacemark::ShopGreengrocer;
+    popularities << GeoDataPlacemark::ShopSeafood;
+    popularities << GeoDataPlacemark::ShopDepartmentStore;
+    popularities << GeoDataPlacemark::ShopKiosk;
+    popularities << GeoDataPlacemark::ShopBag;
+    popularities << GeoDataPlacemark::ShopClothes;
+    popularities << GeoDataPlacemark::ShopFashion;
+    popularities << GeoDataPlacemark::ShopJewelry;
+    popularities << GeoDataPlacemark::ShopShoes;
+    popularities << GeoDataPlacemark::ShopVarietyStore;
+    popularities << GeoDataPlacemark::ShopBeauty;
+    popularities << GeoDataPlacemark::ShopChemist;
+    popularities << GeoDataPlacemark::ShopCosmetics;
+    popularities << GeoDataPlacemark::ShopHairdresser;
+    popularities << GeoDataPlacemark::ShopOptician;
+    popularities << GeoDataPlacemark::ShopPerfumery;
+    popularities << GeoDataPlacemark::ShopDoitYourself;
+    popularities << GeoDataPlacemark::ShopFlorist;
+    popularities << GeoDataPlacemark::ShopHardware;
+    popularities << GeoDataPlacemark::ShopFurniture;
+    popularities << GeoDataPlacemark::ShopElectronics;
+    popularities << GeoDataPlacemark::ShopMobilePhone;
+    popularities << GeoDataPlacemark::ShopBicycle;
+    popularities << GeoDataPlacemark::ShopCar;
+    popularities << GeoDataPlacemark::ShopCarRepair;
+    popularities << GeoDataPlacemark::ShopCarParts;
+    popularities << GeoDataPlacemark::ShopMotorcycle;
+    popularities << GeoDataPlacemark::ShopOutdoor;
+    popularities << GeoDataPlacemark::ShopSports;
+    popularities << GeoDataPlacemark::ShopCopy;
+    popularities << GeoDataPlacemark::ShopArt;
+    popularities << GeoDataPlacemark::ShopMusicalInstrument;
+    popularities << GeoDataPlacemark::ShopPhoto;
+    popularities << GeoDataPlacemark::ShopBook;
+    popularities << GeoDataPlacemark::ShopGift;
+    popularities << GeoDataPlacemark::ShopStationery;
+    popularities << GeoDataPlacemark::ShopLaundry;
+    popularities << GeoDataPlacemark::ShopPet;
+    popularities << GeoDataPlacemark::ShopToys;
+    popularities << GeoDataPlacemark::ShopTravelAgency;
+    popularities << GeoDataPlacemark::ShopDeli;
+    popularities << GeoDataPlacemark::ShopTobacco;
+    popularities << GeoDataPlacemark::ShopTea;
+    popularities << GeoDataPlacemark::ShopComputer;
+    popularities << GeoDataPlacemark::ShopGardenCentre;
+    popularities << GeoDataPlacemark::Shop;
+
+    popularities << GeoDataPlacemark::LeisureGolfCourse;
+    popularities << GeoDataPlacemark::LeisureMinigolfCourse;
+    popularities << GeoDataPlacemark::LeisurePark;
+    popularities << GeoDataPlacemark::LeisurePlayground;
+    popularities << GeoDataPlacemark::LeisurePitch;
+    popularities << GeoDataPlacemark::LeisureSportsCentre;
+    popularities << GeoDataPlacemark::LeisureStadium;
+    popularities << GeoDataPlacemark::LeisureTrack;
+    popularities << GeoDataPlacemark::LeisureSwimmingPool;
+
+    popularities << GeoDataPlacemark::CrossingIsland;
+    popularities << GeoDataPlacemark::CrossingRailway;
+    popularities << GeoDataPlacemark::CrossingSignals;
+    popularities << GeoDataPlacemark::CrossingZebra;
+    popularities << GeoDataPlacemark::HighwayTrafficSignals;
+    popularities << GeoDataPlacemark::HighwayElevator;
+
+    popularities << GeoDataPlacemark::BarrierGate;
+    popularities << GeoDataPlacemark::BarrierLiftGate;
+    popularities << GeoDataPlacemark::AmenityBench;
+    popularities << GeoDataPlacemark::NaturalTree;
+    popularities << GeoDataPlacemark::NaturalCave;
+    popularities << GeoDataPlacemark::AmenityWasteBasket;
+    popularities << GeoDataPlacemark::AerialwayPylon;
+    popularities << GeoDataPlacemark::PowerTower;
+
+    int value = defaultValue + offset * popularities.size();
+    for (auto popularity : popularities) {
+        s_popularities[popularity] = value;
+        value -= offset;
     }
+}
+
+qint64 StyleBuilder::popularity(const GeoDataPlacemark *placemark)
+{
+    qint64 const defaultValue = 100;
+    int const offset = 10;
+    Private::initializePopularities();
 
     bool const isPrivate = placemark->osmData().containsTag(QStringLiteral("access"), QStringLiteral("private"));
     int const base = defaultValue + (isPrivate ? 0 : offset * StyleBuilder::Private::s_popularities.size());
@@ -2478,370 +2674,374 @@ int StyleBuilder::maximumZoomLevel() const
 
 QString StyleBuilder::visualCategoryName(GeoDataPlacemark::GeoDataVisualCategory category)
 {
-    static QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> visualCategoryNames;
-
-    if (visualCategoryNames.isEmpty()) {
-        visualCategoryNames[GeoDataPlacemark::None] = "None";
-        visualCategoryNames[GeoDataPlacemark::Default] = "Default";
-        visualCategoryNames[GeoDataPlacemark::Unknown] = "Unknown";
-        visualCategoryNames[GeoDataPlacemark::SmallCity] = "SmallCity";
-        visualCategoryNames[GeoDataPlacemark::SmallCountyCapital] = "SmallCountyCapital";
-        visualCategoryNames[GeoDataPlacemark::SmallStateCapital] = "SmallStateCapital";
-        visualCategoryNames[GeoDataPlacemark::SmallNationCapital] = "SmallNationCapital";
-        visualCategoryNames[GeoDataPlacemark::MediumCity] = "MediumCity";
-        visualCategoryNames[GeoDataPlacemark::MediumCountyCapital] = "MediumCountyCapital";
-        visualCategoryNames[GeoDataPlacemark::MediumStateCapital] = "MediumStateCapital";
-        visualCategoryNames[GeoDataPlacemark::MediumNationCapital] = "MediumNationCapital";
-        visualCategoryNames[GeoDataPlacemark::BigCity] = "BigCity";
-        visualCategoryNames[GeoDataPlacemark::BigCountyCapital] = "BigCountyCapital";
-        visualCategoryNames[GeoDataPlacemark::BigStateCapital] = "BigStateCapital";
-        visualCategoryNames[GeoDataPlacemark::BigNationCapital] = "BigNationCapital";
-        visualCategoryNames[GeoDataPlacemark::LargeCity] = "LargeCity";
-        visualCategoryNames[GeoDataPlacemark::LargeCountyCapital] = "LargeCountyCapital";
-        visualCategoryNames[GeoDataPlacemark::LargeStateCapital] = "LargeStateCapital";
-        visualCategoryNames[GeoDataPlacemark::LargeNationCapital] = "LargeNationCapital";
-        visualCategoryNames[GeoDataPlacemark::Nation] = "Nation";
-        visualCategoryNames[GeoDataPlacemark::PlaceCity] = "PlaceCity";
-        visualCategoryNames[GeoDataPlacemark::PlaceCityCapital] = "PlaceCityCapital";
-        visualCategoryNames[GeoDataPlacemark::PlaceCityNationalCapital] = "PlaceCityNationalCapital";
-        visualCategoryNames[GeoDataPlacemark::PlaceSuburb] = "PlaceSuburb";
-        visualCategoryNames[GeoDataPlacemark::PlaceHamlet] = "PlaceHamlet";
-        visualCategoryNames[GeoDataPlacemark::PlaceLocality] = "PlaceLocality";
-        visualCategoryNames[GeoDataPlacemark::PlaceTown] = "PlaceTown";
-        visualCategoryNames[GeoDataPlacemark::PlaceTownCapital] = "PlaceTownCapital";
-        visualCategoryNames[GeoDataPlacemark::PlaceTownNationalCapital] = "PlaceTownNationalCapital";
-        visualCategoryNames[GeoDataPlacemark::PlaceVillage] = "PlaceVillage";
-        visualCategoryNames[GeoDataPlacemark::PlaceVillageCapital] = "PlaceVillageCapital";
-        visualCategoryNames[GeoDataPlacemark::PlaceVillageNationalCapital] = "PlaceVillageNationalCapital";
-        visualCategoryNames[GeoDataPlacemark::Mountain] = "Mountain";
-        visualCategoryNames[GeoDataPlacemark::Volcano] = "Volcano";
-        visualCategoryNames[GeoDataPlacemark::Mons] = "Mons";
-        visualCategoryNames[GeoDataPlacemark::Valley] = "Valley";
-        visualCategoryNames[GeoDataPlacemark::Continent] = "Continent";
-        visualCategoryNames[GeoDataPlacemark::Ocean] = "Ocean";
-        visualCategoryNames[GeoDataPlacemark::OtherTerrain] = "OtherTerrain";
-        visualCategoryNames[GeoDataPlacemark::Crater] = "Crater";
-        visualCategoryNames[GeoDataPlacemark::Mare] = "Mare";
-        visualCategoryNames[GeoDataPlacemark::GeographicPole] = "GeographicPole";
-        visualCategoryNames[GeoDataPlacemark::MagneticPole] = "MagneticPole";
-        visualCategoryNames[GeoDataPlacemark::ShipWreck] = "ShipWreck";
-        visualCategoryNames[GeoDataPlacemark::AirPort] = "AirPort";
-        visualCategoryNames[GeoDataPlacemark::Observatory] = "Observatory";
-        visualCategoryNames[GeoDataPlacemark::MilitaryDangerArea] = "MilitaryDangerArea";
-        visualCategoryNames[GeoDataPlacemark::OsmSite] = "OsmSite";
-        visualCategoryNames[GeoDataPlacemark::Coordinate] = "Coordinate";
-        visualCategoryNames[GeoDataPlacemark::MannedLandingSite] = "MannedLandingSite";
-        visualCategoryNames[GeoDataPlacemark::RoboticRover] = "RoboticRover";
-        visualCategoryNames[GeoDataPlacemark::UnmannedSoftLandingSite] = "UnmannedSoftLandingSite";
-        visualCategoryNames[GeoDataPlacemark::UnmannedHardLandingSite] = "UnmannedHardLandingSite";
-        visualCategoryNames[GeoDataPlacemark::Bookmark] = "Bookmark";
-        visualCategoryNames[GeoDataPlacemark::NaturalWater] = "NaturalWater";
-        visualCategoryNames[GeoDataPlacemark::NaturalReef] = "NaturalReef";
-        visualCategoryNames[GeoDataPlacemark::NaturalWood] = "NaturalWood";
-        visualCategoryNames[GeoDataPlacemark::NaturalBeach] = "NaturalBeach";
-        visualCategoryNames[GeoDataPlacemark::NaturalWetland] = "NaturalWetland";
-        visualCategoryNames[GeoDataPlacemark::NaturalGlacier] = "NaturalGlacier";
-        visualCategoryNames[GeoDataPlacemark::NaturalIceShelf] = "NaturalIceShelf";
-        visualCategoryNames[GeoDataPlacemark::NaturalScrub] = "NaturalScrub";
-        visualCategoryNames[GeoDataPlacemark::NaturalCliff] = "NaturalCliff";
-        visualCategoryNames[GeoDataPlacemark::NaturalHeath] = "NaturalHeath";
-        visualCategoryNames[GeoDataPlacemark::HighwayTrafficSignals] = "HighwayTrafficSignals";
-        visualCategoryNames[GeoDataPlacemark::HighwaySteps] = "HighwaySteps";
-        visualCategoryNames[GeoDataPlacemark::HighwayUnknown] = "HighwayUnknown";
-        visualCategoryNames[GeoDataPlacemark::HighwayPath] = "HighwayPath";
-        visualCategoryNames[GeoDataPlacemark::HighwayFootway] = "HighwayFootway";
-        visualCategoryNames[GeoDataPlacemark::HighwayTrack] = "HighwayTrack";
-        visualCategoryNames[GeoDataPlacemark::HighwayPedestrian] = "HighwayPedestrian";
-        visualCategoryNames[GeoDataPlacemark::HighwayCycleway] = "HighwayCycleway";
-        visualCategoryNames[GeoDataPlacemark::HighwayService] = "HighwayService";
-        visualCategoryNames[GeoDataPlacemark::HighwayRoad] = "HighwayRoad";
-        visualCategoryNames[GeoDataPlacemark::HighwayResidential] = "HighwayResidential";
-        visualCategoryNames[GeoDataPlacemark::HighwayLivingStreet] = "HighwayLivingStreet";
-        visualCategoryNames[GeoDataPlacemark::HighwayUnclassified] = "HighwayUnclassified";
-        visualCategoryNames[GeoDataPlacemark::HighwayTertiaryLink] = "HighwayTertiaryLink";
-        visualCategoryNames[GeoDataPlacemark::HighwayTertiary] = "HighwayTertiary";
-        visualCategoryNames[GeoDataPlacemark::HighwaySecondaryLink] = "HighwaySecondaryLink";
-        visualCategoryNames[GeoDataPlacemark::HighwaySecondary] = "HighwaySecondary";
-        visualCategoryNames[GeoDataPlacemark::HighwayPrimaryLink] = "HighwayPrimaryLink";
-        visualCategoryNames[GeoDataPlacemark::HighwayPrimary] = "HighwayPrimary";
-        visualCategoryNames[GeoDataPlacemark::HighwayRaceway] = "HighwayRaceway";
-        visualCategoryNames[GeoDataPlacemark::HighwayTrunkLink] = "HighwayTrunkLink";
-        visualCategoryNames[GeoDataPlacemark::HighwayTrunk] = "HighwayTrunk";
-        visualCategoryNames[GeoDataPlacemark::HighwayMotorwayLink] = "HighwayMotorwayLink";
-        visualCategoryNames[GeoDataPlacemark::HighwayMotorway] = "HighwayMotorway";
-        visualCategoryNames[GeoDataPlacemark::HighwayCorridor] = "HighwayCorridor";
-        visualCategoryNames[GeoDataPlacemark::HighwayElevator] = "HighwayElevator";
-        visualCategoryNames[GeoDataPlacemark::Building] = "Building";
-        visualCategoryNames[GeoDataPlacemark::AccomodationCamping] = "AccomodationCamping";
-        visualCategoryNames[GeoDataPlacemark::AccomodationHostel] = "AccomodationHostel";
-        visualCategoryNames[GeoDataPlacemark::AccomodationHotel] = "AccomodationHotel";
-        visualCategoryNames[GeoDataPlacemark::AccomodationMotel] = "AccomodationMotel";
-        visualCategoryNames[GeoDataPlacemark::AccomodationYouthHostel] = "AccomodationYouthHostel";
-        visualCategoryNames[GeoDataPlacemark::AccomodationGuestHouse] = "AccomodationGuestHouse";
-        visualCategoryNames[GeoDataPlacemark::AmenityLibrary] = "AmenityLibrary";
-        visualCategoryNames[GeoDataPlacemark::AmenityKindergarten] = "AmenityKindergarten";
-        visualCategoryNames[GeoDataPlacemark::EducationCollege] = "EducationCollege";
-        visualCategoryNames[GeoDataPlacemark::EducationSchool] = "EducationSchool";
-        visualCategoryNames[GeoDataPlacemark::EducationUniversity] = "EducationUniversity";
-        visualCategoryNames[GeoDataPlacemark::FoodBar] = "FoodBar";
-        visualCategoryNames[GeoDataPlacemark::FoodBiergarten] = "FoodBiergarten";
-        visualCategoryNames[GeoDataPlacemark::FoodCafe] = "FoodCafe";
-        visualCategoryNames[GeoDataPlacemark::FoodFastFood] = "FoodFastFood";
-        visualCategoryNames[GeoDataPlacemark::FoodPub] = "FoodPub";
-        visualCategoryNames[GeoDataPlacemark::FoodRestaurant] = "FoodRestaurant";
-        visualCategoryNames[GeoDataPlacemark::HealthDentist] = "HealthDentist";
-        visualCategoryNames[GeoDataPlacemark::HealthDoctors] = "HealthDoctors";
-        visualCategoryNames[GeoDataPlacemark::HealthHospital] = "HealthHospital";
-        visualCategoryNames[GeoDataPlacemark::HealthPharmacy] = "HealthPharmacy";
-        visualCategoryNames[GeoDataPlacemark::HealthVeterinary] = "HealthVeterinary";
-        visualCategoryNames[GeoDataPlacemark::MoneyAtm] = "MoneyAtm";
-        visualCategoryNames[GeoDataPlacemark::MoneyBank] = "MoneyBank";
-        visualCategoryNames[GeoDataPlacemark::AmenityEmbassy] = "AmenityEmbassy";
-        visualCategoryNames[GeoDataPlacemark::AmenityEmergencyPhone] = "AmenityEmergencyPhone";
-        visualCategoryNames[GeoDataPlacemark::AmenityMountainRescue] = "AmenityMountainRescue";
-        visualCategoryNames[GeoDataPlacemark::LeisureWaterPark] = "LeisureWaterPark";
-        visualCategoryNames[GeoDataPlacemark::AmenityCommunityCentre] = "AmenityCommunityCentre";
-        visualCategoryNames[GeoDataPlacemark::AmenityFountain] = "AmenityFountain";
-        visualCategoryNames[GeoDataPlacemark::AmenityNightClub] = "AmenityNightClub";
-        visualCategoryNames[GeoDataPlacemark::AmenityBench] = "AmenityBench";
-        visualCategoryNames[GeoDataPlacemark::AmenityCourtHouse] = "AmenityCourtHouse";
-        visualCategoryNames[GeoDataPlacemark::AmenityFireStation] = "AmenityFireStation";
-        visualCategoryNames[GeoDataPlacemark::AmenityHuntingStand] = "AmenityHuntingStand";
-        visualCategoryNames[GeoDataPlacemark::AmenityPolice] = "AmenityPolice";
-        visualCategoryNames[GeoDataPlacemark::AmenityPostBox] = "AmenityPostBox";
-        visualCategoryNames[GeoDataPlacemark::AmenityPostOffice] = "AmenityPostOffice";
-        visualCategoryNames[GeoDataPlacemark::AmenityPrison] = "AmenityPrison";
-        visualCategoryNames[GeoDataPlacemark::AmenityRecycling] = "AmenityRecycling";
-        visualCategoryNames[GeoDataPlacemark::AmenityShelter] = "AmenityShelter";
-        visualCategoryNames[GeoDataPlacemark::AmenityTelephone] = "AmenityTelephone";
-        visualCategoryNames[GeoDataPlacemark::AmenityToilets] = "AmenityToilets";
-        visualCategoryNames[GeoDataPlacemark::AmenityTownHall] = "AmenityTownHall";
-        visualCategoryNames[GeoDataPlacemark::AmenityWasteBasket] = "AmenityWasteBasket";
-        visualCategoryNames[GeoDataPlacemark::AmenityDrinkingWater] = "AmenityDrinkingWater";
-        visualCategoryNames[GeoDataPlacemark::AmenityGraveyard] = "AmenityGraveyard";
-        visualCategoryNames[GeoDataPlacemark::AmenityChargingStation] = "ChargingStation";
-        visualCategoryNames[GeoDataPlacemark::AmenityCarWash] = "CarWash";
-        visualCategoryNames[GeoDataPlacemark::AmenitySocialFacility] = "SocialFacility";
-        visualCategoryNames[GeoDataPlacemark::BarrierCityWall] = "BarrierCityWall";
-        visualCategoryNames[GeoDataPlacemark::BarrierGate] = "BarrierGate";
-        visualCategoryNames[GeoDataPlacemark::BarrierLiftGate] = "BarrierLiftGate";
-        visualCategoryNames[GeoDataPlacemark::BarrierWall] = "BarrierWall";
-        visualCategoryNames[GeoDataPlacemark::NaturalVolcano] = "NaturalVolcano";
-        visualCategoryNames[GeoDataPlacemark::NaturalPeak] = "NaturalPeak";
-        visualCategoryNames[GeoDataPlacemark::NaturalTree] = "NaturalTree";
-        visualCategoryNames[GeoDataPlacemark::NaturalCave] = "NaturalCave";
-        visualCategoryNames[GeoDataPlacemark::ShopBeverages] = "ShopBeverages";
-        visualCategoryNames[GeoDataPlacemark::ShopHifi] = "ShopHifi";
-        visualCategoryNames[GeoDataPlacemark::ShopSupermarket] = "ShopSupermarket";
-        visualCategoryNames[GeoDataPlacemark::ShopAlcohol] = "ShopAlcohol";
-        visualCategoryNames[GeoDataPlacemark::ShopBakery] = "ShopBakery";
-        visualCategoryNames[GeoDataPlacemark::ShopButcher] = "ShopButcher";
-        visualCategoryNames[GeoDataPlacemark::ShopConfectionery] = "ShopConfectionery";
-        visualCategoryNames[GeoDataPlacemark::ShopConvenience] = "ShopConvenience";
-        visualCategoryNames[GeoDataPlacemark::ShopGreengrocer] = "ShopGreengrocer";
-        visualCategoryNames[GeoDataPlacemark::ShopSeafood] = "ShopSeafood";
-        visualCategoryNames[GeoDataPlacemark::ShopDepartmentStore] = "ShopDepartmentStore";
-        visualCategoryNames[GeoDataPlacemark::ShopKiosk] = "ShopKiosk";
-        visualCategoryNames[GeoDataPlacemark::ShopBag] = "ShopBag";
-        visualCategoryNames[GeoDataPlacemark::ShopClothes] = "ShopClothes";
-        visualCategoryNames[GeoDataPlacemark::ShopFashion] = "ShopFashion";
-        visualCategoryNames[GeoDataPlacemark::ShopJewelry] = "ShopJewelry";
-        visualCategoryNames[GeoDataPlacemark::ShopShoes] = "ShopShoes";
-        visualCategoryNames[GeoDataPlacemark::ShopVarietyStore] = "ShopVarietyStore";
-        visualCategoryNames[GeoDataPlacemark::ShopBeauty] = "ShopBeauty";
-        visualCategoryNames[GeoDataPlacemark::ShopChemist] = "ShopChemist";
-        visualCategoryNames[GeoDataPlacemark::ShopCosmetics] = "ShopCosmetics";
-        visualCategoryNames[GeoDataPlacemark::ShopHairdresser] = "ShopHairdresser";
-        visualCategoryNames[GeoDataPlacemark::ShopOptician] = "ShopOptician";
-        visualCategoryNames[GeoDataPlacemark::ShopPerfumery] = "ShopPerfumery";
-        visualCategoryNames[GeoDataPlacemark::ShopDoitYourself] = "ShopDoitYourself";
-        visualCategoryNames[GeoDataPlacemark::ShopFlorist] = "ShopFlorist";
-        visualCategoryNames[GeoDataPlacemark::ShopHardware] = "ShopHardware";
-        visualCategoryNames[GeoDataPlacemark::ShopFurniture] = "ShopFurniture";
-        visualCategoryNames[GeoDataPlacemark::ShopElectronics] = "ShopElectronics";
-        visualCategoryNames[GeoDataPlacemark::ShopMobilePhone] = "ShopMobilePhone";
-        visualCategoryNames[GeoDataPlacemark::ShopBicycle] = "ShopBicycle";
-        visualCategoryNames[GeoDataPlacemark::ShopCar] = "ShopCar";
-        visualCategoryNames[GeoDataPlacemark::ShopCarRepair] = "ShopCarRepair";
-        visualCategoryNames[GeoDataPlacemark::ShopCarParts] = "ShopCarParts";
-        visualCategoryNames[GeoDataPlacemark::ShopMotorcycle] = "ShopMotorcycle";
-        visualCategoryNames[GeoDataPlacemark::ShopOutdoor] = "ShopOutdoor";
-        visualCategoryNames[GeoDataPlacemark::ShopSports] = "ShopSports";
-        visualCategoryNames[GeoDataPlacemark::ShopCopy] = "ShopCopy";
-        visualCategoryNames[GeoDataPlacemark::ShopArt] = "ShopArt";
-        visualCategoryNames[GeoDataPlacemark::ShopMusicalInstrument] = "ShopMusicalInstrument";
-        visualCategoryNames[GeoDataPlacemark::ShopPhoto] = "ShopPhoto";
-        visualCategoryNames[GeoDataPlacemark::ShopBook] = "ShopBook";
-        visualCategoryNames[GeoDataPlacemark::ShopGift] = "ShopGift";
-        visualCategoryNames[GeoDataPlacemark::ShopStationery] = "ShopStationery";
-        visualCategoryNames[GeoDataPlacemark::ShopLaundry] = "ShopLaundry";
-        visualCategoryNames[GeoDataPlacemark::ShopPet] = "ShopPet";
-        visualCategoryNames[GeoDataPlacemark::ShopToys] = "ShopToys";
-        visualCategoryNames[GeoDataPlacemark::ShopTravelAgency] = "ShopTravelAgency";
-        visualCategoryNames[GeoDataPlacemark::ShopDeli] = "ShopDeli";
-        visualCategoryNames[GeoDataPlacemark::ShopTobacco] = "ShopTobacco";
-        visualCategoryNames[GeoDataPlacemark::ShopTea] = "ShopTea";
-        visualCategoryNames[GeoDataPlacemark::ShopComputer] = "ShopComputer";
-        visualCategoryNames[GeoDataPlacemark::ShopGardenCentre] = "ShopGardenCentre";
-        visualCategoryNames[GeoDataPlacemark::Shop] = "Shop";
-        visualCategoryNames[GeoDataPlacemark::ManmadeBridge] = "ManmadeBridge";
-        visualCategoryNames[GeoDataPlacemark::ManmadeLighthouse] = "ManmadeLighthouse";
-        visualCategoryNames[GeoDataPlacemark::ManmadePier] = "ManmadePier";
-        visualCategoryNames[GeoDataPlacemark::ManmadeWaterTower] = "ManmadeWaterTower";
-        visualCategoryNames[GeoDataPlacemark::ManmadeWindMill] = "ManmadeWindMill";
-        visualCategoryNames[GeoDataPlacemark::ManmadeCommunicationsTower] = "ManmadeCommunicationsTower";
-        visualCategoryNames[GeoDataPlacemark::TourismAttraction] = "TouristAttraction";
-        visualCategoryNames[GeoDataPlacemark::TourismArtwork] = "TouristArtwork";
-        visualCategoryNames[GeoDataPlacemark::HistoricArchaeologicalSite] = "HistoricArchaeologicalSite";
-        visualCategoryNames[GeoDataPlacemark::HistoricCastle] = "HistoricCastle";
-        visualCategoryNames[GeoDataPlacemark::HistoricMemorial] = "HistoricMemorial";
-        visualCategoryNames[GeoDataPlacemark::HistoricMonument] = "HistoricMonument";
-        visualCategoryNames[GeoDataPlacemark::AmenityCinema] = "TouristCinema";
-        visualCategoryNames[GeoDataPlacemark::TourismInformation] = "TouristInformation";
-        visualCategoryNames[GeoDataPlacemark::TourismMuseum] = "TouristMuseum";
-        visualCategoryNames[GeoDataPlacemark::HistoricRuins] = "TouristRuin";
-        visualCategoryNames[GeoDataPlacemark::AmenityTheatre] = "TouristTheatre";
-        visualCategoryNames[GeoDataPlacemark::TourismThemePark] = "TouristThemePark";
-        visualCategoryNames[GeoDataPlacemark::TourismViewPoint] = "TouristViewPoint";
-        visualCategoryNames[GeoDataPlacemark::TourismZoo] = "TouristZoo";
-        visualCategoryNames[GeoDataPlacemark::TourismAlpineHut] = "TouristAlpineHut";
-        visualCategoryNames[GeoDataPlacemark::TourismWildernessHut] = "TouristWildernessHut";
-        visualCategoryNames[GeoDataPlacemark::TransportAerodrome] = "TransportAerodrome";
-        visualCategoryNames[GeoDataPlacemark::TransportHelipad] = "TransportHelipad";
-        visualCategoryNames[GeoDataPlacemark::TransportAirportTerminal] = "TransportAirportTerminal";
-        visualCategoryNames[GeoDataPlacemark::TransportAirportGate] = "TransportAirportGate";
-        visualCategoryNames[GeoDataPlacemark::TransportAirportRunway] = "TransportAirportRunway";
-        visualCategoryNames[GeoDataPlacemark::TransportAirportTaxiway] = "TransportAirportTaxiway";
-        visualCategoryNames[GeoDataPlacemark::TransportAirportApron] = "TransportAirportApron";
-        visualCategoryNames[GeoDataPlacemark::TransportBusStation] = "TransportBusStation";
-        visualCategoryNames[GeoDataPlacemark::TransportBusStop] = "TransportBusStop";
-        visualCategoryNames[GeoDataPlacemark::TransportCarShare] = "TransportCarShare";
-        visualCategoryNames[GeoDataPlacemark::TransportFuel] = "TransportFuel";
-        visualCategoryNames[GeoDataPlacemark::TransportParking] = "TransportParking";
-        visualCategoryNames[GeoDataPlacemark::TransportParkingSpace] = "TransportParkingSpace";
-        visualCategoryNames[GeoDataPlacemark::TransportPlatform] = "TransportPlatform";
-        visualCategoryNames[GeoDataPlacemark::TransportRentalBicycle] = "TransportRentalBicycle";
-        visualCategoryNames[GeoDataPlacemark::TransportRentalCar] = "TransportRentalCar";
-        visualCategoryNames[GeoDataPlacemark::TransportRentalSki] = "TransportRentalSki";
-        visualCategoryNames[GeoDataPlacemark::TransportTaxiRank] = "TransportTaxiRank";
-        visualCategoryNames[GeoDataPlacemark::TransportTrainStation] = "TransportTrainStation";
-        visualCategoryNames[GeoDataPlacemark::TransportTramStop] = "TransportTramStop";
-        visualCategoryNames[GeoDataPlacemark::TransportSpeedCamera] = "TransportSpeedCamera";
-        visualCategoryNames[GeoDataPlacemark::TransportBicycleParking] = "TransportBicycleParking";
-        visualCategoryNames[GeoDataPlacemark::TransportMotorcycleParking] = "TransportMotorcycleParking";
-        visualCategoryNames[GeoDataPlacemark::TransportSubwayEntrance] = "TransportSubwayEntrance";
-        visualCategoryNames[GeoDataPlacemark::ReligionPlaceOfWorship] = "ReligionPlaceOfWorship";
-        visualCategoryNames[GeoDataPlacemark::ReligionBahai] = "ReligionBahai";
-        visualCategoryNames[GeoDataPlacemark::ReligionBuddhist] = "ReligionBuddhist";
-        visualCategoryNames[GeoDataPlacemark::ReligionChristian] = "ReligionChristian";
-        visualCategoryNames[GeoDataPlacemark::ReligionMuslim] = "ReligionMuslim";
-        visualCategoryNames[GeoDataPlacemark::ReligionHindu] = "ReligionHindu";
-        visualCategoryNames[GeoDataPlacemark::ReligionJain] = "ReligionJain";
-        visualCategoryNames[GeoDataPlacemark::ReligionJewish] = "ReligionJewish";
-        visualCategoryNames[GeoDataPlacemark::ReligionShinto] = "ReligionShinto";
-        visualCategoryNames[GeoDataPlacemark::ReligionSikh] = "ReligionSikh";
-        visualCategoryNames[GeoDataPlacemark::ReligionTaoist] = "ReligionTaoist";
-        visualCategoryNames[GeoDataPlacemark::LeisureGolfCourse] = "LeisureGolfCourse";
-        visualCategoryNames[GeoDataPlacemark::LeisureMarina] = "LeisureMarina";
-        visualCategoryNames[GeoDataPlacemark::LeisurePark] = "LeisurePark";
-        visualCategoryNames[GeoDataPlacemark::LeisurePlayground] = "LeisurePlayground";
-        visualCategoryNames[GeoDataPlacemark::LeisurePitch] = "LeisurePitch";
-        visualCategoryNames[GeoDataPlacemark::LeisureSportsCentre] = "LeisureSportsCentre";
-        visualCategoryNames[GeoDataPlacemark::LeisureStadium] = "LeisureStadium";
-        visualCategoryNames[GeoDataPlacemark::LeisureTrack] = "LeisureTrack";
-        visualCategoryNames[GeoDataPlacemark::LeisureSwimmingPool] = "LeisureSwimmingPool";
-        visualCategoryNames[GeoDataPlacemark::LeisureMinigolfCourse] = "LeisureMinigolfCourse";
-        visualCategoryNames[GeoDataPlacemark::LanduseAllotments] = "LanduseAllotments";
-        visualCategoryNames[GeoDataPlacemark::LanduseBasin] = "LanduseBasin";
-        visualCategoryNames[GeoDataPlacemark::LanduseCemetery] = "LanduseCemetery";
-        visualCategoryNames[GeoDataPlacemark::LanduseCommercial] = "LanduseCommercial";
-        visualCategoryNames[GeoDataPlacemark::LanduseConstruction] = "LanduseConstruction";
-        visualCategoryNames[GeoDataPlacemark::LanduseFarmland] = "LanduseFarmland";
-        visualCategoryNames[GeoDataPlacemark::LanduseFarmyard] = "LanduseFarmyard";
-        visualCategoryNames[GeoDataPlacemark::LanduseGarages] = "LanduseGarages";
-        visualCategoryNames[GeoDataPlacemark::LanduseGrass] = "LanduseGrass";
-        visualCategoryNames[GeoDataPlacemark::LanduseIndustrial] = "LanduseIndustrial";
-        visualCategoryNames[GeoDataPlacemark::LanduseLandfill] = "LanduseLandfill";
-        visualCategoryNames[GeoDataPlacemark::LanduseMeadow] = "LanduseMeadow";
-        visualCategoryNames[GeoDataPlacemark::LanduseMilitary] = "LanduseMilitary";
-        visualCategoryNames[GeoDataPlacemark::LanduseQuarry] = "LanduseQuarry";
-        visualCategoryNames[GeoDataPlacemark::LanduseRailway] = "LanduseRailway";
-        visualCategoryNames[GeoDataPlacemark::LanduseReservoir] = "LanduseReservoir";
-        visualCategoryNames[GeoDataPlacemark::LanduseResidential] = "LanduseResidential";
-        visualCategoryNames[GeoDataPlacemark::LanduseRetail] = "LanduseRetail";
-        visualCategoryNames[GeoDataPlacemark::LanduseOrchard] = "LanduseOrchard";
-        visualCategoryNames[GeoDataPlacemark::LanduseVineyard] = "LanduseVineyard";
-        visualCategoryNames[GeoDataPlacemark::RailwayRail] = "RailwayRail";
-        visualCategoryNames[GeoDataPlacemark::RailwayNarrowGauge] = "RailwayNarrowGauge";
-        visualCategoryNames[GeoDataPlacemark::RailwayTram] = "RailwayTram";
-        visualCategoryNames[GeoDataPlacemark::RailwayLightRail] = "RailwayLightRail";
-        visualCategoryNames[GeoDataPlacemark::RailwayAbandoned] = "RailwayAbandoned";
-        visualCategoryNames[GeoDataPlacemark::RailwaySubway] = "RailwaySubway";
-        visualCategoryNames[GeoDataPlacemark::RailwayPreserved] = "RailwayPreserved";
-        visualCategoryNames[GeoDataPlacemark::RailwayMiniature] = "RailwayMiniature";
-        visualCategoryNames[GeoDataPlacemark::RailwayConstruction] = "RailwayConstruction";
-        visualCategoryNames[GeoDataPlacemark::RailwayMonorail] = "RailwayMonorail";
-        visualCategoryNames[GeoDataPlacemark::RailwayFunicular] = "RailwayFunicular";
-        visualCategoryNames[GeoDataPlacemark::PowerTower] = "PowerTower";
-        visualCategoryNames[GeoDataPlacemark::AerialwayStation] = "AerialwayStation";
-        visualCategoryNames[GeoDataPlacemark::AerialwayPylon] = "AerialwayPylon";
-        visualCategoryNames[GeoDataPlacemark::AerialwayCableCar] = "AerialwayCableCar";
-        visualCategoryNames[GeoDataPlacemark::AerialwayGondola] = "AerialwayGondola";
-        visualCategoryNames[GeoDataPlacemark::AerialwayChairLift] = "AerialwayChairLift";
-        visualCategoryNames[GeoDataPlacemark::AerialwayMixedLift] = "AerialwayMixedLift";
-        visualCategoryNames[GeoDataPlacemark::AerialwayDragLift] = "AerialwayDragLift";
-        visualCategoryNames[GeoDataPlacemark::AerialwayTBar] = "AerialwayTBar";
-        visualCategoryNames[GeoDataPlacemark::AerialwayJBar] = "AerialwayJBar";
-        visualCategoryNames[GeoDataPlacemark::AerialwayPlatter] = "AerialwayPlatter";
-        visualCategoryNames[GeoDataPlacemark::AerialwayRopeTow] = "AerialwayRopeTow";
-        visualCategoryNames[GeoDataPlacemark::AerialwayMagicCarpet] = "AerialwayMagicCarpet";
-        visualCategoryNames[GeoDataPlacemark::AerialwayZipLine] = "AerialwayZipLine";
-        visualCategoryNames[GeoDataPlacemark::AerialwayGoods] = "AerialwayGoods";
-        visualCategoryNames[GeoDataPlacemark::PisteDownhill] = "PisteDownhill";
-        visualCategoryNames[GeoDataPlacemark::PisteNordic] = "PisteNordic";
-        visualCategoryNames[GeoDataPlacemark::PisteSkitour] = "PisteSkitour";
-        visualCategoryNames[GeoDataPlacemark::PisteSled] = "PisteSled";
-        visualCategoryNames[GeoDataPlacemark::PisteHike] = "PisteHike";
-        visualCategoryNames[GeoDataPlacemark::PisteSleigh] = "PisteSleigh";
-        visualCategoryNames[GeoDataPlacemark::PisteIceSkate] = "PisteIceSkate";
-        visualCategoryNames[GeoDataPlacemark::PisteSnowPark] = "PisteSnowPark";
-        visualCategoryNames[GeoDataPlacemark::PistePlayground] = "PistePlayground";
-        visualCategoryNames[GeoDataPlacemark::PisteSkiJump] = "PisteSkiJump";
-        visualCategoryNames[GeoDataPlacemark::Satellite] = "Satellite";
-        visualCategoryNames[GeoDataPlacemark::Landmass] = "Landmass";
-        visualCategoryNames[GeoDataPlacemark::UrbanArea] = "UrbanArea";
-        visualCategoryNames[GeoDataPlacemark::InternationalDateLine] = "InternationalDateLine";
-        visualCategoryNames[GeoDataPlacemark::Bathymetry] = "Bathymetry";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel1] = "AdminLevel1";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel2] = "AdminLevel2";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel3] = "AdminLevel3";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel4] = "AdminLevel4";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel5] = "AdminLevel5";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel6] = "AdminLevel6";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel7] = "AdminLevel7";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel8] = "AdminLevel8";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel9] = "AdminLevel9";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel10] = "AdminLevel10";
-        visualCategoryNames[GeoDataPlacemark::AdminLevel11] = "AdminLevel11";
-        visualCategoryNames[GeoDataPlacemark::BoundaryMaritime] = "BoundaryMaritime";
-        visualCategoryNames[GeoDataPlacemark::WaterwayCanal] = "WaterwayCanal";
-        visualCategoryNames[GeoDataPlacemark::WaterwayDitch] = "WaterwayDitch";
-        visualCategoryNames[GeoDataPlacemark::WaterwayDrain] = "WaterwayDrain";
-        visualCategoryNames[GeoDataPlacemark::WaterwayStream] = "WaterwayStream";
-        visualCategoryNames[GeoDataPlacemark::WaterwayRiver] = "WaterwayRiver";
-        visualCategoryNames[GeoDataPlacemark::WaterwayWeir] = "WaterwayWeir";
-        visualCategoryNames[GeoDataPlacemark::CrossingIsland] = "CrossingIsland";
-        visualCategoryNames[GeoDataPlacemark::CrossingRailway] = "CrossingRailway";
-        visualCategoryNames[GeoDataPlacemark::CrossingSignals] = "CrossingSignals";
-        visualCategoryNames[GeoDataPlacemark::CrossingZebra] = "CrossingZebra";
-        visualCategoryNames[GeoDataPlacemark::IndoorDoor] = "IndoorDoor";
-        visualCategoryNames[GeoDataPlacemark::IndoorWall] = "IndoorWall";
-        visualCategoryNames[GeoDataPlacemark::IndoorRoom] = "IndoorRoom";
-        visualCategoryNames[GeoDataPlacemark::LastIndex] = "LastIndex";
-    }
+    static const QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> visualCategoryNames = Private::createVisualCategoryNames();
 
     Q_ASSERT(visualCategoryNames.contains(category));
-    return visualCategoryNames[category];
+    return visualCategoryNames.value(category);
+}
+
+QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> StyleBuilder::Private::createVisualCategoryNames()
+{
+    QHash<GeoDataPlacemark::GeoDataVisualCategory, QString> visualCategoryNames;
+    visualCategoryNames[GeoDataPlacemark::None] = "None";
+    visualCategoryNames[GeoDataPlacemark::Default] = "Default";
+    visualCategoryNames[GeoDataPlacemark::Unknown] = "Unknown";
+    visualCategoryNames[GeoDataPlacemark::SmallCity] = "SmallCity";
+    visualCategoryNames[GeoDataPlacemark::SmallCountyCapital] = "SmallCountyCapital";
+    visualCategoryNames[GeoDataPlacemark::SmallStateCapital] = "SmallStateCapital";
+    visualCategoryNames[GeoDataPlacemark::SmallNationCapital] = "SmallNationCapital";
+    visualCategoryNames[GeoDataPlacemark::MediumCity] = "MediumCity";
+    visualCategoryNames[GeoDataPlacemark::MediumCountyCapital] = "MediumCountyCapital";
+    visualCategoryNames[GeoDataPlacemark::MediumStateCapital] = "MediumStateCapital";
+    visualCategoryNames[GeoDataPlacemark::MediumNationCapital] = "MediumNationCapital";
+    visualCategoryNames[GeoDataPlacemark::BigCity] = "BigCity";
+    visualCategoryNames[GeoDataPlacemark::BigCountyCapital] = "BigCountyCapital";
+    visualCategoryNames[GeoDataPlacemark::BigStateCapital] = "BigStateCapital";
+    visualCategoryNames[GeoDataPlacemark::BigNationCapital] = "BigNationCapital";
+    visualCategoryNames[GeoDataPlacemark::LargeCity] = "LargeCity";
+    visualCategoryNames[GeoDataPlacemark::LargeCountyCapital] = "LargeCountyCapital";
+    visualCategoryNames[GeoDataPlacemark::LargeStateCapital] = "LargeStateCapital";
+    visualCategoryNames[GeoDataPlacemark::LargeNationCapital] = "LargeNationCapital";
+    visualCategoryNames[GeoDataPlacemark::Nation] = "Nation";
+    visualCategoryNames[GeoDataPlacemark::PlaceCity] = "PlaceCity";
+    visualCategoryNames[GeoDataPlacemark::PlaceCityCapital] = "PlaceCityCapital";
+    visualCategoryNames[GeoDataPlacemark::PlaceCityNationalCapital] = "PlaceCityNationalCapital";
+    visualCategoryNames[GeoDataPlacemark::PlaceSuburb] = "PlaceSuburb";
+    visualCategoryNames[GeoDataPlacemark::PlaceHamlet] = "PlaceHamlet";
+    visualCategoryNames[GeoDataPlacemark::PlaceLocality] = "PlaceLocality";
+    visualCategoryNames[GeoDataPlacemark::PlaceTown] = "PlaceTown";
+    visualCategoryNames[GeoDataPlacemark::PlaceTownCapital] = "PlaceTownCapital";
+    visualCategoryNames[GeoDataPlacemark::PlaceTownNationalCapital] = "PlaceTownNationalCapital";
+    visualCategoryNames[GeoDataPlacemark::PlaceVillage] = "PlaceVillage";
+    visualCategoryNames[GeoDataPlacemark::PlaceVillageCapital] = "PlaceVillageCapital";
+    visualCategoryNames[GeoDataPlacemark::PlaceVillageNationalCapital] = "PlaceVillageNationalCapital";
+    visualCategoryNames[GeoDataPlacemark::Mountain] = "Mountain";
+    visualCategoryNames[GeoDataPlacemark::Volcano] = "Volcano";
+    visualCategoryNames[GeoDataPlacemark::Mons] = "Mons";
+    visualCategoryNames[GeoDataPlacemark::Valley] = "Valley";
+    visualCategoryNames[GeoDataPlacemark::Continent] = "Continent";
+    visualCategoryNames[GeoDataPlacemark::Ocean] = "Ocean";
+    visualCategoryNames[GeoDataPlacemark::OtherTerrain] = "OtherTerrain";
+    visualCategoryNames[GeoDataPlacemark::Crater] = "Crater";
+    visualCategoryNames[GeoDataPlacemark::Mare] = "Mare";
+    visualCategoryNames[GeoDataPlacemark::GeographicPole] = "GeographicPole";
+    visualCategoryNames[GeoDataPlacemark::MagneticPole] = "MagneticPole";
+    visualCategoryNames[GeoDataPlacemark::ShipWreck] = "ShipWreck";
+    visualCategoryNames[GeoDataPlacemark::AirPort] = "AirPort";
+    visualCategoryNames[GeoDataPlacemark::Observatory] = "Observatory";
+    visualCategoryNames[GeoDataPlacemark::MilitaryDangerArea] = "MilitaryDangerArea";
+    visualCategoryNames[GeoDataPlacemark::OsmSite] = "OsmSite";
+    visualCategoryNames[GeoDataPlacemark::Coordinate] = "Coordinate";
+    visualCategoryNames[GeoDataPlacemark::MannedLandingSite] = "MannedLandingSite";
+    visualCategoryNames[GeoDataPlacemark::RoboticRover] = "RoboticRover";
+    visualCategoryNames[GeoDataPlacemark::UnmannedSoftLandingSite] = "UnmannedSoftLandingSite";
+    visualCategoryNames[GeoDataPlacemark::UnmannedHardLandingSite] = "UnmannedHardLandingSite";
+    visualCategoryNames[GeoDataPlacemark::Bookmark] = "Bookmark";
+    visualCategoryNames[GeoDataPlacemark::NaturalWater] = "NaturalWater";
+    visualCategoryNames[GeoDataPlacemark::NaturalReef] = "NaturalReef";
+    visualCategoryNames[GeoDataPlacemark::NaturalWood] = "NaturalWood";
+    visualCategoryNames[GeoDataPlacemark::NaturalBeach] = "NaturalBeach";
+    visualCategoryNames[GeoDataPlacemark::NaturalWetland] = "NaturalWetland";
+    visualCategoryNames[GeoDataPlacemark::NaturalGlacier] = "NaturalGlacier";
+    visualCategoryNames[GeoDataPlacemark::NaturalIceShelf] = "NaturalIceShelf";
+    visualCategoryNames[GeoDataPlacemark::NaturalScrub] = "NaturalScrub";
+    visualCategoryNames[GeoDataPlacemark::NaturalCliff] = "NaturalCliff";
+    visualCategoryNames[GeoDataPlacemark::NaturalHeath] = "NaturalHeath";
+    visualCategoryNames[GeoDataPlacemark::HighwayTrafficSignals] = "HighwayTrafficSignals";
+    visualCategoryNames[GeoDataPlacemark::HighwaySteps] = "HighwaySteps";
+    visualCategoryNames[GeoDataPlacemark::HighwayUnknown] = "HighwayUnknown";
+    visualCategoryNames[GeoDataPlacemark::HighwayPath] = "HighwayPath";
+    visualCategoryNames[GeoDataPlacemark::HighwayFootway] = "HighwayFootway";
+    visualCategoryNames[GeoDataPlacemark::HighwayTrack] = "HighwayTrack";
+    visualCategoryNames[GeoDataPlacemark::HighwayPedestrian] = "HighwayPedestrian";
+    visualCategoryNames[GeoDataPlacemark::HighwayCycleway] = "HighwayCycleway";
+    visualCategoryNames[GeoDataPlacemark::HighwayService] = "HighwayService";
+    visualCategoryNames[GeoDataPlacemark::HighwayRoad] = "HighwayRoad";
+    visualCategoryNames[GeoDataPlacemark::HighwayResidential] = "HighwayResidential";
+    visualCategoryNames[GeoDataPlacemark::HighwayLivingStreet] = "HighwayLivingStreet";
+    visualCategoryNames[GeoDataPlacemark::HighwayUnclassified] = "HighwayUnclassified";
+    visualCategoryNames[GeoDataPlacemark::HighwayTertiaryLink] = "HighwayTertiaryLink";
+    visualCategoryNames[GeoDataPlacemark::HighwayTertiary] = "HighwayTertiary";
+    visualCategoryNames[GeoDataPlacemark::HighwaySecondaryLink] = "HighwaySecondaryLink";
+    visualCategoryNames[GeoDataPlacemark::HighwaySecondary] = "HighwaySecondary";
+    visualCategoryNames[GeoDataPlacemark::HighwayPrimaryLink] = "HighwayPrimaryLink";
+    visualCategoryNames[GeoDataPlacemark::HighwayPrimary] = "HighwayPrimary";
+    visualCategoryNames[GeoDataPlacemark::HighwayRaceway] = "HighwayRaceway";
+    visualCategoryNames[GeoDataPlacemark::HighwayTrunkLink] = "HighwayTrunkLink";
+    visualCategoryNames[GeoDataPlacemark::HighwayTrunk] = "HighwayTrunk";
+    visualCategoryNames[GeoDataPlacemark::HighwayMotorwayLink] = "HighwayMotorwayLink";
+    visualCategoryNames[GeoDataPlacemark::HighwayMotorway] = "HighwayMotorway";
+    visualCategoryNames[GeoDataPlacemark::HighwayCorridor] = "HighwayCorridor";
+    visualCategoryNames[GeoDataPlacemark::HighwayElevator] = "HighwayElevator";
+    visualCategoryNames[GeoDataPlacemark::Building] = "Building";
+    visualCategoryNames[GeoDataPlacemark::AccomodationCamping] = "AccomodationCamping";
+    visualCategoryNames[GeoDataPlacemark::AccomodationHostel] = "AccomodationHostel";
+    visualCategoryNames[GeoDataPlacemark::AccomodationHotel] = "AccomodationHotel";
+    visualCategoryNames[GeoDataPlacemark::AccomodationMotel] = "AccomodationMotel";
+    visualCategoryNames[GeoDataPlacemark::AccomodationYouthHostel] = "AccomodationYouthHostel";
+    visualCategoryNames[GeoDataPlacemark::AccomodationGuestHouse] = "AccomodationGuestHouse";
+    visualCategoryNames[GeoDataPlacemark::AmenityLibrary] = "AmenityLibrary";
+    visualCategoryNames[GeoDataPlacemark::AmenityKindergarten] = "AmenityKindergarten";
+    visualCategoryNames[GeoDataPlacemark::EducationCollege] = "EducationCollege";
+    visualCategoryNames[GeoDataPlacemark::EducationSchool] = "EducationSchool";
+    visualCategoryNames[GeoDataPlacemark::EducationUniversity] = "EducationUniversity";
+    visualCategoryNames[GeoDataPlacemark::FoodBar] = "FoodBar";
+    visualCategoryNames[GeoDataPlacemark::FoodBiergarten] = "FoodBiergarten";
+    visualCategoryNames[GeoDataPlacemark::FoodCafe] = "FoodCafe";
+    visualCategoryNames[GeoDataPlacemark::FoodFastFood] = "FoodFastFood";
+    visualCategoryNames[GeoDataPlacemark::FoodPub] = "FoodPub";
+    visualCategoryNames[GeoDataPlacemark::FoodRestaurant] = "FoodRestaurant";
+    visualCategoryNames[GeoDataPlacemark::HealthDentist] = "HealthDentist";
+    visualCategoryNames[GeoDataPlacemark::HealthDoctors] = "HealthDoctors";
+    visualCategoryNames[GeoDataPlacemark::HealthHospital] = "HealthHospital";
+    visualCategoryNames[GeoDataPlacemark::HealthPharmacy] = "HealthPharmacy";
+    visualCategoryNames[GeoDataPlacemark::HealthVeterinary] = "HealthVeterinary";
+    visualCategoryNames[GeoDataPlacemark::MoneyAtm] = "MoneyAtm";
+    visualCategoryNames[GeoDataPlacemark::MoneyBank] = "MoneyBank";
+    visualCategoryNames[GeoDataPlacemark::AmenityEmbassy] = "AmenityEmbassy";
+    visualCategoryNames[GeoDataPlacemark::AmenityEmergencyPhone] = "AmenityEmergencyPhone";
+    visualCategoryNames[GeoDataPlacemark::AmenityMountainRescue] = "AmenityMountainRescue";
+    visualCategoryNames[GeoDataPlacemark::LeisureWaterPark] = "LeisureWaterPark";
+    visualCategoryNames[GeoDataPlacemark::AmenityCommunityCentre] = "AmenityCommunityCentre";
+    visualCategoryNames[GeoDataPlacemark::AmenityFountain] = "AmenityFountain";
+    visualCategoryNames[GeoDataPlacemark::AmenityNightClub] = "AmenityNightClub";
+    visualCategoryNames[GeoDataPlacemark::AmenityBench] = "AmenityBench";
+    visualCategoryNames[GeoDataPlacemark::AmenityCourtHouse] = "AmenityCourtHouse";
+    visualCategoryNames[GeoDataPlacemark::AmenityFireStation] = "AmenityFireStation";
+    visualCategoryNames[GeoDataPlacemark::AmenityHuntingStand] = "AmenityHuntingStand";
+    visualCategoryNames[GeoDataPlacemark::AmenityPolice] = "AmenityPolice";
+    visualCategoryNames[GeoDataPlacemark::AmenityPostBox] = "AmenityPostBox";
+    visualCategoryNames[GeoDataPlacemark::AmenityPostOffice] = "AmenityPostOffice";
+    visualCategoryNames[GeoDataPlacemark::AmenityPrison] = "AmenityPrison";
+    visualCategoryNames[GeoDataPlacemark::AmenityRecycling] = "AmenityRecycling";
+    visualCategoryNames[GeoDataPlacemark::AmenityShelter] = "AmenityShelter";
+    visualCategoryNames[GeoDataPlacemark::AmenityTelephone] = "AmenityTelephone";
+    visualCategoryNames[GeoDataPlacemark::AmenityToilets] = "AmenityToilets";
+    visualCategoryNames[GeoDataPlacemark::AmenityTownHall] = "AmenityTownHall";
+    visualCategoryNames[GeoDataPlacemark::AmenityWasteBasket] = "AmenityWasteBasket";
+    visualCategoryNames[GeoDataPlacemark::AmenityDrinkingWater] = "AmenityDrinkingWater";
+    visualCategoryNames[GeoDataPlacemark::AmenityGraveyard] = "AmenityGraveyard";
+    visualCategoryNames[GeoDataPlacemark::AmenityChargingStation] = "ChargingStation";
+    visualCategoryNames[GeoDataPlacemark::AmenityCarWash] = "CarWash";
+    visualCategoryNames[GeoDataPlacemark::AmenitySocialFacility] = "SocialFacility";
+    visualCategoryNames[GeoDataPlacemark::BarrierCityWall] = "BarrierCityWall";
+    visualCategoryNames[GeoDataPlacemark::BarrierGate] = "BarrierGate";
+    visualCategoryNames[GeoDataPlacemark::BarrierLiftGate] = "BarrierLiftGate";
+    visualCategoryNames[GeoDataPlacemark::BarrierWall] = "BarrierWall";
+    visualCategoryNames[GeoDataPlacemark::NaturalVolcano] = "NaturalVolcano";
+    visualCategoryNames[GeoDataPlacemark::NaturalPeak] = "NaturalPeak";
+    visualCategoryNames[GeoDataPlacemark::NaturalTree] = "NaturalTree";
+    visualCategoryNames[GeoDataPlacemark::NaturalCave] = "NaturalCave";
+    visualCategoryNames[GeoDataPlacemark::ShopBeverages] = "ShopBeverages";
+    visualCategoryNames[GeoDataPlacemark::ShopHifi] = "ShopHifi";
+    visualCategoryNames[GeoDataPlacemark::ShopSupermarket] = "ShopSupermarket";
+    visualCategoryNames[GeoDataPlacemark::ShopAlcohol] = "ShopAlcohol";
+    visualCategoryNames[GeoDataPlacemark::ShopBakery] = "ShopBakery";
+    visualCategoryNames[GeoDataPlacemark::ShopButcher] = "ShopButcher";
+    visualCategoryNames[GeoDataPlacemark::ShopConfectionery] = "ShopConfectionery";
+    visualCategoryNames[GeoDataPlacemark::ShopConvenience] = "ShopConvenience";
+    visualCategoryNames[GeoDataPlacemark::ShopGreengrocer] = "ShopGreengrocer";
+    visualCategoryNames[GeoDataPlacemark::ShopSeafood] = "ShopSeafood";
+    visualCategoryNames[GeoDataPlacemark::ShopDepartmentStore] = "ShopDepartmentStore";
+    visualCategoryNames[GeoDataPlacemark::ShopKiosk] = "ShopKiosk";
+    visualCategoryNames[GeoDataPlacemark::ShopBag] = "ShopBag";
+    visualCategoryNames[GeoDataPlacemark::ShopClothes] = "ShopClothes";
+    visualCategoryNames[GeoDataPlacemark::ShopFashion] = "ShopFashion";
+    visualCategoryNames[GeoDataPlacemark::ShopJewelry] = "ShopJewelry";
+    visualCategoryNames[GeoDataPlacemark::ShopShoes] = "ShopShoes";
+    visualCategoryNames[GeoDataPlacemark::ShopVarietyStore] = "ShopVarietyStore";
+    visualCategoryNames[GeoDataPlacemark::ShopBeauty] = "ShopBeauty";
+    visualCategoryNames[GeoDataPlacemark::ShopChemist] = "ShopChemist";
+    visualCategoryNames[GeoDataPlacemark::ShopCosmetics] = "ShopCosmetics";
+    visualCategoryNames[GeoDataPlacemark::ShopHairdresser] = "ShopHairdresser";
+    visualCategoryNames[GeoDataPlacemark::ShopOptician] = "ShopOptician";
+    visualCategoryNames[GeoDataPlacemark::ShopPerfumery] = "ShopPerfumery";
+    visualCategoryNames[GeoDataPlacemark::ShopDoitYourself] = "ShopDoitYourself";
+    visualCategoryNames[GeoDataPlacemark::ShopFlorist] = "ShopFlorist";
+    visualCategoryNames[GeoDataPlacemark::ShopHardware] = "ShopHardware";
+    visualCategoryNames[GeoDataPlacemark::ShopFurniture] = "ShopFurniture";
+    visualCategoryNames[GeoDataPlacemark::ShopElectronics] = "ShopElectronics";
+    visualCategoryNames[GeoDataPlacemark::ShopMobilePhone] = "ShopMobilePhone";
+    visualCategoryNames[GeoDataPlacemark::ShopBicycle] = "ShopBicycle";
+    visualCategoryNames[GeoDataPlacemark::ShopCar] = "ShopCar";
+    visualCategoryNames[GeoDataPlacemark::ShopCarRepair] = "ShopCarRepair";
+    visualCategoryNames[GeoDataPlacemark::ShopCarParts] = "ShopCarParts";
+    visualCategoryNames[GeoDataPlacemark::ShopMotorcycle] = "ShopMotorcycle";
+    visualCategoryNames[GeoDataPlacemark::ShopOutdoor] = "ShopOutdoor";
+    visualCategoryNames[GeoDataPlacemark::ShopSports] = "ShopSports";
+    visualCategoryNames[GeoDataPlacemark::ShopCopy] = "ShopCopy";
+    visualCategoryNames[GeoDataPlacemark::ShopArt] = "ShopArt";
+    visualCategoryNames[GeoDataPlacemark::ShopMusicalInstrument] = "ShopMusicalInstrument";
+    visualCategoryNames[GeoDataPlacemark::ShopPhoto] = "ShopPhoto";
+    visualCategoryNames[GeoDataPlacemark::ShopBook] = "ShopBook";
+    visualCategoryNames[GeoDataPlacemark::ShopGift] = "ShopGift";
+    visualCategoryNames[GeoDataPlacemark::ShopStationery] = "ShopStationery";
+    visualCategoryNames[GeoDataPlacemark::ShopLaundry] = "ShopLaundry";
+    visualCategoryNames[GeoDataPlacemark::ShopPet] = "ShopPet";
+    visualCategoryNames[GeoDataPlacemark::ShopToys] = "ShopToys";
+    visualCategoryNames[GeoDataPlacemark::ShopTravelAgency] = "ShopTravelAgency";
+    visualCategoryNames[GeoDataPlacemark::ShopDeli] = "ShopDeli";
+    visualCategoryNames[GeoDataPlacemark::ShopTobacco] = "ShopTobacco";
+    visualCategoryNames[GeoDataPlacemark::ShopTea] = "ShopTea";
+    visualCategoryNames[GeoDataPlacemark::ShopComputer] = "ShopComputer";
+    visualCategoryNames[GeoDataPlacemark::ShopGardenCentre] = "ShopGardenCentre";
+    visualCategoryNames[GeoDataPlacemark::Shop] = "Shop";
+    visualCategoryNames[GeoDataPlacemark::ManmadeBridge] = "ManmadeBridge";
+    visualCategoryNames[GeoDataPlacemark::ManmadeLighthouse] = "ManmadeLighthouse";
+    visualCategoryNames[GeoDataPlacemark::ManmadePier] = "ManmadePier";
+    visualCategoryNames[GeoDataPlacemark::ManmadeWaterTower] = "ManmadeWaterTower";
+    visualCategoryNames[GeoDataPlacemark::ManmadeWindMill] = "ManmadeWindMill";
+    visualCategoryNames[GeoDataPlacemark::ManmadeCommunicationsTower] = "ManmadeCommunicationsTower";
+    visualCategoryNames[GeoDataPlacemark::TourismAttraction] = "TouristAttraction";
+    visualCategoryNames[GeoDataPlacemark::TourismArtwork] = "TouristArtwork";
+    visualCategoryNames[GeoDataPlacemark::HistoricArchaeologicalSite] = "HistoricArchaeologicalSite";
+    visualCategoryNames[GeoDataPlacemark::HistoricCastle] = "HistoricCastle";
+    visualCategoryNames[GeoDataPlacemark::HistoricMemorial] = "HistoricMemorial";
+    visualCategoryNames[GeoDataPlacemark::HistoricMonument] = "HistoricMonument";
+    visualCategoryNames[GeoDataPlacemark::AmenityCinema] = "TouristCinema";
+    visualCategoryNames[GeoDataPlacemark::TourismInformation] = "TouristInformation";
+    visualCategoryNames[GeoDataPlacemark::TourismMuseum] = "TouristMuseum";
+    visualCategoryNames[GeoDataPlacemark::HistoricRuins] = "TouristRuin";
+    visualCategoryNames[GeoDataPlacemark::AmenityTheatre] = "TouristTheatre";
+    visualCategoryNames[GeoDataPlacemark::TourismThemePark] = "TouristThemePark";
+    visualCategoryNames[GeoDataPlacemark::TourismViewPoint] = "TouristViewPoint";
+    visualCategoryNames[GeoDataPlacemark::TourismZoo] = "TouristZoo";
+    visualCategoryNames[GeoDataPlacemark::TourismAlpineHut] = "TouristAlpineHut";
+    visualCategoryNames[GeoDataPlacemark::TourismWildernessHut] = "TouristWildernessHut";
+    visualCategoryNames[GeoDataPlacemark::TransportAerodrome] = "TransportAerodrome";
+    visualCategoryNames[GeoDataPlacemark::TransportHelipad] = "TransportHelipad";
+    visualCategoryNames[GeoDataPlacemark::TransportAirportTerminal] = "TransportAirportTerminal";
+    visualCategoryNames[GeoDataPlacemark::TransportAirportGate] = "TransportAirportGate";
+    visualCategoryNames[GeoDataPlacemark::TransportAirportRunway] = "TransportAirportRunway";
+    visualCategoryNames[GeoDataPlacemark::TransportAirportTaxiway] = "TransportAirportTaxiway";
+    visualCategoryNames[GeoDataPlacemark::TransportAirportApron] = "TransportAirportApron";
+    visualCategoryNames[GeoDataPlacemark::TransportBusStation] = "TransportBusStation";
+    visualCategoryNames[GeoDataPlacemark::TransportBusStop] = "TransportBusStop";
+    visualCategoryNames[GeoDataPlacemark::TransportCarShare] = "TransportCarShare";
+    visualCategoryNames[GeoDataPlacemark::TransportFuel] = "TransportFuel";
+    visualCategoryNames[GeoDataPlacemark::TransportParking] = "TransportParking";
+    visualCategoryNames[GeoDataPlacemark::TransportParkingSpace] = "TransportParkingSpace";
+    visualCategoryNames[GeoDataPlacemark::TransportPlatform] = "TransportPlatform";
+    visualCategoryNames[GeoDataPlacemark::TransportRentalBicycle] = "TransportRentalBicycle";
+    visualCategoryNames[GeoDataPlacemark::TransportRentalCar] = "TransportRentalCar";
+    visualCategoryNames[GeoDataPlacemark::TransportRentalSki] = "TransportRentalSki";
+    visualCategoryNames[GeoDataPlacemark::TransportTaxiRank] = "TransportTaxiRank";
+    visualCategoryNames[GeoDataPlacemark::TransportTrainStation] = "TransportTrainStation";
+    visualCategoryNames[GeoDataPlacemark::TransportTramStop] = "TransportTramStop";
+    visualCategoryNames[GeoDataPlacemark::TransportSpeedCamera] = "TransportSpeedCamera";
+    visualCategoryNames[GeoDataPlacemark::TransportBicycleParking] = "TransportBicycleParking";
+    visualCategoryNames[GeoDataPlacemark::TransportMotorcycleParking] = "TransportMotorcycleParking";
+    visualCategoryNames[GeoDataPlacemark::TransportSubwayEntrance] = "TransportSubwayEntrance";
+    visualCategoryNames[GeoDataPlacemark::ReligionPlaceOfWorship] = "ReligionPlaceOfWorship";
+    visualCategoryNames[GeoDataPlacemark::ReligionBahai] = "ReligionBahai";
+    visualCategoryNames[GeoDataPlacemark::ReligionBuddhist] = "ReligionBuddhist";
+    visualCategoryNames[GeoDataPlacemark::ReligionChristian] = "ReligionChristian";
+    visualCategoryNames[GeoDataPlacemark::ReligionMuslim] = "ReligionMuslim";
+    visualCategoryNames[GeoDataPlacemark::ReligionHindu] = "ReligionHindu";
+    visualCategoryNames[GeoDataPlacemark::ReligionJain] = "ReligionJain";
+    visualCategoryNames[GeoDataPlacemark::ReligionJewish] = "ReligionJewish";
+    visualCategoryNames[GeoDataPlacemark::ReligionShinto] = "ReligionShinto";
+    visualCategoryNames[GeoDataPlacemark::ReligionSikh] = "ReligionSikh";
+    visualCategoryNames[GeoDataPlacemark::ReligionTaoist] = "ReligionTaoist";
+    visualCategoryNames[GeoDataPlacemark::LeisureGolfCourse] = "LeisureGolfCourse";
+    visualCategoryNames[GeoDataPlacemark::LeisureMarina] = "LeisureMarina";
+    visualCategoryNames[GeoDataPlacemark::LeisurePark] = "LeisurePark";
+    visualCategoryNames[GeoDataPlacemark::LeisurePlayground] = "LeisurePlayground";
+    visualCategoryNames[GeoDataPlacemark::LeisurePitch] = "LeisurePitch";
+    visualCategoryNames[GeoDataPlacemark::LeisureSportsCentre] = "LeisureSportsCentre";
+    visualCategoryNames[GeoDataPlacemark::LeisureStadium] = "LeisureStadium";
+    visualCategoryNames[GeoDataPlacemark::LeisureTrack] = "LeisureTrack";
+    visualCategoryNames[GeoDataPlacemark::LeisureSwimmingPool] = "LeisureSwimmingPool";
+    visualCategoryNames[GeoDataPlacemark::LeisureMinigolfCourse] = "LeisureMinigolfCourse";
+    visualCategoryNames[GeoDataPlacemark::LanduseAllotments] = "LanduseAllotments";
+    visualCategoryNames[GeoDataPlacemark::LanduseBasin] = "LanduseBasin";
+    visualCategoryNames[GeoDataPlacemark::LanduseCemetery] = "LanduseCemetery";
+    visualCategoryNames[GeoDataPlacemark::LanduseCommercial] = "LanduseCommercial";
+    visualCategoryNames[GeoDataPlacemark::LanduseConstruction] = "LanduseConstruction";
+    visualCategoryNames[GeoDataPlacemark::LanduseFarmland] = "LanduseFarmland";
+    visualCategoryNames[GeoDataPlacemark::LanduseFarmyard] = "LanduseFarmyard";
+    visualCategoryNames[GeoDataPlacemark::LanduseGarages] = "LanduseGarages";
+    visualCategoryNames[GeoDataPlacemark::LanduseGrass] = "LanduseGrass";
+    visualCategoryNames[GeoDataPlacemark::LanduseIndustrial] = "LanduseIndustrial";
+    visualCategoryNames[GeoDataPlacemark::LanduseLandfill] = "LanduseLandfill";
+    visualCategoryNames[GeoDataPlacemark::LanduseMeadow] = "LanduseMeadow";
+    visualCategoryNames[GeoDataPlacemark::LanduseMilitary] = "LanduseMilitary";
+    visualCategoryNames[GeoDataPlacemark::LanduseQuarry] = "LanduseQuarry";
+    visualCategoryNames[GeoDataPlacemark::LanduseRailway] = "LanduseRailway";
+    visualCategoryNames[GeoDataPlacemark::LanduseReservoir] = "LanduseReservoir";
+    visualCategoryNames[GeoDataPlacemark::LanduseResidential] = "LanduseResidential";
+    visualCategoryNames[GeoDataPlacemark::LanduseRetail] = "LanduseRetail";
+    visualCategoryNames[GeoDataPlacemark::LanduseOrchard] = "LanduseOrchard";
+    visualCategoryNames[GeoDataPlacemark::LanduseVineyard] = "LanduseVineyard";
+    visualCategoryNames[GeoDataPlacemark::RailwayRail] = "RailwayRail";
+    visualCategoryNames[GeoDataPlacemark::RailwayNarrowGauge] = "RailwayNarrowGauge";
+    visualCategoryNames[GeoDataPlacemark::RailwayTram] = "RailwayTram";
+    visualCategoryNames[GeoDataPlacemark::RailwayLightRail] = "RailwayLightRail";
+    visualCategoryNames[GeoDataPlacemark::RailwayAbandoned] = "RailwayAbandoned";
+    visualCategoryNames[GeoDataPlacemark::RailwaySubway] = "RailwaySubway";
+    visualCategoryNames[GeoDataPlacemark::RailwayPreserved] = "RailwayPreserved";
+    visualCategoryNames[GeoDataPlacemark::RailwayMiniature] = "RailwayMiniature";
+    visualCategoryNames[GeoDataPlacemark::RailwayConstruction] = "RailwayConstruction";
+    visualCategoryNames[GeoDataPlacemark::RailwayMonorail] = "RailwayMonorail";
+    visualCategoryNames[GeoDataPlacemark::RailwayFunicular] = "RailwayFunicular";
+    visualCategoryNames[GeoDataPlacemark::PowerTower] = "PowerTower";
+    visualCategoryNames[GeoDataPlacemark::AerialwayStation] = "AerialwayStation";
+    visualCategoryNames[GeoDataPlacemark::AerialwayPylon] = "AerialwayPylon";
+    visualCategoryNames[GeoDataPlacemark::AerialwayCableCar] = "AerialwayCableCar";
+    visualCategoryNames[GeoDataPlacemark::AerialwayGondola] = "AerialwayGondola";
+    visualCategoryNames[GeoDataPlacemark::AerialwayChairLift] = "AerialwayChairLift";
+    visualCategoryNames[GeoDataPlacemark::AerialwayMixedLift] = "AerialwayMixedLift";
+    visualCategoryNames[GeoDataPlacemark::AerialwayDragLift] = "AerialwayDragLift";
+    visualCategoryNames[GeoDataPlacemark::AerialwayTBar] = "AerialwayTBar";
+    visualCategoryNames[GeoDataPlacemark::AerialwayJBar] = "AerialwayJBar";
+    visualCategoryNames[GeoDataPlacemark::AerialwayPlatter] = "AerialwayPlatter";
+    visualCategoryNames[GeoDataPlacemark::AerialwayRopeTow] = "AerialwayRopeTow";
+    visualCategoryNames[GeoDataPlacemark::AerialwayMagicCarpet] = "AerialwayMagicCarpet";
+    visualCategoryNames[GeoDataPlacemark::AerialwayZipLine] = "AerialwayZipLine";
+    visualCategoryNames[GeoDataPlacemark::AerialwayGoods] = "AerialwayGoods";
+    visualCategoryNames[GeoDataPlacemark::PisteDownhill] = "PisteDownhill";
+    visualCategoryNames[GeoDataPlacemark::PisteNordic] = "PisteNordic";
+    visualCategoryNames[GeoDataPlacemark::PisteSkitour] = "PisteSkitour";
+    visualCategoryNames[GeoDataPlacemark::PisteSled] = "PisteSled";
+    visualCategoryNames[GeoDataPlacemark::PisteHike] = "PisteHike";
+    visualCategoryNames[GeoDataPlacemark::PisteSleigh] = "PisteSleigh";
+    visualCategoryNames[GeoDataPlacemark::PisteIceSkate] = "PisteIceSkate";
+    visualCategoryNames[GeoDataPlacemark::PisteSnowPark] = "PisteSnowPark";
+    visualCategoryNames[GeoDataPlacemark::PistePlayground] = "PistePlayground";
+    visualCategoryNames[GeoDataPlacemark::PisteSkiJump] = "PisteSkiJump";
+    visualCategoryNames[GeoDataPlacemark::Satellite] = "Satellite";
+    visualCategoryNames[GeoDataPlacemark::Landmass] = "Landmass";
+    visualCategoryNames[GeoDataPlacemark::UrbanArea] = "UrbanArea";
+    visualCategoryNames[GeoDataPlacemark::InternationalDateLine] = "InternationalDateLine";
+    visualCategoryNames[GeoDataPlacemark::Bathymetry] = "Bathymetry";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel1] = "AdminLevel1";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel2] = "AdminLevel2";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel3] = "AdminLevel3";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel4] = "AdminLevel4";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel5] = "AdminLevel5";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel6] = "AdminLevel6";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel7] = "AdminLevel7";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel8] = "AdminLevel8";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel9] = "AdminLevel9";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel10] = "AdminLevel10";
+    visualCategoryNames[GeoDataPlacemark::AdminLevel11] = "AdminLevel11";
+    visualCategoryNames[GeoDataPlacemark::BoundaryMaritime] = "BoundaryMaritime";
+    visualCategoryNames[GeoDataPlacemark::WaterwayCanal] = "WaterwayCanal";
+    visualCategoryNames[GeoDataPlacemark::WaterwayDitch] = "WaterwayDitch";
+    visualCategoryNames[GeoDataPlacemark::WaterwayDrain] = "WaterwayDrain";
+    visualCategoryNames[GeoDataPlacemark::WaterwayStream] = "WaterwayStream";
+    visualCategoryNames[GeoDataPlacemark::WaterwayRiver] = "WaterwayRiver";
+    visualCategoryNames[GeoDataPlacemark::WaterwayWeir] = "WaterwayWeir";
+    visualCategoryNames[GeoDataPlacemark::CrossingIsland] = "CrossingIsland";
+    visualCategoryNames[GeoDataPlacemark::CrossingRailway] = "CrossingRailway";
+    visualCategoryNames[GeoDataPlacemark::CrossingSignals] = "CrossingSignals";
+    visualCategoryNames[GeoDataPlacemark::CrossingZebra] = "CrossingZebra";
+    visualCategoryNames[GeoDataPlacemark::IndoorDoor] = "IndoorDoor";
+    visualCategoryNames[GeoDataPlacemark::IndoorWall] = "IndoorWall";
+    visualCategoryNames[GeoDataPlacemark::IndoorRoom] = "IndoorRoom";
+    visualCategoryNames[GeoDataPlacemark::LastIndex] = "LastIndex";
+
+    return visualCategoryNames;
 }
 
 QHash<StyleBuilder::OsmTag, GeoDataPlacemark::GeoDataVisualCategory> StyleBuilder::osmTagMapping()
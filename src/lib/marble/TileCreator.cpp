@@ -14,22 +14,59 @@
 
 #include <cmath>
 
+#include <QBuffer>
 #include <QDir>
+#include <QFile>
+#include <QFuture>
 #include <QRect>
 #include <QSize>
+#include <QThreadPool>
 #include <QVector>
 #include <QApplication>
 #include <QImage>
 #include <QPainter>
+#include <QtConcurrentRun>
 
 #include "MarbleGlobal.h"
 #include "MarbleDirs.h"
 #include "MarbleDebug.h"
+#include "MarbleZipWriter.h"
 #include "TileLoaderHelper.h"
 
 namespace Marble
 {
 
+namespace
+{
+
+/**
+ * Shrinks four child tiles into their parent tile by taking every second pixel.
+ * Pixels are copied rather than interpolated since some tile sets, like SRTM
+ * data, store values in the color channels.
+ */
+template<typename Pixel>
+void reduceTiles( const QImage &topLeft, const QImage &topRight,
+                  const QImage &bottomLeft, const QImage &bottomRight, QImage &tile )
+{
+    const int size = tile.width();
+    const int half = size / 2;
+    for ( int y = 0; y < size; ++y ) {
+        const bool top = y < half;
+        const int sourceY = 2 * ( top ? y : y - half );
+        const Pixel *leftLine = reinterpret_cast<const Pixel *>( ( top ? topLeft : bottomLeft ).constScanLine( sourceY ) );
+        const Pixel *rightLine = reinterpret_cast<const Pixel *>( ( top ? topRight : bottomRight ).constScanLine( sourceY ) );
+        Pixel *destLine = reinterpret_cast<Pixel *>( tile.scanLine( y ) );
+        for ( int x = 0; x < half; ++x ) {
+            destLine[x] = leftLine[2 * x];
+        }
+        for ( int x = half; x < size; ++x ) {
+            destLine[x] = rightLine[2 * ( x - half )];
+        }
+    }
+}
+
+}
+
 class TileCreatorPrivate
 {
  public:
@@ -41,13 +78,19 @@ class TileCreatorPrivate
          m_tileFormat( "jpg" ),
          m_resume( false ),
          m_verify( false ),
-         m_source( source )
+         m_source( source ),
+         m_archive( nullptr ),
+         m_writtenTileCount( 0 )
      {
         if (m_dem == QLatin1String("true")) {
             m_tileQuality = 70;
         } else {
             m_tileQuality = 85;
         }
+
+        for ( int cnt = 0; cnt <= 255; ++cnt ) {
+            m_grayScalePalette << qRgb( cnt, cnt, cnt );
+        }
     }
 
     ~TileCreatorPrivate()
@@ -55,6 +98,40 @@ class TileCreatorPrivate
         delete m_source;
     }
 
+    /** A tile to be encoded and written by a worker thread */
+    struct TileJob
+    {
+        QImage image;
+        QString name;
+        QString fileName;
+        QByteArray format;
+        int quality;
+        bool verify;
+    };
+
+    struct WrittenTile
+    {
+        WrittenTile() : ok( false ) {}
+
+        QString name;
+        // The encoded tile, only kept if it goes into the archive
+        QByteArray data;
+        bool ok;
+    };
+
+    static QString tileName( int tileLevel, int row, int column, const QString &format );
+
+    QImage normalizedTile( const QImage &tile ) const;
+    QImage reduce( const QImage &topLeft, const QImage &topRight,
+                   const QImage &bottomLeft, const QImage &bottomRight ) const;
+
+    void addRow( int tileLevel, int row, const QVector<QImage> &tiles );
+    void queueTile( const QImage &tile, int tileLevel, int row, int column );
+    void collectTiles( int maxPending );
+
+    static WrittenTile writeTile( const TileJob &job );
+    static void verifyTile( const QImage &tile, const QImage &writtenTile, const QString &name );
+
  public:
     QString  m_dem;
     QString  m_targetDir;
@@ -63,10 +140,168 @@ class TileCreatorPrivate
     int      m_tileQuality;
     bool     m_resume;
     bool     m_verify;
+    QString  m_archiveFile;
 
     TileCreatorSource  *m_source;
+
+    QVector<QRgb> m_grayScalePalette;
+    MarbleZipWriter *m_archive;
+    // For each level, the even row of tiles waiting for the odd row below it
+    QVector< QVector<QImage> > m_pendingRows;
+    QList< QFuture<WrittenTile> > m_pendingTiles;
+    int m_writtenTileCount;
 };
 
+QString TileCreatorPrivate::tileName( int tileLevel, int row, int column, const QString &format )
+{
+    return QString( "%1/%2/%2_%3.%4" )
+            .arg( tileLevel )
+            .arg( row, tileDigits, 10, QLatin1Char('0') )
+            .arg( column, tileDigits, 10, QLatin1Char('0') )
+            .arg( format );
+}
+
+QImage TileCreatorPrivate::normalizedTile( const QImage &tile ) const
+{
+    if ( m_dem == QLatin1String("true") ) {
+        return tile.convertToFormat( QImage::Format_Indexed8, m_grayScalePalette, Qt::ThresholdDither );
+    }
+
+    if ( tile.format() != QImage::Format_ARGB32 && tile.format() != QImage::Format_RGB32 ) {
+        return tile.convertToFormat( QImage::Format_ARGB32 );
+    }
+
+    return tile;
+}
+
+QImage TileCreatorPrivate::reduce( const QImage &topLeft, const QImage &topRight,
+                                   const QImage &bottomLeft, const QImage &bottomRight ) const
+{
+    QImage tile( topLeft.size(), topLeft.format() );
+    if ( tile.format() == QImage::Format_Indexed8 ) {
+        tile.setColorTable( m_grayScalePalette );
+        reduceTiles<uchar>( topLeft, topRight, bottomLeft, bottomRight, tile );
+    } else {
+        reduceTiles<QRgb>( topLeft, topRight, bottomLeft, bottomRight, tile );
+    }
+    return tile;
+}
+
+void TileCreatorPrivate::addRow( int tileLevel, int row, const QVector<QImage> &tiles )
+{
+    for ( int m = 0; m < tiles.size(); ++m ) {
+        queueTile( tiles[m], tileLevel, row, m );
+    }
+
+    if ( tileLevel == 0 ) {
+        return;
+    }
+
+    // Each level has twice the rows and columns of the level above, so every
+    // pair of rows turns into one row of parent tiles
+    if ( row % 2 == 0 ) {
+        m_pendingRows[tileLevel] = tiles;
+        return;
+    }
+
+    const QVector<QImage> upperRow = m_pendingRows[tileLevel];
+    m_pendingRows[tileLevel].clear();
+
+    QVector<QImage> parents;
+    parents.reserve( tiles.size() / 2 );
+    for ( int m = 0; m + 1 < tiles.size(); m += 2 ) {
+        parents << reduce( upperRow[m], upperRow[m + 1], tiles[m], tiles[m + 1] );
+    }
+
+    addRow( tileLevel - 1, row / 2, parents );
+}
+
+void TileCreatorPrivate::queueTile( const QImage &tile, int tileLevel, int row, int column )
+{
+    TileJob job;
+    job.name = tileName( tileLevel, row, column, m_tileFormat );
+
+    if ( !m_archive ) {
+        job.fileName = m_targetDir + job.name;
+        if ( m_resume && QFile::exists( job.fileName ) ) {
+            ++m_writtenTileCount;
+            return;
+        }
+
+        if ( column == 0 ) {
+            const QString dirName = m_targetDir + QString( "%1/%2" ).arg( tileLevel ).arg( row, tileDigits, 10, QLatin1Char('0') );
+            if ( !QDir( dirName ).exists() )
+                ( QDir::root() ).mkpath( dirName );
+        }
+    }
+
+    job.image = tile;
+    job.format = m_tileFormat.toLatin1();
+    job.quality = m_tileQuality;
+    job.verify = m_verify;
+
+    // Keep the number of encoded tiles waiting in memory bounded
+    collectTiles( 2 * QThreadPool::globalInstance()->maxThreadCount() );
+    m_pendingTiles << QtConcurrent::run( &TileCreatorPrivate::writeTile, job );
+}
+
+void TileCreatorPrivate::collectTiles( int maxPending )
+{
+    while ( !m_pendingTiles.isEmpty()
+            && ( m_pendingTiles.size() > maxPending || m_pendingTiles.first().isFinished() ) ) {
+        const WrittenTile tile = m_pendingTiles.takeFirst().result();
+        if ( !tile.ok ) {
+            mDebug() << "Error while writing Tile: " << tile.name;
+        } else if ( m_archive ) {
+            m_archive->addFile( tile.name, tile.data );
+        }
+        ++m_writtenTileCount;
+    }
+}
+
+TileCreatorPrivate::WrittenTile TileCreatorPrivate::writeTile( const TileJob &job )
+{
+    WrittenTile result;
+    result.name = job.name;
+
+    QBuffer buffer( &result.data );
+    buffer.open( QIODevice::WriteOnly );
+    result.ok = job.image.save( &buffer, job.format.constData(), job.quality );
+    buffer.close();
+
+    if ( result.ok && job.verify ) {
+        verifyTile( job.image, QImage::fromData( result.data, job.format.constData() ), job.name );
+    }
+
+    if ( result.ok && !job.fileName.isEmpty() ) {
+        QFile file( job.fileName );
+        result.ok = file.open( QIODevice::WriteOnly ) && file.write( result.data ) == result.data.size();
+        result.data.clear();
+    }
+
+    return result;
+}
+
+void TileCreatorPrivate::verifyTile( const QImage &tile, const QImage &writtenTile, const QString &name )
+{
+    Q_ASSERT( writtenTile.size() == tile.size() );
+    for ( int i=0; i < writtenTile.size().width(); ++i) {
+        for ( int j=0; j < writtenTile.size().height(); ++j) {
+            if ( writtenTile.pixel( i, j ) != tile.pixel( i, j ) ) {
+                unsigned int  pixel = tile.pixel( i, j);
+                unsigned int  writtenPixel = writtenTile.pixel( i, j);
+                qWarning() << "*****" << name << "pixel" << i << j << "is off by" << (pixel - writtenPixel) << "pixel" << pixel << "writtenPixel" << writtenPixel;
+                QByteArray baPixel((char*)&pixel, sizeof(unsigned int));
+                qWarning() << "pixel" << baPixel.size() << "0x" << baPixel.toHex();
+                QByteArray baWrittenPixel((char*)&writtenPixel, sizeof(unsigned int));
+                qWarning() << "writtenPixel" << baWrittenPixel.size() << "0x" << baWrittenPixel.toHex();
+                Q_ASSERT(false);
+                return;
+            }
+        }
+    }
+}
+
 class TileCreatorSourceImage : public TileCreatorSource
 {
 public:
@@ -210,21 +445,14 @@ void TileCreator::cancelTileCreation()
 
 void TileCreator::run()
 {
-    if (d->m_resume && d->m_tileFormat == QLatin1String("jpg") && d->m_tileQuality != 100) {
-        qWarning() << "Resuming jpegs is only supported with tileQuality 100";
+    if ( d->m_resume && !d->m_archiveFile.isEmpty() ) {
+        qWarning() << "Resuming is not supported when writing to an archive";
         return;
     }
 
     if (!d->m_targetDir.endsWith(QLatin1Char('/')))
         d->m_targetDir += QLatin1Char('/');
 
-    mDebug() << "Installing tiles to: " << d->m_targetDir;
-
-    QVector<QRgb> grayScalePalette;
-    for ( int cnt = 0; cnt <= 255; ++cnt ) {
-        grayScalePalette.insert(cnt, qRgb(cnt, cnt, cnt));
-    }
-
     QSize fullImageSize = d->m_source->fullImageSize();
     int  imageWidth  = fullImageSize.width();
     int  imageHeight = fullImageSize.height();
@@ -252,9 +480,24 @@ void TileCreator::run()
     }
     mDebug() << "Maximum Tile Level: " << maxTileLevel;
 
+    if ( d->m_archiveFile.isEmpty() ) {
+        mDebug() << "Installing tiles to: " << d->m_targetDir;
 
-    if ( !QDir( d->m_targetDir ).exists() )
-        ( QDir::root() ).mkpath( d->m_targetDir );
+        if ( !QDir( d->m_targetDir ).exists() )
+            ( QDir::root() ).mkpath( d->m_targetDir );
+    } else {
+        mDebug() << "Writing tiles to archive: " << d->m_archiveFile;
+
+        d->m_archive = new MarbleZipWriter( d->m_archiveFile );
+        if ( d->m_archive->status() != MarbleZipWriter::NoError ) {
+            qWarning() << "Cannot write archive" << d->m_archiveFile;
+            delete d->m_archive;
+            d->m_archive = nullptr;
+            return;
+        }
+        // Tiles are compressed images already
+        d->m_archive->setCompressionPolicy( MarbleZipWriter::NeverCompress );
+    }
 
     // Counting total amount of tiles to be generated for the progressbar
     // to prevent compiler warnings this var should
@@ -273,307 +516,73 @@ void TileCreator::run()
     int  mmax = TileLoaderHelper::levelToColumn( defaultLevelZeroColumns, maxTileLevel );
     int  nmax = TileLoaderHelper::levelToRow( defaultLevelZeroRows, maxTileLevel );
 
-    // Loading each row at highest spatial resolution and cropping tiles
-    int      percentCompleted = 0;
-    int      createdTilesCount = 0;
-    QString  tileName;
-
-    // Creating directory structure for the highest level
-    QString  dirName( d->m_targetDir
-                      + QString("%1").arg(maxTileLevel) );
-    if ( !QDir( dirName ).exists() ) 
-        ( QDir::root() ).mkpath( dirName );
-
-    for ( int n = 0; n < nmax; ++n ) {
-        QString dirName( d->m_targetDir
-                         + QString("%1/%2").arg(maxTileLevel).arg(n, tileDigits, 10, QLatin1Char('0')));
-        if ( !QDir( dirName ).exists() ) 
-            ( QDir::root() ).mkpath( dirName );
-    }
-
-    for ( int n = 0; n < nmax; ++n ) {
+    // Only the tiles of the highest level are taken from the source. The
+    // tiles of the upper levels are reduced from their children in memory
+    // as soon as two rows are complete, so no tile is ever read back from
+    // disk. Encoding and writing happens on the global thread pool.
+    d->m_pendingRows = QVector< QVector<QImage> >( maxTileLevel + 1 );
+    d->m_writtenTileCount = 0;
 
-        for ( int m = 0; m < mmax; ++m ) {
+    QSize const expectedSize( c_defaultTileSize, c_defaultTileSize );
+    bool  ok = true;
 
-            mDebug() << "** tile" << m << "x" << n;
+    for ( int n = 0; n < nmax && ok; ++n ) {
 
-            if ( d->m_cancelled ) 
-                return;
+        QVector<QImage> row;
+        row.reserve( mmax );
 
-            tileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                       .arg( maxTileLevel )
-                                       .arg(n, tileDigits, 10, QLatin1Char('0'))
-                                       .arg(m, tileDigits, 10, QLatin1Char('0'))
-                                       .arg( d->m_tileFormat );
+        for ( int m = 0; m < mmax && ok; ++m ) {
 
-            if ( QFile::exists( tileName ) && d->m_resume ) {
+            mDebug() << "** tile" << m << "x" << n;
 
-                //mDebug() << tileName << "exists already";
+            if ( d->m_cancelled ) {
+                ok = false;
+                break;
+            }
 
+            QImage tile;
+            const QString tileName = d->m_targetDir + TileCreatorPrivate::tileName( maxTileLevel, n, m, d->m_tileFormat );
+            if ( d->m_resume && QFile::exists( tileName ) ) {
+                // The parent tiles still need the existing one
+                tile = QImage( tileName );
             } else {
+                tile = d->m_source->tile( n, m, maxTileLevel );
+            }
 
-                QImage tile = d->m_source->tile( n, m, maxTileLevel );
-
-                if ( tile.isNull() ) {
-                    mDebug() << "Read-Error! Null QImage!";
-                    return;
-                }
-
-                if (d->m_dem == QLatin1String("true")) {
-                    tile = tile.convertToFormat(QImage::Format_Indexed8,
-                                                grayScalePalette,
-                                                Qt::ThresholdDither);
-                }
-
-                bool  ok = tile.save(tileName, d->m_tileFormat.toLatin1().data(), d->m_tileFormat == QLatin1String("jpg") ? 100 : d->m_tileQuality);
-                if ( !ok )
-                    mDebug() << "Error while writing Tile: " << tileName;
-
-                mDebug() << tileName << "size" << QFile( tileName ).size();
-
-                if ( d->m_verify ) {
-                    QImage writtenTile(tileName);
-                    Q_ASSERT( writtenTile.size() == tile.size() );
-                    for ( int i=0; i < writtenTile.size().width(); ++i) {
-                        for ( int j=0; j < writtenTile.size().height(); ++j) {
-                            if ( writtenTile.pixel( i, j ) != tile.pixel( i, j ) ) {
-                                unsigned int  pixel = tile.pixel( i, j);
-                                unsigned int  writtenPixel = writtenTile.pixel( i, j);
-                                qWarning() << "***** pixel" << i << j << "is off by" << (pixel - writtenPixel) << "pixel" << pixel << "writtenPixel" << writtenPixel;
-                                QByteArray baPixel((char*)&pixel, sizeof(unsigned int));
-                                qWarning() << "pixel" << baPixel.size() << "0x" << baPixel.toHex();
-                                QByteArray baWrittenPixel((char*)&writtenPixel, sizeof(unsigned int));
-                                qWarning() << "writtenPixel" << baWrittenPixel.size() << "0x" << baWrittenPixel.toHex();
-                                Q_ASSERT(false);
-                            }
-                        }
-                    }
-                }
-
+            if ( tile.isNull() ) {
+                mDebug() << "Read-Error! Null QImage!";
+                ok = false;
+            } else if ( tile.size() != expectedSize ) {
+                mDebug() << "Invalid tile size" << tile.size();
+                ok = false;
+            } else {
+                row << d->normalizedTile( tile );
             }
 
-            percentCompleted =  (int) ( 90 * (qreal)(createdTilesCount) 
-                                        / (qreal)(totalTileCount) );	
-            createdTilesCount++;
+            // Don't exceed 99% as this would cancel the thread unexpectedly
+            emit progress( (int) ( 99 * (qreal)(d->m_writtenTileCount)
+                                   / (qreal)(totalTileCount) ) );
+        }
 
-            mDebug() << "percentCompleted" << percentCompleted;
-            emit progress( percentCompleted );
+        if ( ok ) {
+            d->addRow( maxTileLevel, n, row );
         }
     }
 
-    mDebug() << "tileLevel: " << maxTileLevel << " successfully created.";
-
-    tileLevel = maxTileLevel;
-
-    // Now that we have the tiles at the highest resolution lets build
-    // them together four by four.
-
-    while( tileLevel > 0 ) {
-        tileLevel--;
-
-        int  nmaxit =  TileLoaderHelper::levelToRow( defaultLevelZeroRows, tileLevel );
-
-        for ( int n = 0; n < nmaxit; ++n ) {
-            QString  dirName( d->m_targetDir
-                              + QString("%1/%2")
-                                  .arg(tileLevel)
-                                  .arg(n, tileDigits, 10, QLatin1Char('0')));
-
-            // mDebug() << "dirName: " << dirName;
-            if ( !QDir( dirName ).exists() ) 
-                ( QDir::root() ).mkpath( dirName );
+    d->collectTiles( 0 );
+    d->m_pendingRows.clear();
+    delete d->m_archive;
+    d->m_archive = nullptr;
 
-            int   mmaxit = TileLoaderHelper::levelToColumn( defaultLevelZeroColumns, tileLevel );
-            for ( int m = 0; m < mmaxit; ++m ) {
-
-                if ( d->m_cancelled )
-                    return;
-
-                QString newTileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                           .arg( tileLevel )
-                                           .arg(n, tileDigits, 10, QLatin1Char('0'))
-                                           .arg(m, tileDigits, 10, QLatin1Char('0'))
-                                           .arg( d->m_tileFormat );
-
-                if ( QFile::exists( newTileName ) && d->m_resume ) {
-                    //mDebug() << newTileName << "exists already";
-                } else {
-                    tileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                            .arg( tileLevel + 1 )
-                                            .arg(2*n, tileDigits, 10, QLatin1Char('0'))
-                                            .arg(2*m, tileDigits, 10, QLatin1Char('0'))
-                                            .arg( d->m_tileFormat );
-                    QImage  img_topleft( tileName );
-
-                    tileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                            .arg( tileLevel + 1 )
-                                            .arg(2*n, tileDigits, 10, QLatin1Char('0'))
-                                            .arg(2*m+1, tileDigits, 10, QLatin1Char('0'))
-                                            .arg( d->m_tileFormat );
-                    QImage  img_topright( tileName );
-
-                    tileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                            .arg( tileLevel + 1 )
-                                            .arg(2*n+1, tileDigits, 10, QLatin1Char('0'))
-                                            .arg(2*m, tileDigits, 10, QLatin1Char('0'))
-                                            .arg( d->m_tileFormat );
-                    QImage  img_bottomleft( tileName );
-
-                    tileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                            .arg( tileLevel + 1 )
-                                            .arg(2*n+1, tileDigits, 10, QLatin1Char('0'))
-                                            .arg(2*m+1, tileDigits, 10, QLatin1Char('0'))
-                                            .arg( d->m_tileFormat );
-                    QImage  img_bottomright( tileName );
-
-                    QSize const expectedSize( c_defaultTileSize, c_defaultTileSize );
-                    if ( img_topleft.size() != expectedSize ||
-                         img_topright.size() != expectedSize ||
-                         img_bottomleft.size() != expectedSize ||
-                         img_bottomright.size() != expectedSize ) {
-                        mDebug() << "Tile write failure. Missing write permissions?";
-                        emit progress( 100 );
-                        return;
-                    }
-                    QImage  tile = img_topleft;
-
-                    if (d->m_dem == QLatin1String("true")) {
-
-                        tile.setColorTable( grayScalePalette );
-                        uchar* destLine;
-
-                        for ( uint y = 0; y < c_defaultTileSize / 2; ++y ) {
-                            destLine = tile.scanLine( y );
-                            const uchar* srcLine = img_topleft.scanLine( 2 * y );
-                            for ( uint x = 0; x < c_defaultTileSize / 2; ++x )
-                                destLine[x] = srcLine[ 2*x ];
-                        }
-                        for ( uint y = 0; y < c_defaultTileSize / 2; ++y ) {
-                            destLine = tile.scanLine( y );
-                            const uchar* srcLine = img_topright.scanLine( 2 * y );
-                            for ( uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x )
-                                destLine[x] = srcLine[ 2 * ( x - c_defaultTileSize / 2 ) ];
-                        }
-                        for ( uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y ) {
-                            destLine = tile.scanLine( y );
-                            const uchar* srcLine = img_bottomleft.scanLine( 2 * ( y - c_defaultTileSize / 2 ) );
-                            for ( uint x = 0; x < c_defaultTileSize / 2; ++x )
-                                destLine[ x ] = srcLine[ 2 * x ];
-                        }
-                        for ( uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y ) {
-                            destLine = tile.scanLine( y );
-                            const uchar* srcLine = img_bottomright.scanLine( 2 * ( y - c_defaultTileSize/2 ) );
-                            for ( uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x )
-                                destLine[x] = srcLine[ 2 * ( x - c_defaultTileSize / 2 ) ];
-                        }
-                    }
-                    else {
-
-                        // tile.depth() != 8
-
-                        img_topleft = img_topleft.convertToFormat( QImage::Format_ARGB32 );
-                        img_topright = img_topright.convertToFormat( QImage::Format_ARGB32 );
-                        img_bottomleft = img_bottomleft.convertToFormat( QImage::Format_ARGB32 );
-                        img_bottomright = img_bottomright.convertToFormat( QImage::Format_ARGB32 );
-                        tile = img_topleft;
-
-                        QRgb* destLine;
-
-                        for ( uint y = 0; y < c_defaultTileSize / 2; ++y ) {
-                            destLine = (QRgb*) tile.scanLine( y );
-                            const QRgb* srcLine = (QRgb*) img_topleft.scanLine( 2 * y );
-                            for ( uint x = 0; x < c_defaultTileSize / 2; ++x )
-                                destLine[x] = srcLine[ 2 * x ];
-                        }
-                        for ( uint y = 0; y < c_defaultTileSize / 2; ++y ) {
-                            destLine = (QRgb*) tile.scanLine( y );
-                            const QRgb* srcLine = (QRgb*) img_topright.scanLine( 2 * y );
-                            for ( uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x )
-                                destLine[x] = srcLine[ 2 * ( x - c_defaultTileSize / 2 ) ];
-                        }
-                        for ( uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y ) {
-                            destLine = (QRgb*) tile.scanLine( y );
-                            const QRgb* srcLine = (QRgb*) img_bottomleft.scanLine( 2 * ( y-c_defaultTileSize/2 ) );
-                            for ( uint x = 0; x < c_defaultTileSize / 2; ++x )
-                                destLine[x] = srcLine[ 2 * x ];
-                        }
-                        for ( uint y = c_defaultTileSize / 2; y < c_defaultTileSize; ++y ) {
-                            destLine = (QRgb*) tile.scanLine( y );
-                            const QRgb* srcLine = (QRgb*) img_bottomright.scanLine( 2 * ( y-c_defaultTileSize / 2 ) );
-                            for ( uint x = c_defaultTileSize / 2; x < c_defaultTileSize; ++x )
-                                destLine[x] = srcLine[ 2*( x-c_defaultTileSize / 2 ) ];
-                        }
-                    }
-
-                    mDebug() << newTileName;
-
-                    // Saving at 100% JPEG quality to have a high-quality
-                    // version to create the remaining needed tiles from.
-                    bool  ok = tile.save(newTileName, d->m_tileFormat.toLatin1().data(), d->m_tileFormat == QLatin1String("jpg") ? 100 : d->m_tileQuality);
-                    if ( ! ok )
-                        mDebug() << "Error while writing Tile: " << newTileName;
-                }
-
-                percentCompleted =  (int) ( 90 * (qreal)(createdTilesCount)
-                                            / (qreal)(totalTileCount) );	
-                createdTilesCount++;
-						
-                emit progress( percentCompleted );
-                mDebug() << "percentCompleted" << percentCompleted;
-            }
-        }
-        mDebug() << "tileLevel: " << tileLevel << " successfully created.";
+    if ( !ok ) {
+        return;
     }
-    mDebug() << "Tile creation completed.";
 
-    if (d->m_tileFormat == QLatin1String("jpg") && d->m_tileQuality != 100) {
-
-        // Applying correct lower JPEG compression now that we created all tiles
-        int savedTilesCount = 0;
-
-        tileLevel = 0;
-        while ( tileLevel <= maxTileLevel ) {
-            int nmaxit =  TileLoaderHelper::levelToRow( defaultLevelZeroRows, tileLevel );
-            for ( int n = 0; n < nmaxit; ++n) {
-                int mmaxit =  TileLoaderHelper::levelToColumn( defaultLevelZeroColumns, tileLevel );
-                for ( int m = 0; m < mmaxit; ++m) {
-
-                    if ( d->m_cancelled )
-                        return;
-
-                    savedTilesCount++;
-
-                    tileName = d->m_targetDir + QString("%1/%2/%2_%3.%4")
-                                            .arg( tileLevel )
-                                            .arg(n, tileDigits, 10, QLatin1Char('0'))
-                                            .arg(m, tileDigits, 10, QLatin1Char('0'))
-                                            .arg( d->m_tileFormat );
-                    QImage tile( tileName );
-
-                    bool ok;
-
-                    ok = tile.save( tileName, d->m_tileFormat.toLatin1().data(), d->m_tileQuality );
-
-                    if ( !ok )
-                        mDebug() << "Error while writing Tile: " << tileName;
-                    // Don't exceed 99% as this would cancel the thread unexpectedly
-                    percentCompleted = 90 + (int)( 9 * (qreal)(savedTilesCount)
-                                                / (qreal)(totalTileCount) );
-                    emit progress( percentCompleted );
-                    mDebug() << "percentCompleted" << percentCompleted;
-                    //mDebug() << "Saving Tile #" << savedTilesCount
-                    //         << " of " << totalTileCount
-                    //         << " Percent: " << percentCompleted;
-                }
-            }
-            tileLevel++;
-        }
-    }
+    mDebug() << "Tile creation completed.";
 
-    percentCompleted = 100;
-    emit progress( percentCompleted );
+    emit progress( 100 );
 
-    mDebug() << "percentCompleted: " << percentCompleted;
+    mDebug() << "percentCompleted: " << 100;
 }
 
 void TileCreator::setTileFormat(const QString& format)
@@ -616,6 +625,16 @@ bool TileCreator::verifyExactResult() const
     return d->m_verify;
 }
 
+void TileCreator::setArchiveFile( const QString &fileName )
+{
+    d->m_archiveFile = fileName;
+}
+
+QString TileCreator::archiveFile() const
+{
+    return d->m_archiveFile;
+}
+
 
 }
 
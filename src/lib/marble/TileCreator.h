@@ -76,10 +76,17 @@ class MARBLE_EXPORT TileCreator : public QThread
     void setTileQuality( int quality );
     void setResume( bool resume );
     void setVerifyExactResult( bool verify );
+
+    /**
+     * Writes all tiles into the zip archive @p fileName instead of the target
+     * directory. Resuming is not supported for archives.
+     */
+    void setArchiveFile( const QString &fileName );
     QString tileFormat() const;
     int tileQuality() const;
     bool resume() const;
     bool verifyExactResult() const;
+    QString archiveFile() const;
 
  protected:
     void run() override;
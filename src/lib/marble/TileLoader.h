@@ -39,7 +39,7 @@ class GeoSceneTileDataset;
 class GeoSceneTextureTileDataset;
 class GeoSceneVectorTileDataset;
 
-class TileLoader: public QObject
+class MARBLE_EXPORT TileLoader: public QObject
 {
     Q_OBJECT
 
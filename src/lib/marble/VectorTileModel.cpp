@@ -11,34 +11,103 @@
 
 #include "VectorTileModel.h"
 
+#include "FrameProfiler.h"
+#include "GeoDataBuilding.h"
 #include "GeoDataDocument.h"
 #include "GeoDataLatLonBox.h"
-#include "GeoDataTreeModel.h"
+#include "GeoDataLineString.h"
+#include "GeoDataMultiGeometry.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPolygon.h"
 #include "GeoSceneVectorTileDataset.h"
+#include "GeometryLayer.h"
 #include "MarbleGlobal.h"
 #include "MarbleDebug.h"
 #include "MathHelper.h"
+#include "PlacemarkLayer.h"
 #include "TileId.h"
 #include "TileLoader.h"
 
 #include <qmath.h>
+#include <QElapsedTimer>
 #include <QThreadPool>
 
+#include <limits>
+
 namespace Marble
 {
 
-TileRunner::TileRunner(TileLoader *loader, const GeoSceneVectorTileDataset *tileDataset, const TileId &id) :
+namespace
+{
+
+int coordinateCount(const GeoDataGeometry *geometry)
+{
+    if (const GeoDataLineString *lineString = dynamic_cast<const GeoDataLineString *>(geometry)) {
+        return lineString->size();
+    }
+
+    if (const GeoDataPolygon *polygon = dynamic_cast<const GeoDataPolygon *>(geometry)) {
+        int count = polygon->outerBoundary().size();
+        for (const GeoDataLinearRing &ring: polygon->innerBoundaries()) {
+            count += ring.size();
+        }
+        return count;
+    }
+
+    if (const GeoDataMultiGeometry *multiGeometry = dynamic_cast<const GeoDataMultiGeometry *>(geometry)) {
+        int count = 0;
+        for (int i = 0; i < multiGeometry->size(); ++i) {
+            count += coordinateCount(&multiGeometry->at(i));
+        }
+        return count;
+    }
+
+    if (const GeoDataBuilding *building = dynamic_cast<const GeoDataBuilding *>(geometry)) {
+        return coordinateCount(building->multiGeometry());
+    }
+
+    return 1;
+}
+
+}
+
+TileRunner::TileRunner(TileLoader *loader, const GeoSceneVectorTileDataset *tileDataset, const TileId &id,
+                       const GeometryLayer *geometryLayer, const QSharedPointer<QAtomicInt> &cancelled) :
     m_loader(loader),
     m_tileDataset(tileDataset),
-    m_id(id)
+    m_id(id),
+    m_geometryLayer(geometryLayer),
+    m_cancelled(cancelled)
 {
 }
 
 void TileRunner::run()
 {
+    if (m_cancelled->load()) {
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const qint64 start = FrameProfiler::timestamp();
+
     GeoDataDocument *const document = m_loader->loadTileVectorData(m_tileDataset, m_id, DownloadBrowse);
 
-    emit documentLoaded(m_id, document);
+    if (m_cancelled->load()) {
+        delete document;
+        return;
+    }
+
+    // Building the graphics items of large tiles takes long, keep it out of the GUI thread
+    QVector<GeoGraphicsItem*> items;
+    if (document) {
+        items = m_geometryLayer->createTileItems(document);
+        FrameProfiler::addEvent(QStringLiteral("vectortile"),
+                                QString("%1/%2/%3").arg(m_id.zoomLevel()).arg(m_id.x()).arg(m_id.y()),
+                                start, FrameProfiler::timestamp());
+    }
+
+    emit documentLoaded(m_id, document, items, timer.elapsed());
 }
 
 VectorTileModel::CacheDocument::CacheDocument(GeoDataDocument *doc, VectorTileModel *vectorTileModel, const GeoDataLatLonBox &boundingBox) :
@@ -54,18 +123,21 @@ VectorTileModel::CacheDocument::~CacheDocument()
     m_vectorTileModel->removeTile(m_document);
 }
 
-VectorTileModel::VectorTileModel(TileLoader *loader, const GeoSceneVectorTileDataset *layer, GeoDataTreeModel *treeModel, QThreadPool *threadPool) :
+VectorTileModel::VectorTileModel(TileLoader *loader, const GeoSceneVectorTileDataset *layer, GeometryLayer *geometryLayer,
+                                 PlacemarkLayer *placemarkLayer, QThreadPool *threadPool) :
     m_loader(loader),
     m_layer(layer),
-    m_treeModel(treeModel),
+    m_geometryLayer(geometryLayer),
+    m_placemarkLayer(placemarkLayer),
     m_threadPool(threadPool),
     m_tileLoadLevel(-1),
     m_tileZoomLevel(-1),
-    m_deleteDocumentsLater(false)
+    m_parseTimeHistogram(12, 0),
+    m_retainedDocuments(64 * 1024 * 1024),
+    m_cacheHits(0),
+    m_cacheMisses(0)
 {
-    connect(this, SIGNAL(tileAdded(GeoDataDocument*)), treeModel, SLOT(addDocument(GeoDataDocument*)));
-    connect(this, SIGNAL(tileRemoved(GeoDataDocument*)), treeModel, SLOT(removeDocument(GeoDataDocument*)));
-    connect(treeModel, SIGNAL(removed(GeoDataObject*)), this, SLOT(cleanupTile(GeoDataObject*)));
+    // nothing to do
 }
 
 void VectorTileModel::setViewport(const GeoDataLatLonBox &latLonBox)
@@ -97,8 +169,8 @@ void VectorTileModel::setViewport(const GeoDataLatLonBox &latLonBox)
 
     // if zoom level has changed, empty vectortile cache
     if (tileLoadLevel != m_tileLoadLevel) {
-        m_deleteDocumentsLater = m_tileLoadLevel >= 0;
         m_tileLoadLevel = tileLoadLevel;
+        cancelPendingTiles(tileLoadLevel);
     }
 
     /** LOGIC FOR DOWNLOADING ALL THE TILES THAT ARE INSIDE THE SCREEN AT THE CURRENT ZOOM LEVEL **/
@@ -108,22 +180,28 @@ void VectorTileModel::setViewport(const GeoDataLatLonBox &latLonBox)
     // More info: http://wiki.openstreetmap.org/wiki/Slippy_map_tilenames#C.2FC.2B.2B
     const QRect rect = m_layer->tileProjection()->tileIndexes(latLonBox, tileLoadLevel);
 
+    // Tiles closest to the center of the viewport are parsed first
+    const GeoDataCoordinates center = latLonBox.center();
+    const GeoDataLatLonBox centerBox(center.latitude(), center.latitude(), center.longitude(), center.longitude());
+    const QPoint centerTile = m_layer->tileProjection()->tileIndexes(centerBox, tileLoadLevel).topLeft();
+
     // Download tiles and send them to VectorTileLayer
     // When changing zoom, download everything inside the screen
     // TODO: hardcodes assumption about tiles indexing also ends at dateline
     // TODO: what about crossing things in y direction?
     if (!latLonBox.crossesDateLine()) {
-        queryTiles(tileLoadLevel, rect);
+        queryTiles(tileLoadLevel, rect, centerTile);
     }
     // When only moving screen, just download the new tiles
     else {
         // TODO: maxTileX (calculation knowledge) should be a property of tileProjection or m_layer
         const int maxTileX = (1 << tileLoadLevel) * m_layer->levelZeroColumns() - 1;
 
-        queryTiles(tileLoadLevel, QRect(QPoint(0, rect.top()), rect.bottomRight()));
-        queryTiles(tileLoadLevel, QRect(rect.topLeft(), QPoint(maxTileX, rect.bottom())));
+        queryTiles(tileLoadLevel, QRect(QPoint(0, rect.top()), rect.bottomRight()), centerTile);
+        queryTiles(tileLoadLevel, QRect(rect.topLeft(), QPoint(maxTileX, rect.bottom())), centerTile);
     }
     removeTilesOutOfView(latLonBox);
+    removeReplacedTiles();
 }
 
 void VectorTileModel::removeTilesOutOfView(const GeoDataLatLonBox &boundingBox)
@@ -137,6 +215,29 @@ void VectorTileModel::removeTilesOutOfView(const GeoDataLatLonBox &boundingBox)
             ++iter;
         }
     }
+
+    // Skip parsing tiles which left the view before their turn came
+    for (auto iter = m_pendingDocuments.begin(); iter != m_pendingDocuments.end();) {
+        const GeoDataLatLonBox tileBox = m_layer->tileProjection()->geoCoordinates(iter.key());
+        if (!extendedViewport.intersects(tileBox)) {
+            iter.value()->store(1);
+            iter = m_pendingDocuments.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void VectorTileModel::cancelPendingTiles(int tileZoomLevel)
+{
+    for (auto iter = m_pendingDocuments.begin(); iter != m_pendingDocuments.end();) {
+        if (iter.key().zoomLevel() != tileZoomLevel) {
+            iter.value()->store(1);
+            iter = m_pendingDocuments.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
 }
 
 QString VectorTileModel::name() const
@@ -146,7 +247,15 @@ QString VectorTileModel::name() const
 
 void VectorTileModel::removeTile(GeoDataDocument *document)
 {
-    emit tileRemoved(document);
+    m_geometryLayer->removeTileDocument(document);
+    m_placemarkLayer->removeTileDocument(document);
+
+    auto const iter = m_garbageQueue.find(document);
+    if (iter != m_garbageQueue.end()) {
+        const TileId id = iter.value();
+        m_garbageQueue.erase(iter);
+        retainTile(id, document);
+    }
 }
 
 int VectorTileModel::tileZoomLevel() const
@@ -159,6 +268,31 @@ int VectorTileModel::cachedDocuments() const
     return m_documents.size();
 }
 
+int VectorTileModel::pendingDocuments() const
+{
+    return m_pendingDocuments.size();
+}
+
+QVector<int> VectorTileModel::parseTimeHistogram() const
+{
+    return m_parseTimeHistogram;
+}
+
+void VectorTileModel::setCacheLimit(quint64 kiloBytes)
+{
+    m_retainedDocuments.setMaxCost(static_cast<int>(qMin<quint64>(kiloBytes * 1024, std::numeric_limits<int>::max())));
+}
+
+int VectorTileModel::cacheHits() const
+{
+    return m_cacheHits;
+}
+
+int VectorTileModel::cacheMisses() const
+{
+    return m_cacheMisses;
+}
+
 void VectorTileModel::reload()
 {
     for (auto const &tile : m_documents.keys()) {
@@ -169,57 +303,170 @@ void VectorTileModel::reload()
 void VectorTileModel::updateTile(const TileId &idWithMapThemeHash, GeoDataDocument *document)
 {
     TileId const id(0, idWithMapThemeHash.zoomLevel(), idWithMapThemeHash.x(), idWithMapThemeHash.y());
-    m_pendingDocuments.removeAll(id);
+    m_pendingDocuments.remove(id);
     if (!document) {
+        removeReplacedTiles();
         return;
     }
 
     if (m_tileLoadLevel != id.zoomLevel()) {
-        delete document;
+        // Keep it for zooming back
+        retainTile(id, document);
         return;
     }
 
+    insertTile(id, document, m_geometryLayer->createTileItems(document));
+    removeReplacedTiles();
+}
+
+void VectorTileModel::insertTile(const TileId &id, GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items)
+{
     document->setName(QString("%1/%2/%3").arg(id.zoomLevel()).arg(id.x()).arg(id.y()));
-    m_garbageQueue << document;
+    m_garbageQueue.insert(document, id);
     if (m_documents.contains(id)) {
         m_documents.remove(id);
-    }
-    if (m_deleteDocumentsLater) {
-        m_deleteDocumentsLater = false;
-        m_documents.clear();
+        // drop the outdated document the removal moved to the cache
+        m_retainedDocuments.remove(id);
     }
     const GeoDataLatLonBox boundingBox = m_layer->tileProjection()->geoCoordinates(id);
     m_documents[id] = QSharedPointer<CacheDocument>(new CacheDocument(document, this, boundingBox));
-    emit tileAdded(document);
+    m_geometryLayer->addTileDocument(document, items);
+    m_placemarkLayer->addTileDocument(document);
+}
+
+void VectorTileModel::retainTile(const TileId &id, GeoDataDocument *document)
+{
+    // QCache deletes the document right away if it exceeds the limit on its own
+    m_retainedDocuments.insert(id, document, estimatedSize(document));
+}
+
+void VectorTileModel::showRetainedAncestor(const TileId &id)
+{
+    // Display the closest parent tile available while the tile loads (overzoom)
+    const QVector<int> tileLevels = m_layer->tileLevels();
+    for (int i = tileLevels.size() - 1; i >= 0; --i) {
+        const int level = tileLevels[i];
+        if (level >= id.zoomLevel()) {
+            continue;
+        }
+
+        const int deltaLevel = id.zoomLevel() - level;
+        const TileId parentId(0, level, id.x() >> deltaLevel, id.y() >> deltaLevel);
+        if (m_documents.contains(parentId)) {
+            return;
+        }
+        if (GeoDataDocument *document = m_retainedDocuments.take(parentId)) {
+            insertTile(parentId, document, m_geometryLayer->createTileItems(document));
+            return;
+        }
+    }
+}
+
+void VectorTileModel::removeReplacedTiles()
+{
+    // Tiles of other levels stay displayed until all the tiles of the
+    // current level that overlap them are loaded
+    for (auto iter = m_documents.begin(); iter != m_documents.end();) {
+        bool isReplaced = iter.key().zoomLevel() != m_tileLoadLevel;
+        for (auto pending = m_pendingDocuments.constBegin(); isReplaced && pending != m_pendingDocuments.constEnd(); ++pending) {
+            isReplaced = !overlaps(iter.key(), pending.key());
+        }
+
+        if (isReplaced) {
+            iter = m_documents.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+bool VectorTileModel::overlaps(const TileId &one, const TileId &another)
+{
+    const TileId &lower = one.zoomLevel() <= another.zoomLevel() ? one : another;
+    const TileId &higher = one.zoomLevel() <= another.zoomLevel() ? another : one;
+    const int deltaLevel = higher.zoomLevel() - lower.zoomLevel();
+    return (higher.x() >> deltaLevel) == lower.x() && (higher.y() >> deltaLevel) == lower.y();
+}
+
+int VectorTileModel::estimatedSize(const GeoDataDocument *document)
+{
+    // Rough estimates of the memory used by a placemark including its OSM data,
+    // and by a coordinate including its private data
+    const qint64 placemarkSize = 512;
+    const qint64 coordinateSize = 64;
+
+    qint64 size = sizeof(GeoDataDocument);
+    for (const GeoDataPlacemark *placemark: document->placemarkList()) {
+        size += placemarkSize;
+        if (placemark->geometry()) {
+            size += coordinateSize * coordinateCount(placemark->geometry());
+        }
+    }
+
+    return static_cast<int>(qMin<qint64>(size, std::numeric_limits<int>::max()));
+}
+
+void VectorTileModel::addLoadedTile(const TileId &id, GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items, int parseTime)
+{
+    if (document) {
+        int bucket = 0;
+        while (bucket < m_parseTimeHistogram.size() - 1 && parseTime >= (1 << bucket)) {
+            ++bucket;
+        }
+        ++m_parseTimeHistogram[bucket];
+    }
+
+    if (document && m_tileLoadLevel == id.zoomLevel()) {
+        m_pendingDocuments.remove(id);
+        insertTile(id, document, items);
+        removeReplacedTiles();
+    } else {
+        // The items are only of use if the tile is shown right away
+        qDeleteAll(items);
+        updateTile(id, document);
+    }
 }
 
 void VectorTileModel::clear()
 {
+    cancelPendingTiles(-1);
     m_documents.clear();
+    m_retainedDocuments.clear();
 }
 
-void VectorTileModel::queryTiles(int tileZoomLevel, const QRect &rect)
+void VectorTileModel::queryTiles(int tileZoomLevel, const QRect &rect, const QPoint &centerTile)
 {
+    // TODO: maxTileX (calculation knowledge) should be a property of tileProjection or m_layer
+    const int tileColumns = (1 << tileZoomLevel) * m_layer->levelZeroColumns();
+
     // Download all the tiles inside the given indexes
     for (int x = rect.left(); x <= rect.right(); ++x) {
         for (int y = rect.top(); y <= rect.bottom(); ++y) {
             const TileId tileId = TileId(0, tileZoomLevel, x, y);
-            if (!m_documents.contains(tileId) && !m_pendingDocuments.contains(tileId)) {
-                m_pendingDocuments << tileId;
-                TileRunner *job = new TileRunner(m_loader, m_layer, tileId);
-                connect(job, SIGNAL(documentLoaded(TileId, GeoDataDocument*)), this, SLOT(updateTile(TileId, GeoDataDocument*)));
-                m_threadPool->start(job);
+            if (m_documents.contains(tileId) || m_pendingDocuments.contains(tileId)) {
+                continue;
             }
-        }
-    }
-}
 
-void VectorTileModel::cleanupTile(GeoDataObject *object)
-{
-    if (GeoDataDocument *document = geodata_cast<GeoDataDocument>(object)) {
-        if (m_garbageQueue.contains(document)) {
-            m_garbageQueue.removeAll(document);
-            delete document;
+            if (GeoDataDocument *document = m_retainedDocuments.take(tileId)) {
+                ++m_cacheHits;
+                FrameProfiler::count(QStringLiteral("Vector tile cache hits"));
+                insertTile(tileId, document, m_geometryLayer->createTileItems(document));
+            } else {
+                ++m_cacheMisses;
+                FrameProfiler::count(QStringLiteral("Vector tile cache misses"));
+                showRetainedAncestor(tileId);
+
+                QSharedPointer<QAtomicInt> cancelled(new QAtomicInt(0));
+                m_pendingDocuments.insert(tileId, cancelled);
+                TileRunner *job = new TileRunner(m_loader, m_layer, tileId, m_geometryLayer, cancelled);
+                connect(job, SIGNAL(documentLoaded(TileId, GeoDataDocument*, QVector<GeoGraphicsItem*>, int)),
+                        this, SLOT(addLoadedTile(TileId, GeoDataDocument*, QVector<GeoGraphicsItem*>, int)));
+
+                // The thread pool runs jobs of higher priority first
+                const int dx = qMin(qAbs(x - centerTile.x()), tileColumns - qAbs(x - centerTile.x()));
+                const int dy = qAbs(y - centerTile.y());
+                m_threadPool->start(job, -(dx * dx + dy * dy));
+            }
         }
     }
 }
@@ -15,8 +15,14 @@
 #include <QObject>
 #include <QRunnable>
 
+#include <QAtomicInt>
+#include <QCache>
+#include <QHash>
 #include <QMap>
+#include <QSharedPointer>
+#include <QVector>
 
+#include "marble_export.h"
 #include "TileId.h"
 #include "GeoDataLatLonBox.h"
 
@@ -26,9 +32,10 @@ namespace Marble
 {
 
 class GeoDataDocument;
-class GeoDataTreeModel;
+class GeoGraphicsItem;
 class GeoSceneVectorTileDataset;
-class GeoDataObject;
+class GeometryLayer;
+class PlacemarkLayer;
 class TileLoader;
 
 class TileRunner : public QObject, public QRunnable
@@ -36,24 +43,42 @@ class TileRunner : public QObject, public QRunnable
     Q_OBJECT
 
 public:
-    TileRunner( TileLoader *loader, const GeoSceneVectorTileDataset *texture, const TileId &id );
+    /**
+     * @param geometryLayer  creates the graphics items of the parsed document in the
+     * thread of the runner
+     * @param cancelled  set to a non-zero value to skip loading the tile or to discard
+     * the document once parsed; may be changed from any thread
+     */
+    TileRunner( TileLoader *loader, const GeoSceneVectorTileDataset *texture, const TileId &id,
+                const GeometryLayer *geometryLayer, const QSharedPointer<QAtomicInt> &cancelled );
     void run() override;
 
 Q_SIGNALS:
-    void documentLoaded( const TileId &id, GeoDataDocument *document );
+    /**
+     * @param items  graphics items of the document, owned by the receiver
+     * @param parseTime  time in milliseconds spent loading and parsing the tile
+     */
+    void documentLoaded( const TileId &id, GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items, int parseTime );
 
 private:
     TileLoader *const m_loader;
     const GeoSceneVectorTileDataset *const m_tileDataset;
     const TileId m_id;
+    const GeometryLayer *const m_geometryLayer;
+    const QSharedPointer<QAtomicInt> m_cancelled;
 };
 
-class VectorTileModel : public QObject
+class MARBLE_EXPORT VectorTileModel : public QObject
 {
     Q_OBJECT
 
 public:
-    explicit VectorTileModel( TileLoader *loader, const GeoSceneVectorTileDataset *layer, GeoDataTreeModel *treeModel, QThreadPool *threadPool );
+    /**
+     * Tiles are shown through @p geometryLayer and @p placemarkLayer directly, they are
+     * not added to the tree model.
+     */
+    explicit VectorTileModel( TileLoader *loader, const GeoSceneVectorTileDataset *layer, GeometryLayer *geometryLayer,
+                              PlacemarkLayer *placemarkLayer, QThreadPool *threadPool );
 
     void setViewport(const GeoDataLatLonBox &bbox);
 
@@ -65,6 +90,38 @@ public:
 
     int cachedDocuments() const;
 
+    /**
+     * @brief Returns the number of tiles queued or being parsed
+     */
+    int pendingDocuments() const;
+
+    /**
+     * @brief Returns the number of parsed tiles per parse time range. Bucket i < 11
+     * counts tiles parsed in less than 2^i milliseconds (and at least 2^(i-1)),
+     * bucket 11 counts all slower tiles.
+     */
+    QVector<int> parseTimeHistogram() const;
+
+    /**
+     * @brief Sets the memory budget for parsed tiles which are not displayed anymore.
+     *
+     * Such tiles are displayed again without reading and parsing them when they come
+     * back into view, also after zooming out and in again. The least recently used
+     * tiles are discarded first.
+     * @param kiloBytes  the limit in kilobytes
+     */
+    void setCacheLimit(quint64 kiloBytes);
+
+    /**
+     * @brief Returns the number of tiles taken from the cache of parsed tiles
+     */
+    int cacheHits() const;
+
+    /**
+     * @brief Returns the number of tiles that had to be loaded
+     */
+    int cacheMisses() const;
+
     void reload();
 
 public Q_SLOTS:
@@ -74,15 +131,21 @@ public Q_SLOTS:
 
 Q_SIGNALS:
     void tileCompleted( const TileId &tileId );
-    void tileAdded(GeoDataDocument *document);
-    void tileRemoved(GeoDataDocument *document);
 
 private Q_SLOTS:
-    void cleanupTile(GeoDataObject* feature);
+    void addLoadedTile(const TileId &id, GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items, int parseTime);
 
 private:
     void removeTilesOutOfView(const GeoDataLatLonBox &boundingBox);
-    void queryTiles(int tileZoomLevel, const QRect &rect);
+    void queryTiles(int tileZoomLevel, const QRect &rect, const QPoint &centerTile);
+    void cancelPendingTiles(int tileZoomLevel);
+    void insertTile(const TileId &id, GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items);
+    void retainTile(const TileId &id, GeoDataDocument *document);
+    void showRetainedAncestor(const TileId &id);
+    void removeReplacedTiles();
+
+    static bool overlaps(const TileId &one, const TileId &another);
+    static int estimatedSize(const GeoDataDocument *document);
 
 private:
     struct CacheDocument
@@ -90,7 +153,7 @@ private:
         /** The CacheDocument takes ownership of doc */
         CacheDocument(GeoDataDocument *doc, VectorTileModel* vectorTileModel, const GeoDataLatLonBox &boundingBox);
 
-        /** Remove the document from the tree and delete the document */
+        /** Hide the document, the model keeps it in its cache */
         ~CacheDocument();
 
         GeoDataLatLonBox latLonBox() const { return m_boundingBox; }
@@ -105,14 +168,21 @@ private:
 
     TileLoader *const m_loader;
     const GeoSceneVectorTileDataset *const m_layer;
-    GeoDataTreeModel *const m_treeModel;
+    GeometryLayer *const m_geometryLayer;
+    PlacemarkLayer *const m_placemarkLayer;
     QThreadPool *const m_threadPool;
     int m_tileLoadLevel;
     int m_tileZoomLevel;
-    QList<TileId> m_pendingDocuments;
-    QList<GeoDataDocument*> m_garbageQueue;
+    /** Queued or running tiles with their cancellation flag */
+    QMap<TileId, QSharedPointer<QAtomicInt> > m_pendingDocuments;
+    QVector<int> m_parseTimeHistogram;
+    /** Displayed documents, moved to m_retainedDocuments once hidden */
+    QHash<GeoDataDocument *, TileId> m_garbageQueue;
+    /** Parsed documents not displayed, with their estimated size in bytes as cost */
+    QCache<TileId, GeoDataDocument> m_retainedDocuments;
+    int m_cacheHits;
+    int m_cacheMisses;
     QMap<TileId, QSharedPointer<CacheDocument> > m_documents;
-    bool m_deleteDocumentsLater;
 };
 
 }
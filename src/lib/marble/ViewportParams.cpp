@@ -20,6 +20,7 @@
 
 #include "MarbleDebug.h"
 #include "GeoDataLatLonAltBox.h"
+#include "ScreenPolygonPool.h"
 #include "SphericalProjection.h"
 #include "EquirectProjection.h"
 #include "MercatorProjection.h"
@@ -73,6 +74,8 @@ public:
     static const VerticalPerspectiveProjection   s_verticalPerspectiveProjection;
 
     GeoDataCoordinates   m_focusPoint;
+
+    ScreenPolygonPool    m_polygonPool;
 };
 
 const SphericalProjection  ViewportParamsPrivate::s_sphericalProjection;
@@ -408,6 +411,12 @@ bool ViewportParams::screenCoordinates( const qreal lon, const qreal lat,
     return d->m_currentProjection->screenCoordinates( lon, lat, this, x, y );
 }
 
+int ViewportParams::screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                       qreal *x, qreal *y, bool *visible ) const
+{
+    return d->m_currentProjection->screenCoordinates( lon, lat, count, this, x, y, visible );
+}
+
 bool ViewportParams::screenCoordinates( const GeoDataCoordinates &geopoint,
                         qreal &x, qreal &y,
                         bool &globeHidesPoint ) const
@@ -436,6 +445,11 @@ bool ViewportParams::screenCoordinates( const GeoDataLineString &lineString,
     return d->m_currentProjection->screenCoordinates( lineString, this, polygons );
 }
 
+ScreenPolygonPool *ViewportParams::polygonPool() const
+{
+    return &d->m_polygonPool;
+}
+
 bool ViewportParams::geoCoordinates( const int x, const int y,
                      qreal &lon, qreal &lat,
                      GeoDataCoordinates::Unit unit ) const
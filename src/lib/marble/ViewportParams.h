@@ -36,6 +36,7 @@ class GeoDataLatLonAltBox;
 class GeoDataLatLonBox;
 class GeoDataLineString;
 class AbstractProjection;
+class ScreenPolygonPool;
 class ViewportParamsPrivate;
 
 /** 
@@ -128,6 +129,19 @@ class MARBLE_EXPORT ViewportParams
     bool screenCoordinates( const qreal lon, const qreal lat,
                             qreal &x, qreal &y ) const;
 
+    /**
+     * @brief Get the screen coordinates of @p count points at once.
+     *
+     * Gives the same results as calling screenCoordinates( lon[i], lat[i], x[i], y[i] )
+     * for each point, storing the return values in @p visible.
+     *
+     * @return the number of visible points
+     *
+     * @see AbstractProjection::screenCoordinates()
+     */
+    int screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                           qreal *x, qreal *y, bool *visible ) const;
+
     /**
      * @brief Get the screen coordinates corresponding to geographical coordinates in the map.
      *
@@ -169,10 +183,20 @@ class MARBLE_EXPORT ViewportParams
                             const QSizeF& size,
                             bool &globeHidesPoint ) const;
 
-
+    /**
+     * @brief Get the screen polygons of a line string in the map.
+     *
+     * The caller owns the polygons appended to @p polygons. They should be
+     * released to polygonPool() when no longer needed, but may be deleted as well.
+     */
     bool screenCoordinates( const GeoDataLineString &lineString,
                             QVector<QPolygonF*> &polygons ) const;
 
+    /**
+     * @brief The pool of screen polygons created by screenCoordinates() for line strings
+     */
+    ScreenPolygonPool *polygonPool() const;
+
     /**
      * @brief Get the earth coordinates corresponding to a pixel in the map.
      * @param x      the x coordinate of the pixel
@@ -18,7 +18,7 @@
 #include "GeoDataStyle.h"
 #include "GeoDataIconStyle.h"
 #include "GeoDataLabelStyle.h"
-#include "PlacemarkLayer.h"
+#include "LabelAtlas.h"
 
 #include <QApplication>
 #include <QPainter>
@@ -120,13 +120,13 @@ void VisiblePlacemark::setSymbolPosition( const QPointF& position )
     m_symbolPosition = position;
 }
 
-const QPixmap& VisiblePlacemark::labelPixmap()
+const QString& VisiblePlacemark::labelId()
 {
     if (m_labelDirty) {
-        drawLabelPixmap();
+        updateLabelId();
     }
 
-    return m_labelPixmap;
+    return m_labelId;
 }
 
 void VisiblePlacemark::setSymbolPixmap()
@@ -181,59 +181,68 @@ const GeoDataCoordinates &VisiblePlacemark::coordinates() const
     return m_coordinates;
 }
 
-void VisiblePlacemark::drawLabelPixmap()
+bool VisiblePlacemark::hasLabel() const
+{
+    return !m_placemark->displayName().isEmpty()
+            && m_style->labelStyle().color() != QColor(Qt::transparent);
+}
+
+VisiblePlacemark::LabelStyle VisiblePlacemark::labelStyle() const
+{
+    if ( m_selected ) {
+        return Selected;
+    } else if ( m_style->labelStyle().glow() ) {
+        return Glow;
+    }
+    return Normal;
+}
+
+void VisiblePlacemark::updateLabelId()
 {
     m_labelDirty = false;
-    QString labelName = m_placemark->displayName();
-    if ( labelName.isEmpty() || m_style->labelStyle().color() == QColor(Qt::transparent) ) {
-        m_labelPixmap = QPixmap();
+    if ( !hasLabel() ) {
+        m_labelId.clear();
         return;
     }
 
-    QFont  labelFont  = m_style->labelStyle().scaledFont();
-    QColor labelColor = m_style->labelStyle().color();
+    // Glowing labels are wider, also when drawn selected
+    const int style = 2 * labelStyle() + ( m_style->labelStyle().glow() ? 1 : 0 );
+    m_labelId = LabelAtlas::key( m_placemark->displayName(), m_style->labelStyle().scaledFont(),
+                                 m_style->labelStyle().color(), style );
+}
 
-    LabelStyle labelStyle = Normal;
-    if ( m_selected ) {
-        labelStyle = Selected;
-    } else if ( m_style->labelStyle().glow() ) {
-        labelStyle = Glow;
+QImage VisiblePlacemark::labelImage() const
+{
+    if ( !hasLabel() ) {
+        return QImage();
     }
 
+    QString labelName = m_placemark->displayName();
+    QFont  labelFont  = m_style->labelStyle().scaledFont();
+    QColor labelColor = m_style->labelStyle().color();
+
     int textHeight = QFontMetrics( labelFont ).height();
 
     int textWidth;
     if ( m_style->labelStyle().glow() ) {
-        labelFont.setWeight( 75 ); // Needed to calculate the correct pixmap size;
+        labelFont.setWeight( 75 ); // Needed to calculate the correct image size;
         textWidth = ( QFontMetrics( labelFont ).width( labelName )
             + qRound( 2 * s_labelOutlineWidth ) );
     } else {
         textWidth = ( QFontMetrics( labelFont ).width( labelName ) );
     }
 
+    QImage image( QSize( textWidth, textHeight ),
+                  QImage::Format_ARGB32_Premultiplied );
+    image.fill( 0 );
 
-    // Due to some XOrg bug this requires a workaround via
-    // QImage in some cases (at least with Qt 4.2).
-    if ( !PlacemarkLayer::m_useXWorkaround ) {
-        m_labelPixmap = QPixmap( QSize( textWidth, textHeight ) );
-        m_labelPixmap.fill( Qt::transparent );
-
-        QPainter labelPainter( &m_labelPixmap );
-
-        drawLabelText( labelPainter, labelName, labelFont, labelStyle, labelColor );
-    } else {
-        QImage image( QSize( textWidth, textHeight ),
-                      QImage::Format_ARGB32_Premultiplied );
-        image.fill( 0 );
-
-        QPainter labelPainter( &image );
+    QPainter labelPainter( &image );
 
-        drawLabelText( labelPainter, labelName, labelFont, labelStyle, labelColor );
+    drawLabelText( labelPainter, labelName, labelFont, labelStyle(), labelColor );
 
-        labelPainter.end();
+    labelPainter.end();
 
-        m_labelPixmap = QPixmap::fromImage( image );
-    }
+    return image;
 }
 
 void VisiblePlacemark::drawLabelText(QPainter &labelPainter, const QString &text,
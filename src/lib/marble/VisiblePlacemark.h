@@ -16,6 +16,7 @@
 #ifndef MARBLE_VISIBLEPLACEMARK_H
 #define MARBLE_VISIBLEPLACEMARK_H
 
+#include <QImage>
 #include <QObject>
 #include <QPixmap>
 #include <QPoint>
@@ -86,9 +87,15 @@ class VisiblePlacemark : public QObject
     void setSymbolPosition(const QPointF &position );
 
     /**
-     * Returns the pixmap of the place mark name label.
+     * Returns the key identifying the rendered name label in a LabelAtlas,
+     * or an empty string if the place mark has no visible label.
      */
-    const QPixmap& labelPixmap();
+    const QString& labelId();
+
+    /**
+     * Renders the place mark name label.
+     */
+    QImage labelImage() const;
 
     /**
      * Returns the area covered by the place mark name label on the map.
@@ -124,14 +131,16 @@ private Q_SLOTS:
 
  private:
     static void drawLabelText( QPainter &labelPainter, const QString &text, const QFont &labelFont, LabelStyle labelStyle, const QColor &color );
-    void drawLabelPixmap();
+    bool hasLabel() const;
+    LabelStyle labelStyle() const;
+    void updateLabelId();
 
     const GeoDataPlacemark *m_placemark;
 
     // View stuff
     QPointF     m_symbolPosition; // position of the placemark's symbol
     bool        m_selected;       // state of the placemark
-    QPixmap     m_labelPixmap;    // the text label (most often name)
+    QString     m_labelId;        // atlas key of the text label (most often name)
     bool        m_labelDirty;
     QRectF      m_labelRect;      // bounding box of label
 
@@ -22,6 +22,7 @@
 #include <routing/Route.h>
 #include <declarative/RouteRequestModel.h>
 #include <ViewportParams.h>
+#include <ScreenPolygonPool.h>
 #include <PositionTracking.h>
 
 #include <QDebug>
@@ -145,7 +146,7 @@ QSGNode * Routing::updatePaintNode(QSGNode *oldNode, UpdatePaintNodeData *) {
         }
     }
 
-    qDeleteAll(polygons);
+    d->m_marbleMap->viewport()->polygonPool()->release(polygons);
     return oldNode;
 }
 
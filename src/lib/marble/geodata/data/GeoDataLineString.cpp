@@ -137,6 +137,41 @@ GeoDataCoordinates GeoDataLineStringPrivate::findDateLine( const GeoDataCoordina
     return findDateLine( previousCoords, interpolatedCoords, recursionCounter );
 }
 
+void GeoDataLineStringPrivate::extendLatLonAltBox( const GeoDataCoordinates &coordinates, bool closed )
+{
+    if ( m_dirtyBox || closed || m_vector.isEmpty() ) {
+        m_dirtyBox = true;
+        return;
+    }
+
+    // Boxes of line strings crossing the IDL depend on all crossings,
+    // only plain boxes not touching it are extended
+    const qreal east = m_latLonAltBox.east();
+    const qreal west = m_latLonAltBox.west();
+    if ( west > east || ( west <= -M_PI && east >= M_PI ) ) {
+        m_dirtyBox = true;
+        return;
+    }
+
+    qreal previousLon, previousLat;
+    m_vector.last().geoCoordinates( previousLon, previousLat );
+    GeoDataCoordinates::normalizeLonLat( previousLon, previousLat );
+
+    qreal lon, lat;
+    coordinates.geoCoordinates( lon, lat );
+    GeoDataCoordinates::normalizeLonLat( lon, lat );
+
+    if ( ( previousLon < 0 ) != ( lon < 0 ) && fabs( previousLon ) + fabs( lon ) > M_PI ) {
+        m_dirtyBox = true;
+        return;
+    }
+
+    m_latLonAltBox.setBoundaries( qMax( m_latLonAltBox.north(), lat ), qMin( m_latLonAltBox.south(), lat ),
+                                  qMax( east, lon ), qMin( west, lon ) );
+    m_latLonAltBox.setMinAltitude( qMin( m_latLonAltBox.minAltitude(), coordinates.altitude() ) );
+    m_latLonAltBox.setMaxAltitude( qMax( m_latLonAltBox.maxAltitude(), coordinates.altitude() ) );
+}
+
 quint8 GeoDataLineStringPrivate::levelForResolution(qreal resolution) const {
     if (m_previousResolution == resolution) return m_level;
 
@@ -429,7 +464,7 @@ void GeoDataLineString::append ( const GeoDataCoordinates& value )
     delete d->m_rangeCorrected;
     d->m_rangeCorrected = nullptr;
     d->m_dirtyRange = true;
-    d->m_dirtyBox = true;
+    d->extendLatLonAltBox( value, isClosed() );
     d->m_vector.append( value );
 }
 
@@ -467,7 +502,7 @@ GeoDataLineString& GeoDataLineString::operator << ( const GeoDataCoordinates& va
     delete d->m_rangeCorrected;
     d->m_rangeCorrected = nullptr;
     d->m_dirtyRange = true;
-    d->m_dirtyBox = true;
+    d->extendLatLonAltBox( value, isClosed() );
     d->m_vector.append( value );
     return *this;
 }
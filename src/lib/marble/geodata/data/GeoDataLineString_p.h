@@ -77,6 +77,12 @@ class GeoDataLineStringPrivate : public GeoDataGeometryPrivate
                        const GeoDataCoordinates & currentCoords,
                        int recursionCounter ) const;
 
+    /**
+     * Extends a valid bounding box by @p coordinates, which are about to be
+     * appended, or marks it dirty if that's not possible.
+     */
+    void extendLatLonAltBox( const GeoDataCoordinates &coordinates, bool closed );
+
     quint8 levelForResolution(qreal resolution) const;
     static qreal resolutionForLevel(int level);
     void optimize(GeoDataLineString& lineString) const;
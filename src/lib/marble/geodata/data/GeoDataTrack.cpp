@@ -227,6 +227,18 @@ void GeoDataTrack::addPoint( const QDateTime &when, const GeoDataCoordinates &co
 
     Q_D(GeoDataTrack);
     d->equalizeWhenSize();
+
+    // Live tracking adds points in chronological order, append them to the
+    // line string instead of rebuilding it
+    if (d->m_when.isEmpty() || !(d->m_when.last() > when)) {
+        d->m_when.append(when);
+        d->m_coordinates.append(coord);
+        if (!d->m_lineStringNeedsUpdate) {
+            d->m_lineString.append(coord);
+        }
+        return;
+    }
+
     d->m_lineStringNeedsUpdate = true;
     int i=0;
     while (i < d->m_when.size()) {
@@ -245,7 +257,9 @@ void GeoDataTrack::appendCoordinates( const GeoDataCoordinates &coord )
 
     Q_D(GeoDataTrack);
     d->equalizeWhenSize();
-    d->m_lineStringNeedsUpdate = true;
+    if (!d->m_lineStringNeedsUpdate) {
+        d->m_lineString.append(coord);
+    }
     d->m_coordinates.append(coord);
 }
 
@@ -293,9 +307,14 @@ void GeoDataTrack::removeBefore( const QDateTime &when )
     }
     d->equalizeWhenSize();
 
-    while (!d->m_when.isEmpty() && d->m_when.first() < when) {
-        d->m_when.takeFirst();
-        d->m_coordinates.takeFirst();
+    int count = 0;
+    while (count < d->m_when.size() && d->m_when.at(count) < when) {
+        ++count;
+    }
+    if (count > 0) {
+        d->m_when.remove(0, count);
+        d->m_coordinates.remove(0, count);
+        d->m_lineStringNeedsUpdate = true;
     }
 }
 
@@ -312,6 +331,7 @@ void GeoDataTrack::removeAfter( const QDateTime &when )
     while (!d->m_when.isEmpty() && d->m_when.last() > when) {
         d->m_when.takeLast();
         d->m_coordinates.takeLast();
+        d->m_lineStringNeedsUpdate = true;
     }
 }
 
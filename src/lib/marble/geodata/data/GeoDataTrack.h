@@ -135,7 +135,8 @@ public:
 
     /**
      * Add a new point with coordinates @p coord associated with the
-     * time value @p when
+     * time value @p when. Points later than all others are appended in
+     * constant time, earlier ones are inserted in chronological order.
      */
     void addPoint( const QDateTime &when, const GeoDataCoordinates &coord );
 
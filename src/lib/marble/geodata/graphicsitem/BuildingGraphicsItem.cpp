@@ -12,6 +12,7 @@
 
 #include "MarbleDebug.h"
 #include "ViewportParams.h"
+#include "ScreenPolygonPool.h"
 #include "GeoDataTypes.h"
 #include "GeoDataPlacemark.h"
 #include "GeoDataLinearRing.h"
@@ -156,14 +157,11 @@ void BuildingGraphicsItem::paint(GeoPainter* painter, const ViewportParams* view
 
     // For level 18, 19 .. render 3D buildings in perspective
     if (layer.endsWith(QLatin1String("/frame"))) {
-        qDeleteAll(m_cachedOuterPolygons);
-        qDeleteAll(m_cachedInnerPolygons);
-        qDeleteAll(m_cachedOuterRoofPolygons);
-        qDeleteAll(m_cachedInnerRoofPolygons);
-        m_cachedOuterPolygons.clear();
-        m_cachedInnerPolygons.clear();
-        m_cachedOuterRoofPolygons.clear();
-        m_cachedInnerRoofPolygons.clear();
+        ScreenPolygonPool *const pool = viewport->polygonPool();
+        pool->release(m_cachedOuterPolygons);
+        pool->release(m_cachedInnerPolygons);
+        pool->release(m_cachedOuterRoofPolygons);
+        pool->release(m_cachedInnerRoofPolygons);
         updatePolygons(*viewport, m_cachedOuterPolygons,
                                  m_cachedInnerPolygons,
                                  m_hasInnerBoundaries);
@@ -228,7 +226,7 @@ void BuildingGraphicsItem::paintRoof(GeoPainter* painter, const ViewportParams*
             for( const QPolygonF* innerRoof: m_cachedInnerRoofPolygons ) {
                 painter->drawPolyline( *innerRoof );
             }
-            qDeleteAll(fillPolygons);
+            viewport->polygonPool()->release(fillPolygons);
         }
         else {
             for( const QPolygonF* outerRoof: m_cachedOuterRoofPolygons ) {
@@ -260,7 +258,7 @@ void BuildingGraphicsItem::paintRoof(GeoPainter* painter, const ViewportParams*
             for( const QPolygonF* innerPolygon:  m_cachedInnerPolygons ) {
                 painter->drawPolyline( *innerPolygon );
             }
-            qDeleteAll(fillPolygons);
+            viewport->polygonPool()->release(fillPolygons);
         }
         else {
             for( const QPolygonF* outerPolygon:  m_cachedOuterPolygons ) {
@@ -355,7 +353,7 @@ void BuildingGraphicsItem::paintFrame(GeoPainter *painter, const ViewportParams
             }
             // draw the building sides
             int const size = outline->size();
-            QPolygonF * outerRoof = new QPolygonF;
+            QPolygonF * outerRoof = viewport->polygonPool()->acquire();
             outerRoof->reserve(outline->size());
             QPointF a = (*outline)[0];
             QPointF shiftA = a + buildingOffset(a, viewport);
@@ -384,7 +382,7 @@ void BuildingGraphicsItem::paintFrame(GeoPainter *painter, const ViewportParams
             }
             // draw the building sides
             int const size = outline->size();
-            QPolygonF * innerRoof = new QPolygonF;
+            QPolygonF * innerRoof = viewport->polygonPool()->acquire();
             innerRoof->reserve(outline->size());
             QPointF a = (*outline)[0];
             QPointF shiftA = a + buildingOffset(a, viewport);
@@ -415,7 +413,7 @@ void BuildingGraphicsItem::paintFrame(GeoPainter *painter, const ViewportParams
             for( QPolygonF* fillPolygon: fillPolygons ) {
                 painter->drawPolygon(*fillPolygon);
             }
-            qDeleteAll(fillPolygons);
+            viewport->polygonPool()->release(fillPolygons);
     }
 }
 
@@ -18,6 +18,7 @@
 #include "GeoPainter.h"
 #include "StyleBuilder.h"
 #include "ViewportParams.h"
+#include "ScreenPolygonPool.h"
 #include "GeoDataStyle.h"
 #include "GeoDataColorStyle.h"
 #include "MarbleDebug.h"
@@ -137,8 +138,7 @@ void GeoLineStringGraphicsItem::paint(GeoPainter* painter, const ViewportParams*
     setRenderContext(RenderContext(tileLevel));
 
     if (layer.endsWith(QLatin1String("/outline"))) {
-        qDeleteAll(m_cachedPolygons);
-        m_cachedPolygons.clear();
+        viewport->polygonPool()->release(m_cachedPolygons);
         m_cachedRegion = QRegion();
         painter->polygonsFromLineString(*m_renderLineString, m_cachedPolygons);
         if (m_cachedPolygons.empty()) {
@@ -159,8 +159,7 @@ void GeoLineStringGraphicsItem::paint(GeoPainter* painter, const ViewportParams*
             }
         }
     } else {
-        qDeleteAll(m_cachedPolygons);
-        m_cachedPolygons.clear();
+        viewport->polygonPool()->release(m_cachedPolygons);
         m_cachedRegion = QRegion();
         painter->polygonsFromLineString(*m_renderLineString, m_cachedPolygons);
         if (m_cachedPolygons.empty()) {
@@ -20,7 +20,7 @@
 namespace Marble
 {
 
-class GeoSceneVectorTileDataset : public GeoSceneTileDataset
+class GEODATA_EXPORT GeoSceneVectorTileDataset : public GeoSceneTileDataset
 {
  public:
 
@@ -10,6 +10,8 @@
 
 #include "GeoWriter.h"
 
+#include "GeoDataCoordinates.h"
+#include "GeoDataLineString.h"
 #include "GeoDocument.h"
 #include "GeoTagWriter.h"
 #include "KmlElementDictionary.h"
@@ -17,13 +19,71 @@
 
 #include "MarbleDebug.h"
 
+#include <cmath>
+
 namespace Marble
 {
 
+namespace
+{
+
+const int charactersChunkSize = 64 * 1024;
+
+/**
+ * Appends @p value to @p buffer formatted like QString::number( value, 'f', precision ).
+ * Values are rounded in integer arithmetic, which is exact unless the value is
+ * huge or close to a tie. Those rare cases are left to the locale aware code.
+ */
+void appendFixed( QByteArray &buffer, double value, int precision )
+{
+    static const double powers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10 };
+    if ( precision < 0 || precision > 10 ) {
+        buffer += QByteArray::number( value, 'f', precision );
+        return;
+    }
+
+    const double scaled = std::fabs( value ) * powers[precision];
+    // Below 2^43 the scaled value is off by less than 2^-10
+    if ( !( scaled < 8.0e12 ) || std::fabs( scaled - std::floor( scaled ) - 0.5 ) < 0.01 ) {
+        buffer += QByteArray::number( value, 'f', precision );
+        return;
+    }
+
+    quint64 digits = static_cast<quint64>( std::floor( scaled + 0.5 ) );
+    if ( digits == 0 ) {
+        // Leave the sign of values rounding to zero to QByteArray::number()
+        buffer += QByteArray::number( value, 'f', precision );
+        return;
+    }
+
+    char text[32];
+    int position = sizeof( text );
+    for ( int i = 0; i < precision; ++i ) {
+        text[--position] = '0' + digits % 10;
+        digits /= 10;
+    }
+    if ( precision > 0 ) {
+        text[--position] = '.';
+    }
+    do {
+        text[--position] = '0' + digits % 10;
+        digits /= 10;
+    } while ( digits );
+    if ( value < 0 ) {
+        text[--position] = '-';
+    }
+
+    buffer.append( text + position, sizeof( text ) - position );
+}
+
+}
+
 GeoWriter::GeoWriter()
 {
     //FIXME: work out a standard way to do this.
     m_documentType = kml::kmlTag_nameSpaceOgc22;
+    // Reserving keeps resize( 0 ) from freeing the buffer after each chunk
+    m_characters.reserve( charactersChunkSize + 256 );
 }
 
 bool GeoWriter::write(QIODevice* device, const GeoNode *feature)
@@ -101,6 +161,57 @@ void GeoWriter::writeOptionalElement( const QString &key, const QString &value,
     }
 }
 
+void GeoWriter::writeCoordinates( const GeoDataLineString &lineString, bool writeAltitude,
+                                  int altitudePrecision, bool closeRing )
+{
+    const int size = lineString.size();
+    for ( int i = 0; i < size; ++i ) {
+        if ( i > 0 ) {
+            m_characters += ' ';
+        }
+        appendCoordinates( lineString.at( i ), ',', writeAltitude, altitudePrecision );
+        if ( m_characters.size() >= charactersChunkSize ) {
+            flushCharacters();
+        }
+    }
+
+    if ( closeRing && size > 0 ) {
+        m_characters += ' ';
+        appendCoordinates( lineString.at( 0 ), ',', writeAltitude, altitudePrecision );
+    }
+
+    flushCharacters();
+}
+
+void GeoWriter::writeCoordinates( const GeoDataCoordinates &coordinates, char separator,
+                                  bool writeAltitude, int altitudePrecision )
+{
+    appendCoordinates( coordinates, separator, writeAltitude, altitudePrecision );
+    flushCharacters();
+}
+
+void GeoWriter::appendCoordinates( const GeoDataCoordinates &coordinates, char separator,
+                                   bool writeAltitude, int altitudePrecision )
+{
+    appendFixed( m_characters, coordinates.longitude( GeoDataCoordinates::Degree ), 10 );
+    m_characters += separator;
+    appendFixed( m_characters, coordinates.latitude( GeoDataCoordinates::Degree ), 10 );
+    if ( writeAltitude ) {
+        m_characters += separator;
+        appendFixed( m_characters, coordinates.altitude(), altitudePrecision );
+    }
+}
+
+void GeoWriter::flushCharacters()
+{
+    if ( m_characters.isEmpty() ) {
+        return;
+    }
+
+    writeCharacters( QString::fromLatin1( m_characters ) );
+    m_characters.resize( 0 );
+}
+
 void GeoWriter::writeOptionalAttribute( const QString &key, const QString &value, const QString &defaultValue )
 {
     if( value != defaultValue ) {
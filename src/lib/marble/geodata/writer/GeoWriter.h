@@ -20,6 +20,8 @@ namespace Marble
 {
 
 class GeoNode;
+class GeoDataCoordinates;
+class GeoDataLineString;
 
 /**
  * @brief Standard Marble way of writing XML
@@ -74,6 +76,26 @@ public:
      */
     void writeOptionalAttribute( const QString &key, const QString &value, const QString &defaultValue = QString() );
 
+    /**
+     * @brief Writes the coordinates of @p lineString as KML coordinate tuples
+     * "lon,lat[,alt]" separated by spaces. Longitude and latitude are written
+     * in degrees with 10 decimals, the altitude with @p altitudePrecision
+     * decimals if @p writeAltitude is set. With @p closeRing the first
+     * coordinates are repeated at the end.
+     *
+     * The numbers are formatted into a reused buffer which is written in
+     * large chunks, avoiding temporary strings per coordinate.
+     */
+    void writeCoordinates( const GeoDataLineString &lineString, bool writeAltitude,
+                           int altitudePrecision, bool closeRing = false );
+
+    /**
+     * @brief Writes a single coordinate tuple with the numbers separated by
+     * @p separator, see above.
+     */
+    void writeCoordinates( const GeoDataCoordinates &coordinates, char separator,
+                           bool writeAltitude, int altitudePrecision );
+
     template<class T>
     void writeOptionalElement( const QString &key, const T &value , const T &defaultValue = T() )
     {
@@ -87,8 +109,13 @@ private:
     friend class GeoDataDocumentWriter;
     bool writeElement( const GeoNode* object );
 
+    void appendCoordinates( const GeoDataCoordinates &coordinates, char separator,
+                            bool writeAltitude, int altitudePrecision );
+    void flushCharacters();
+
 private:
     QString m_documentType;
+    QByteArray m_characters;
 };
 
 }
@@ -48,25 +48,7 @@ bool KmlLineStringTagWriter::write( const GeoNode *node, GeoWriter& writer ) con
             }
         }
 
-        for ( int i = 0; i < lineString->size(); ++i ) {
-            GeoDataCoordinates coordinates = lineString->at( i );
-            if ( i > 0 )
-            {
-                writer.writeCharacters( " " );
-            }
-
-            qreal lon = coordinates.longitude( GeoDataCoordinates::Degree );
-            writer.writeCharacters( QString::number( lon, 'f', 10 ) );
-            writer.writeCharacters( "," );
-            qreal lat = coordinates.latitude( GeoDataCoordinates::Degree );
-            writer.writeCharacters( QString::number( lat, 'f', 10 ) );
-
-            if ( hasAltitude ) {
-                qreal alt = coordinates.altitude();
-                writer.writeCharacters( "," );
-                writer.writeCharacters( QString::number( alt, 'f', 2 ) );
-            }
-        }
+        writer.writeCoordinates( *lineString, hasAltitude, 2 );
 
         writer.writeEndElement();
         writer.writeEndElement();
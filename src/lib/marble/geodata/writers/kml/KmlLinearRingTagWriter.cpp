@@ -38,22 +38,8 @@ bool KmlLinearRingTagWriter::write( const GeoNode *node, GeoWriter& writer ) con
         writer.writeOptionalElement( kml::kmlTag_tessellate, QString::number( ring->tessellate() ), "0" );
         writer.writeStartElement( "coordinates" );
 
-        int size = ring->size() >= 3 && ring->first() != ring->last() ? ring->size() + 1 : ring->size();
-
-        for ( int i = 0; i < size; ++i )
-        {
-            GeoDataCoordinates coordinates = ring->at( i % ring->size() );
-            if ( i > 0 )
-            {
-                writer.writeCharacters( " " );
-            }
-
-            qreal lon = coordinates.longitude( GeoDataCoordinates::Degree );
-            writer.writeCharacters( QString::number( lon, 'f', 10 ) );
-            writer.writeCharacters( "," );
-            qreal lat = coordinates.latitude( GeoDataCoordinates::Degree );
-            writer.writeCharacters( QString::number( lat, 'f', 10 ) );
-        }
+        const bool closeRing = ring->size() >= 3 && ring->first() != ring->last();
+        writer.writeCoordinates( *ring, false, 0, closeRing );
 
         writer.writeEndElement();
         writer.writeEndElement();
@@ -43,16 +43,7 @@ bool KmlPointTagWriter::write( const GeoNode *node,
     //FIXME: this should be using the GeoDataCoordinates::toString but currently
     // it is not including the altitude and is adding an extra space after commas
 
-    QString coordinateString =
-        QString::number(point->coordinates().longitude(GeoDataCoordinates::Degree), 'f', 10) +
-        QLatin1Char(',') +
-        QString::number(point->coordinates().latitude(GeoDataCoordinates::Degree) , 'f', 10);
-
-    if( point->coordinates().altitude() ) {
-        coordinateString += QLatin1Char(',') + QString::number( point->coordinates().altitude() , 'f' , 10);
-    }
-
-    writer.writeCharacters( coordinateString );
+    writer.writeCoordinates( point->coordinates(), ',', point->coordinates().altitude() != 0, 10 );
     writer.writeEndElement();
 
     KmlGroundOverlayWriter::writeAltitudeMode( writer, point->altitudeMode() );
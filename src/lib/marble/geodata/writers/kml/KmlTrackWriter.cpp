@@ -36,13 +36,9 @@ bool KmlTrackWriter::write( const GeoNode *node, GeoWriter &writer ) const
     for ( int i = 0; i < points; i++ ) {
         writer.writeElement( "when", track->whenList().at( i ).toString( Qt::ISODate ) );
 
-        qreal lon, lat, alt;
-        track->coordinatesList().at( i ).geoCoordinates( lon, lat, alt, GeoDataCoordinates::Degree );
-        const QString coord = QString::number(lon, 'f', 10) + QLatin1Char(' ') +
-                              QString::number(lat, 'f', 10) + QLatin1Char(' ') +
-                              QString::number(alt, 'f', 10);
-
-        writer.writeElement( "gx:coord", coord );
+        writer.writeStartElement( "gx:coord" );
+        writer.writeCoordinates( track->coordinatesList().at( i ), ' ', true, 10 );
+        writer.writeEndElement();
     }
     writer.writeEndElement();
 
@@ -40,6 +40,7 @@ class KDescendantsProxyModelPrivate
           m_ignoreNextLayoutAboutToBeChanged(false),
           m_ignoreNextLayoutChanged(false),
           m_relayouting(false),
+          m_insertingDescendants(false),
           m_displayAncestorData(false),
           m_ancestorSeparator(QStringLiteral(" / "))
     {
@@ -57,6 +58,10 @@ class KDescendantsProxyModelPrivate
 
     void updateInternalIndexes(int start, int offset);
 
+    int descendantCount(const QModelIndex &sourceParent) const;
+    int insertDescendantMappings(const QModelIndex &sourceParent, int proxyRow);
+    void insertDescendants(const QModelIndex &sourceParent);
+
     void resetInternalData();
 
     void sourceRowsAboutToBeInserted(const QModelIndex &, int, int);
@@ -80,6 +85,7 @@ class KDescendantsProxyModelPrivate
     bool m_ignoreNextLayoutAboutToBeChanged;
     bool m_ignoreNextLayoutChanged;
     bool m_relayouting;
+    bool m_insertingDescendants;
 
     bool m_displayAncestorData;
     QString m_ancestorSeparator;
@@ -202,6 +208,64 @@ void KDescendantsProxyModelPrivate::updateInternalIndexes(int start, int offset)
 
 }
 
+int KDescendantsProxyModelPrivate::descendantCount(const QModelIndex &sourceParent) const
+{
+    Q_Q(const KDescendantsProxyModel);
+    const int rowCount = q->sourceModel()->rowCount(sourceParent);
+    int count = rowCount;
+    for (int sourceRow = 0; sourceRow < rowCount; ++sourceRow) {
+        static const int column = 0;
+        count += descendantCount(q->sourceModel()->index(sourceRow, column, sourceParent));
+    }
+    return count;
+}
+
+int KDescendantsProxyModelPrivate::insertDescendantMappings(const QModelIndex &sourceParent, int proxyRow)
+{
+    // Maps the last child of each parent in the subtree of sourceParent, starting
+    // at proxyRow. Returns the proxy row following the subtree.
+    Q_Q(KDescendantsProxyModel);
+    const int rowCount = q->sourceModel()->rowCount(sourceParent);
+    for (int sourceRow = 0; sourceRow < rowCount; ++sourceRow) {
+        static const int column = 0;
+        const QModelIndex child = q->sourceModel()->index(sourceRow, column, sourceParent);
+        Q_ASSERT(child.isValid());
+        if (sourceRow == rowCount - 1) {
+            m_mapping.insert(child, proxyRow);
+        }
+        proxyRow = insertDescendantMappings(child, proxyRow + 1);
+    }
+    return proxyRow;
+}
+
+void KDescendantsProxyModelPrivate::insertDescendants(const QModelIndex &sourceParent)
+{
+    // Unlike processPendingParents(), which inserts the children of one parent at
+    // a time, this inserts the whole subtree with a single signal. Proxies and
+    // views on top of this model then process a large inserted document at once.
+    Q_Q(KDescendantsProxyModel);
+
+    const int count = descendantCount(sourceParent);
+    Q_ASSERT(count > 0);
+
+    const QModelIndex proxyParent = q->mapFromSource(sourceParent);
+    Q_ASSERT(sourceParent.isValid() == proxyParent.isValid());
+    const int proxyStart = proxyParent.row() + 1;
+
+    // Keeps rowCount() from building the mapping on its own while it is empty
+    m_insertingDescendants = true;
+    q->beginInsertRows(QModelIndex(), proxyStart, proxyStart + count - 1);
+
+    updateInternalIndexes(proxyStart, count);
+    const int proxyEnd = insertDescendantMappings(sourceParent, proxyStart);
+    Q_ASSERT(proxyEnd == proxyStart + count);
+    Q_UNUSED(proxyEnd)
+    m_rowCount += count;
+
+    m_insertingDescendants = false;
+    q->endInsertRows();
+}
+
 KDescendantsProxyModel::KDescendantsProxyModel(QObject *parent)
     : QAbstractProxyModel(parent), d_ptr(new KDescendantsProxyModelPrivate(this))
 {
@@ -324,7 +388,7 @@ int KDescendantsProxyModel::rowCount(const QModelIndex &parent) const
         return 0;
     }
 
-    if (d->m_mapping.isEmpty() && sourceModel()->hasChildren()) {
+    if (d->m_mapping.isEmpty() && !d->m_insertingDescendants && sourceModel()->hasChildren()) {
         Q_ASSERT(sourceModel()->rowCount() > 0);
         const_cast<KDescendantsProxyModelPrivate *>(d)->synchronousMappingRefresh();
     }
@@ -572,8 +636,7 @@ void KDescendantsProxyModelPrivate::sourceRowsInserted(const QModelIndex &parent
 
     if (rowCount == difference) {
         // @p parent was not a parent before.
-        m_pendingParents.append(parent);
-        scheduleProcessPendingParents();
+        insertDescendants(parent);
         return;
     }
 
@@ -652,20 +715,19 @@ void KDescendantsProxyModelPrivate::sourceRowsInserted(const QModelIndex &parent
         m_mapping.insert(newIndex, newProxyRow);
     }
 
+    m_rowCount += difference;
+
+    q->endInsertRows();
+
     for (int row = start; row <= end; ++row) {
         static const int column = 0;
         const QModelIndex idx = q->sourceModel()->index(row, column, parent);
         Q_ASSERT(idx.isValid());
         if (q->sourceModel()->hasChildren(idx)) {
             Q_ASSERT(q->sourceModel()->rowCount(idx) > 0);
-            m_pendingParents.append(idx);
+            insertDescendants(idx);
         }
     }
-
-    m_rowCount += difference;
-
-    q->endInsertRows();
-    scheduleProcessPendingParents();
 }
 
 void KDescendantsProxyModelPrivate::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int start, int end)
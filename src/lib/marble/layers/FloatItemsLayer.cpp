@@ -64,6 +64,8 @@ void FloatItemsLayer::addFloatItem(AbstractFloatItem *floatItem)
             this,      SIGNAL(repaintNeeded(QRegion)));
     connect(floatItem, SIGNAL(visibilityChanged(bool,QString)),
             this,      SLOT(updateVisibility(bool,QString)));
+    connect(floatItem, SIGNAL(enabledChanged(bool)),
+            this,      SIGNAL(repaintNeeded()));
 
     m_floatItems.append( floatItem );
 }
@@ -78,6 +80,12 @@ QString FloatItemsLayer::runtimeTrace() const
     return QStringLiteral("Float Items: %1").arg(m_floatItems.size());
 }
 
+bool FloatItemsLayer::supportsRetainedRendering() const
+{
+    // Float items request repaints whenever their content changes
+    return true;
+}
+
 void FloatItemsLayer::updateVisibility(bool visible, const QString &nameId)
 {
     emit visibilityChanged(nameId, visible);
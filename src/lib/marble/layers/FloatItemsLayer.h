@@ -48,6 +48,8 @@ class FloatItemsLayer : public QObject, public LayerInterface
 
     QString runtimeTrace() const override;
 
+    bool supportsRetainedRendering() const override;
+
  Q_SIGNALS:
     /**
      * @brief Signal that a render item has been initialized
@@ -83,6 +83,11 @@ public:
     void createGraphicsItems(const GeoDataObject *object);
     void createGraphicsItems(const GeoDataObject *object, FeatureRelationHash &relations);
     void createGraphicsItemFromGeometry(const GeoDataGeometry *object, const GeoDataPlacemark *placemark, const Relations &relations);
+    static void buildGraphicsItems(const GeoDataGeometry *object, const GeoDataPlacemark *placemark, const Relations &relations,
+                                   const StyleBuilder *styleBuilder, GeoGraphicItems &items);
+    static void buildGraphicsItems(const GeoDataContainer *container, const FeatureRelationHash &relations,
+                                   const StyleBuilder *styleBuilder, GeoGraphicItems &items);
+    void addGraphicsItems(const GeoGraphicItems &items);
     void createGraphicsItemFromOverlay(const GeoDataOverlay *overlay);
     void removeGraphicsItems(const GeoDataFeature *feature);
     void updateTiledLineStrings(const GeoDataPlacemark *placemark, GeoLineStringGraphicsItem* lineStringItem);
@@ -90,6 +95,8 @@ public:
     void clearCache();
     bool showRelation(const GeoDataRelation* relation) const;
     void updateRelationVisibility();
+    bool updateRelationVisibility(const GeoDataDocument *document);
+    void addTileDocumentItems(const GeoDataDocument *document, const GeoGraphicItems &items);
 
     const QAbstractItemModel *const m_model;
     const StyleBuilder *const m_styleBuilder;
@@ -98,6 +105,8 @@ public:
     QList<ScreenOverlayGraphicsItem*> m_screenOverlays;
 
     QHash<qint64, OsmLineStringItems> m_osmLineStringItems;
+    /** Vector tiles shown without being part of m_model */
+    QSet<const GeoDataDocument*> m_tileDocuments;
     int m_tileLevel;
     GeoGraphicsItem* m_lastFeatureAt;
 
@@ -251,6 +260,11 @@ bool GeometryLayer::render(GeoPainter *painter, ViewportParams *viewport,
         auto & layerItems = d->m_cachedPaintFragments[layer];
         AbstractGeoPolygonGraphicsItem::s_previousStyle = nullptr;
         GeoLineStringGraphicsItem::s_previousStyle = nullptr;
+        // Labels of a layer don't overlap anything else drawn in it, so they are blitted at once
+        bool const isLabelLayer = layer.endsWith(QLatin1String("/label"));
+        if (isLabelLayer) {
+            painter->beginLabelBatch();
+        }
         for (auto item: layerItems) {
             if (d->m_levelTagDebugModeEnabled) {
                 if (const auto placemark = geodata_cast<GeoDataPlacemark>(item->feature())) {
@@ -267,6 +281,9 @@ bool GeometryLayer::render(GeoPainter *painter, ViewportParams *viewport,
             }
             item->paint(painter, viewport, layer, d->m_tileLevel);
         }
+        if (isLabelLayer) {
+            painter->endLabelBatch();
+        }
     }
 
     for (const auto & item: d->m_cachedDefaultLayer) {
@@ -402,17 +419,36 @@ void GeometryLayerPrivate::updateRelationVisibility()
         QVariant const data = m_model->data(m_model->index(i, 0), MarblePlacemarkModel::ObjectPointerRole);
         GeoDataObject *object = qvariant_cast<GeoDataObject*> (data);
         if (auto doc = geodata_cast<GeoDataDocument>(object)) {
-            for (auto feature: doc->featureList()) {
-                if (auto relation = geodata_cast<GeoDataRelation>(feature)) {
-                    relation->setVisible(showRelation(relation));
-                }
-            }
+            updateRelationVisibility(doc);
         }
     }
+    for (auto doc: m_tileDocuments) {
+        updateRelationVisibility(doc);
+    }
     m_scene.resetStyle();
 }
 
+bool GeometryLayerPrivate::updateRelationVisibility(const GeoDataDocument *document)
+{
+    bool hasRelations = false;
+    for (auto feature: document->featureList()) {
+        if (auto relation = geodata_cast<GeoDataRelation>(feature)) {
+            relation->setVisible(showRelation(relation));
+            hasRelations = true;
+        }
+    }
+    return hasRelations;
+}
+
 void GeometryLayerPrivate::createGraphicsItemFromGeometry(const GeoDataGeometry* object, const GeoDataPlacemark *placemark, const Relations &relations)
+{
+    GeoGraphicItems items;
+    buildGraphicsItems(object, placemark, relations, m_styleBuilder, items);
+    addGraphicsItems(items);
+}
+
+void GeometryLayerPrivate::buildGraphicsItems(const GeoDataGeometry* object, const GeoDataPlacemark *placemark, const Relations &relations,
+                                              const StyleBuilder *styleBuilder, GeoGraphicItems &items)
 {
     if (!placemark->isGloballyVisible()) {
         return; // Reconsider this when visibility can be changed dynamically
@@ -420,9 +456,7 @@ void GeometryLayerPrivate::createGraphicsItemFromGeometry(const GeoDataGeometry*
 
     GeoGraphicsItem *item = nullptr;
     if (const auto line = geodata_cast<GeoDataLineString>(object)) {
-        auto lineStringItem = new GeoLineStringGraphicsItem(placemark, line);
-        item = lineStringItem;
-        updateTiledLineStrings(placemark, lineStringItem);
+        item = new GeoLineStringGraphicsItem(placemark, line);
     } else if (const auto ring = geodata_cast<GeoDataLinearRing>(object)) {
         item = GeoPolygonGraphicsItem::createGraphicsItem(placemark, ring);
     } else if (const auto poly = geodata_cast<GeoDataPolygon>(object)) {
@@ -435,12 +469,12 @@ void GeometryLayerPrivate::createGraphicsItemFromGeometry(const GeoDataGeometry*
     } else if (const auto multigeo = geodata_cast<GeoDataMultiGeometry>(object)) {
         int rowCount = multigeo->size();
         for (int row = 0; row < rowCount; ++row) {
-            createGraphicsItemFromGeometry(multigeo->child(row), placemark, relations);
+            buildGraphicsItems(multigeo->child(row), placemark, relations, styleBuilder, items);
         }
     } else if (const auto multitrack = geodata_cast<GeoDataMultiTrack>(object)) {
         int rowCount = multitrack->size();
         for (int row = 0; row < rowCount; ++row) {
-            createGraphicsItemFromGeometry(multitrack->child(row), placemark, relations);
+            buildGraphicsItems(multitrack->child(row), placemark, relations, styleBuilder, items);
         }
     } else if (const auto track = geodata_cast<GeoDataTrack>(object)) {
         item = new GeoTrackGraphicsItem(placemark, track);
@@ -449,10 +483,44 @@ void GeometryLayerPrivate::createGraphicsItemFromGeometry(const GeoDataGeometry*
         return;
     }
     item->setRelations(relations);
-    item->setStyleBuilder(m_styleBuilder);
+    item->setStyleBuilder(styleBuilder);
     item->setVisible(item->visible() && placemark->isGloballyVisible());
-    item->setMinZoomLevel(m_styleBuilder->minimumZoomLevel(*placemark));
-    m_scene.addItem(item);
+    item->setMinZoomLevel(styleBuilder->minimumZoomLevel(*placemark));
+    items << item;
+}
+
+void GeometryLayerPrivate::buildGraphicsItems(const GeoDataContainer *container, const FeatureRelationHash &relations,
+                                              const StyleBuilder *styleBuilder, GeoGraphicItems &items)
+{
+    for (auto feature: container->featureList()) {
+        if (auto placemark = geodata_cast<GeoDataPlacemark>(feature)) {
+            buildGraphicsItems(placemark->geometry(), placemark, relations.value(placemark), styleBuilder, items);
+        } else if (auto childContainer = dynamic_cast<const GeoDataContainer*>(feature)) {
+            buildGraphicsItems(childContainer, relations, styleBuilder, items);
+        }
+    }
+}
+
+void GeometryLayerPrivate::addGraphicsItems(const GeoGraphicItems &items)
+{
+    for (auto item: items) {
+        if (auto lineStringItem = dynamic_cast<GeoLineStringGraphicsItem*>(item)) {
+            updateTiledLineStrings(static_cast<const GeoDataPlacemark*>(item->feature()), lineStringItem);
+        }
+        m_scene.addItem(item);
+    }
+}
+
+void GeometryLayerPrivate::addTileDocumentItems(const GeoDataDocument *document, const GeoGraphicItems &items)
+{
+    // Items of route members resolve their labels from the relations, which
+    // could not be made visible while the items were created in another thread
+    if (updateRelationVisibility(document)) {
+        for (auto item: items) {
+            item->resetStyle();
+        }
+    }
+    addGraphicsItems(items);
 }
 
 void GeometryLayerPrivate::createGraphicsItemFromOverlay(const GeoDataOverlay *overlay)
@@ -547,6 +615,39 @@ void GeometryLayer::removePlacemarks(const QModelIndex& parent, int first, int l
 
 }
 
+QVector<GeoGraphicsItem*> GeometryLayer::createTileItems(const GeoDataDocument *document) const
+{
+    GeometryLayerPrivate::FeatureRelationHash relations;
+    for (auto feature: document->featureList()) {
+        if (auto relation = geodata_cast<GeoDataRelation>(feature)) {
+            for (auto member: relation->members()) {
+                relations[member] << relation;
+            }
+        }
+    }
+
+    GeometryLayerPrivate::GeoGraphicItems items;
+    GeometryLayerPrivate::buildGraphicsItems(document, relations, d->m_styleBuilder, items);
+    return items;
+}
+
+void GeometryLayer::addTileDocument(const GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items)
+{
+    Q_ASSERT(!d->m_tileDocuments.contains(document));
+    d->clearCache();
+    d->m_tileDocuments << document;
+    d->addTileDocumentItems(document, items);
+    emit repaintNeeded();
+}
+
+void GeometryLayer::removeTileDocument(const GeoDataDocument *document)
+{
+    if (d->m_tileDocuments.remove(document)) {
+        d->removeGraphicsItems(document);
+        emit repaintNeeded();
+    }
+}
+
 void GeometryLayer::resetCacheData()
 {
     d->clearCache();
@@ -559,6 +660,9 @@ void GeometryLayer::resetCacheData()
     if (object && object->parent()) {
         d->createGraphicsItems(object->parent());
     }
+    for (auto document: d->m_tileDocuments) {
+        d->addTileDocumentItems(document, createTileItems(document));
+    }
     emit repaintNeeded();
 }
 
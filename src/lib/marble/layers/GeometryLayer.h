@@ -25,7 +25,9 @@ class QPoint;
 namespace Marble
 {
 class GeoPainter;
+class GeoDataDocument;
 class GeoDataFeature;
+class GeoGraphicsItem;
 class GeoDataPlacemark;
 class GeoDataRelation;
 class StyleBuilder;
@@ -33,7 +35,7 @@ class ViewportParams;
 
 class GeometryLayerPrivate;
 
-class GeometryLayer : public QObject, public LayerInterface
+class MARBLE_EXPORT GeometryLayer : public QObject, public LayerInterface
 {
     Q_OBJECT
 public:
@@ -66,6 +68,24 @@ public:
 
     int debugLevelTag() const;
 
+    /**
+     * Creates the graphics items of the placemarks in the vector tile @p document.
+     * The layer is left untouched, so this may be called from another thread as long
+     * as no other thread modifies the document. The caller owns the items until
+     * passing them to addTileDocument().
+     */
+    QVector<GeoGraphicsItem*> createTileItems(const GeoDataDocument *document) const;
+
+    /**
+     * Shows the vector tile @p document, which is not part of the tree model.
+     * The layer takes ownership of @p items, which must have been created by
+     * createTileItems() for this document. The document stays owned by the caller
+     * and must outlive its removal by removeTileDocument().
+     */
+    void addTileDocument(const GeoDataDocument *document, const QVector<GeoGraphicsItem*> &items);
+
+    void removeTileDocument(const GeoDataDocument *document);
+
 public Q_SLOTS:
     void addPlacemarks( const QModelIndex& index, int first, int last );
     void removePlacemarks( const QModelIndex& index, int first, int last );
@@ -131,9 +131,7 @@ bool PlacemarkLayer::render( GeoPainter *geoPainter, ViewportParams *viewport,
                     painter->drawPixmap( symbolPos, mark->symbolPixmap() );
 #endif
                 }
-                if (!mark->labelPixmap().isNull()) {
-                    painter->drawPixmap( labelRect, mark->labelPixmap() );
-                }
+                drawLabel(painter, mark, labelRect);
             }
         } else { // simple case, one draw per placemark
 
@@ -157,12 +155,13 @@ bool PlacemarkLayer::render( GeoPainter *geoPainter, ViewportParams *viewport,
                 painter->drawPixmap( symbolPos, mark->symbolPixmap() );
 #endif
             }
-            if (!mark->labelPixmap().isNull()) {
-                painter->drawPixmap( labelRect, mark->labelPixmap() );
-            }
+            drawLabel(painter, mark, labelRect);
         }
     }
 
+    // Labels were drawn before the symbols when drawing them one by one
+    m_labelAtlas.flush(painter);
+
 #ifdef BATCH_RENDERING
     for (auto iter = hash.begin(), end = hash.end(); iter != end; ++iter) {
         auto const & fragment = iter.value();
@@ -198,6 +197,25 @@ bool PlacemarkLayer::render( GeoPainter *geoPainter, ViewportParams *viewport,
     return true;
 }
 
+void PlacemarkLayer::drawLabel(QPainter *painter, VisiblePlacemark *mark, const QRect &labelRect)
+{
+    const QString &labelId = mark->labelId();
+    if (labelId.isEmpty()) {
+        return;
+    }
+
+    // Labels are queued in the atlas and blitted together at the end of the frame
+    if (m_labelAtlas.contains(labelId) || m_labelAtlas.insert(labelId, mark->labelImage())) {
+        m_labelAtlas.draw(labelId, QRectF(labelRect).center());
+        return;
+    }
+
+    const QImage image = mark->labelImage();
+    if (!image.isNull()) {
+        painter->drawImage(labelRect, image);
+    }
+}
+
 RenderState PlacemarkLayer::renderState() const
 {
     return RenderState(QStringLiteral("Placemarks"));
@@ -218,6 +236,16 @@ bool PlacemarkLayer::hasPlacemarkAt(const QPoint &pos)
     return m_layout.hasPlacemarkAt(pos);
 }
 
+void PlacemarkLayer::addTileDocument( const GeoDataDocument *document )
+{
+    m_layout.addTileDocument( document );
+}
+
+void PlacemarkLayer::removeTileDocument( const GeoDataDocument *document )
+{
+    m_layout.removeTileDocument( document );
+}
+
 bool PlacemarkLayer::isDebugModeEnabled() const
 {
     return m_debugModeEnabled;
@@ -24,6 +24,7 @@
 #include <QVector>
 #include <QPainter>
 
+#include "LabelAtlas.h"
 #include "PlacemarkLayout.h"
 
 class QAbstractItemModel;
@@ -33,6 +34,7 @@ class QString;
 namespace Marble
 {
 
+class GeoDataDocument;
 class GeoPainter;
 class GeoSceneLayer;
 class MarbleClock;
@@ -46,7 +48,7 @@ struct Fragment
     QPixmap pixmap;
 };
 
-class PlacemarkLayer : public QObject, public LayerInterface
+class MARBLE_EXPORT PlacemarkLayer : public QObject, public LayerInterface
 {
     Q_OBJECT
 
@@ -86,6 +88,12 @@ class PlacemarkLayer : public QObject, public LayerInterface
 
     bool hasPlacemarkAt(const QPoint &pos);
 
+    /**
+     * @see PlacemarkLayout::addTileDocument()
+     */
+    void addTileDocument( const GeoDataDocument *document );
+    void removeTileDocument( const GeoDataDocument *document );
+
     bool isDebugModeEnabled() const;
     void setDebugModeEnabled(bool enabled);
 
@@ -114,9 +122,11 @@ class PlacemarkLayer : public QObject, public LayerInterface
 
  private:
     void renderDebug(GeoPainter *painter, ViewportParams *viewport, const QVector<VisiblePlacemark*> & placemarks) const;
+    void drawLabel(QPainter *painter, VisiblePlacemark *mark, const QRect &labelRect);
     static bool testXBug();
 
     PlacemarkLayout m_layout;
+    LabelAtlas m_labelAtlas;
     bool m_debugModeEnabled;
     bool m_levelTagDebugModeEnabled;
     int m_tileLevel;
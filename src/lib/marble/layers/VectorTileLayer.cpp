@@ -14,6 +14,7 @@
 #include "VectorTileLayer.h"
 
 #include <qmath.h>
+#include <QThread>
 #include <QThreadPool>
 
 #include "VectorTileModel.h"
@@ -27,6 +28,7 @@
 #include "RenderState.h"
 #include "GeoDataDocument.h"
 #include "GeoDataLatLonAltBox.h"
+#include "GeoGraphicsItem.h"
 #include "HttpDownloadManager.h"
 
 namespace Marble
@@ -38,12 +40,14 @@ public:
     Private(HttpDownloadManager *downloadManager,
             const PluginManager *pluginManager,
             VectorTileLayer *parent,
-            GeoDataTreeModel *treeModel);
+            GeometryLayer *geometryLayer,
+            PlacemarkLayer *placemarkLayer);
 
     ~Private();
 
     void updateTile(const TileId &tileId, GeoDataDocument* document);
     void updateLayerSettings();
+    void updateCacheLimits();
 
 public:
     VectorTileLayer  *const m_parent;
@@ -51,9 +55,11 @@ public:
     QVector<VectorTileModel *> m_tileModels;
     QVector<VectorTileModel *> m_activeTileModels;
     const GeoSceneGroup *m_layerSettings;
+    quint64 m_cacheLimit;
 
-    // TreeModel for displaying GeoDataDocuments
-    GeoDataTreeModel *const m_treeModel;
+    // Layers displaying the tiles
+    GeometryLayer *const m_geometryLayer;
+    PlacemarkLayer *const m_placemarkLayer;
 
     QThreadPool m_threadPool; // a shared thread pool for all layers to keep CPU usage sane
 };
@@ -61,15 +67,19 @@ public:
 VectorTileLayer::Private::Private(HttpDownloadManager *downloadManager,
                                   const PluginManager *pluginManager,
                                   VectorTileLayer *parent,
-                                  GeoDataTreeModel *treeModel) :
+                                  GeometryLayer *geometryLayer,
+                                  PlacemarkLayer *placemarkLayer) :
     m_parent(parent),
     m_loader(downloadManager, pluginManager),
     m_tileModels(),
     m_activeTileModels(),
     m_layerSettings(nullptr),
-    m_treeModel(treeModel)
+    m_cacheLimit(64 * 1024),
+    m_geometryLayer(geometryLayer),
+    m_placemarkLayer(placemarkLayer)
 {
-    m_threadPool.setMaxThreadCount(1);
+    // Leave one core to the GUI thread
+    m_threadPool.setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
 }
 
 VectorTileLayer::Private::~Private()
@@ -84,6 +94,13 @@ void VectorTileLayer::Private::updateTile(const TileId &tileId, GeoDataDocument*
     }
 }
 
+void VectorTileLayer::Private::updateCacheLimits()
+{
+    for (VectorTileModel *mapper: m_tileModels) {
+        mapper->setCacheLimit(m_cacheLimit / m_tileModels.size());
+    }
+}
+
 void VectorTileLayer::Private::updateLayerSettings()
 {
     m_activeTileModels.clear();
@@ -106,12 +123,14 @@ void VectorTileLayer::Private::updateLayerSettings()
 
 VectorTileLayer::VectorTileLayer(HttpDownloadManager *downloadManager,
                                  const PluginManager *pluginManager,
-                                 GeoDataTreeModel *treeModel)
+                                 GeometryLayer *geometryLayer,
+                                 PlacemarkLayer *placemarkLayer)
     : QObject()
-    , d(new Private(downloadManager, pluginManager, this, treeModel))
+    , d(new Private(downloadManager, pluginManager, this, geometryLayer, placemarkLayer))
 {
     qRegisterMetaType<TileId>("TileId");
     qRegisterMetaType<GeoDataDocument*>("GeoDataDocument*");
+    qRegisterMetaType<QVector<GeoGraphicsItem*> >("QVector<GeoGraphicsItem*>");
 
     connect(&d->m_loader, SIGNAL(tileCompleted(TileId, GeoDataDocument*)), this, SLOT(updateTile(TileId, GeoDataDocument*)));
 }
@@ -143,11 +162,65 @@ int VectorTileLayer::tileZoomLevel() const
 QString VectorTileLayer::runtimeTrace() const
 {
     int tiles = 0;
+    int pending = 0;
     for (const auto *mapper: d->m_activeTileModels) {
         tiles += mapper->cachedDocuments();
+        pending += mapper->pendingDocuments();
     }
     int const layers = d->m_activeTileModels.size();
-    return QStringLiteral("Vector Tiles: %1 tiles in %2 layers").arg(tiles).arg(layers);
+    return QStringLiteral("Vector Tiles: %1 tiles in %2 layers, %3 queued").arg(tiles).arg(layers).arg(pending);
+}
+
+int VectorTileLayer::layerCount() const
+{
+    return d->m_tileModels.size();
+}
+
+int VectorTileLayer::parseThreadCount() const
+{
+    return d->m_threadPool.maxThreadCount();
+}
+
+void VectorTileLayer::setParseThreadCount(int threads)
+{
+    d->m_threadPool.setMaxThreadCount(qMax(1, threads));
+}
+
+void VectorTileLayer::setVolatileCacheLimit(quint64 kilobytes)
+{
+    d->m_cacheLimit = kilobytes;
+    d->updateCacheLimits();
+}
+
+int VectorTileLayer::cacheHits() const
+{
+    int hits = 0;
+    for (const auto *mapper: d->m_tileModels) {
+        hits += mapper->cacheHits();
+    }
+    return hits;
+}
+
+int VectorTileLayer::cacheMisses() const
+{
+    int misses = 0;
+    for (const auto *mapper: d->m_tileModels) {
+        misses += mapper->cacheMisses();
+    }
+    return misses;
+}
+
+QVector<int> VectorTileLayer::parseTimeHistogram() const
+{
+    QVector<int> histogram;
+    for (const auto *mapper: d->m_activeTileModels) {
+        const QVector<int> modelHistogram = mapper->parseTimeHistogram();
+        histogram.resize(qMax(histogram.size(), modelHistogram.size()));
+        for (int i = 0; i < modelHistogram.size(); ++i) {
+            histogram[i] += modelHistogram[i];
+        }
+    }
+    return histogram;
 }
 
 bool VectorTileLayer::render(GeoPainter *painter, ViewportParams *viewport,
@@ -191,8 +264,9 @@ void VectorTileLayer::setMapTheme(const QVector<const GeoSceneVectorTileDataset
     d->m_activeTileModels.clear();
 
     for (const GeoSceneVectorTileDataset *layer: textures) {
-        d->m_tileModels << new VectorTileModel(&d->m_loader, layer, d->m_treeModel, &d->m_threadPool);
+        d->m_tileModels << new VectorTileModel(&d->m_loader, layer, d->m_geometryLayer, d->m_placemarkLayer, &d->m_threadPool);
     }
+    d->updateCacheLimits();
 
     d->m_layerSettings = textureLayerSettings;
 
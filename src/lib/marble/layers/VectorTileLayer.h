@@ -26,7 +26,8 @@ class GeoPainter;
 class GeoDataDocument;
 class GeoSceneGroup;
 class GeoSceneVectorTileDataset;
-class GeoDataTreeModel;
+class GeometryLayer;
+class PlacemarkLayer;
 class PluginManager;
 class HttpDownloadManager;
 class ViewportParams;
@@ -39,7 +40,8 @@ class VectorTileLayer : public QObject, public LayerInterface
 public:
     VectorTileLayer(HttpDownloadManager *downloadManager,
                     const PluginManager *pluginManager,
-                    GeoDataTreeModel *treeModel);
+                    GeometryLayer *geometryLayer,
+                    PlacemarkLayer *placemarkLayer);
 
     ~VectorTileLayer() override;
 
@@ -49,8 +51,47 @@ public:
 
     int tileZoomLevel() const;
 
+    /**
+     * @brief Returns the number of vector tile layers of the current map theme
+     */
+    int layerCount() const;
+
     QString runtimeTrace() const override;
 
+    /**
+     * @brief Returns the number of threads parsing vector tiles in parallel
+     */
+    int parseThreadCount() const;
+
+    /**
+     * @brief Sets the number of threads parsing vector tiles in parallel
+     * (default: one less than the number of CPU cores, at least one)
+     */
+    void setParseThreadCount(int threads);
+
+    /**
+     * @brief Returns the parse time histogram of all active vector tile layers
+     * @see VectorTileModel::parseTimeHistogram()
+     */
+    QVector<int> parseTimeHistogram() const;
+
+    /**
+     * @brief Sets the memory budget for parsed tiles kept for reuse, shared by all layers
+     * @see VectorTileModel::setCacheLimit()
+     */
+    void setVolatileCacheLimit(quint64 kilobytes);
+
+    /**
+     * @brief Returns the number of tiles of the current map theme displayed from the cache
+     * of parsed tiles
+     */
+    int cacheHits() const;
+
+    /**
+     * @brief Returns the number of tiles of the current map theme that had to be loaded
+     */
+    int cacheMisses() const;
+
     bool render(GeoPainter *painter, ViewportParams *viewport,
                 const QString &renderPos = QLatin1String("NONE"),
                 GeoSceneLayer *layer = nullptr) override;
@@ -21,7 +21,7 @@
 
 namespace Marble {
 
-qint64 OsmObjectManager::m_minId = -1;
+QAtomicInteger<qint64> OsmObjectManager::m_minId( -1 );
 
 void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
 {
@@ -29,9 +29,9 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
 
     bool isNull = osmData.isNull();
     if ( isNull ) {
-        // The "--m_minId" assignments mean: assigning an id lower( by 1 ) than the current lowest,
+        // The "nextId()" assignments mean: assigning an id lower( by 1 ) than the current lowest,
         // and updating the current lowest id.
-        osmData.setId( --m_minId );
+        osmData.setId( nextId() );
     }
 
     // Assigning osmData to each of the line's nodes ( if they don't already have data )
@@ -41,7 +41,7 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
 
         for ( ; it != end; ++it ) {
             if (osmData.nodeReference(*it).isNull()) {
-                osmData.nodeReference(*it).setId(--m_minId);
+                osmData.nodeReference(*it).setId(nextId());
             }
         }
     }
@@ -58,7 +58,7 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
     if (lineString) {
         for (auto it =lineString->constBegin(), end = lineString->constEnd(); it != end; ++it ) {
             if (osmData.nodeReference(*it).isNull()) {
-                osmData.nodeReference(*it).setId(--m_minId);
+                osmData.nodeReference(*it).setId(nextId());
             }
         }
     }
@@ -81,7 +81,7 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
         // Outer boundary
         OsmPlacemarkData &outerBoundaryData = osmData.memberReference( index );
         if (outerBoundaryData.isNull()) {
-            outerBoundaryData.setId(--m_minId);
+            outerBoundaryData.setId(nextId());
         }
 
         // Outer boundary nodes
@@ -90,7 +90,7 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
 
         for ( ; it != end; ++it ) {
             if (outerBoundaryData.nodeReference(*it).isNull()) {
-                outerBoundaryData.nodeReference(*it).setId(--m_minId);
+                outerBoundaryData.nodeReference(*it).setId(nextId());
             }
         }
 
@@ -99,7 +99,7 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
             ++index;
             OsmPlacemarkData &innerRingData = osmData.memberReference( index );
             if (innerRingData.isNull()) {
-                innerRingData.setId(--m_minId);
+                innerRingData.setId(nextId());
             }
 
             // Inner boundary nodes
@@ -108,7 +108,7 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
 
             for ( ; it != end; ++it ) {
                 if (innerRingData.nodeReference(*it).isNull()) {
-                    innerRingData.nodeReference(*it).setId(--m_minId);
+                    innerRingData.nodeReference(*it).setId(nextId());
                 }
             }
         }
@@ -117,7 +117,16 @@ void OsmObjectManager::initializeOsmData( GeoDataPlacemark* placemark )
 
 void OsmObjectManager::registerId( qint64 id )
 {
-    m_minId = qMin( id, m_minId );
+    for ( qint64 current = m_minId.load(); id < current; current = m_minId.load() ) {
+        if ( m_minId.testAndSetOrdered( current, id ) ) {
+            break;
+        }
+    }
+}
+
+qint64 OsmObjectManager::nextId()
+{
+    return m_minId.fetchAndAddOrdered( -1 ) - 1;
 }
 
 }
@@ -12,7 +12,7 @@
 #define MARBLE_OSMOBJECTMANAGER_H
 
 #include <marble_export.h>
-#include <QtGlobal>
+#include <QAtomicInteger>
 
 namespace Marble
 {
@@ -30,7 +30,7 @@ public:
 
     /**
      * @brief initializeOsmData assigns valid osmData
-     * to a placemark that does not have it.
+     * to a placemark that does not have it. Safe to call from several threads.
      */
     static void initializeOsmData( GeoDataPlacemark *placemark );
 
@@ -40,12 +40,14 @@ public:
     static void registerId( qint64 id );
 
 private:
+    static qint64 nextId();
+
     /**
      * @brief newly created placemarks are assigned negative unique IDs.
      * In order to assure there are no duplicate IDs, they are assigned the
      * minId - 1 id.
      */
-    static qint64 m_minId;
+    static QAtomicInteger<qint64> m_minId;
 };
 
 }
@@ -174,6 +174,19 @@ bool AbstractProjection::screenCoordinates( const GeoDataCoordinates &geopoint,
     return screenCoordinates( geopoint, viewport, x, y, globeHidesPoint );
 }
 
+int AbstractProjection::screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                           const ViewportParams *viewport,
+                                           qreal *x, qreal *y, bool *visible ) const
+{
+    int visibleCount = 0;
+    for ( int i = 0; i < count; ++i ) {
+        visible[i] = screenCoordinates( lon[i], lat[i], viewport, x[i], y[i] );
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
 GeoDataLatLonAltBox AbstractProjection::latLonAltBox( const QRect& screenRect,
                                                       const ViewportParams *viewport ) const
 {
@@ -227,6 +227,25 @@ class MARBLE_EXPORT AbstractProjection
                             const ViewportParams *viewport,
                             QVector<QPolygonF*> &polygons ) const = 0;
 
+    /**
+     * @brief Get the screen coordinates of many geographical coordinates at once.
+     * @param lon      the lon coordinates of the points in radians
+     * @param lat      the lat coordinates of the points in radians
+     * @param count    the number of points
+     * @param viewport the viewport parameters
+     * @param x        the x coordinates of the pixels are returned through this array
+     * @param y        the y coordinates of the pixels are returned through this array
+     * @param visible  returns for each point whether it is visible on the screen
+     * @return the number of visible points
+     *
+     * Each point gives the same result as screenCoordinates( lon, lat, viewport, x, y ),
+     * the pixel coordinates of invisible points are unspecified. Projections override
+     * this to avoid a virtual call and a GeoDataCoordinates object per point.
+     */
+    virtual int screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                   const ViewportParams *viewport,
+                                   qreal *x, qreal *y, bool *visible ) const;
+
     /**
      * @brief Get the earth coordinates corresponding to a pixel in the map.
      * @param x      the x coordinate of the pixel
@@ -19,6 +19,7 @@
 #include "GeoDataCoordinates.h"
 #include "GeoDataLatLonAltBox.h"
 #include "ViewportParams.h"
+#include "ScreenPolygonPool.h"
 
 #include <QPainterPath>
 
@@ -322,7 +323,7 @@ void AzimuthalProjectionPrivate::crossHorizon( const GeoDataCoordinates & bCoord
     }
     else {
         if ( allowLatePolygonCut && !polygons.last()->isEmpty() ) {
-            QPolygonF *path = new QPolygonF;
+            QPolygonF *path = viewport->polygonPool()->acquire();
             polygons.append( path );
         }
     }
@@ -350,7 +351,7 @@ bool AzimuthalProjectionPrivate::lineStringToPolygon( const GeoDataLineString &l
     qreal horizonX = -1.0;
     qreal horizonY = -1.0;
 
-    QPolygonF * polygon = new QPolygonF;
+    QPolygonF * polygon = viewport->polygonPool()->acquire();
     if (!tessellate) {
         polygon->reserve(lineString.size());
     }
@@ -493,7 +494,7 @@ bool AzimuthalProjectionPrivate::lineStringToPolygon( const GeoDataLineString &l
                 if (   !previousGlobeHidesPoint
                     && !lineString.isClosed()
                     ) {
-                    polygons.append( new QPolygonF );
+                    polygons.append( viewport->polygonPool()->acquire() );
                 }
             }
 
@@ -524,7 +525,7 @@ bool AzimuthalProjectionPrivate::lineStringToPolygon( const GeoDataLineString &l
     }
 
     if ( polygons.last()->size() <= 1 ){
-        delete polygons.last();
+        viewport->polygonPool()->release( polygons.last() );
         polygons.pop_back(); // Clean up "unused" empty polygon instances
     }
 
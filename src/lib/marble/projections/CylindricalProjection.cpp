@@ -21,6 +21,7 @@
 #include "GeoDataCoordinates.h"
 #include "GeoDataLatLonAltBox.h"
 #include "ViewportParams.h"
+#include "ScreenPolygonPool.h"
 
 #include <QPainterPath>
 
@@ -281,7 +282,7 @@ bool CylindricalProjectionPrivate::lineStringToPolygon( const GeoDataLineString
     int mirrorCount = 0;
     qreal distance = repeatDistance( viewport );
 
-    QPolygonF * polygon = new QPolygonF;
+    QPolygonF * polygon = viewport->polygonPool()->acquire();
     if (!tessellate) {
         polygon->reserve(lineString.size());
     }
@@ -390,7 +391,8 @@ bool CylindricalProjectionPrivate::lineStringToPolygon( const GeoDataLineString
     return polygons.isEmpty();
 }
 
-void CylindricalProjectionPrivate::translatePolygons( const QVector<QPolygonF *> &polygons,
+void CylindricalProjectionPrivate::translatePolygons( const ViewportParams *viewport,
+                                                      const QVector<QPolygonF *> &polygons,
                                                       QVector<QPolygonF *> &translatedPolygons,
                                                       qreal xOffset )
 {
@@ -401,8 +403,8 @@ void CylindricalProjectionPrivate::translatePolygons( const QVector<QPolygonF *>
     QVector<QPolygonF *>::const_iterator itEnd = polygons.constEnd();
 
     for( ; itPolygon != itEnd; ++itPolygon ) {
-        QPolygonF * polygon = new QPolygonF;
-        *polygon = **itPolygon;
+        QPolygonF * polygon = viewport->polygonPool()->acquire();
+        *polygon << **itPolygon;
         polygon->translate( xOffset, 0 );
         translatedPolygons.append( polygon );
     }
@@ -441,7 +443,7 @@ void CylindricalProjectionPrivate::repeatPolygons( const ViewportParams *viewpor
     for (int it = repeatsLeft; it > 0; --it) {
         const qreal xOffset = -it * repeatXInterval;
         QVector<QPolygonF *> translatedPolygons;
-        translatePolygons( polygons, translatedPolygons, xOffset );
+        translatePolygons( viewport, polygons, translatedPolygons, xOffset );
         repeatedPolygons << translatedPolygons;
     }
 
@@ -450,7 +452,7 @@ void CylindricalProjectionPrivate::repeatPolygons( const ViewportParams *viewpor
     for (int it = 1; it <= repeatsRight; ++it) {
         const qreal xOffset = +it * repeatXInterval;
         QVector<QPolygonF *> translatedPolygons;
-        translatePolygons( polygons, translatedPolygons, xOffset );
+        translatePolygons( viewport, polygons, translatedPolygons, xOffset );
         repeatedPolygons << translatedPolygons;
     }
 
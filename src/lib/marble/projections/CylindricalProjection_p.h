@@ -62,7 +62,8 @@ class CylindricalProjectionPrivate : public AbstractProjectionPrivate
                               const ViewportParams *viewport,
                               QVector<QPolygonF*> &polygons ) const;
 
-    static void translatePolygons( const QVector<QPolygonF *> &polygons,
+    static void translatePolygons( const ViewportParams *viewport,
+                                   const QVector<QPolygonF *> &polygons,
                                    QVector<QPolygonF *> &translatedPolygons,
                                    qreal xOffset );
 
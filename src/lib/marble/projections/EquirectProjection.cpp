@@ -152,6 +152,35 @@ bool EquirectProjection::screenCoordinates( const GeoDataCoordinates &coordinate
     return false;
 }
 
+int EquirectProjection::screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                           const ViewportParams *viewport,
+                                           qreal *x, qreal *y, bool *visible ) const
+{
+    // Convenience variables
+    const int radius = viewport->radius();
+    const int width  = viewport->width();
+    const int height = viewport->height();
+    const qreal rad2Pixel = 2.0 * radius / M_PI;
+    const qreal repeatDistance = 4 * radius;
+
+    const qreal centerLon = viewport->centerLongitude();
+    const qreal centerLat = viewport->centerLatitude();
+
+    int visibleCount = 0;
+    for ( int i = 0; i < count; ++i ) {
+        x[i] = (qreal)(width)  / 2.0 + rad2Pixel * ( lon[i] - centerLon );
+        y[i] = (qreal)(height) / 2.0 - rad2Pixel * ( lat[i] - centerLat );
+
+        visible[i] = 0 <= y[i] && y[i] < height
+                && ( ( 0 <= x[i] && x[i] < width )
+                     || ( 0 <= x[i] - repeatDistance && x[i] - repeatDistance < width )
+                     || ( 0 <= x[i] + repeatDistance && x[i] + repeatDistance < width ) );
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
 
 bool EquirectProjection::geoCoordinates( const int x, const int y,
                                          const ViewportParams *viewport,
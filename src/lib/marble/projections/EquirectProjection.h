@@ -84,6 +84,10 @@ class EquirectProjection : public CylindricalProjection
                             const QSizeF& size,
                             bool &globeHidesPoint ) const override;
 
+    int screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                           const ViewportParams *viewport,
+                           qreal *x, qreal *y, bool *visible ) const override;
+
     using CylindricalProjection::screenCoordinates;
 
     /**
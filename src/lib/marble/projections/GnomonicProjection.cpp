@@ -146,6 +146,43 @@ bool GnomonicProjection::screenCoordinates( const GeoDataCoordinates &coordinate
     return visible;
 }
 
+int GnomonicProjection::screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                           const ViewportParams *viewport,
+                                           qreal *x, qreal *y, bool *visible ) const
+{
+    const qreal lambdaPrime = viewport->centerLongitude();
+    const qreal sinPhi1 = qSin( viewport->centerLatitude() );
+    const qreal cosPhi1 = qCos( viewport->centerLatitude() );
+    // Integer divisions, as in the single point version
+    const qreal scale = viewport->radius() / 2;
+    const qint64 radius = clippingRadius() * viewport->radius();
+    const qreal radiusSquared = radius * radius;
+    const int width = viewport->width();
+    const int height = viewport->height();
+
+    int visibleCount = 0;
+    for ( int i = 0; i < count; ++i ) {
+        const qreal sinPhi = qSin( lat[i] );
+        const qreal cosPhi = qCos( lat[i] );
+        const qreal cosLambda = qCos( lon[i] - lambdaPrime );
+        const qreal cosC = sinPhi1 * sinPhi + cosPhi1 * cosPhi * cosLambda;
+
+        const qreal projectedX = ( cosPhi * qSin( lon[i] - lambdaPrime ) ) / cosC * scale;
+        const qreal projectedY = ( cosPhi1 * sinPhi - sinPhi1 * cosPhi * cosLambda ) / cosC * scale;
+
+        x[i] = projectedX + width / 2;
+        y[i] = height / 2 - projectedY;
+
+        // Points beyond the horizon and the clipping radius are hidden
+        visible[i] = cosC > 0
+                && !( projectedX * projectedX + projectedY * projectedY > radiusSquared )
+                && x[i] >= 0 && x[i] < width && y[i] >= 0 && y[i] < height;
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
 
 bool GnomonicProjection::geoCoordinates( const int x, const int y,
                                           const ViewportParams *viewport,
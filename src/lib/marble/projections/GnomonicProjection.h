@@ -74,6 +74,10 @@ class GnomonicProjection : public AzimuthalProjection
                             const QSizeF& size,
                             bool &globeHidesPoint ) const override;
 
+    int screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                           const ViewportParams *viewport,
+                           qreal *x, qreal *y, bool *visible ) const override;
+
     using AbstractProjection::screenCoordinates;
 
     /**
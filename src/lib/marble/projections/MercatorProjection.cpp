@@ -164,6 +164,40 @@ bool MercatorProjection::screenCoordinates( const GeoDataCoordinates &coordinate
     return false;
 }
 
+int MercatorProjection::screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                           const ViewportParams *viewport,
+                                           qreal *x, qreal *y, bool *visible ) const
+{
+    // Convenience variables
+    const int radius = viewport->radius();
+    const qreal width  = (qreal)(viewport->width());
+    const qreal height = (qreal)(viewport->height());
+    const qreal rad2Pixel = 2 * radius / M_PI;
+    const qreal repeatDistance = 4 * radius;
+
+    const qreal centerLon = viewport->centerLongitude();
+    const qreal centerLatInv = gdInv( viewport->centerLatitude() );
+    const qreal minimumLat = minLat();
+    const qreal maximumLat = maxLat();
+
+    int visibleCount = 0;
+    for ( int i = 0; i < count; ++i ) {
+        const qreal boundedLat = qBound( minimumLat, lat[i], maximumLat );
+
+        x[i] = width  / 2 + rad2Pixel * ( lon[i] - centerLon );
+        y[i] = height / 2 - rad2Pixel * ( gdInv( boundedLat ) - centerLatInv );
+
+        visible[i] = boundedLat == lat[i]
+                && 0 <= y[i] && y[i] < height
+                && ( ( 0 <= x[i] && x[i] < width )
+                     || ( 0 <= x[i] - repeatDistance && x[i] - repeatDistance < width )
+                     || ( 0 <= x[i] + repeatDistance && x[i] + repeatDistance < width ) );
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
 
 bool MercatorProjection::geoCoordinates( const int x, const int y,
                                          const ViewportParams *viewport,
@@ -83,6 +83,10 @@ class MercatorProjection : public CylindricalProjection
                             const QSizeF& size,
                             bool &globeHidesPoint ) const override;
 
+    int screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                           const ViewportParams *viewport,
+                           qreal *x, qreal *y, bool *visible ) const override;
+
     using CylindricalProjection::screenCoordinates;
 
    /**
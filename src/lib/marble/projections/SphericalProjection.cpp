@@ -27,6 +27,8 @@
 
 #include <QIcon>
 
+#include <cmath>
+
 #define SAFE_DISTANCE
 
 namespace Marble
@@ -153,6 +155,40 @@ bool SphericalProjection::screenCoordinates( const GeoDataCoordinates &coordinat
     return visible;
 }
 
+int SphericalProjection::screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                                            const ViewportParams *viewport,
+                                            qreal *x, qreal *y, bool *visible ) const
+{
+    // The single point version at zero altitude, without creating a quaternion per point
+    const matrix &planetAxisMatrix = viewport->planetAxisMatrix();
+    const qreal radius = viewport->radius();
+    const qreal pixelAltitude = radius / EARTH_RADIUS * EARTH_RADIUS;
+    const qreal width = viewport->width();
+    const qreal height = viewport->height();
+
+    int visibleCount = 0;
+    for ( int i = 0; i < count; ++i ) {
+        const qreal cosLat = cos( lat[i] );
+        const qreal qx = cosLat * sin( lon[i] );
+        const qreal qy = sin( lat[i] );
+        const qreal qz = cosLat * cos( lon[i] );
+
+        const qreal rotatedX = planetAxisMatrix[0][0] * qx + planetAxisMatrix[1][0] * qy + planetAxisMatrix[2][0] * qz;
+        const qreal rotatedY = planetAxisMatrix[0][1] * qx + planetAxisMatrix[1][1] * qy + planetAxisMatrix[2][1] * qz;
+        const qreal rotatedZ = planetAxisMatrix[0][2] * qx + planetAxisMatrix[1][2] * qy + planetAxisMatrix[2][2] * qz;
+
+        x[i] = width  / 2 + pixelAltitude * rotatedX;
+        y[i] = height / 2 - pixelAltitude * rotatedY;
+
+        // Points on the far side of the planet are hidden
+        visible[i] = !( rotatedZ < 0 )
+                && x[i] >= 0 && x[i] < width && y[i] >= 0 && y[i] < height;
+        visibleCount += visible[i];
+    }
+
+    return visibleCount;
+}
+
 
 bool SphericalProjection::geoCoordinates( const int x, const int y,
                                           const ViewportParams *viewport,
@@ -81,6 +81,10 @@ class SphericalProjection : public AzimuthalProjection
                             const QSizeF& size,
                             bool &globeHidesPoint ) const override;
 
+    int screenCoordinates( const qreal *lon, const qreal *lat, int count,
+                           const ViewportParams *viewport,
+                           qreal *x, qreal *y, bool *visible ) const override;
+
     using AbstractProjection::screenCoordinates;
 
     /**
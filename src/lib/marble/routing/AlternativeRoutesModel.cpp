@@ -18,28 +18,88 @@
 #include "GeoDataPlacemark.h"
 
 #include <QTimer>
-#include <QPainter>
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 
 namespace Marble {
 
 class Q_DECL_HIDDEN AlternativeRoutesModel::Private
 {
 public:
+    /** Cartesian coordinates on the unit sphere */
+    struct Vector3
+    {
+        qreal x;
+        qreal y;
+        qreal z;
+    };
+
+    /**
+      * Simplified route geometry used to compare routes. Points are stored as unit vectors
+      * such that distances can be computed without trigonometry and without special casing
+      * the date line.
+      */
+    struct Outline
+    {
+        QVector<Vector3> points;
+        Vector3 minimum;
+        Vector3 maximum;
+    };
+
+    /** Result of the worker thread handling a lazily added route */
+    struct OutlinedRoute
+    {
+        Outline outline;
+
+        /** Index of the first similar outline, -1 if none */
+        int similarRoute;
+
+        /** Number of outlines it was compared with */
+        int comparedRoutes;
+    };
+
+    typedef QFutureWatcher<OutlinedRoute> OutlineWatcher;
+
     Private();
 
     /**
       * Returns true if there exists a route with high similarity to the given one
       */
-    bool filter( const GeoDataDocument* document ) const;
+    bool filter( const Outline &outline ) const;
 
     /**
       * Returns a similarity measure in the range of [0..1]. Two routes with a similarity of 0 can
       * be treated as totally different (e.g. different route requests), two routes with a similarity
       * of 1 are considered equal. Otherwise the routes overlap to an extent indicated by the
       * similarity value -- the higher, the more they do overlap.
+      * The computation stops as soon as the similarity is known to be above or below the given
+      * threshold, the returned value is only exact with respect to that comparison then.
       * @note: The direction of routes is important; reversed routes are not considered equal
       */
-    static qreal similarity( const GeoDataDocument* routeA, const GeoDataDocument* routeB );
+    static qreal similarity( const Outline &routeA, const Outline &routeB, qreal threshold );
+
+    /**
+      * Returns the simplified geometry of the given route. Safe to call from worker threads.
+      */
+    static Outline outline( const GeoDataLineString &wayPoints );
+
+    /**
+      * Returns the outline of the given route along with the first of the given outlines
+      * it is similar to. Safe to call from worker threads.
+      */
+    static OutlinedRoute outlineRoute( const GeoDataLineString &wayPoints, const QVector<Outline> &outlines );
+
+    /**
+      * Returns the index of the first outline in m_outlines from the given index on which is
+      * similar to the given one, -1 if none
+      */
+    int similarRoute( const Outline &outline, int from = 0 ) const;
+
+    /**
+      * Adds the given route with the given outline to the model, or replaces a similar route
+      * with it if it has a higher score
+      */
+    void insertRoute( AlternativeRoutesModel *model, GeoDataDocument *document, const Outline &outline, int similarRoute );
 
     /**
       * Returns the distance between the given polygon and the given point
@@ -64,10 +124,16 @@ public:
     static GeoDataCoordinates coordinates( const GeoDataCoordinates &start, qreal distance, qreal bearing );
 
     /**
-      * Returns the similarity between routeA and routeB. This method is not symmetric, i.e. in
+      * Returns the similarity between routeA and routeB, i.e. the fraction of routeB that lies
+      * within the given tolerance of routeA. This method is not symmetric, i.e. in
       * general unidirectionalSimilarity(a,b) != unidirectionalSimilarity(b,a)
       */
-    static qreal unidirectionalSimilarity( const GeoDataDocument* routeA, const GeoDataDocument* routeB );
+    static qreal unidirectionalSimilarity( const Outline &routeA, const Outline &routeB, qreal tolerance, qreal threshold );
+
+    /**
+      * Returns the squared distance between the point and the line segment from a to b
+      */
+    static qreal squaredDistance( const Vector3 &point, const Vector3 &a, const Vector3 &b );
 
     /**
       * (Primitive) scoring for routes
@@ -81,13 +147,18 @@ public:
 
     static const GeoDataLineString* waypoints( const GeoDataDocument* document );
 
-    static int nonZero( const QImage &image );
-
-    static QPolygonF polygon( const GeoDataLineString &lineString, qreal x, qreal y, qreal sx, qreal sy );
-
     /** The currently shown alternative routes (model data) */
     QVector<GeoDataDocument*> m_routes;
 
+    /** Outlines of the routes in m_routes, same order */
+    QVector<Outline> m_outlines;
+
+    /**
+      * Routes whose outline is being computed in a worker thread, in the order they were added.
+      * Results are applied in this order, not in the order the workers finish.
+      */
+    QVector<QPair<OutlineWatcher*, GeoDataDocument*> > m_pendingRoutes;
+
     /** Pending route data (waiting for other results to come in) */
     QVector<GeoDataDocument*> m_restrainedRoutes;
 
@@ -104,45 +175,165 @@ AlternativeRoutesModel::Private::Private() :
     // nothing to do
 }
 
-int AlternativeRoutesModel::Private::nonZero( const QImage &image )
+bool AlternativeRoutesModel::Private::filter( const Outline &outline ) const
 {
-  QRgb const black = qRgb( 0, 0, 0 );
-  int count = 0;
-  for ( int y = 0; y < image.height(); ++y ) {
-      QRgb* destLine = (QRgb*) image.scanLine( y );
-      for ( int x = 0; x < image.width(); ++x ) {
-          count += destLine[x] == black ? 0 : 1;
-      }
-  }
-  return count;
+    return similarRoute( outline ) >= 0;
 }
 
-QPolygonF AlternativeRoutesModel::Private::polygon( const GeoDataLineString &lineString, qreal x, qreal y, qreal sx, qreal sy )
+int AlternativeRoutesModel::Private::similarRoute( const Outline &outline, int from ) const
 {
-    QPolygonF poly;
-    for ( int i = 0; i < lineString.size(); ++i ) {
-        poly << QPointF( qAbs( ( lineString)[i].longitude() - x ) * sx,
-                         qAbs( ( lineString)[i].latitude()  - y ) * sy );
+    for ( int i = from; i < m_outlines.size(); ++i ) {
+        qreal similarity = Private::similarity( outline, m_outlines.at( i ), 0.8 );
+        if ( similarity > 0.8 ) {
+            return i;
+        }
     }
-    return poly;
+
+    return -1;
 }
 
-bool AlternativeRoutesModel::Private::filter( const GeoDataDocument* document ) const
+AlternativeRoutesModel::Private::OutlinedRoute AlternativeRoutesModel::Private::outlineRoute( const GeoDataLineString &wayPoints, const QVector<Outline> &outlines )
 {
-    for ( int i=0; i<m_routes.size(); ++i ) {
-        qreal similarity = Private::similarity( document, m_routes.at( i ) );
-        if ( similarity > 0.8 ) {
-            return true;
+    OutlinedRoute result;
+    result.outline = outline( wayPoints );
+    result.similarRoute = -1;
+    result.comparedRoutes = outlines.size();
+    for ( int i = 0; i < outlines.size(); ++i ) {
+        if ( similarity( result.outline, outlines.at( i ), 0.8 ) > 0.8 ) {
+            result.similarRoute = i;
+            break;
+        }
+    }
+
+    return result;
+}
+
+void AlternativeRoutesModel::Private::insertRoute( AlternativeRoutesModel *model, GeoDataDocument *document, const Outline &outline, int similarRoute )
+{
+    if ( similarRoute >= 0 ) {
+        if ( higherScore( document, m_routes.at( similarRoute ) ) ) {
+            m_routes[similarRoute] = document;
+            m_outlines[similarRoute] = outline;
+            QModelIndex changed = model->index( similarRoute );
+            emit model->dataChanged( changed, changed );
+        }
+
+        return;
+    }
+
+    const int affected = m_routes.size();
+    model->beginInsertRows( QModelIndex(), affected, affected );
+    m_routes.push_back( document );
+    m_outlines.push_back( outline );
+    model->endInsertRows();
+}
+
+qreal AlternativeRoutesModel::Private::similarity( const Outline &routeA, const Outline &routeB, qreal threshold )
+{
+    if ( routeA.points.isEmpty() || routeB.points.isEmpty() ) {
+        return 0.0;
+    }
+
+    // Match the resolution of the former 64x64 raster comparison: points closer
+    // than 1/64 of the extent of both routes are considered to overlap
+    qreal const dx = qMax( routeA.maximum.x, routeB.maximum.x ) - qMin( routeA.minimum.x, routeB.minimum.x );
+    qreal const dy = qMax( routeA.maximum.y, routeB.maximum.y ) - qMin( routeA.minimum.y, routeB.minimum.y );
+    qreal const dz = qMax( routeA.maximum.z, routeB.maximum.z ) - qMin( routeA.minimum.z, routeB.minimum.z );
+    qreal const tolerance = sqrt( dx * dx + dy * dy + dz * dz ) / 64.0;
+    if ( tolerance <= 0.0 ) {
+        return 0.0;
+    }
+
+    qreal const forward = unidirectionalSimilarity( routeA, routeB, tolerance, threshold );
+    if ( forward > threshold ) {
+        return forward;
+    }
+
+    return qMax<qreal>( forward, unidirectionalSimilarity( routeB, routeA, tolerance, threshold ) );
+}
+
+AlternativeRoutesModel::Private::Outline AlternativeRoutesModel::Private::outline( const GeoDataLineString &wayPoints )
+{
+    Outline result;
+    Vector3 const origin = { 0.0, 0.0, 0.0 };
+    result.minimum = origin;
+    result.maximum = origin;
+    if ( wayPoints.isEmpty() ) {
+        return result;
+    }
+
+    QVector<Vector3> points;
+    points.reserve( wayPoints.size() );
+    for ( int i = 0; i < wayPoints.size(); ++i ) {
+        qreal const lon = wayPoints.at( i ).longitude();
+        qreal const lat = wayPoints.at( i ).latitude();
+        Vector3 const point = { cos( lat ) * cos( lon ), cos( lat ) * sin( lon ), sin( lat ) };
+        points << point;
+    }
+
+    result.minimum = points.first();
+    result.maximum = points.first();
+    for( const Vector3 &point: points ) {
+        result.minimum.x = qMin( result.minimum.x, point.x );
+        result.minimum.y = qMin( result.minimum.y, point.y );
+        result.minimum.z = qMin( result.minimum.z, point.z );
+        result.maximum.x = qMax( result.maximum.x, point.x );
+        result.maximum.y = qMax( result.maximum.y, point.y );
+        result.maximum.z = qMax( result.maximum.z, point.z );
+    }
+
+    // Douglas-Peucker simplification with a tolerance well below the one used for comparison
+    qreal const dx = result.maximum.x - result.minimum.x;
+    qreal const dy = result.maximum.y - result.minimum.y;
+    qreal const dz = result.maximum.z - result.minimum.z;
+    qreal const tolerance = ( dx * dx + dy * dy + dz * dz ) / ( 256.0 * 256.0 );
+
+    QVector<bool> keep( points.size(), false );
+    keep.first() = true;
+    keep.last() = true;
+    QVector<QPair<int, int> > ranges;
+    ranges << qMakePair( 0, points.size() - 1 );
+    while ( !ranges.isEmpty() ) {
+        QPair<int, int> const range = ranges.takeLast();
+        qreal maxDistance = -1.0;
+        int maxIndex = -1;
+        for ( int i = range.first + 1; i < range.second; ++i ) {
+            qreal const distance = squaredDistance( points[i], points[range.first], points[range.second] );
+            if ( distance > maxDistance ) {
+                maxDistance = distance;
+                maxIndex = i;
+            }
+        }
+
+        if ( maxIndex >= 0 && maxDistance > tolerance ) {
+            keep[maxIndex] = true;
+            ranges << qMakePair( range.first, maxIndex ) << qMakePair( maxIndex, range.second );
         }
     }
 
-    return false;
+    for ( int i = 0; i < points.size(); ++i ) {
+        if ( keep[i] ) {
+            result.points << points[i];
+        }
+    }
+
+    return result;
 }
 
-qreal AlternativeRoutesModel::Private::similarity( const GeoDataDocument* routeA, const GeoDataDocument* routeB )
+qreal AlternativeRoutesModel::Private::squaredDistance( const Vector3 &point, const Vector3 &a, const Vector3 &b )
 {
-    return qMax<qreal>( unidirectionalSimilarity( routeA, routeB ),
-                        unidirectionalSimilarity( routeB, routeA ) );
+    qreal const abx = b.x - a.x;
+    qreal const aby = b.y - a.y;
+    qreal const abz = b.z - a.z;
+    qreal const apx = point.x - a.x;
+    qreal const apy = point.y - a.y;
+    qreal const apz = point.z - a.z;
+    qreal const length = abx * abx + aby * aby + abz * abz;
+    qreal const t = length > 0.0 ? qBound<qreal>( 0.0, ( apx * abx + apy * aby + apz * abz ) / length, 1.0 ) : 0.0;
+    qreal const x = apx - t * abx;
+    qreal const y = apy - t * aby;
+    qreal const z = apz - t * abz;
+    return x * x + y * y + z * z;
 }
 
 qreal AlternativeRoutesModel::Private::distance( const GeoDataLineString &wayPoints, const GeoDataCoordinates &position )
@@ -196,36 +387,60 @@ qreal AlternativeRoutesModel::Private::distance( const GeoDataCoordinates &satel
     }
 }
 
-qreal AlternativeRoutesModel::Private::unidirectionalSimilarity( const GeoDataDocument* routeA, const GeoDataDocument* routeB )
+qreal AlternativeRoutesModel::Private::unidirectionalSimilarity( const Outline &routeA, const Outline &routeB, qreal tolerance, qreal threshold )
 {
-    const GeoDataLineString* waypointsA = waypoints( routeA );
-    const GeoDataLineString* waypointsB = waypoints( routeB );
-    if ( !waypointsA || !waypointsB )
-    {
-        return 0.0;
-    }
-
-    QImage image( 64, 64, QImage::Format_ARGB32_Premultiplied );
-    image.fill( qRgb( 0, 0, 0 ) );
-    GeoDataLatLonBox box = GeoDataLatLonBox::fromLineString( *waypointsA );
-    box = box.united( GeoDataLatLonBox::fromLineString( *waypointsB ) );
-    if ( !box.width() || !box.height() ) {
-      return 0.0;
+    // Sample routeB in steps of the tolerance and count the samples close to routeA
+    QVector<int> steps;
+    steps.reserve( routeB.points.size() );
+    int samples = 1;
+    for ( int i = 1; i < routeB.points.size(); ++i ) {
+        Vector3 const &a = routeB.points[i-1];
+        Vector3 const &b = routeB.points[i];
+        qreal const length = sqrt( ( b.x - a.x ) * ( b.x - a.x ) + ( b.y - a.y ) * ( b.y - a.y ) + ( b.z - a.z ) * ( b.z - a.z ) );
+        int const step = qMax( 1, int( ceil( length / tolerance ) ) );
+        steps << step;
+        samples += step;
     }
 
-    qreal const sw = image.width() / box.width();
-    qreal const sh = image.height() / box.height();
+    qreal const squaredTolerance = tolerance * tolerance;
+    int const maxMisses = int( ( 1.0 - threshold ) * samples );
+    int misses = 0;
+    int hint = 0;
+    for ( int i = 0; i < routeB.points.size(); ++i ) {
+        int const step = i + 1 < routeB.points.size() ? steps[i] : 1;
+        for ( int j = 0; j < step; ++j ) {
+            Vector3 sample = routeB.points[i];
+            if ( j > 0 ) {
+                Vector3 const &next = routeB.points[i+1];
+                qreal const t = qreal( j ) / step;
+                sample.x += t * ( next.x - sample.x );
+                sample.y += t * ( next.y - sample.y );
+                sample.z += t * ( next.z - sample.z );
+            }
 
-    QPainter painter( &image );
-    painter.setPen( QColor( Qt::white ) );
+            // Consecutive samples are usually close to the same part of routeA
+            bool covered = false;
+            if ( routeA.points.size() == 1 ) {
+                covered = squaredDistance( sample, routeA.points[0], routeA.points[0] ) <= squaredTolerance;
+            } else if ( squaredDistance( sample, routeA.points[hint], routeA.points[hint+1] ) <= squaredTolerance ) {
+                covered = true;
+            } else {
+                for ( int k = 0; k + 1 < routeA.points.size(); ++k ) {
+                    if ( squaredDistance( sample, routeA.points[k], routeA.points[k+1] ) <= squaredTolerance ) {
+                        covered = true;
+                        hint = k;
+                        break;
+                    }
+                }
+            }
 
-    painter.drawPoints( Private::polygon( *waypointsA, box.west(), box.north(), sw, sh ) );
-    int const countA = Private::nonZero( image );
+            if ( !covered && ++misses > maxMisses ) {
+                return qreal( samples - misses ) / samples;
+            }
+        }
+    }
 
-    painter.drawPoints( Private::polygon( *waypointsB, box.west(), box.north(), sw, sh ) );
-    int const countB = Private::nonZero( image );
-    Q_ASSERT( countA <= countB );
-    return countB ? 1.0 - qreal( countB - countA ) / countB : 0;
+    return qreal( samples - misses ) / samples;
 }
 
 bool AlternativeRoutesModel::Private::higherScore( const GeoDataDocument* one, const GeoDataDocument* two )
@@ -350,11 +565,14 @@ void AlternativeRoutesModel::addRestrainedRoutes()
     std::sort( d->m_restrainedRoutes.begin(), d->m_restrainedRoutes.end(), Private::higherScore );
 
     for( GeoDataDocument* route: d->m_restrainedRoutes ) {
-        if ( !d->filter( route ) ) {
+        const GeoDataLineString* lineString = Private::waypoints( route );
+        Private::Outline const outline = Private::outline( lineString ? *lineString : GeoDataLineString() );
+        if ( !d->filter( outline ) ) {
             int affected = d->m_routes.size();
             beginInsertRows( QModelIndex(), affected, affected );
 //            GeoDataDocument* base = d->m_routes.isEmpty() ? 0 : d->m_routes.first();
             d->m_routes.push_back( route );
+            d->m_outlines.push_back( outline );
             endInsertRows();
         }
     }
@@ -366,6 +584,9 @@ void AlternativeRoutesModel::addRestrainedRoutes()
 
 void AlternativeRoutesModel::addRoute( GeoDataDocument* document, WritePolicy policy )
 {
+    const GeoDataLineString* lineString = Private::waypoints( document );
+    GeoDataLineString const wayPoints = lineString ? *lineString : GeoDataLineString();
+
     if (policy != Instant) {
         if (d->m_routes.isEmpty()) {
             d->m_restrainedRoutes.push_back(document);
@@ -380,24 +601,37 @@ void AlternativeRoutesModel::addRoute( GeoDataDocument* document, WritePolicy po
             }
         }
 
-        for ( int i=0; i<d->m_routes.size(); ++i ) {
-            qreal similarity = Private::similarity( document, d->m_routes.at( i ) );
-            if ( similarity > 0.8 ) {
-                if ( Private::higherScore( document, d->m_routes.at( i ) ) ) {
-                    d->m_routes[i] = document;
-                    QModelIndex changed = index( i );
-                    emit dataChanged( changed, changed );
-                }
+        // Simplifying and comparing long routes takes a while, keep the ui responsive
+        // while other routing runners report their results. The worker compares the
+        // route with the outlines known now, addOutlinedRoute() with those added later.
+        Private::OutlineWatcher* watcher = new Private::OutlineWatcher( this );
+        connect( watcher, SIGNAL(finished()), this, SLOT(addOutlinedRoute()) );
+        d->m_pendingRoutes << qMakePair( watcher, document );
+        watcher->setFuture( QtConcurrent::run( &Private::outlineRoute, wayPoints, d->m_outlines ) );
+        return;
+    }
 
-                return;
-            }
+    // Instant routes are shown right away, the outline is needed for later comparisons only
+    const Private::Outline outline = Private::outline( wayPoints );
+    d->insertRoute( this, document, outline, -1 );
+}
+
+void AlternativeRoutesModel::addOutlinedRoute()
+{
+    // Watchers finishing out of order wait for those before them, so they are
+    // deleted here rather than when they finish
+    while ( !d->m_pendingRoutes.isEmpty() && d->m_pendingRoutes.first().first->isFinished() ) {
+        const QPair<Private::OutlineWatcher*, GeoDataDocument*> pending = d->m_pendingRoutes.takeFirst();
+        const Private::OutlinedRoute result = pending.first->result();
+        delete pending.first;
+
+        // Similar routes replace each other, so the index found by the worker is still valid
+        int similarRoute = result.similarRoute;
+        if ( similarRoute < 0 ) {
+            similarRoute = d->similarRoute( result.outline, result.comparedRoutes );
         }
+        d->insertRoute( this, pending.second, result.outline, similarRoute );
     }
-
-    const int affected = d->m_routes.size();
-    beginInsertRows(QModelIndex(), affected, affected);
-    d->m_routes.push_back(document);
-    endInsertRows();
 }
 
 const GeoDataLineString* AlternativeRoutesModel::waypoints( const GeoDataDocument* document )
@@ -428,9 +662,18 @@ void AlternativeRoutesModel::clear()
 {
     beginResetModel();
     QVector<GeoDataDocument*> routes = d->m_routes;
+    QVector<GeoDataDocument*> pendingRoutes;
+    for ( const auto &pending: d->m_pendingRoutes ) {
+        // Deleting the watcher disconnects it, the worker still finishes on its own copy
+        delete pending.first;
+        pendingRoutes << pending.second;
+    }
     d->m_currentIndex = -1;
     d->m_routes.clear();
+    d->m_outlines.clear();
+    d->m_pendingRoutes.clear();
     qDeleteAll(routes);
+    qDeleteAll(pendingRoutes);
     endResetModel();
 }
 
@@ -90,6 +90,8 @@ Q_SIGNALS:
 private Q_SLOTS:
     void addRestrainedRoutes();
 
+    void addOutlinedRoute();
+
 private:
     class Private;
     Private *const d;
@@ -10,14 +10,32 @@
 
 #include "Route.h"
 
+#include "MarbleGlobal.h"
+
+#include <qmath.h>
+
+#include <algorithm>
+
 namespace Marble
 {
 
+namespace
+{
+    /** Number of segments following the last known closest one probed before querying the index */
+    int const positionSearchWindow = 3;
+
+    /** Segments covering more grid cells than this are not put into the index */
+    int const maximumCellsPerSegment = 64;
+}
+
 Route::Route() :
     m_distance( 0.0 ),
     m_travelTime( 0 ),
     m_positionDirty( true ),
-    m_closestSegmentIndex( -1 )
+    m_closestSegmentIndex( -1 ),
+    m_distanceToRoute( -1.0 ),
+    m_cellSize( 0.0 ),
+    m_segmentIndexDirty( true )
 {
     // nothing to do
 }
@@ -36,6 +54,7 @@ void Route::addRouteSegment( const RouteSegment &segment )
         }
         m_segments.push_back( segment );
         m_positionDirty = true;
+        m_segmentIndexDirty = true;
 
         for ( int i=1; i<m_segments.size(); ++i ) {
             m_segments[i-1].setNextRouteSegment(&m_segments[i]);
@@ -99,32 +118,159 @@ GeoDataCoordinates Route::position() const
     return m_position;
 }
 
+quint64 Route::cellKey( int x, int y )
+{
+    return ( quint64( quint32( x ) ) << 32 ) | quint32( y );
+}
+
+void Route::updateSegmentIndex() const
+{
+    m_segmentIndex.clear();
+    m_unindexedSegments.clear();
+
+    // Choose the cell size from the average segment extent such that a
+    // typical segment touches only a few cells
+    qreal extent = 0.0;
+    int indexable = 0;
+    for ( const RouteSegment &segment: m_segments ) {
+        GeoDataLatLonBox const bounds = segment.bounds();
+        if ( !bounds.crossesDateLine() ) {
+            extent += qMax( bounds.width(), bounds.height() );
+            ++indexable;
+        }
+    }
+    m_cellSize = qBound<qreal>( 1.0e-5, indexable > 0 ? extent / indexable : 0.0, 0.05 );
+
+    int const columns = qCeil( 2 * M_PI / m_cellSize );
+    int const rows = qCeil( M_PI / m_cellSize );
+    for ( int i=0; i<m_segments.size(); ++i ) {
+        GeoDataLatLonBox const bounds = m_segments[i].bounds();
+        if ( bounds.crossesDateLine() ) {
+            m_unindexedSegments << i;
+            continue;
+        }
+
+        int const x0 = qBound( 0, qFloor( ( bounds.west() + M_PI ) / m_cellSize ), columns - 1 );
+        int const x1 = qBound( 0, qFloor( ( bounds.east() + M_PI ) / m_cellSize ), columns - 1 );
+        int const y0 = qBound( 0, qFloor( ( bounds.south() + M_PI / 2 ) / m_cellSize ), rows - 1 );
+        int const y1 = qBound( 0, qFloor( ( bounds.north() + M_PI / 2 ) / m_cellSize ), rows - 1 );
+        if ( ( x1 - x0 + 1 ) * ( y1 - y0 + 1 ) > maximumCellsPerSegment ) {
+            m_unindexedSegments << i;
+            continue;
+        }
+
+        for ( int x=x0; x<=x1; ++x ) {
+            for ( int y=y0; y<=y1; ++y ) {
+                m_segmentIndex[cellKey( x, y )] << i;
+            }
+        }
+    }
+
+    m_segmentIndexDirty = false;
+}
+
+void Route::segmentsNear( const GeoDataCoordinates &position, qreal distance, QVector<int> &result ) const
+{
+    result = m_unindexedSegments;
+
+    int const columns = qCeil( 2 * M_PI / m_cellSize );
+    int const rows = qCeil( M_PI / m_cellSize );
+    qreal const radius = 1.01 * distance / EARTH_RADIUS;
+    qreal const south = qMax<qreal>( -M_PI / 2, position.latitude() - radius );
+    qreal const north = qMin<qreal>( M_PI / 2, position.latitude() + radius );
+    int const y0 = qBound( 0, qFloor( ( south + M_PI / 2 ) / m_cellSize ), rows - 1 );
+    int const y1 = qBound( 0, qFloor( ( north + M_PI / 2 ) / m_cellSize ), rows - 1 );
+
+    // Meridians converge towards the poles, widen the longitude range accordingly
+    qreal const cosLatitude = qCos( qMax( qAbs( south ), qAbs( north ) ) );
+    int x0 = 0;
+    int x1 = columns - 1;
+    if ( radius < M_PI * cosLatitude ) {
+        qreal const lonRadius = radius / cosLatitude;
+        x0 = qFloor( ( position.longitude() - lonRadius + M_PI ) / m_cellSize );
+        x1 = qFloor( ( position.longitude() + lonRadius + M_PI ) / m_cellSize );
+        if ( x1 - x0 + 1 >= columns ) {
+            x0 = 0;
+            x1 = columns - 1;
+        }
+    }
+
+    if ( qint64( x1 - x0 + 1 ) * ( y1 - y0 + 1 ) > m_segmentIndex.size() ) {
+        // Cheaper to visit all populated cells than to probe empty ones
+        QHash<quint64, QVector<int> >::const_iterator iter = m_segmentIndex.constBegin();
+        for ( ; iter != m_segmentIndex.constEnd(); ++iter ) {
+            result << iter.value();
+        }
+    } else {
+        for ( int x=x0; x<=x1; ++x ) {
+            // wrap around the date line
+            int const column = ( ( x % columns ) + columns ) % columns;
+            for ( int y=y0; y<=y1; ++y ) {
+                QHash<quint64, QVector<int> >::const_iterator const iter = m_segmentIndex.constFind( cellKey( column, y ) );
+                if ( iter != m_segmentIndex.constEnd() ) {
+                    result << iter.value();
+                }
+            }
+        }
+    }
+
+    std::sort( result.begin(), result.end() );
+    result.erase( std::unique( result.begin(), result.end() ), result.end() );
+}
+
 void Route::updatePosition() const
 {
+    m_distanceToRoute = -1.0;
+
     if ( !m_segments.isEmpty() ) {
+        if ( m_segmentIndexDirty ) {
+            updateSegmentIndex();
+        }
+
         if ( m_closestSegmentIndex < 0 || m_closestSegmentIndex >= m_segments.size() ) {
             m_closestSegmentIndex = 0;
         }
 
+        // Positions usually advance along the route. Probing the segments around
+        // the last closest one first yields a tight upper bound for the distance,
+        // which keeps the index query below small regardless of the route length.
+        int const first = qMax( 0, m_closestSegmentIndex - 1 );
+        int const last = qMin( m_segments.size() - 1, m_closestSegmentIndex + positionSearchWindow );
         qreal distance = m_segments[m_closestSegmentIndex].distanceTo( m_position, m_currentWaypoint, m_positionOnRoute );
-        QList<int> candidates;
 
-        for ( int i=0; i<m_segments.size(); ++i ) {
-            if ( i != m_closestSegmentIndex && m_segments[i].minimalDistanceTo( m_position ) <= distance ) {
-                candidates << i;
+        GeoDataCoordinates closest, interpolated;
+        for ( int i=first; i<=last; ++i ) {
+            if ( i == m_closestSegmentIndex ) {
+                continue;
+            }
+            qreal const dist = m_segments[i].distanceTo( m_position, closest, interpolated );
+            if ( dist < distance ) {
+                distance = dist;
+                m_closestSegmentIndex = i;
+                m_positionOnRoute = interpolated;
+                m_currentWaypoint = closest;
             }
         }
 
-        GeoDataCoordinates closest, interpolated;
+        QVector<int> candidates;
+        segmentsNear( m_position, distance, candidates );
         for( int i: candidates ) {
+            if ( i >= first && i <= last ) {
+                continue;
+            }
+            if ( m_segments[i].minimalDistanceTo( m_position ) > distance ) {
+                continue;
+            }
             qreal const dist = m_segments[i].distanceTo( m_position, closest, interpolated );
-            if ( distance < 0.0 || dist < distance ) {
+            if ( dist < distance ) {
                 distance = dist;
                 m_closestSegmentIndex = i;
                 m_positionOnRoute = interpolated;
                 m_currentWaypoint = closest;
             }
         }
+
+        m_distanceToRoute = distance;
     }
 
     m_positionDirty = false;
@@ -153,6 +299,15 @@ GeoDataCoordinates Route::positionOnRoute() const
     return m_positionOnRoute;
 }
 
+qreal Route::distanceToRoute() const
+{
+    if ( m_positionDirty ) {
+        updatePosition();
+    }
+
+    return m_distanceToRoute;
+}
+
 GeoDataCoordinates Route::currentWaypoint() const
 {
     if ( m_positionDirty ) {
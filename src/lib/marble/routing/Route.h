@@ -14,6 +14,8 @@
 #include "RouteSegment.h"
 #include "GeoDataLatLonBox.h"
 
+#include <QHash>
+
 namespace Marble
 {
 
@@ -52,9 +54,21 @@ public:
 
     GeoDataCoordinates positionOnRoute() const;
 
+    /**
+      * Distance in meters between the current position and the closest point
+      * on the route, or a negative value if the route is empty
+      */
+    qreal distanceToRoute() const;
+
 private:
     void updatePosition() const;
 
+    void updateSegmentIndex() const;
+
+    void segmentsNear( const GeoDataCoordinates &position, qreal distance, QVector<int> &result ) const;
+
+    static quint64 cellKey( int x, int y );
+
     GeoDataLatLonBox m_bounds;
 
     qreal m_distance;
@@ -77,6 +91,18 @@ private:
 
     mutable GeoDataCoordinates m_currentWaypoint;
 
+    mutable qreal m_distanceToRoute;
+
+    /** Uniform lat/lon grid mapping cells to the segments whose bounds touch them */
+    mutable QHash<quint64, QVector<int> > m_segmentIndex;
+
+    /** Segments crossing the date line, checked on every position update */
+    mutable QVector<int> m_unindexedSegments;
+
+    mutable qreal m_cellSize;
+
+    mutable bool m_segmentIndexDirty;
+
     GeoDataCoordinates m_position;
 };
 
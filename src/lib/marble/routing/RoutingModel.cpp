@@ -10,8 +10,6 @@
 
 #include "RoutingModel.h"
 
-#include "Planet.h"
-#include "PlanetFactory.h"
 #include "Route.h"
 #include "RouteRequest.h"
 #include "PositionTracking.h"
@@ -285,8 +283,7 @@ void RoutingModel::updatePosition( const GeoDataCoordinates& location, qreal spe
     d->m_route.setPosition( location );
 
     d->updateViaPoints( location );
-    const qreal planetRadius = PlanetFactory::construct("earth").radius();
-    const qreal distance = planetRadius * location.sphericalDistanceTo(d->m_route.positionOnRoute());
+    const qreal distance = d->m_route.distanceToRoute();
     emit positionChanged();
 
     qreal deviation = 0.0;
@@ -295,7 +292,7 @@ void RoutingModel::updatePosition( const GeoDataCoordinates& location, qreal spe
     }
     qreal const threshold = deviation + qBound(10.0, speed*10.0, 150.0);
 
-    RoutingModelPrivate::RouteDeviation const deviated = distance < threshold ? RoutingModelPrivate::OnRoute : RoutingModelPrivate::OffRoute;
+    RoutingModelPrivate::RouteDeviation const deviated = distance >= 0.0 && distance < threshold ? RoutingModelPrivate::OnRoute : RoutingModelPrivate::OffRoute;
     if ( d->m_deviation != deviated ) {
         d->m_deviation = deviated;
         emit deviatedFromRoute( deviated == RoutingModelPrivate::OffRoute );
@@ -42,9 +42,11 @@ QVector<QPointF> ElevationProfileDataSource::calculateElevationData(const GeoDat
     QVector<QPointF> result;
     qreal distance = 0;
 
+    const QVector<qreal> elevations = getElevations( lineString );
+
     //GeoDataLineString path;
     for ( int i = 0; i < lineString.size(); i++ ) {
-        const qreal ele = getElevation( lineString[i] );
+        const qreal ele = elevations[i];
 
         if ( i ) {
             distance += EARTH_RADIUS * lineString[i-1].sphericalDistanceTo(lineString[i]);
@@ -57,6 +59,17 @@ QVector<QPointF> ElevationProfileDataSource::calculateElevationData(const GeoDat
 
     return result;
 }
+
+QVector<qreal> ElevationProfileDataSource::getElevations(const GeoDataLineString &lineString) const
+{
+    QVector<qreal> result;
+    result.reserve( lineString.size() );
+    for ( const GeoDataCoordinates &coordinates: lineString ) {
+        result << getElevation( coordinates );
+    }
+
+    return result;
+}
 // end of impl of ElevationProfileDataSource
 
 ElevationProfileTrackDataSource::ElevationProfileTrackDataSource( const GeoDataTreeModel *treeModel, QObject *parent ) :
@@ -242,6 +255,12 @@ qreal ElevationProfileRouteDataSource::getElevation(const GeoDataCoordinates &co
     qreal ele = m_elevationModel->height( lon, lat );
     return ele;
 }
+
+QVector<qreal> ElevationProfileRouteDataSource::getElevations(const GeoDataLineString &lineString) const
+{
+    // Samples all points tile by tile instead of one query per point
+    return m_elevationModel->heights( lineString );
+}
 // end of impl of ElevationProfileRouteDataSource
 
 }
@@ -54,6 +54,12 @@ Q_SIGNALS:
 protected:
     QVector<QPointF> calculateElevationData(const GeoDataLineString &lineString) const;
     virtual qreal getElevation(const GeoDataCoordinates &coordinates) const = 0;
+
+    /**
+     * @brief Returns the elevations of all points of @p lineString. The default
+     * implementation calls getElevation() for each point.
+     */
+    virtual QVector<qreal> getElevations(const GeoDataLineString &lineString) const;
 };
 
 /**
@@ -108,6 +114,7 @@ public Q_SLOTS:
 
 protected:
     qreal getElevation(const GeoDataCoordinates &coordinates) const override;
+    QVector<qreal> getElevations(const GeoDataLineString &lineString) const override;
 
 private:
     const RoutingModel *const m_routingModel;
@@ -506,6 +506,12 @@ void ElevationProfileFloatItem::handleDataUpdate(const GeoDataLineString &points
 {
     m_eleData = eleData;
     m_points = points;
+    m_longitudes.resize( m_points.size() );
+    m_latitudes.resize( m_points.size() );
+    for ( int i = 0; i < m_points.size(); ++i ) {
+        m_longitudes[i] = m_points.at( i ).longitude();
+        m_latitudes[i] = m_points.at( i ).latitude();
+    }
     calculateStatistics( m_eleData );
     if ( m_eleData.length() >= 2 ) {
         m_axisX.setRange( m_eleData.first().x(), m_eleData.last().x() );
@@ -521,16 +527,19 @@ void ElevationProfileFloatItem::updateVisiblePoints()
         return;
     }
 
+    // project the whole route at once, it is checked again on every view change
+    const int count = qMin( m_eleData.count(), m_longitudes.size() );
+    QVector<qreal> x( count );
+    QVector<qreal> y( count );
+    QVector<bool> visible( count );
+    m_marbleWidget->viewport()->screenCoordinates( m_longitudes.constData(), m_latitudes.constData(), count,
+                                                   x.data(), y.data(), visible.data() );
+
     // find the longest visible route section on screen
     QList<QList<int> > routeSegments;
     QList<int> currentRouteSegment;
-    for ( int i = 0; i < m_eleData.count(); i++ ) {
-        qreal lon = m_points[i].longitude(GeoDataCoordinates::Degree);
-        qreal lat = m_points[i].latitude (GeoDataCoordinates::Degree);
-        qreal x = 0;
-        qreal y = 0;
-
-        if ( m_marbleWidget->screenCoordinates(lon, lat, x, y) ) {
+    for ( int i = 0; i < count; i++ ) {
+        if ( visible.at( i ) ) {
             // on screen --> add point to list
             currentRouteSegment.append(i);
         } else {
@@ -142,6 +142,9 @@ Q_SIGNALS:
     bool              m_zoomToViewport;
     QVector<QPointF>    m_eleData;
     GeoDataLineString m_points;
+    // m_points in radians, as needed for projecting them all at once
+    QVector<qreal>    m_longitudes;
+    QVector<qreal>    m_latitudes;
     qreal             m_minElevation;
     qreal             m_maxElevation;
     qreal             m_gain;
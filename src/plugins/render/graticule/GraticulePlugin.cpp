@@ -120,6 +120,10 @@ void GraticulePlugin::initialize ()
     
     initLineMaps( GeoDataCoordinates::defaultNotation() );                
 
+    // Grid and labels differ between planets
+    connect( marbleModel(), SIGNAL(themeChanged(QString)),
+             this, SIGNAL(repaintNeeded()) );
+
     m_isInitialized = true;
 }
 
@@ -295,6 +299,18 @@ qreal GraticulePlugin::zValue() const
     return 1.0;
 }
 
+bool GraticulePlugin::supportsRetainedRendering() const
+{
+    // MarbleMap repaints retained layers when the notation changes
+    return true;
+}
+
+bool GraticulePlugin::supportsConcurrentRendering() const
+{
+    // Rendering with a changed notation updates the line maps
+    return m_currentNotation == GeoDataCoordinates::defaultNotation();
+}
+
 void GraticulePlugin::renderGrid( GeoPainter *painter, ViewportParams *viewport,
                                   const QPen& equatorCirclePen,
                                   const QPen& tropicsCirclePen,
@@ -91,6 +91,10 @@ class GraticulePlugin : public RenderPlugin, public DialogConfigurationInterface
 
     qreal zValue() const override;
 
+    bool supportsRetainedRendering() const override;
+
+    bool supportsConcurrentRendering() const override;
+
     QHash<QString,QVariant> settings() const override;
 
     void setSettings( const QHash<QString,QVariant> &settings ) override;
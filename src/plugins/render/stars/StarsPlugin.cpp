@@ -21,6 +21,8 @@
 #include <QColorDialog>
 #include <qmath.h>
 
+#include <algorithm>
+
 #include "MarbleClock.h"
 #include "MarbleDebug.h"
 #include "MarbleDirs.h"
@@ -38,6 +40,13 @@
 namespace Marble
 {
 
+namespace
+{
+    // 16 x 32 cells of about 80 square degrees each
+    const int skyBands = 16;
+    const int skySlices = 32;
+}
+
 StarsPlugin::StarsPlugin( const MarbleModel *marbleModel )
     : RenderPlugin( marbleModel ),
       m_nameIndex( 0 ),
@@ -533,6 +542,8 @@ void StarsPlugin::loadStars()
     //mDebug() << Q_FUNC_INFO;
     // Load star data
     m_stars.clear();
+    m_skyCells.clear();
+    m_idHash.clear();
 
     QFile starFile(MarbleDirs::path(QStringLiteral("stars/stars.dat")));
     starFile.open( QIODevice::ReadOnly );
@@ -560,7 +571,7 @@ void StarsPlugin::loadStars()
 
     int maxid = 0;
     int id = 0;
-    int starIndex = 0;
+    QVector<int> starCells;
     double ra;
     double de;
     double mag;
@@ -586,13 +597,11 @@ void StarsPlugin::loadStars()
         StarPoint star( id, ( qreal )( ra ), ( qreal )( de ), ( qreal )( mag ), colorId );
         // Create entry in stars database
         m_stars << star;
-        // Create key,value pair in idHash table to map from star id to
-        // index in star database vector
-        m_idHash[id] = starIndex;
-        // Increment Index for use in hash
-        ++starIndex;
+        starCells << skyCell( ra, de );
     }
 
+    createSkyCells( starCells );
+
     // load the Sun pixmap
     // TODO: adjust pixmap size according to distance
     m_pixmapSun.load(MarbleDirs::path(QStringLiteral("svg/sun.png")));
@@ -601,6 +610,83 @@ void StarsPlugin::loadStars()
     m_starsLoaded = true;
 }
 
+int StarsPlugin::skyCell( qreal rect, qreal decl )
+{
+    // Equal steps of sin(decl) give bands of equal area
+    const int band = qBound( 0, int( ( qSin( decl ) + 1.0 ) / 2.0 * skyBands ), skyBands - 1 );
+    qreal normalizedRect = fmod( rect, 2 * M_PI );
+    if ( normalizedRect < 0 ) {
+        normalizedRect += 2 * M_PI;
+    }
+    const int slice = qBound( 0, int( normalizedRect / ( 2 * M_PI ) * skySlices ), skySlices - 1 );
+
+    return band * skySlices + slice;
+}
+
+void StarsPlugin::createSkyCells( const QVector<int> &starCells )
+{
+    // Order the stars by cell and by magnitude within each cell
+    QVector<int> order( m_stars.size() );
+    for ( int i = 0; i < order.size(); ++i ) {
+        order[i] = i;
+    }
+    std::sort( order.begin(), order.end(), [&]( int left, int right ) {
+        if ( starCells[left] != starCells[right] ) {
+            return starCells[left] < starCells[right];
+        }
+        return m_stars[left].magnitude() < m_stars[right].magnitude();
+    } );
+
+    m_skyCells.resize( skyBands * skySlices );
+    QVector<int> starCounts( m_skyCells.size(), 0 );
+    for ( int cell: starCells ) {
+        ++starCounts[cell];
+    }
+
+    int begin = 0;
+    for ( int cell = 0; cell < m_skyCells.size(); ++cell ) {
+        const int band = cell / skySlices;
+        const int slice = cell % skySlices;
+        const qreal south = qAsin( -1.0 + 2.0 * band / skyBands );
+        const qreal north = qAsin( -1.0 + 2.0 * ( band + 1 ) / skyBands );
+        const qreal west = 2 * M_PI * slice / skySlices;
+        const qreal east = 2 * M_PI * ( slice + 1 ) / skySlices;
+
+        SkyCell &skyCell = m_skyCells[cell];
+        skyCell.center = Quaternion::fromSpherical( ( west + east ) / 2, qAsin( ( qSin( south ) + qSin( north ) ) / 2 ) );
+
+        // The farthest point is a corner or the middle of the southern or northern edge
+        const qreal boundary[][2] = {
+            { west, south }, { east, south }, { west, north }, { east, north },
+            { ( west + east ) / 2, south }, { ( west + east ) / 2, north }
+        };
+        skyCell.radius = 0.0;
+        for ( const auto &point: boundary ) {
+            const Quaternion q = Quaternion::fromSpherical( point[0], point[1] );
+            const qreal dx = q.v[Q_X] - skyCell.center.v[Q_X];
+            const qreal dy = q.v[Q_Y] - skyCell.center.v[Q_Y];
+            const qreal dz = q.v[Q_Z] - skyCell.center.v[Q_Z];
+            skyCell.radius = qMax( skyCell.radius, qSqrt( dx * dx + dy * dy + dz * dz ) );
+        }
+
+        skyCell.begin = begin;
+        begin += starCounts[cell];
+        skyCell.end = begin;
+    }
+
+    QVector<StarPoint> stars;
+    stars.reserve( m_stars.size() );
+    for ( int index: order ) {
+        const StarPoint &star = m_stars[index];
+        // Create key,value pair in idHash table to map from star id to
+        // index in star database vector
+        m_idHash[star.id()] = stars.size();
+        stars << star;
+    }
+
+    m_stars = stars;
+}
+
 void StarsPlugin::createStarPixmaps()
 {
     // Load star pixmaps
@@ -1064,37 +1150,54 @@ bool StarsPlugin::render( GeoPainter *painter, ViewportParams *viewport,
 
         // Render Stars
 
-        for ( int s = 0; s < m_stars.size(); ++s  ) {
-            Quaternion  qpos = m_stars.at(s).quaternion();
-
-            qpos.rotateAroundAxis( skyAxisMatrix );
-
-            if ( qpos.v[Q_Z] > 0 ) {
+        for ( const SkyCell &cell: m_skyCells ) {
+            Quaternion center = cell.center;
+            center.rotateAroundAxis( skyAxisMatrix );
+
+            // Skip cells behind the observer or outside the screen area
+            const qreal centerX = viewport->width()  / 2 + skyRadius * center.v[Q_X];
+            const qreal centerY = viewport->height() / 2 - skyRadius * center.v[Q_Y];
+            const qreal margin = skyRadius * cell.radius;
+            if ( center.v[Q_Z] > cell.radius
+                 || centerX + margin < 0 || centerX - margin >= viewport->width()
+                 || centerY + margin < 0 || centerY - margin >= viewport->height() ) {
                 continue;
             }
 
-            qreal  earthCenteredX = qpos.v[Q_X] * skyRadius;
-            qreal  earthCenteredY = qpos.v[Q_Y] * skyRadius;
+            for ( int s = cell.begin; s < cell.end; ++s ) {
+                // Show star if it is brighter than magnitude threshold,
+                // all remaining stars of the cell are fainter
+                if ( m_stars.at(s).magnitude() >= m_magnitudeLimit ) {
+                    break;
+                }
 
-            // Don't draw high placemarks (e.g. satellites) that aren't visible.
-            if ( qpos.v[Q_Z] < 0
-                    && ( ( earthCenteredX * earthCenteredX
-                           + earthCenteredY * earthCenteredY )
-                         < earthRadius * earthRadius ) ) {
-                continue;
-            }
+                Quaternion  qpos = m_stars.at(s).quaternion();
 
-            // Let (x, y) be the position on the screen of the placemark..
-            const int x = ( int )( viewport->width()  / 2 + skyRadius * qpos.v[Q_X] );
-            const int y = ( int )( viewport->height() / 2 - skyRadius * qpos.v[Q_Y] );
+                qpos.rotateAroundAxis( skyAxisMatrix );
 
-            // Skip placemarks that are outside the screen area
-            if ( x < 0 || x >= viewport->width()
-                    || y < 0 || y >= viewport->height() )
-                continue;
+                if ( qpos.v[Q_Z] > 0 ) {
+                    continue;
+                }
+
+                qreal  earthCenteredX = qpos.v[Q_X] * skyRadius;
+                qreal  earthCenteredY = qpos.v[Q_Y] * skyRadius;
 
-            // Show star if it is brighter than magnitude threshold
-            if ( m_stars.at(s).magnitude() < m_magnitudeLimit ) {
+                // Don't draw high placemarks (e.g. satellites) that aren't visible.
+                if ( qpos.v[Q_Z] < 0
+                        && ( ( earthCenteredX * earthCenteredX
+                               + earthCenteredY * earthCenteredY )
+                             < earthRadius * earthRadius ) ) {
+                    continue;
+                }
+
+                // Let (x, y) be the position on the screen of the placemark..
+                const int x = ( int )( viewport->width()  / 2 + skyRadius * qpos.v[Q_X] );
+                const int y = ( int )( viewport->height() / 2 - skyRadius * qpos.v[Q_Y] );
+
+                // Skip placemarks that are outside the screen area
+                if ( x < 0 || x >= viewport->width()
+                        || y < 0 || y >= viewport->height() )
+                    continue;
 
                 // colorId is used to select which pixmap in vector to display
                 int colorId = m_stars.at(s).colorId();
@@ -220,6 +220,7 @@ private:
                       matrix &skyAxisMatrix) const;
     void createStarPixmaps();
     void loadStars();
+    void createSkyCells( const QVector<int> &starCells );
     void loadConstellations();
     void loadDsos();
     QPointer<QDialog> m_configDialog;
@@ -241,7 +242,25 @@ private:
     bool m_dsosLoaded;
     bool m_zoomSunMoon;
     bool m_viewSolarSystemLabel;
+    /**
+     * A patch of the sky. The sky is split into declination bands of equal
+     * area, each divided into slices of equal right ascension, so all cells
+     * cover the same area. m_stars is ordered by cell and by increasing
+     * magnitude within each cell.
+     */
+    struct SkyCell
+    {
+        Quaternion center;
+        // Distance from the center to the farthest point of the cell on the unit sphere
+        qreal radius;
+        int begin;
+        int end;
+    };
+
+    static int skyCell( qreal rect, qreal decl );
+
     QVector<StarPoint> m_stars;
+    QVector<SkyCell> m_skyCells;
     QPixmap m_pixmapSun;
     QPixmap m_pixmapMoon;
     QVector<Constellation> m_constellations;
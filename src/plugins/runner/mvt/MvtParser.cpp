@@ -0,0 +1,623 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "MvtParser.h"
+
+#include "MvtTile.h"
+
+#include "GeoDataBuilding.h"
+#include "GeoDataDocument.h"
+#include "GeoDataLinearRing.h"
+#include "GeoDataMultiGeometry.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPoint.h"
+#include "GeoDataPolygon.h"
+#include "MarbleDebug.h"
+#include "StyleBuilder.h"
+#include "osm/OsmPlacemarkData.h"
+
+#include <QSet>
+#include <QVector>
+#include <QtEndian>
+
+#include <cstring>
+
+namespace Marble
+{
+
+namespace
+{
+
+/**
+ * Reads the fields of a protocol buffer message without copying it.
+ * Once malformed data is encountered, hasError() is set and no more fields are returned.
+ */
+class ProtobufReader
+{
+public:
+    ProtobufReader( const char *begin, const char *end ) :
+        m_position( begin ),
+        m_end( end ),
+        m_field( 0 ),
+        m_wireType( 0 ),
+        m_error( false )
+    {
+    }
+
+    bool next()
+    {
+        if ( m_error || m_position >= m_end ) {
+            return false;
+        }
+
+        quint64 const key = varint();
+        m_field = quint32( key >> 3 );
+        m_wireType = int( key & 0x7 );
+        return !m_error;
+    }
+
+    quint32 field() const
+    {
+        return m_field;
+    }
+
+    int wireType() const
+    {
+        return m_wireType;
+    }
+
+    bool atEnd() const
+    {
+        return m_error || m_position >= m_end;
+    }
+
+    bool hasError() const
+    {
+        return m_error;
+    }
+
+    void setError()
+    {
+        m_error = true;
+    }
+
+    quint64 varint()
+    {
+        quint64 result = 0;
+        for ( int shift = 0; shift < 64 && m_position < m_end; shift += 7 ) {
+            quint8 const byte = quint8( *m_position++ );
+            result |= quint64( byte & 0x7f ) << shift;
+            if ( !( byte & 0x80 ) ) {
+                return result;
+            }
+        }
+
+        m_error = true;
+        return 0;
+    }
+
+    quint32 fixed32()
+    {
+        if ( !advance( 4 ) ) {
+            return 0;
+        }
+        return qFromLittleEndian<quint32>( reinterpret_cast<const uchar*>( m_position - 4 ) );
+    }
+
+    quint64 fixed64()
+    {
+        if ( !advance( 8 ) ) {
+            return 0;
+        }
+        return qFromLittleEndian<quint64>( reinterpret_cast<const uchar*>( m_position - 8 ) );
+    }
+
+    /** Returns a reader for the current length delimited field */
+    ProtobufReader message()
+    {
+        quint64 const length = varint();
+        if ( m_error || length > quint64( m_end - m_position ) ) {
+            m_error = true;
+            return ProtobufReader( m_end, m_end );
+        }
+
+        ProtobufReader const result( m_position, m_position + length );
+        m_position += length;
+        return result;
+    }
+
+    QString string()
+    {
+        ProtobufReader const bytes = message();
+        return QString::fromUtf8( bytes.m_position, int( bytes.m_end - bytes.m_position ) );
+    }
+
+    /** Appends the values of a packed (or single unpacked) repeated varint field */
+    void packedVarints( QVector<quint32> &values )
+    {
+        if ( m_wireType == Mvt::Varint ) {
+            values << quint32( varint() );
+        } else if ( m_wireType == Mvt::LengthDelimited ) {
+            ProtobufReader packed = message();
+            while ( !packed.atEnd() ) {
+                values << quint32( packed.varint() );
+            }
+            m_error = m_error || packed.hasError();
+        } else {
+            m_error = true;
+        }
+    }
+
+    void skip()
+    {
+        switch ( m_wireType ) {
+        case Mvt::Varint:
+            varint();
+            break;
+        case Mvt::Fixed64:
+            advance( 8 );
+            break;
+        case Mvt::LengthDelimited:
+            message();
+            break;
+        case Mvt::Fixed32:
+            advance( 4 );
+            break;
+        default:
+            m_error = true;
+        }
+    }
+
+private:
+    bool advance( int bytes )
+    {
+        if ( m_end - m_position < bytes ) {
+            m_error = true;
+            return false;
+        }
+        m_position += bytes;
+        return true;
+    }
+
+    const char *m_position;
+    const char *m_end;
+    quint32 m_field;
+    int m_wireType;
+    bool m_error;
+};
+
+typedef QVector<QPoint> TilePath;
+
+class LayerParser
+{
+public:
+    LayerParser( const MvtTile &tile, GeoDataDocument *document ) :
+        m_tile( tile ),
+        m_document( document ),
+        m_extent( Mvt::defaultExtent )
+    {
+    }
+
+    bool parse( ProtobufReader reader );
+
+private:
+    bool parseValue( ProtobufReader reader );
+    bool parseFeature( ProtobufReader reader );
+    static bool decodePaths( const QVector<quint32> &commands, QVector<TilePath> &paths );
+
+    GeoDataGeometry *createPoints( const QVector<TilePath> &paths ) const;
+    GeoDataGeometry *createLineStrings( const QVector<TilePath> &paths ) const;
+    GeoDataGeometry *createPolygons( const QVector<TilePath> &paths, const OsmPlacemarkData &osmData ) const;
+    GeoDataLinearRing createRing( const TilePath &path ) const;
+
+    static qint64 signedArea( const TilePath &path );
+    static bool isBuilding( const OsmPlacemarkData &osmData );
+    static QString buildingName( const OsmPlacemarkData &osmData );
+    static double buildingHeight( const OsmPlacemarkData &osmData );
+
+    const MvtTile m_tile;
+    GeoDataDocument *const m_document;
+    quint32 m_extent;
+    QVector<QString> m_keys;
+    QVector<QString> m_values;
+};
+
+bool LayerParser::parse( ProtobufReader reader )
+{
+    // Keys and values may follow the features, so decode those last
+    QVector<ProtobufReader> features;
+    while ( reader.next() ) {
+        switch ( reader.field() ) {
+        case Mvt::LayerFeatures:
+            features << reader.message();
+            break;
+        case Mvt::LayerKeys:
+            m_keys << reader.string();
+            break;
+        case Mvt::LayerValues:
+            if ( !parseValue( reader.message() ) ) {
+                return false;
+            }
+            break;
+        case Mvt::LayerExtent:
+            m_extent = quint32( reader.varint() );
+            break;
+        default:
+            // name and version are not needed
+            reader.skip();
+        }
+    }
+
+    if ( reader.hasError() || m_extent == 0 ) {
+        return false;
+    }
+
+    for( const ProtobufReader &feature: features ) {
+        if ( !parseFeature( feature ) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LayerParser::parseValue( ProtobufReader reader )
+{
+    QString value;
+    while ( reader.next() ) {
+        switch ( reader.field() ) {
+        case Mvt::StringValue:
+            value = reader.string();
+            break;
+        case Mvt::FloatValue: {
+            quint32 const bits = reader.fixed32();
+            float number;
+            std::memcpy( &number, &bits, sizeof( number ) );
+            value = QString::number( number );
+            break;
+        }
+        case Mvt::DoubleValue: {
+            quint64 const bits = reader.fixed64();
+            double number;
+            std::memcpy( &number, &bits, sizeof( number ) );
+            value = QString::number( number, 'g', 15 );
+            break;
+        }
+        case Mvt::IntValue:
+            value = QString::number( qint64( reader.varint() ) );
+            break;
+        case Mvt::UIntValue:
+            value = QString::number( reader.varint() );
+            break;
+        case Mvt::SIntValue: {
+            quint64 const bits = reader.varint();
+            value = QString::number( qint64( bits >> 1 ) ^ -qint64( bits & 1 ) );
+            break;
+        }
+        case Mvt::BoolValue:
+            value = reader.varint() ? QStringLiteral( "yes" ) : QStringLiteral( "no" );
+            break;
+        default:
+            reader.skip();
+        }
+    }
+
+    m_values << value;
+    return !reader.hasError();
+}
+
+bool LayerParser::parseFeature( ProtobufReader reader )
+{
+    OsmPlacemarkData osmData;
+    QVector<quint32> tags;
+    QVector<quint32> commands;
+    quint64 type = Mvt::Unknown;
+
+    while ( reader.next() ) {
+        switch ( reader.field() ) {
+        case Mvt::FeatureId:
+            osmData.setId( qint64( reader.varint() ) );
+            break;
+        case Mvt::FeatureTags:
+            reader.packedVarints( tags );
+            break;
+        case Mvt::FeatureType:
+            type = reader.varint();
+            break;
+        case Mvt::FeatureGeometry:
+            reader.packedVarints( commands );
+            break;
+        default:
+            reader.skip();
+        }
+    }
+
+    if ( reader.hasError() || tags.size() % 2 != 0 ) {
+        return false;
+    }
+
+    for ( int i = 0; i < tags.size(); i += 2 ) {
+        if ( tags[i] >= quint32( m_keys.size() ) || tags[i+1] >= quint32( m_values.size() ) ) {
+            return false;
+        }
+        osmData.addTag( m_keys[tags[i]], m_values[tags[i+1]] );
+    }
+
+    QVector<TilePath> paths;
+    if ( !decodePaths( commands, paths ) ) {
+        return false;
+    }
+
+    GeoDataPlacemark::GeoDataVisualCategory const category = StyleBuilder::determineVisualCategory( osmData );
+    GeoDataGeometry *geometry = nullptr;
+    switch ( type ) {
+    case Mvt::Point:
+        // Like OsmNode, points without a style would only add clutter
+        if ( category != GeoDataPlacemark::None ) {
+            geometry = createPoints( paths );
+        }
+        break;
+    case Mvt::LineString:
+        geometry = createLineStrings( paths );
+        break;
+    case Mvt::Polygon:
+        geometry = createPolygons( paths, osmData );
+        break;
+    default:
+        // unknown geometry types are to be ignored
+        break;
+    }
+
+    if ( !geometry ) {
+        return true;
+    }
+
+    GeoDataPlacemark *placemark = new GeoDataPlacemark;
+    placemark->setGeometry( geometry );
+    placemark->setVisualCategory( category );
+    placemark->setName( osmData.tagValue( QStringLiteral( "name" ) ) );
+    if ( placemark->name().isEmpty() ) {
+        placemark->setName( osmData.tagValue( QStringLiteral( "ref" ) ) );
+    }
+    placemark->setOsmData( osmData );
+    placemark->setZoomLevel( StyleBuilder::minimumZoomLevel( category ) );
+    placemark->setPopularity( StyleBuilder::popularity( placemark ) );
+    placemark->setVisible( category != GeoDataPlacemark::None );
+    m_document->append( placemark );
+
+    return true;
+}
+
+bool LayerParser::decodePaths( const QVector<quint32> &commands, QVector<TilePath> &paths )
+{
+    // The cursor is not reset between paths, all parameters are relative to the previous point
+    QPoint cursor;
+    int i = 0;
+    while ( i < commands.size() ) {
+        quint32 const id = commands[i] & 0x7;
+        quint32 const count = commands[i] >> 3;
+        ++i;
+
+        if ( id == Mvt::ClosePath ) {
+            if ( paths.isEmpty() ) {
+                return false;
+            }
+            continue;
+        }
+
+        if ( ( id != Mvt::MoveTo && id != Mvt::LineTo ) || 2 * quint64( count ) > quint64( commands.size() - i ) ) {
+            return false;
+        }
+        if ( id == Mvt::LineTo && paths.isEmpty() ) {
+            return false;
+        }
+
+        for ( quint32 j = 0; j < count; ++j ) {
+            cursor += QPoint( Mvt::zigzagDecode( commands[i] ), Mvt::zigzagDecode( commands[i+1] ) );
+            i += 2;
+            if ( id == Mvt::MoveTo ) {
+                paths << TilePath();
+            }
+            paths.last() << cursor;
+        }
+    }
+
+    return true;
+}
+
+GeoDataGeometry *LayerParser::createPoints( const QVector<TilePath> &paths ) const
+{
+    if ( paths.isEmpty() ) {
+        return nullptr;
+    }
+
+    if ( paths.size() == 1 ) {
+        return new GeoDataPoint( m_tile.coordinates( paths.first().first(), m_extent ) );
+    }
+
+    GeoDataMultiGeometry *multiGeometry = new GeoDataMultiGeometry;
+    for( const TilePath &path: paths ) {
+        multiGeometry->append( new GeoDataPoint( m_tile.coordinates( path.first(), m_extent ) ) );
+    }
+    return multiGeometry;
+}
+
+GeoDataGeometry *LayerParser::createLineStrings( const QVector<TilePath> &paths ) const
+{
+    QVector<GeoDataLineString*> lineStrings;
+    for( const TilePath &path: paths ) {
+        if ( path.size() < 2 ) {
+            continue;
+        }
+
+        GeoDataLineString *lineString = new GeoDataLineString;
+        lineString->reserve( path.size() );
+        for( const QPoint &point: path ) {
+            lineString->append( m_tile.coordinates( point, m_extent ) );
+        }
+        lineStrings << lineString;
+    }
+
+    if ( lineStrings.size() < 2 ) {
+        return lineStrings.isEmpty() ? nullptr : lineStrings.first();
+    }
+
+    GeoDataMultiGeometry *multiGeometry = new GeoDataMultiGeometry;
+    for( GeoDataLineString *lineString: lineStrings ) {
+        multiGeometry->append( lineString );
+    }
+    return multiGeometry;
+}
+
+GeoDataGeometry *LayerParser::createPolygons( const QVector<TilePath> &paths, const OsmPlacemarkData &osmData ) const
+{
+    // Each ring with a positive area starts a new polygon, the following
+    // rings with a negative area are its holes
+    QVector<GeoDataGeometry*> polygons;
+    GeoDataPolygon *polygon = nullptr;
+    GeoDataLinearRing outerRing;
+    for( const TilePath &path: paths ) {
+        qint64 const area = signedArea( path );
+        if ( area > 0 ) {
+            if ( polygon ) {
+                polygons << polygon;
+                polygon = nullptr;
+            } else if ( !outerRing.isEmpty() ) {
+                polygons << new GeoDataLinearRing( outerRing );
+            }
+            outerRing = createRing( path );
+        } else if ( area < 0 && !outerRing.isEmpty() ) {
+            if ( !polygon ) {
+                polygon = new GeoDataPolygon;
+                polygon->setOuterBoundary( outerRing );
+            }
+            polygon->appendInnerBoundary( createRing( path ) );
+        }
+    }
+
+    if ( polygon ) {
+        polygons << polygon;
+    } else if ( !outerRing.isEmpty() ) {
+        polygons << new GeoDataLinearRing( outerRing );
+    }
+
+    if ( polygons.isEmpty() ) {
+        return nullptr;
+    }
+
+    if ( isBuilding( osmData ) ) {
+        GeoDataBuilding *building = new GeoDataBuilding;
+        building->setName( buildingName( osmData ) );
+        building->setHeight( buildingHeight( osmData ) );
+        for( GeoDataGeometry *geometry: polygons ) {
+            building->multiGeometry()->append( geometry );
+        }
+        return building;
+    }
+
+    if ( polygons.size() == 1 ) {
+        return polygons.first();
+    }
+
+    GeoDataMultiGeometry *multiGeometry = new GeoDataMultiGeometry;
+    for( GeoDataGeometry *geometry: polygons ) {
+        multiGeometry->append( geometry );
+    }
+    return multiGeometry;
+}
+
+GeoDataLinearRing LayerParser::createRing( const TilePath &path ) const
+{
+    GeoDataLinearRing ring;
+    ring.reserve( path.size() );
+    for( const QPoint &point: path ) {
+        ring.append( m_tile.coordinates( point, m_extent ) );
+    }
+    return ring;
+}
+
+qint64 LayerParser::signedArea( const TilePath &path )
+{
+    // Twice the area in tile coordinates (y pointing down), positive for exterior rings
+    qint64 area = 0;
+    for ( int i = 0, n = path.size(); i < n; ++i ) {
+        QPoint const &a = path[i];
+        QPoint const &b = path[( i + 1 ) % n];
+        area += qint64( a.x() ) * b.y() - qint64( b.x() ) * a.y();
+    }
+    return area;
+}
+
+bool LayerParser::isBuilding( const OsmPlacemarkData &osmData )
+{
+    static const QSet<StyleBuilder::OsmTag> buildingTags = StyleBuilder::buildingTags();
+
+    for ( auto iter = osmData.tagsBegin(), end = osmData.tagsEnd(); iter != end; ++iter ) {
+        if ( buildingTags.contains( StyleBuilder::OsmTag( iter.key(), iter.value() ) ) ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QString LayerParser::buildingName( const OsmPlacemarkData &osmData )
+{
+    auto tagIter = osmData.findTag( QStringLiteral( "addr:housename" ) );
+    if ( tagIter != osmData.tagsEnd() ) {
+        return tagIter.value();
+    }
+
+    return osmData.tagValue( QStringLiteral( "addr:housenumber" ) );
+}
+
+double LayerParser::buildingHeight( const OsmPlacemarkData &osmData )
+{
+    double height = 8.0;
+
+    QHash<QString, QString>::const_iterator tagIter;
+    if ( ( tagIter = osmData.findTag( QStringLiteral( "height" ) ) ) != osmData.tagsEnd() ) {
+        height = GeoDataBuilding::parseBuildingHeight( tagIter.value() );
+    } else if ( ( tagIter = osmData.findTag( QStringLiteral( "building:levels" ) ) ) != osmData.tagsEnd() ) {
+        int const levels = tagIter.value().toInt();
+        int const skipLevels = osmData.tagValue( QStringLiteral( "building:min_level" ) ).toInt();
+        height = 3.0 * qBound( 1, 1 + levels - skipLevels, 35 );
+    }
+
+    return qBound( 1.0, height, 1000.0 );
+}
+
+}
+
+GeoDataDocument *MvtParser::parse( const QByteArray &data, const MvtTile &tile, QString &error )
+{
+    GeoDataDocument *document = new GeoDataDocument;
+
+    ProtobufReader reader( data.constData(), data.constData() + data.size() );
+    while ( reader.next() ) {
+        if ( reader.field() == Mvt::TileLayers && reader.wireType() == Mvt::LengthDelimited ) {
+            LayerParser layer( tile, document );
+            if ( !layer.parse( reader.message() ) ) {
+                reader.setError();
+            }
+        } else {
+            reader.skip();
+        }
+    }
+
+    if ( reader.hasError() ) {
+        error = QStringLiteral( "Malformed vector tile %1" ).arg( tile.name() );
+        mDebug() << error;
+        delete document;
+        return nullptr;
+    }
+
+    return document;
+}
+
+}
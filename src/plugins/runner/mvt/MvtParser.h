@@ -0,0 +1,38 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_MVTPARSER_H
+#define MARBLE_MVTPARSER_H
+
+#include <QByteArray>
+#include <QString>
+
+namespace Marble
+{
+
+class GeoDataDocument;
+class MvtTile;
+
+/**
+ * Decodes Mapbox Vector Tiles directly into placemarks. Feature properties
+ * are treated as OpenStreetMap tags, so that the placemarks are styled like
+ * those of OsmParser.
+ */
+class MvtParser
+{
+public:
+    /**
+     * Decodes the vector tile @p data covering @p tile.
+     * @return a new document, or nullptr with @p error set if @p data is malformed
+     */
+    static GeoDataDocument* parse( const QByteArray &data, const MvtTile &tile, QString &error );
+};
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "MvtPlugin.h"
+#include "MvtRunner.h"
+
+namespace Marble
+{
+
+MvtPlugin::MvtPlugin( QObject *parent ) :
+    ParseRunnerPlugin( parent )
+{
+}
+
+QString MvtPlugin::name() const
+{
+    return tr( "Mapbox Vector Tile Parser" );
+}
+
+QString MvtPlugin::nameId() const
+{
+    return QStringLiteral("Mvt");
+}
+
+QString MvtPlugin::version() const
+{
+    return QStringLiteral("1.0");
+}
+
+QString MvtPlugin::description() const
+{
+    return tr( "Create GeoDataDocument from Mapbox Vector Tiles" );
+}
+
+QString MvtPlugin::copyrightYears() const
+{
+    return QStringLiteral("2026");
+}
+
+QVector<PluginAuthor> MvtPlugin::pluginAuthors() const
+{
+    return QVector<PluginAuthor>()
+            << PluginAuthor(QStringLiteral("Marble Developers"), QStringLiteral("marble-devel@kde.org"));
+}
+
+QString MvtPlugin::fileFormatDescription() const
+{
+    return tr( "Mapbox Vector Tiles" );
+}
+
+QStringList MvtPlugin::fileExtensions() const
+{
+    return QStringList() << QStringLiteral("mvt");
+}
+
+ParsingRunner* MvtPlugin::newRunner() const
+{
+    return new MvtRunner;
+}
+
+}
+
+#include "moc_MvtPlugin.cpp"
@@ -0,0 +1,46 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_MVTPLUGIN_H
+#define MARBLE_MVTPLUGIN_H
+
+#include "ParseRunnerPlugin.h"
+
+namespace Marble
+{
+
+class MvtPlugin : public ParseRunnerPlugin
+{
+    Q_OBJECT
+    Q_PLUGIN_METADATA(IID "org.kde.marble.MvtPlugin")
+    Q_INTERFACES( Marble::ParseRunnerPlugin )
+
+public:
+    explicit MvtPlugin( QObject *parent = nullptr );
+
+    QString name() const override;
+
+    QString nameId() const override;
+
+    QString version() const override;
+
+    QString description() const override;
+
+    QString copyrightYears() const override;
+
+    QVector<PluginAuthor> pluginAuthors() const override;
+
+    QString fileFormatDescription() const override;
+
+    QStringList fileExtensions() const override;
+
+    ParsingRunner* newRunner() const override;
+};
+
+}
+#endif // MARBLE_MVTPLUGIN_H
@@ -0,0 +1,55 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "MvtRunner.h"
+
+#include "GeoDataDocument.h"
+#include "MvtParser.h"
+#include "MvtTile.h"
+#include "MarbleDebug.h"
+
+#include <QFile>
+
+namespace Marble
+{
+
+MvtRunner::MvtRunner(QObject *parent) :
+    ParsingRunner(parent)
+{
+}
+
+GeoDataDocument *MvtRunner::parseFile(const QString &fileName, DocumentRole role, QString &error)
+{
+    // Tile coordinates are relative to the tile, so its position must be known.
+    // Tiles are stored as <zoom>/<x>/<y>.mvt like all other vector tiles.
+    MvtTile tile;
+    if (!MvtTile::fromPath(fileName, tile)) {
+        error = QStringLiteral("Cannot determine the tile of %1, expected a path like z/x/y.mvt").arg(fileName);
+        mDebug() << error;
+        return nullptr;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = QStringLiteral("Cannot open file %1").arg(fileName);
+        mDebug() << error;
+        return nullptr;
+    }
+
+    GeoDataDocument* document = MvtParser::parse(file.readAll(), tile, error);
+    if (document) {
+        document->setDocumentRole(role);
+        document->setFileName(fileName);
+        document->setName(tile.name());
+    }
+    return document;
+}
+
+}
+
+#include "moc_MvtRunner.cpp"
@@ -0,0 +1,26 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_MVTRUNNER_H
+#define MARBLE_MVTRUNNER_H
+
+#include "ParsingRunner.h"
+
+namespace Marble
+{
+
+class MvtRunner : public ParsingRunner
+{
+    Q_OBJECT
+public:
+    explicit MvtRunner(QObject *parent = nullptr);
+    GeoDataDocument* parseFile( const QString &fileName, DocumentRole role, QString& error ) override;
+};
+
+}
+#endif // MARBLE_MVTRUNNER_H
@@ -0,0 +1,99 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "MvtTile.h"
+
+#include "GeoDataCoordinates.h"
+#include "MarbleGlobal.h"
+#include "MarbleMath.h"
+
+#include <QDir>
+#include <QStringList>
+
+namespace Marble
+{
+
+MvtTile::MvtTile( int zoomLevel, int x, int y ) :
+    m_zoomLevel( zoomLevel ),
+    m_x( x ),
+    m_y( y )
+{
+}
+
+bool MvtTile::fromPath( const QString &path, MvtTile &tile )
+{
+    QStringList const parts = QDir::fromNativeSeparators( path ).split( QLatin1Char( '/' ) );
+    if ( parts.size() < 3 ) {
+        return false;
+    }
+
+    bool ok[3];
+    int const zoomLevel = parts.at( parts.size() - 3 ).toInt( &ok[0] );
+    int const x = parts.at( parts.size() - 2 ).toInt( &ok[1] );
+    int const y = parts.last().section( QLatin1Char( '.' ), 0, 0 ).toInt( &ok[2] );
+    if ( !ok[0] || !ok[1] || !ok[2] || zoomLevel < 0 || zoomLevel > 30 ) {
+        return false;
+    }
+
+    int const tileCount = 1 << zoomLevel;
+    if ( x < 0 || x >= tileCount || y < 0 || y >= tileCount ) {
+        return false;
+    }
+
+    tile = MvtTile( zoomLevel, x, y );
+    return true;
+}
+
+QString MvtTile::name() const
+{
+    return QStringLiteral( "%1/%2/%3" ).arg( m_zoomLevel ).arg( m_x ).arg( m_y );
+}
+
+int MvtTile::zoomLevel() const
+{
+    return m_zoomLevel;
+}
+
+int MvtTile::x() const
+{
+    return m_x;
+}
+
+int MvtTile::y() const
+{
+    return m_y;
+}
+
+GeoDataCoordinates MvtTile::coordinates( const QPoint &position, quint32 extent ) const
+{
+    qreal const tileCount = 1 << m_zoomLevel;
+    qreal const x = ( m_x + qreal( position.x() ) / extent ) / tileCount;
+    qreal const y = ( m_y + qreal( position.y() ) / extent ) / tileCount;
+
+    qreal const lon = x * 2 * M_PI - M_PI;
+    qreal const lat = gd( M_PI * ( 1.0 - 2.0 * y ) );
+    return GeoDataCoordinates( lon, lat );
+}
+
+QPoint MvtTile::position( const GeoDataCoordinates &coordinates, quint32 extent ) const
+{
+    // Mercator is undefined at the poles, clamp to the latitude of the map edge
+    static const qreal maxLat = gd( M_PI );
+
+    qreal const tileCount = 1 << m_zoomLevel;
+    qreal const lat = qBound( -maxLat, coordinates.latitude(), maxLat );
+    qreal const x = ( coordinates.longitude() + M_PI ) / ( 2 * M_PI ) * tileCount - m_x;
+    qreal const y = ( 1.0 - gdInv( lat ) / M_PI ) / 2.0 * tileCount - m_y;
+
+    // Keep far away coordinates and their deltas within the range of qint32
+    qreal const limit = 1 << 28;
+    return QPoint( qRound( qBound( -limit, x * extent, limit ) ),
+                   qRound( qBound( -limit, y * extent, limit ) ) );
+}
+
+}
@@ -0,0 +1,131 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_MVTTILE_H
+#define MARBLE_MVTTILE_H
+
+#include <QPoint>
+#include <QString>
+
+namespace Marble
+{
+
+class GeoDataCoordinates;
+
+/**
+ * Field numbers and constants of the Mapbox Vector Tile specification 2.1,
+ * see https://github.com/mapbox/vector-tile-spec
+ */
+namespace Mvt
+{
+    enum TileField { TileLayers = 3 };
+
+    enum LayerField {
+        LayerName = 1,
+        LayerFeatures = 2,
+        LayerKeys = 3,
+        LayerValues = 4,
+        LayerExtent = 5,
+        LayerVersion = 15
+    };
+
+    enum ValueField {
+        StringValue = 1,
+        FloatValue = 2,
+        DoubleValue = 3,
+        IntValue = 4,
+        UIntValue = 5,
+        SIntValue = 6,
+        BoolValue = 7
+    };
+
+    enum FeatureField {
+        FeatureId = 1,
+        FeatureTags = 2,
+        FeatureType = 3,
+        FeatureGeometry = 4
+    };
+
+    enum GeometryType {
+        Unknown = 0,
+        Point = 1,
+        LineString = 2,
+        Polygon = 3
+    };
+
+    enum Command {
+        MoveTo = 1,
+        LineTo = 2,
+        ClosePath = 7
+    };
+
+    enum WireType {
+        Varint = 0,
+        Fixed64 = 1,
+        LengthDelimited = 2,
+        Fixed32 = 5
+    };
+
+    const quint32 defaultExtent = 4096;
+
+    inline qint32 zigzagDecode( quint32 value )
+    {
+        return qint32( value >> 1 ) ^ -qint32( value & 1 );
+    }
+
+    inline quint32 zigzagEncode( qint32 value )
+    {
+        return ( quint32( value ) << 1 ) ^ quint32( value >> 31 );
+    }
+}
+
+/**
+ * A tile of the spherical mercator tiling scheme used by vector tile themes.
+ * Converts between geographic coordinates and the integer coordinates
+ * of a vector tile with a given extent.
+ */
+class MvtTile
+{
+public:
+    explicit MvtTile( int zoomLevel = 0, int x = 0, int y = 0 );
+
+    /**
+     * Reads the tile from @p path, which must end with zoomLevel/x/y
+     * and may have an extension, e.g. "cache/13/4277/2881.mvt" or "13/4277/2881".
+     * @return false and leaves @p tile untouched if @p path does not describe a tile
+     */
+    static bool fromPath( const QString &path, MvtTile &tile );
+
+    /**
+     * The tile as "zoomLevel/x/y", the document name used by vector tiles
+     */
+    QString name() const;
+
+    int zoomLevel() const;
+
+    int x() const;
+
+    int y() const;
+
+    GeoDataCoordinates coordinates( const QPoint &position, quint32 extent ) const;
+
+    /**
+     * Returns the position of @p coordinates in tile coordinates, which are outside
+     * of [0, extent) for coordinates outside of the tile.
+     */
+    QPoint position( const GeoDataCoordinates &coordinates, quint32 extent ) const;
+
+private:
+    int m_zoomLevel;
+    int m_x;
+    int m_y;
+};
+
+}
+
+#endif
@@ -0,0 +1,365 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "MvtWriter.h"
+
+#include "MvtTile.h"
+
+#include "GeoDataBuilding.h"
+#include "GeoDataDocument.h"
+#include "GeoDataLinearRing.h"
+#include "GeoDataMultiGeometry.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPoint.h"
+#include "GeoDataPolygon.h"
+#include "osm/OsmPlacemarkData.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QIODevice>
+#include <QVector>
+
+#include <algorithm>
+
+namespace Marble
+{
+
+namespace
+{
+
+class ProtobufWriter
+{
+public:
+    void writeVarint( quint64 value )
+    {
+        while ( value >= 0x80 ) {
+            m_data += char( ( value & 0x7f ) | 0x80 );
+            value >>= 7;
+        }
+        m_data += char( value );
+    }
+
+    void writeVarintField( quint32 field, quint64 value )
+    {
+        writeKey( field, Mvt::Varint );
+        writeVarint( value );
+    }
+
+    void writeBytesField( quint32 field, const QByteArray &bytes )
+    {
+        writeKey( field, Mvt::LengthDelimited );
+        writeVarint( quint64( bytes.size() ) );
+        m_data += bytes;
+    }
+
+    void writePackedField( quint32 field, const QVector<quint32> &values )
+    {
+        ProtobufWriter packed;
+        for( quint32 value: values ) {
+            packed.writeVarint( value );
+        }
+        writeBytesField( field, packed.data() );
+    }
+
+    const QByteArray &data() const
+    {
+        return m_data;
+    }
+
+private:
+    void writeKey( quint32 field, Mvt::WireType wireType )
+    {
+        writeVarint( ( quint64( field ) << 3 ) | wireType );
+    }
+
+    QByteArray m_data;
+};
+
+typedef QVector<QPoint> TilePath;
+
+class LayerWriter
+{
+public:
+    LayerWriter( const MvtTile &tile ) :
+        m_tile( tile ),
+        m_extent( Mvt::defaultExtent )
+    {
+    }
+
+    void addContainer( const GeoDataContainer *container );
+
+    QByteArray data( const QString &name ) const;
+
+private:
+    void addPlacemark( const GeoDataPlacemark *placemark );
+    void addGeometry( const GeoDataGeometry *geometry );
+    void addFeature( Mvt::GeometryType type, const QVector<quint32> &tags, qint64 id, const QVector<quint32> &commands );
+
+    TilePath path( const GeoDataLineString &lineString, bool closed ) const;
+    void addRing( const GeoDataLinearRing &ring, bool outer );
+    QVector<quint32> tags( const GeoDataPlacemark *placemark );
+    static quint32 index( const QString &string, QHash<QString, quint32> &indices, QVector<QString> &strings );
+    static quint32 command( Mvt::Command id, int count );
+    static void encodePath( const TilePath &path, bool closed, QPoint &cursor, QVector<quint32> &commands );
+    static qint64 signedArea( const TilePath &path );
+
+    const MvtTile m_tile;
+    const quint32 m_extent;
+
+    QHash<QString, quint32> m_keyIndices;
+    QVector<QString> m_keys;
+    QHash<QString, quint32> m_valueIndices;
+    QVector<QString> m_values;
+    QVector<QByteArray> m_features;
+
+    // geometries of the current placemark, grouped by feature type
+    QVector<QPoint> m_points;
+    QVector<TilePath> m_lines;
+    QVector<TilePath> m_rings;
+};
+
+void LayerWriter::addContainer( const GeoDataContainer *container )
+{
+    for( const GeoDataFeature *feature: container->featureList() ) {
+        if ( const GeoDataPlacemark *placemark = geodata_cast<GeoDataPlacemark>( feature ) ) {
+            addPlacemark( placemark );
+        } else if ( const GeoDataContainer *child = dynamic_cast<const GeoDataContainer*>( feature ) ) {
+            addContainer( child );
+        }
+    }
+}
+
+QByteArray LayerWriter::data( const QString &name ) const
+{
+    ProtobufWriter layer;
+    layer.writeVarintField( Mvt::LayerVersion, 2 );
+    layer.writeBytesField( Mvt::LayerName, name.toUtf8() );
+    for( const QByteArray &feature: m_features ) {
+        layer.writeBytesField( Mvt::LayerFeatures, feature );
+    }
+    for( const QString &key: m_keys ) {
+        layer.writeBytesField( Mvt::LayerKeys, key.toUtf8() );
+    }
+    for( const QString &value: m_values ) {
+        ProtobufWriter valueMessage;
+        valueMessage.writeBytesField( Mvt::StringValue, value.toUtf8() );
+        layer.writeBytesField( Mvt::LayerValues, valueMessage.data() );
+    }
+    layer.writeVarintField( Mvt::LayerExtent, m_extent );
+    return layer.data();
+}
+
+void LayerWriter::addPlacemark( const GeoDataPlacemark *placemark )
+{
+    m_points.clear();
+    m_lines.clear();
+    m_rings.clear();
+    addGeometry( placemark->geometry() );
+    if ( m_points.isEmpty() && m_lines.isEmpty() && m_rings.isEmpty() ) {
+        return;
+    }
+
+    QVector<quint32> const featureTags = tags( placemark );
+    qint64 const id = placemark->osmData().id();
+
+    // A feature has a single geometry type, mixed geometries need several features
+    if ( !m_points.isEmpty() ) {
+        QVector<quint32> commands;
+        commands << command( Mvt::MoveTo, m_points.size() );
+        QPoint cursor;
+        for( const QPoint &point: m_points ) {
+            commands << Mvt::zigzagEncode( point.x() - cursor.x() ) << Mvt::zigzagEncode( point.y() - cursor.y() );
+            cursor = point;
+        }
+        addFeature( Mvt::Point, featureTags, id, commands );
+    }
+
+    if ( !m_lines.isEmpty() ) {
+        QVector<quint32> commands;
+        QPoint cursor;
+        for( const TilePath &line: m_lines ) {
+            encodePath( line, false, cursor, commands );
+        }
+        addFeature( Mvt::LineString, featureTags, id, commands );
+    }
+
+    if ( !m_rings.isEmpty() ) {
+        QVector<quint32> commands;
+        QPoint cursor;
+        for( const TilePath &ring: m_rings ) {
+            encodePath( ring, true, cursor, commands );
+        }
+        addFeature( Mvt::Polygon, featureTags, id, commands );
+    }
+}
+
+void LayerWriter::addGeometry( const GeoDataGeometry *geometry )
+{
+    if ( const GeoDataPoint *point = geodata_cast<GeoDataPoint>( geometry ) ) {
+        m_points << m_tile.position( point->coordinates(), m_extent );
+    } else if ( const GeoDataLineString *lineString = geodata_cast<GeoDataLineString>( geometry ) ) {
+        TilePath const line = path( *lineString, false );
+        if ( line.size() > 1 ) {
+            m_lines << line;
+        }
+    } else if ( const GeoDataLinearRing *ring = geodata_cast<GeoDataLinearRing>( geometry ) ) {
+        addRing( *ring, true );
+    } else if ( const GeoDataPolygon *polygon = geodata_cast<GeoDataPolygon>( geometry ) ) {
+        int const outerRings = m_rings.size();
+        addRing( polygon->outerBoundary(), true );
+        if ( m_rings.size() > outerRings ) {
+            for( const GeoDataLinearRing &innerRing: polygon->innerBoundaries() ) {
+                addRing( innerRing, false );
+            }
+        }
+    } else if ( const GeoDataBuilding *building = geodata_cast<GeoDataBuilding>( geometry ) ) {
+        addGeometry( building->multiGeometry() );
+    } else if ( const GeoDataMultiGeometry *multiGeometry = geodata_cast<GeoDataMultiGeometry>( geometry ) ) {
+        for ( int i = 0; i < multiGeometry->size(); ++i ) {
+            addGeometry( &multiGeometry->at( i ) );
+        }
+    }
+}
+
+void LayerWriter::addFeature( Mvt::GeometryType type, const QVector<quint32> &tags, qint64 id, const QVector<quint32> &commands )
+{
+    ProtobufWriter feature;
+    if ( id > 0 ) {
+        feature.writeVarintField( Mvt::FeatureId, quint64( id ) );
+    }
+    if ( !tags.isEmpty() ) {
+        feature.writePackedField( Mvt::FeatureTags, tags );
+    }
+    feature.writeVarintField( Mvt::FeatureType, type );
+    feature.writePackedField( Mvt::FeatureGeometry, commands );
+    m_features << feature.data();
+}
+
+TilePath LayerWriter::path( const GeoDataLineString &lineString, bool closed ) const
+{
+    // Points collapsing at the tile resolution are dropped
+    TilePath result;
+    result.reserve( lineString.size() );
+    for( const GeoDataCoordinates &coordinates: lineString ) {
+        QPoint const point = m_tile.position( coordinates, m_extent );
+        if ( result.isEmpty() || result.last() != point ) {
+            result << point;
+        }
+    }
+
+    // Rings are closed implicitly
+    if ( closed && result.size() > 1 && result.first() == result.last() ) {
+        result.removeLast();
+    }
+
+    return result;
+}
+
+void LayerWriter::addRing( const GeoDataLinearRing &ring, bool outer )
+{
+    TilePath tilePath = path( ring, true );
+    qint64 const area = tilePath.size() > 2 ? signedArea( tilePath ) : 0;
+    if ( area == 0 ) {
+        return;
+    }
+
+    // Exterior rings have a positive area, interior rings a negative one
+    if ( ( area > 0 ) != outer ) {
+        std::reverse( tilePath.begin(), tilePath.end() );
+    }
+    m_rings << tilePath;
+}
+
+QVector<quint32> LayerWriter::tags( const GeoDataPlacemark *placemark )
+{
+    QVector<quint32> result;
+    OsmPlacemarkData const &osmData = placemark->osmData();
+    for ( auto iter = osmData.tagsBegin(), end = osmData.tagsEnd(); iter != end; ++iter ) {
+        result << index( iter.key(), m_keyIndices, m_keys ) << index( iter.value(), m_valueIndices, m_values );
+    }
+
+    if ( result.isEmpty() && !placemark->name().isEmpty() ) {
+        result << index( QStringLiteral( "name" ), m_keyIndices, m_keys )
+               << index( placemark->name(), m_valueIndices, m_values );
+    }
+
+    return result;
+}
+
+quint32 LayerWriter::index( const QString &string, QHash<QString, quint32> &indices, QVector<QString> &strings )
+{
+    auto const iter = indices.constFind( string );
+    if ( iter != indices.constEnd() ) {
+        return iter.value();
+    }
+
+    quint32 const result = quint32( strings.size() );
+    indices.insert( string, result );
+    strings << string;
+    return result;
+}
+
+quint32 LayerWriter::command( Mvt::Command id, int count )
+{
+    return ( quint32( count ) << 3 ) | id;
+}
+
+void LayerWriter::encodePath( const TilePath &path, bool closed, QPoint &cursor, QVector<quint32> &commands )
+{
+    commands.reserve( commands.size() + 2 * path.size() + 3 );
+    for ( int i = 0; i < path.size(); ++i ) {
+        if ( i == 0 ) {
+            commands << command( Mvt::MoveTo, 1 );
+        } else if ( i == 1 ) {
+            commands << command( Mvt::LineTo, path.size() - 1 );
+        }
+        commands << Mvt::zigzagEncode( path[i].x() - cursor.x() ) << Mvt::zigzagEncode( path[i].y() - cursor.y() );
+        cursor = path[i];
+    }
+
+    if ( closed ) {
+        commands << command( Mvt::ClosePath, 1 );
+    }
+}
+
+qint64 LayerWriter::signedArea( const TilePath &path )
+{
+    qint64 area = 0;
+    for ( int i = 0, n = path.size(); i < n; ++i ) {
+        QPoint const &a = path[i];
+        QPoint const &b = path[( i + 1 ) % n];
+        area += qint64( a.x() ) * b.y() - qint64( b.x() ) * a.y();
+    }
+    return area;
+}
+
+}
+
+bool MvtWriter::write( QIODevice *device, const GeoDataDocument &document )
+{
+    if ( !device || !device->isWritable() ) {
+        return false;
+    }
+
+    MvtTile tile;
+    if ( !MvtTile::fromPath( document.name(), tile ) ) {
+        qWarning() << "Cannot write" << document.name() << "as vector tile, expecting a document named zoomLevel/x/y";
+        return false;
+    }
+
+    LayerWriter layer( tile );
+    layer.addContainer( &document );
+
+    ProtobufWriter writer;
+    writer.writeBytesField( Mvt::TileLayers, layer.data( QStringLiteral( "osm" ) ) );
+    return device->write( writer.data() ) == writer.data().size();
+}
+
+MARBLE_ADD_WRITER( MvtWriter, "mvt" )
+
+}
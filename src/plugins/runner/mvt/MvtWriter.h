@@ -0,0 +1,32 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_MVTWRITER_H
+#define MARBLE_MVTWRITER_H
+
+#include "GeoWriterBackend.h"
+
+namespace Marble
+{
+
+/**
+ * Writes a document as Mapbox Vector Tile with a single layer. The tile is taken
+ * from the document name ("zoomLevel/x/y" as created by vector tile clipping);
+ * documents without such a name are not written.
+ * OpenStreetMap tags become feature properties and positive OpenStreetMap ids
+ * feature ids. Relations are not written since vector tiles cannot express them.
+ */
+class MvtWriter : public GeoWriterBackend
+{
+public:
+    bool write(QIODevice *device, const GeoDataDocument &document) override;
+};
+
+}
+
+#endif
@@ -0,0 +1,250 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include <QBuffer>
+#include <QObject>
+#include <QtTest>
+
+#include "GeoDataDocument.h"
+#include "GeoDataLinearRing.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPoint.h"
+#include "GeoDataPolygon.h"
+#include "osm/OsmPlacemarkData.h"
+#include "MvtParser.h"
+#include "MvtTile.h"
+#include "MvtWriter.h"
+
+using namespace Marble;
+
+class TestMvt : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void roundTrip();
+    void unnamedDocument();
+    void truncated();
+    void corrupt_data();
+    void corrupt();
+
+private:
+    static GeoDataPlacemark *createPlacemark( qint64 id, const QString &key, const QString &value, GeoDataGeometry *geometry );
+    static QByteArray varint( quint64 value );
+    static QByteArray varintField( quint32 field, quint64 value );
+    static QByteArray bytesField( quint32 field, const QByteArray &bytes );
+    static QByteArray tile( const QByteArray &features, const QByteArray &keysAndValues = QByteArray() );
+    static bool compare( const GeoDataCoordinates &a, const GeoDataCoordinates &b );
+
+    const MvtTile m_tile = MvtTile( 14, 8529, 5645 );
+};
+
+GeoDataPlacemark *TestMvt::createPlacemark( qint64 id, const QString &key, const QString &value, GeoDataGeometry *geometry )
+{
+    OsmPlacemarkData osmData;
+    osmData.setId( id );
+    osmData.addTag( key, value );
+    osmData.addTag( QStringLiteral( "name" ), QStringLiteral( "Feature %1" ).arg( id ) );
+
+    GeoDataPlacemark *placemark = new GeoDataPlacemark;
+    placemark->setOsmData( osmData );
+    placemark->setGeometry( geometry );
+    return placemark;
+}
+
+QByteArray TestMvt::varint( quint64 value )
+{
+    QByteArray result;
+    while ( value >= 0x80 ) {
+        result += char( ( value & 0x7f ) | 0x80 );
+        value >>= 7;
+    }
+    result += char( value );
+    return result;
+}
+
+QByteArray TestMvt::varintField( quint32 field, quint64 value )
+{
+    return varint( field << 3 | Mvt::Varint ) + varint( value );
+}
+
+QByteArray TestMvt::bytesField( quint32 field, const QByteArray &bytes )
+{
+    return varint( field << 3 | Mvt::LengthDelimited ) + varint( bytes.size() ) + bytes;
+}
+
+QByteArray TestMvt::tile( const QByteArray &features, const QByteArray &keysAndValues )
+{
+    QByteArray const layer = varintField( Mvt::LayerVersion, 2 )
+                           + bytesField( Mvt::LayerName, "osm" )
+                           + features
+                           + keysAndValues
+                           + varintField( Mvt::LayerExtent, Mvt::defaultExtent );
+    return bytesField( Mvt::TileLayers, layer );
+}
+
+bool TestMvt::compare( const GeoDataCoordinates &a, const GeoDataCoordinates &b )
+{
+    return qAbs( a.longitude() - b.longitude() ) < 1e-9 && qAbs( a.latitude() - b.latitude() ) < 1e-9;
+}
+
+void TestMvt::roundTrip()
+{
+    // Coordinates on the tile grid survive encoding unchanged
+    GeoDataLineString *road = new GeoDataLineString;
+    *road << m_tile.coordinates( QPoint( 100, 100 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 2000, 150 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 3900, 4000 ), Mvt::defaultExtent );
+
+    GeoDataLinearRing outer;
+    outer << m_tile.coordinates( QPoint( 500, 500 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 1500, 500 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 1500, 1500 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 500, 1500 ), Mvt::defaultExtent );
+    GeoDataLinearRing inner;
+    inner << m_tile.coordinates( QPoint( 800, 800 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 1200, 800 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 1200, 1200 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 800, 1200 ), Mvt::defaultExtent );
+    GeoDataPolygon *forest = new GeoDataPolygon;
+    forest->setOuterBoundary( outer );
+    forest->appendInnerBoundary( inner );
+
+    GeoDataPoint *restaurant = new GeoDataPoint( m_tile.coordinates( QPoint( 3000, 3000 ), Mvt::defaultExtent ) );
+
+    GeoDataDocument document;
+    document.setName( m_tile.name() );
+    document.append( createPlacemark( 1, "highway", "primary", road ) );
+    document.append( createPlacemark( 2, "landuse", "forest", forest ) );
+    document.append( createPlacemark( 3, "amenity", "restaurant", restaurant ) );
+
+    QBuffer buffer;
+    buffer.open( QBuffer::WriteOnly );
+    MvtWriter writer;
+    QVERIFY( writer.write( &buffer, document ) );
+
+    QString error;
+    QScopedPointer<GeoDataDocument> parsed( MvtParser::parse( buffer.data(), m_tile, error ) );
+    QVERIFY( parsed );
+    QVERIFY( error.isEmpty() );
+
+    QVector<GeoDataPlacemark*> const placemarks = parsed->placemarkList();
+    QCOMPARE( placemarks.size(), 3 );
+
+    for ( int i = 0; i < placemarks.size(); ++i ) {
+        OsmPlacemarkData const &osmData = placemarks[i]->osmData();
+        QCOMPARE( osmData.id(), qint64( i + 1 ) );
+        QCOMPARE( osmData.tagValue( "name" ), QStringLiteral( "Feature %1" ).arg( i + 1 ) );
+        QCOMPARE( placemarks[i]->name(), QStringLiteral( "Feature %1" ).arg( i + 1 ) );
+    }
+
+    const GeoDataLineString *parsedRoad = geodata_cast<GeoDataLineString>( placemarks[0]->geometry() );
+    QVERIFY( parsedRoad );
+    QCOMPARE( placemarks[0]->osmData().tagValue( "highway" ), QString( "primary" ) );
+    QCOMPARE( parsedRoad->size(), road->size() );
+    for ( int i = 0; i < road->size(); ++i ) {
+        QVERIFY( compare( parsedRoad->at( i ), road->at( i ) ) );
+    }
+
+    const GeoDataPolygon *parsedForest = geodata_cast<GeoDataPolygon>( placemarks[1]->geometry() );
+    QVERIFY( parsedForest );
+    QCOMPARE( placemarks[1]->osmData().tagValue( "landuse" ), QString( "forest" ) );
+    QCOMPARE( parsedForest->outerBoundary().size(), outer.size() );
+    QCOMPARE( parsedForest->innerBoundaries().size(), 1 );
+    QCOMPARE( parsedForest->innerBoundaries().first().size(), inner.size() );
+    for ( int i = 0; i < outer.size(); ++i ) {
+        QVERIFY( compare( parsedForest->outerBoundary().at( i ), outer.at( i ) ) );
+    }
+
+    const GeoDataPoint *parsedRestaurant = geodata_cast<GeoDataPoint>( placemarks[2]->geometry() );
+    QVERIFY( parsedRestaurant );
+    QVERIFY( compare( parsedRestaurant->coordinates(), restaurant->coordinates() ) );
+}
+
+void TestMvt::unnamedDocument()
+{
+    GeoDataDocument document;
+    document.setName( "not a tile" );
+    document.append( createPlacemark( 1, "highway", "primary", new GeoDataPoint( m_tile.coordinates( QPoint( 10, 10 ), Mvt::defaultExtent ) ) ) );
+
+    QBuffer buffer;
+    buffer.open( QBuffer::WriteOnly );
+    MvtWriter writer;
+    QTest::ignoreMessage( QtWarningMsg, "Cannot write \"not a tile\" as vector tile, expecting a document named zoomLevel/x/y" );
+    QVERIFY( !writer.write( &buffer, document ) );
+    QVERIFY( buffer.data().isEmpty() );
+}
+
+void TestMvt::truncated()
+{
+    GeoDataLineString *road = new GeoDataLineString;
+    *road << m_tile.coordinates( QPoint( 100, 100 ), Mvt::defaultExtent )
+          << m_tile.coordinates( QPoint( 2000, 150 ), Mvt::defaultExtent );
+    GeoDataDocument document;
+    document.setName( m_tile.name() );
+    document.append( createPlacemark( 1, "highway", "primary", road ) );
+
+    QBuffer buffer;
+    buffer.open( QBuffer::WriteOnly );
+    MvtWriter writer;
+    QVERIFY( writer.write( &buffer, document ) );
+    QByteArray const data = buffer.data();
+
+    // All data is in a single layer, so no prefix of it is a valid tile
+    for ( int size = 1; size < data.size(); ++size ) {
+        QString error;
+        GeoDataDocument *parsed = MvtParser::parse( data.left( size ), m_tile, error );
+        QVERIFY2( !parsed, qPrintable( QString( "Accepted %1 of %2 bytes" ).arg( size ).arg( data.size() ) ) );
+        QVERIFY( !error.isEmpty() );
+    }
+}
+
+void TestMvt::corrupt_data()
+{
+    QTest::addColumn<QByteArray>( "data" );
+
+    // A line feature with tags name=Feature
+    QByteArray const keysAndValues = bytesField( Mvt::LayerKeys, "name" )
+                                   + bytesField( Mvt::LayerValues, bytesField( Mvt::StringValue, "Feature" ) );
+    QByteArray const tags = bytesField( Mvt::FeatureTags, varint( 0 ) + varint( 0 ) );
+    QByteArray const type = varintField( Mvt::FeatureType, Mvt::LineString );
+    QByteArray const moveTo = varint( 1 << 3 | Mvt::MoveTo ) + varint( 0 ) + varint( 0 );
+    QByteArray const lineTo = varint( 1 << 3 | Mvt::LineTo ) + varint( 2 ) + varint( 2 );
+
+    QTest::newRow( "invalid wire type" ) << QByteArray( "\x1f", 1 );
+    QTest::newRow( "overlong varint" ) << QByteArray( 11, '\xff' );
+    QTest::newRow( "length beyond end" ) << QByteArray( "\x1a\x05" "ab", 4 );
+    QTest::newRow( "key index out of range" )
+            << tile( bytesField( Mvt::LayerFeatures, tags + type + bytesField( Mvt::FeatureGeometry, moveTo + lineTo ) ) );
+    QTest::newRow( "odd number of tags" )
+            << tile( bytesField( Mvt::LayerFeatures, bytesField( Mvt::FeatureTags, varint( 0 ) ) + type
+                                 + bytesField( Mvt::FeatureGeometry, moveTo + lineTo ) ), keysAndValues );
+    QTest::newRow( "LineTo without MoveTo" )
+            << tile( bytesField( Mvt::LayerFeatures, tags + type + bytesField( Mvt::FeatureGeometry, lineTo ) ), keysAndValues );
+    QTest::newRow( "missing command parameters" )
+            << tile( bytesField( Mvt::LayerFeatures, tags + type
+                                 + bytesField( Mvt::FeatureGeometry, varint( 5 << 3 | Mvt::MoveTo ) + varint( 0 ) + varint( 0 ) ) ),
+                     keysAndValues );
+    QTest::newRow( "unknown command" )
+            << tile( bytesField( Mvt::LayerFeatures, tags + type + bytesField( Mvt::FeatureGeometry, varint( 1 << 3 | 3 ) ) ),
+                     keysAndValues );
+}
+
+void TestMvt::corrupt()
+{
+    QFETCH( QByteArray, data );
+
+    QString error;
+    GeoDataDocument *parsed = MvtParser::parse( data, m_tile, error );
+    QVERIFY( !parsed );
+    QCOMPARE( error, QStringLiteral( "Malformed vector tile %1" ).arg( m_tile.name() ) );
+}
+
+QTEST_MAIN( TestMvt )
+
+#include "TestMvt.moc"
@@ -43,6 +43,9 @@ private:
 
     static bool isBuildingTag(const StyleBuilder::OsmTag &keyValue);
 
+    static void createAreaTags();
+    static void createBuildingTags();
+
     OsmPlacemarkData m_osmData;
     QVector<qint64> m_references;
 
@@ -0,0 +1,121 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "routing/AlternativeRoutesModel.h"
+
+#include "GeoDataDocument.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+
+#include <QTest>
+
+namespace Marble
+{
+
+class AlternativeRoutesModelTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void instant();
+    void insertionOrder();
+    void similarRoutes();
+
+ private:
+    /**
+     * A route along the parallel at @p latitude from 0 to 20 degree longitude. Routes
+     * with instructions score higher than those without.
+     */
+    static GeoDataDocument *createRoute( qreal latitude, int points = 100, bool instructions = false );
+};
+
+GeoDataDocument *AlternativeRoutesModelTest::createRoute( qreal latitude, int points, bool instructions )
+{
+    GeoDataLineString *wayPoints = new GeoDataLineString;
+    for ( int i = 0; i < points; ++i ) {
+        *wayPoints << GeoDataCoordinates( 20.0 * i / ( points - 1 ), latitude, 0.0, GeoDataCoordinates::Degree );
+    }
+
+    GeoDataPlacemark *route = new GeoDataPlacemark( "Route" );
+    route->setGeometry( wayPoints );
+
+    GeoDataDocument *document = new GeoDataDocument;
+    document->append( route );
+    if ( instructions ) {
+        GeoDataPlacemark *instruction = new GeoDataPlacemark( "Turn left" );
+        instruction->setCoordinate( wayPoints->first() );
+        document->append( instruction );
+    }
+
+    return document;
+}
+
+void AlternativeRoutesModelTest::instant()
+{
+    AlternativeRoutesModel model;
+
+    GeoDataDocument *route = createRoute( 10.0 );
+    model.addRoute( route, AlternativeRoutesModel::Instant );
+
+    QCOMPARE( model.rowCount(), 1 );
+    QCOMPARE( model.route( 0 ), static_cast<const GeoDataDocument *>( route ) );
+}
+
+void AlternativeRoutesModelTest::insertionOrder()
+{
+    AlternativeRoutesModel model;
+
+    // The first route takes longest to simplify, yet it is inserted first
+    GeoDataDocument *first = createRoute( 10.0, 200000 );
+    GeoDataDocument *second = createRoute( 30.0 );
+    GeoDataDocument *third = createRoute( 50.0 );
+    model.addRoute( createRoute( -50.0 ), AlternativeRoutesModel::Instant );
+    model.addRoute( first );
+    model.addRoute( second );
+    model.addRoute( third );
+
+    QTRY_COMPARE_WITH_TIMEOUT( model.rowCount(), 4, 30000 );
+    QCOMPARE( model.route( 1 ), static_cast<const GeoDataDocument *>( first ) );
+    QCOMPARE( model.route( 2 ), static_cast<const GeoDataDocument *>( second ) );
+    QCOMPARE( model.route( 3 ), static_cast<const GeoDataDocument *>( third ) );
+}
+
+void AlternativeRoutesModelTest::similarRoutes()
+{
+    AlternativeRoutesModel model;
+
+    GeoDataDocument *route = createRoute( 10.0 );
+    model.addRoute( route, AlternativeRoutesModel::Instant );
+
+    // Similar, but no better: ignored. More points follow the parallel more closely, which
+    // makes the route longer.
+    model.addRoute( createRoute( 10.0, 200 ) );
+    // Similar and with instructions: replaces the first route
+    GeoDataDocument *better = createRoute( 10.0, 80, true );
+    model.addRoute( better );
+    GeoDataDocument *other = createRoute( 40.0 );
+    model.addRoute( other );
+    // Outlined before the route above was in the model, so it is compared with it afterwards
+    model.addRoute( createRoute( 40.0, 150 ) );
+    GeoDataDocument *last = createRoute( 70.0 );
+    model.addRoute( last );
+
+    // Pending routes are applied in order, so all others are done once the last one is in
+    QTRY_COMPARE_WITH_TIMEOUT( model.rowCount(), 3, 30000 );
+    QCOMPARE( model.route( 2 ), static_cast<const GeoDataDocument *>( last ) );
+    QCOMPARE( model.route( 0 ), static_cast<const GeoDataDocument *>( better ) );
+    QCOMPARE( model.route( 1 ), static_cast<const GeoDataDocument *>( other ) );
+
+    delete route;
+}
+
+}
+
+QTEST_MAIN( Marble::AlternativeRoutesModelTest )
+
+#include "AlternativeRoutesModelTest.moc"
@@ -0,0 +1,140 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "AbstractProjection.h"
+#include "ViewportParams.h"
+#include "TestUtils.h"
+
+Q_DECLARE_METATYPE( Marble::Projection )
+
+namespace Marble
+{
+
+class BatchProjectionTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void initTestCase();
+
+    void screenCoordinates_data();
+    void screenCoordinates();
+
+    void benchmark_data();
+    void benchmark();
+
+ private:
+    /** A grid covering the whole globe and some invalid latitudes */
+    QVector<qreal> m_lon;
+    QVector<qreal> m_lat;
+};
+
+void BatchProjectionTest::initTestCase()
+{
+    for ( qreal lon = -200.0; lon <= 200.0; lon += 2.5 ) {
+        for ( qreal lat = -95.0; lat <= 95.0; lat += 2.5 ) {
+            m_lon << lon * DEG2RAD;
+            m_lat << lat * DEG2RAD;
+        }
+    }
+}
+
+void BatchProjectionTest::screenCoordinates_data()
+{
+    QTest::addColumn<Marble::Projection>( "projection" );
+    QTest::addColumn<qreal>( "centerLon" );
+    QTest::addColumn<qreal>( "centerLat" );
+    QTest::addColumn<int>( "radius" );
+
+    const Projection projections[] = {
+        Spherical, Equirectangular, Mercator, Gnomonic,
+        Stereographic, LambertAzimuthal, AzimuthalEquidistant, VerticalPerspective
+    };
+
+    for( Projection projection: projections ) {
+        addRow() << projection << qreal(0.0) << qreal(0.0) << 200;
+        addRow() << projection << qreal(30.0) << qreal(60.0) << 400;
+        addRow() << projection << qreal(-170.0) << qreal(-20.0) << 3000;
+    }
+}
+
+void BatchProjectionTest::screenCoordinates()
+{
+    QFETCH( Marble::Projection, projection );
+    QFETCH( qreal, centerLon );
+    QFETCH( qreal, centerLat );
+    QFETCH( int, radius );
+
+    const ViewportParams viewport( projection, centerLon * DEG2RAD, centerLat * DEG2RAD, radius, QSize( 800, 600 ) );
+
+    const int count = m_lon.size();
+    QVector<qreal> x( count );
+    QVector<qreal> y( count );
+    QVector<bool> visible( count );
+    const int visibleCount = viewport.screenCoordinates( m_lon.constData(), m_lat.constData(), count,
+                                                         x.data(), y.data(), visible.data() );
+
+    int expectedVisibleCount = 0;
+    for ( int i = 0; i < count; ++i ) {
+        qreal expectedX = 0;
+        qreal expectedY = 0;
+        const bool expectedVisible = viewport.screenCoordinates( m_lon[i], m_lat[i], expectedX, expectedY );
+
+        QCOMPARE( visible[i], expectedVisible );
+        if ( expectedVisible ) {
+            ++expectedVisibleCount;
+            QFUZZYCOMPARE( x[i], expectedX, 1e-6 );
+            QFUZZYCOMPARE( y[i], expectedY, 1e-6 );
+        }
+    }
+
+    QCOMPARE( visibleCount, expectedVisibleCount );
+    QVERIFY( visibleCount > 0 );
+}
+
+void BatchProjectionTest::benchmark_data()
+{
+    QTest::addColumn<Marble::Projection>( "projection" );
+    QTest::addColumn<bool>( "batch" );
+
+    const Projection projections[] = { Spherical, Equirectangular, Mercator, Gnomonic };
+    for( Projection projection: projections ) {
+        addRow() << projection << false;
+        addRow() << projection << true;
+    }
+}
+
+void BatchProjectionTest::benchmark()
+{
+    QFETCH( Marble::Projection, projection );
+    QFETCH( bool, batch );
+
+    const ViewportParams viewport( projection, 10.0 * DEG2RAD, 45.0 * DEG2RAD, 400, QSize( 800, 600 ) );
+
+    const int count = m_lon.size();
+    QVector<qreal> x( count );
+    QVector<qreal> y( count );
+    QVector<bool> visible( count );
+
+    QBENCHMARK {
+        if ( batch ) {
+            viewport.screenCoordinates( m_lon.constData(), m_lat.constData(), count,
+                                        x.data(), y.data(), visible.data() );
+        } else {
+            for ( int i = 0; i < count; ++i ) {
+                visible[i] = viewport.screenCoordinates( m_lon[i], m_lat[i], x[i], y[i] );
+            }
+        }
+    }
+}
+
+}
+
+QTEST_MAIN( Marble::BatchProjectionTest )
+
+#include "BatchProjectionTest.moc"
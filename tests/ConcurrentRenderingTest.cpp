@@ -0,0 +1,207 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "GeoDataLineString.h"
+#include "GeoPainter.h"
+#include "LayerInterface.h"
+#include "MarbleMap.h"
+#include "TestUtils.h"
+
+#include <QImage>
+#include <QThreadPool>
+
+namespace Marble
+{
+
+/**
+ * A layer drawing a dense, semi-transparent grid of tessellated lines,
+ * so that its rendering is expensive and the paint order is visible.
+ */
+class GridLayer : public LayerInterface
+{
+public:
+    GridLayer( const QString &renderPosition, const QColor &color, int lines, bool concurrent ) :
+        m_renderPosition( renderPosition ),
+        m_color( color ),
+        m_concurrent( concurrent )
+    {
+        for ( int i = 0; i < lines; ++i ) {
+            const qreal lat = -80.0 + 160.0 * i / lines;
+            const qreal lon = -180.0 + 360.0 * i / lines;
+
+            GeoDataLineString parallel( Tessellate );
+            parallel << GeoDataCoordinates( -180.0, lat, 0.0, GeoDataCoordinates::Degree )
+                     << GeoDataCoordinates( 0.0, lat, 0.0, GeoDataCoordinates::Degree )
+                     << GeoDataCoordinates( 180.0, lat, 0.0, GeoDataCoordinates::Degree );
+            m_lines << parallel;
+
+            GeoDataLineString meridian( Tessellate );
+            meridian << GeoDataCoordinates( lon, -85.0, 0.0, GeoDataCoordinates::Degree )
+                     << GeoDataCoordinates( lon, 85.0, 0.0, GeoDataCoordinates::Degree );
+            m_lines << meridian;
+        }
+    }
+
+    QStringList renderPosition() const override
+    {
+        return QStringList() << m_renderPosition;
+    }
+
+    bool render( GeoPainter *painter, ViewportParams *viewport,
+                 const QString &renderPos, GeoSceneLayer *layer ) override
+    {
+        Q_UNUSED( viewport )
+        Q_UNUSED( renderPos )
+        Q_UNUSED( layer )
+
+        painter->setRenderHint( QPainter::Antialiasing, true );
+        painter->setPen( QPen( m_color, 2.0 ) );
+        for( const GeoDataLineString &line: m_lines ) {
+            painter->drawPolyline( line );
+        }
+
+        return true;
+    }
+
+    bool supportsConcurrentRendering() const override
+    {
+        return m_concurrent;
+    }
+
+private:
+    const QString m_renderPosition;
+    const QColor m_color;
+    const bool m_concurrent;
+    QVector<GeoDataLineString> m_lines;
+};
+
+class ConcurrentRenderingTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void sameResult();
+
+    void benchmark_data();
+    void benchmark();
+
+ private:
+    QImage renderMap( bool concurrent );
+    static int maximumChannelDifference( const QImage &image1, const QImage &image2 );
+
+    MarbleMap *m_map;
+    QVector<LayerInterface *> m_layers;
+};
+
+void ConcurrentRenderingTest::initTestCase()
+{
+    m_map = new MarbleMap;
+    m_map->setMapThemeId( "earth/plain/plain.dgml" );
+    m_map->setSize( 800, 600 );
+    m_map->setRadius( 400 );
+
+    // Layers at independent render positions, interleaved with one that must stay in the GUI thread
+    m_layers << new GridLayer( "STARS", QColor( 255, 255, 0, 128 ), 100, true )
+             << new GridLayer( "HOVERS_ABOVE_SURFACE", QColor( 255, 0, 0, 128 ), 100, true )
+             << new GridLayer( "GRATICULE", QColor( 0, 255, 0, 128 ), 100, false )
+             << new GridLayer( "PLACEMARKS", QColor( 0, 0, 255, 128 ), 100, true )
+             << new GridLayer( "ATMOSPHERE", QColor( 0, 255, 255, 128 ), 100, true )
+             << new GridLayer( "ORBIT", QColor( 255, 0, 255, 128 ), 100, true );
+    for( LayerInterface *layer: m_layers ) {
+        m_map->addLayer( layer );
+    }
+
+    // load the tiles of the texture layer
+    renderMap( false );
+    QThreadPool::globalInstance()->waitForDone();
+    renderMap( false );
+}
+
+void ConcurrentRenderingTest::cleanupTestCase()
+{
+    for( LayerInterface *layer: m_layers ) {
+        m_map->removeLayer( layer );
+    }
+    qDeleteAll( m_layers );
+    delete m_map;
+}
+
+QImage ConcurrentRenderingTest::renderMap( bool concurrent )
+{
+    m_map->setConcurrentRendering( concurrent );
+
+    QImage image( m_map->size(), QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+    GeoPainter painter( &image, m_map->viewport(), m_map->mapQuality() );
+    m_map->paint( painter, QRect() );
+    painter.end();
+
+    return image;
+}
+
+int ConcurrentRenderingTest::maximumChannelDifference( const QImage &image1, const QImage &image2 )
+{
+    int result = 0;
+    for ( int y = 0; y < image1.height(); ++y ) {
+        const QRgb *line1 = reinterpret_cast<const QRgb *>( image1.constScanLine( y ) );
+        const QRgb *line2 = reinterpret_cast<const QRgb *>( image2.constScanLine( y ) );
+        for ( int x = 0; x < image1.width(); ++x ) {
+            result = qMax( result, qAbs( qRed( line1[x] ) - qRed( line2[x] ) ) );
+            result = qMax( result, qAbs( qGreen( line1[x] ) - qGreen( line2[x] ) ) );
+            result = qMax( result, qAbs( qBlue( line1[x] ) - qBlue( line2[x] ) ) );
+            result = qMax( result, qAbs( qAlpha( line1[x] ) - qAlpha( line2[x] ) ) );
+        }
+    }
+    return result;
+}
+
+void ConcurrentRenderingTest::sameResult()
+{
+    const QImage sequential = renderMap( false );
+    const QImage concurrent = renderMap( true );
+
+    QCOMPARE( concurrent.size(), sequential.size() );
+    QCOMPARE( concurrent.format(), sequential.format() );
+
+    // Layers rendered concurrently are blended into a buffer of their own first,
+    // which rounds differently where their semi-transparent lines overlap
+    QVERIFY( maximumChannelDifference( concurrent, sequential ) <= 3 );
+}
+
+void ConcurrentRenderingTest::benchmark_data()
+{
+    QTest::addColumn<bool>( "concurrent" );
+
+    addRow() << false;
+    addRow() << true;
+}
+
+void ConcurrentRenderingTest::benchmark()
+{
+    QFETCH( bool, concurrent );
+
+    m_map->setConcurrentRendering( concurrent );
+
+    QImage image( m_map->size(), QImage::Format_ARGB32_Premultiplied );
+
+    QBENCHMARK {
+        // Rotate the map to prevent any reuse of the previous frame
+        m_map->rotateBy( 1.0, 0.0 );
+        GeoPainter painter( &image, m_map->viewport(), m_map->mapQuality() );
+        m_map->paint( painter, QRect() );
+    }
+}
+
+}
+
+QTEST_MAIN( Marble::ConcurrentRenderingTest )
+
+#include "ConcurrentRenderingTest.moc"
@@ -0,0 +1,172 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "FrameProfiler.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QList>
+#include <QMap>
+#include <QTemporaryDir>
+#include <QTest>
+
+namespace Marble
+{
+
+class FrameProfilerTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void disabled();
+    void chromeTrace();
+    void csv();
+    void capacity();
+    void save();
+
+ private:
+    static void recordFrame( int tiles );
+};
+
+void FrameProfilerTest::init()
+{
+    FrameProfiler::setCapacity( 1000 );
+    FrameProfiler::setEnabled( true );
+}
+
+void FrameProfilerTest::cleanup()
+{
+    FrameProfiler::setEnabled( false );
+    FrameProfiler::clear();
+}
+
+void FrameProfilerTest::recordFrame( int tiles )
+{
+    FrameProfiler::beginFrame();
+    const qint64 start = FrameProfiler::timestamp();
+    const qint64 end = FrameProfiler::timestamp();
+    FrameProfiler::addEvent( "layer", "Texture \"layer\"", start, end );
+    FrameProfiler::count( "Tile cache hits", tiles );
+    FrameProfiler::setGauge( "Download queue", 3.0 );
+    FrameProfiler::endFrame();
+}
+
+void FrameProfilerTest::disabled()
+{
+    FrameProfiler::setEnabled( false );
+    QVERIFY( !FrameProfiler::isEnabled() );
+    QCOMPARE( FrameProfiler::timestamp(), qint64( 0 ) );
+
+    recordFrame( 1 );
+
+    QCOMPARE( FrameProfiler::toCsv().count( '\n' ), 1 );
+}
+
+void FrameProfilerTest::chromeTrace()
+{
+    QVERIFY( FrameProfiler::isEnabled() );
+    recordFrame( 2 );
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson( FrameProfiler::toChromeTrace(), &error );
+    QCOMPARE( error.error, QJsonParseError::NoError );
+
+    const QJsonArray events = document.object().value( "traceEvents" ).toArray();
+    // the frame, the layer event and two counters
+    QCOMPARE( events.size(), 4 );
+
+    const QJsonObject frame = events.at( 0 ).toObject();
+    QCOMPARE( frame.value( "name" ).toString(), QString( "Frame 0" ) );
+    QCOMPARE( frame.value( "ph" ).toString(), QString( "X" ) );
+    QVERIFY( frame.value( "dur" ).toDouble() >= 0.0 );
+
+    const QJsonObject layer = events.at( 1 ).toObject();
+    QCOMPARE( layer.value( "cat" ).toString(), QString( "layer" ) );
+    QCOMPARE( layer.value( "name" ).toString(), QString( "Texture \"layer\"" ) );
+    QVERIFY( layer.value( "ts" ).toDouble() >= frame.value( "ts" ).toDouble() );
+
+    QMap<QString, double> counters;
+    for ( int i = 2; i < events.size(); ++i ) {
+        const QJsonObject counter = events.at( i ).toObject();
+        QCOMPARE( counter.value( "ph" ).toString(), QString( "C" ) );
+        counters[counter.value( "name" ).toString()] = counter.value( "args" ).toObject().value( "value" ).toDouble();
+    }
+    QCOMPARE( counters.value( "Tile cache hits" ), 2.0 );
+    QCOMPARE( counters.value( "Download queue" ), 3.0 );
+}
+
+void FrameProfilerTest::csv()
+{
+    recordFrame( 5 );
+    recordFrame( 7 );
+
+    const QList<QByteArray> lines = FrameProfiler::toCsv().trimmed().split( '\n' );
+    QCOMPARE( lines.first(), QByteArray( "frame,category,name,thread,start_us,duration_us,value" ) );
+    // header and four lines per frame
+    QCOMPARE( lines.size(), 9 );
+
+    QVERIFY( lines.at( 1 ).startsWith( "0,frame,frame,0," ) );
+    QVERIFY( lines.at( 2 ).startsWith( "0,layer,\"Texture \"\"layer\"\"\",0," ) );
+    QVERIFY( lines.at( 3 ).startsWith( "0,counter,\"Download queue\",0," ) );
+    QVERIFY( lines.at( 3 ).endsWith( ",,3" ) );
+    QVERIFY( lines.at( 4 ).startsWith( "0,counter,\"Tile cache hits\",0," ) );
+    QVERIFY( lines.at( 4 ).endsWith( ",,5" ) );
+    QVERIFY( lines.at( 5 ).startsWith( "1,frame,frame,0," ) );
+    QVERIFY( lines.at( 8 ).endsWith( ",,7" ) );
+}
+
+void FrameProfilerTest::capacity()
+{
+    FrameProfiler::setCapacity( 3 );
+    QCOMPARE( FrameProfiler::capacity(), 3 );
+
+    for ( int i = 0; i < 5; ++i ) {
+        recordFrame( i );
+    }
+
+    // only the last three frames are kept, oldest first
+    const QByteArray csv = FrameProfiler::toCsv();
+    QCOMPARE( csv.count( ",frame,frame," ), 3 );
+    QVERIFY( csv.contains( "\n2,frame,frame," ) );
+    QVERIFY( csv.contains( "\n4,frame,frame," ) );
+    QVERIFY( !csv.contains( "\n1,frame,frame," ) );
+    QVERIFY( csv.indexOf( "\n2,frame" ) < csv.indexOf( "\n4,frame" ) );
+}
+
+void FrameProfilerTest::save()
+{
+    recordFrame( 1 );
+
+    QTemporaryDir directory;
+    QVERIFY( directory.isValid() );
+
+    const QString csvFileName = directory.path() + "/profile.csv";
+    QVERIFY( FrameProfiler::save( csvFileName ) );
+    QFile csvFile( csvFileName );
+    QVERIFY( csvFile.open( QFile::ReadOnly ) );
+    QCOMPARE( csvFile.readAll(), FrameProfiler::toCsv() );
+
+    const QString traceFileName = directory.path() + "/profile.json";
+    QVERIFY( FrameProfiler::save( traceFileName ) );
+    QFile traceFile( traceFileName );
+    QVERIFY( traceFile.open( QFile::ReadOnly ) );
+    QCOMPARE( traceFile.readAll(), FrameProfiler::toChromeTrace() );
+
+    QVERIFY( !FrameProfiler::save( directory.path() + "/missing/profile.csv" ) );
+}
+
+}
+
+QTEST_MAIN( Marble::FrameProfilerTest )
+
+#include "FrameProfilerTest.moc"
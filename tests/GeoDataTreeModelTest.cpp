@@ -8,12 +8,16 @@
 // Copyright 2014      Bernhard Beschow <bbeschow@cs.tu-berlin.de>
 //
 
+#include <QSignalSpy>
 #include <QTest>
 
 #include "GeoDataTreeModel.h"
 
 #include "GeoDataDocument.h"
+#include "GeoDataFolder.h"
 #include "GeoDataPlacemark.h"
+#include "MarblePlacemarkModel.h"
+#include "kdescendantsproxymodel.h"
 
 namespace Marble
 {
@@ -26,6 +30,11 @@ private Q_SLOTS:
     void defaultConstructor();
     void setRootDocument();
     void addDocument();
+    void descendantsProxy();
+
+private:
+    static void appendDescendants( const GeoDataContainer *container, QVector<const GeoDataObject *> &objects );
+    static void verifyDescendants( const GeoDataTreeModel &model, const KDescendantsProxyModel &proxy );
 };
 
 void GeoDataTreeModelTest::defaultConstructor()
@@ -73,6 +82,74 @@ void GeoDataTreeModelTest::addDocument()
     }
 }
 
+void GeoDataTreeModelTest::descendantsProxy()
+{
+    GeoDataTreeModel model;
+    KDescendantsProxyModel proxy;
+    proxy.setSourceModel( &model );
+    QSignalSpy rowsInsertedSpy( &proxy, SIGNAL(rowsInserted(QModelIndex,int,int)) );
+
+    GeoDataDocument *document = new GeoDataDocument;
+    GeoDataFolder *folder = new GeoDataFolder;
+    folder->append( new GeoDataPlacemark );
+    folder->append( new GeoDataPlacemark );
+    document->append( folder );
+    document->append( new GeoDataPlacemark );
+
+    // The whole document is announced at once
+    model.addDocument( document );
+    QCOMPARE( proxy.rowCount(), 5 );
+    QCOMPARE( rowsInsertedSpy.count(), 1 );
+    QCOMPARE( rowsInsertedSpy.at( 0 ).at( 1 ).toInt(), 0 );
+    QCOMPARE( rowsInsertedSpy.at( 0 ).at( 2 ).toInt(), 4 );
+    verifyDescendants( model, proxy );
+
+    // A document appended to existing ones, followed by its children
+    GeoDataDocument *secondDocument = new GeoDataDocument;
+    GeoDataFolder *secondFolder = new GeoDataFolder;
+    secondFolder->append( new GeoDataPlacemark );
+    secondDocument->append( secondFolder );
+    rowsInsertedSpy.clear();
+    model.addDocument( secondDocument );
+    QCOMPARE( proxy.rowCount(), 8 );
+    QCOMPARE( rowsInsertedSpy.count(), 2 );
+    QCOMPARE( rowsInsertedSpy.at( 1 ).at( 1 ).toInt(), 6 );
+    QCOMPARE( rowsInsertedSpy.at( 1 ).at( 2 ).toInt(), 7 );
+    verifyDescendants( model, proxy );
+
+    // A folder inserted in the middle of an existing one
+    GeoDataFolder *thirdFolder = new GeoDataFolder;
+    thirdFolder->append( new GeoDataPlacemark );
+    thirdFolder->append( new GeoDataPlacemark );
+    model.addFeature( folder, thirdFolder, 1 );
+    QCOMPARE( proxy.rowCount(), 11 );
+    verifyDescendants( model, proxy );
+}
+
+void GeoDataTreeModelTest::appendDescendants( const GeoDataContainer *container, QVector<const GeoDataObject *> &objects )
+{
+    for ( const GeoDataFeature *feature: container->featureList() ) {
+        objects << feature;
+        if ( const GeoDataContainer *child = dynamic_cast<const GeoDataContainer *>( feature ) ) {
+            appendDescendants( child, objects );
+        }
+    }
+}
+
+void GeoDataTreeModelTest::verifyDescendants( const GeoDataTreeModel &model, const KDescendantsProxyModel &proxy )
+{
+    QVector<const GeoDataObject *> objects;
+    appendDescendants( const_cast<GeoDataTreeModel &>( model ).rootDocument(), objects );
+    QCOMPARE( proxy.rowCount(), objects.size() );
+
+    for ( int row = 0; row < objects.size(); ++row ) {
+        const QModelIndex proxyIndex = proxy.index( row, 0 );
+        const QModelIndex sourceIndex = model.index( objects[row] );
+        QCOMPARE( proxy.mapToSource( proxyIndex ), sourceIndex );
+        QCOMPARE( proxy.mapFromSource( sourceIndex ), proxyIndex );
+    }
+}
+
 }
 
 QTEST_MAIN( Marble::GeoDataTreeModelTest )
@@ -0,0 +1,199 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "layers/GeometryLayer.h"
+
+#include "GeoDataDocument.h"
+#include "GeoDataLinearRing.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPolygon.h"
+#include "GeoDataTreeModel.h"
+#include "GeoGraphicsItem.h"
+#include "GeoPainter.h"
+#include "StyleBuilder.h"
+#include "ViewportParams.h"
+
+#include <QImage>
+#include <QRunnable>
+#include <QTest>
+#include <QThreadPool>
+
+namespace Marble
+{
+
+/**
+ * Creates the graphics items of a tile in a thread of the pool, like VectorTileModel does.
+ */
+class TileItemsJob : public QRunnable
+{
+public:
+    TileItemsJob( const GeometryLayer *layer, const GeoDataDocument *document ) :
+        m_layer( layer ),
+        m_document( document )
+    {
+        setAutoDelete( false );
+    }
+
+    void run() override
+    {
+        m_items = m_layer->createTileItems( m_document );
+    }
+
+    QVector<GeoGraphicsItem *> items() const
+    {
+        return m_items;
+    }
+
+private:
+    const GeometryLayer *const m_layer;
+    const GeoDataDocument *const m_document;
+    QVector<GeoGraphicsItem *> m_items;
+};
+
+class GeometryLayerTest : public QObject
+{
+    Q_OBJECT
+
+ public:
+    GeometryLayerTest();
+
+ private Q_SLOTS:
+    void sameItemsOffThread();
+    void concurrentTiles();
+    void addAndRemoveTile();
+
+ private:
+    /** A tile with a road and a forest next to it, @p offset shifts both to the east */
+    static GeoDataDocument *createTile( qreal offset = 0.0 );
+
+    /** Renders the layer at a high zoom level and returns its runtime trace */
+    QString renderLayer();
+
+    GeoDataTreeModel m_treeModel;
+    StyleBuilder m_styleBuilder;
+    GeometryLayer m_layer;
+};
+
+GeometryLayerTest::GeometryLayerTest() :
+    m_layer( &m_treeModel, &m_styleBuilder )
+{
+    m_layer.setTileLevel( 17 );
+}
+
+GeoDataDocument *GeometryLayerTest::createTile( qreal offset )
+{
+    GeoDataLineString *line = new GeoDataLineString;
+    *line << GeoDataCoordinates( offset, 0.0, 0.0, GeoDataCoordinates::Degree )
+          << GeoDataCoordinates( offset + 0.001, 0.0005, 0.0, GeoDataCoordinates::Degree );
+    GeoDataPlacemark *road = new GeoDataPlacemark( "Road" );
+    road->setVisualCategory( GeoDataPlacemark::HighwayPrimary );
+    road->setGeometry( line );
+
+    GeoDataLinearRing ring;
+    ring << GeoDataCoordinates( offset, 0.001, 0.0, GeoDataCoordinates::Degree )
+         << GeoDataCoordinates( offset + 0.001, 0.001, 0.0, GeoDataCoordinates::Degree )
+         << GeoDataCoordinates( offset + 0.001, 0.002, 0.0, GeoDataCoordinates::Degree )
+         << GeoDataCoordinates( offset, 0.002, 0.0, GeoDataCoordinates::Degree );
+    GeoDataPolygon *polygon = new GeoDataPolygon;
+    polygon->setOuterBoundary( ring );
+    GeoDataPlacemark *forest = new GeoDataPlacemark( "Forest" );
+    forest->setVisualCategory( GeoDataPlacemark::LanduseForest );
+    forest->setGeometry( polygon );
+
+    GeoDataDocument *document = new GeoDataDocument;
+    document->append( road );
+    document->append( forest );
+    return document;
+}
+
+QString GeometryLayerTest::renderLayer()
+{
+    ViewportParams viewport( Mercator, 0.0005 * DEG2RAD, 0.001 * DEG2RAD, 20000000, QSize( 400, 400 ) );
+    QImage image( viewport.size(), QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+    GeoPainter painter( &image, &viewport, NormalQuality );
+    m_layer.render( &painter, &viewport );
+    painter.end();
+
+    return m_layer.runtimeTrace();
+}
+
+void GeometryLayerTest::sameItemsOffThread()
+{
+    QScopedPointer<GeoDataDocument> document( createTile() );
+    const QVector<GeoGraphicsItem *> expected = m_layer.createTileItems( document.data() );
+    QCOMPARE( expected.size(), 2 );
+
+    TileItemsJob job( &m_layer, document.data() );
+    QThreadPool::globalInstance()->start( &job );
+    QThreadPool::globalInstance()->waitForDone();
+    const QVector<GeoGraphicsItem *> items = job.items();
+
+    QCOMPARE( items.size(), expected.size() );
+    for ( int i = 0; i < items.size(); ++i ) {
+        QCOMPARE( items[i]->feature(), expected[i]->feature() );
+        QCOMPARE( items[i]->latLonAltBox(), expected[i]->latLonAltBox() );
+        QCOMPARE( items[i]->zValue(), expected[i]->zValue() );
+        QCOMPARE( items[i]->minZoomLevel(), expected[i]->minZoomLevel() );
+        QCOMPARE( items[i]->paintLayers(), expected[i]->paintLayers() );
+    }
+
+    qDeleteAll( expected );
+    qDeleteAll( items );
+}
+
+void GeometryLayerTest::concurrentTiles()
+{
+    QVector<GeoDataDocument *> documents;
+    QVector<TileItemsJob *> jobs;
+    for ( int i = 0; i < 16; ++i ) {
+        documents << createTile( 0.01 * i );
+        jobs << new TileItemsJob( &m_layer, documents.last() );
+    }
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount( 4 );
+    for ( TileItemsJob *job: jobs ) {
+        threadPool.start( job );
+    }
+    threadPool.waitForDone();
+
+    for ( int i = 0; i < jobs.size(); ++i ) {
+        const QVector<GeoGraphicsItem *> items = jobs[i]->items();
+        QCOMPARE( items.size(), 2 );
+        QCOMPARE( items[0]->feature(), static_cast<const GeoDataFeature *>( documents[i]->child( 0 ) ) );
+        QCOMPARE( items[1]->feature(), static_cast<const GeoDataFeature *>( documents[i]->child( 1 ) ) );
+        qDeleteAll( items );
+    }
+
+    qDeleteAll( jobs );
+    qDeleteAll( documents );
+}
+
+void GeometryLayerTest::addAndRemoveTile()
+{
+    QScopedPointer<GeoDataDocument> document( createTile() );
+    QCOMPARE( renderLayer(), QString( "Geometries: 0 Zoom: 17" ) );
+
+    // Items created off the GUI thread are owned by the layer once added
+    TileItemsJob job( &m_layer, document.data() );
+    QThreadPool::globalInstance()->start( &job );
+    QThreadPool::globalInstance()->waitForDone();
+    m_layer.addTileDocument( document.data(), job.items() );
+    QCOMPARE( renderLayer(), QString( "Geometries: 2 Zoom: 17" ) );
+
+    m_layer.removeTileDocument( document.data() );
+    QCOMPARE( renderLayer(), QString( "Geometries: 0 Zoom: 17" ) );
+}
+
+}
+
+QTEST_MAIN( Marble::GeometryLayerTest )
+
+#include "GeometryLayerTest.moc"
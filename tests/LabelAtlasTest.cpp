@@ -0,0 +1,226 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "LabelAtlas.h"
+#include "TestUtils.h"
+
+#include <QFont>
+#include <QFontMetrics>
+#include <QImage>
+#include <QPainter>
+
+namespace Marble
+{
+
+class LabelAtlasTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void initTestCase();
+
+    void insertAndDraw();
+    void tooLarge();
+    void evictLeastRecentlyUsed();
+    void keepPendingPages();
+    void shrinkBudget();
+
+    void benchmark_data();
+    void benchmark();
+
+ private:
+    static QImage filledImage( const QSize &size, const QColor &color );
+    QImage labelImage( const QString &text ) const;
+
+    /** Street names of a dense city map, many of them repeated */
+    QStringList m_texts;
+    QFont m_font;
+};
+
+void LabelAtlasTest::initTestCase()
+{
+    for ( int i = 0; i < 1000; ++i ) {
+        m_texts << QStringLiteral( "Street %1" ).arg( i );
+    }
+    m_font.setPointSize( 9 );
+}
+
+QImage LabelAtlasTest::filledImage( const QSize &size, const QColor &color )
+{
+    QImage image( size, QImage::Format_ARGB32_Premultiplied );
+    image.fill( color.rgba() );
+    return image;
+}
+
+QImage LabelAtlasTest::labelImage( const QString &text ) const
+{
+    QImage image( QFontMetrics( m_font ).size( 0, text ), QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+    QPainter painter( &image );
+    painter.setFont( m_font );
+    painter.drawText( image.rect(), text );
+    return image;
+}
+
+void LabelAtlasTest::insertAndDraw()
+{
+    LabelAtlas atlas;
+    const QString key = LabelAtlas::key( QStringLiteral( "Marble" ), m_font, Qt::red );
+    QCOMPARE( key, LabelAtlas::key( QStringLiteral( "Marble" ), m_font, Qt::red ) );
+    QVERIFY( key != LabelAtlas::key( QStringLiteral( "Marble" ), m_font, Qt::red, 1 ) );
+    QVERIFY( key != LabelAtlas::key( QStringLiteral( "Marble" ), m_font, Qt::blue ) );
+
+    QVERIFY( !atlas.draw( key, QPointF( 10, 10 ) ) );
+    QVERIFY( atlas.insert( key, filledImage( QSize( 20, 10 ), Qt::red ) ) );
+    QVERIFY( atlas.contains( key ) );
+    QCOMPARE( atlas.labelCount(), 1 );
+    QCOMPARE( atlas.pageCount(), 1 );
+
+    QVERIFY( atlas.draw( key, QPointF( 20, 20 ) ) );
+    QVERIFY( atlas.draw( key, QPointF( 60, 20 ) ) );
+    QCOMPARE( atlas.pendingCount(), 2 );
+
+    QImage target = filledImage( QSize( 100, 40 ), Qt::white );
+    QPainter painter( &target );
+    atlas.flush( &painter );
+    painter.end();
+    QCOMPARE( atlas.pendingCount(), 0 );
+
+    QCOMPARE( target.pixel( 20, 20 ), QColor( Qt::red ).rgba() );
+    QCOMPARE( target.pixel( 11, 16 ), QColor( Qt::red ).rgba() );
+    QCOMPARE( target.pixel( 60, 20 ), QColor( Qt::red ).rgba() );
+    QCOMPARE( target.pixel( 40, 20 ), QColor( Qt::white ).rgba() );
+    QCOMPARE( target.pixel( 20, 5 ), QColor( Qt::white ).rgba() );
+}
+
+void LabelAtlasTest::tooLarge()
+{
+    LabelAtlas atlas;
+    QVERIFY( !atlas.insert( QStringLiteral( "wide" ), filledImage( QSize( LabelAtlas::pageSize().width() + 1, 10 ), Qt::red ) ) );
+    QVERIFY( !atlas.insert( QStringLiteral( "null" ), QImage() ) );
+    QCOMPARE( atlas.labelCount(), 0 );
+}
+
+void LabelAtlasTest::evictLeastRecentlyUsed()
+{
+    // A single page holding four quarter page labels
+    LabelAtlas atlas( 0 );
+    const QSize quarter = LabelAtlas::pageSize() / 2 - QSize( 2, 2 );
+    for ( int i = 0; i < 4; ++i ) {
+        QVERIFY( atlas.insert( QString::number( i ), filledImage( quarter, Qt::red ) ) );
+    }
+    QCOMPARE( atlas.pageCount(), 1 );
+    QCOMPARE( atlas.labelCount(), 4 );
+    QCOMPARE( atlas.evictionCount(), qint64( 0 ) );
+
+    QVERIFY( atlas.insert( QStringLiteral( "4" ), filledImage( quarter, Qt::red ) ) );
+    QCOMPARE( atlas.pageCount(), 1 );
+    QCOMPARE( atlas.labelCount(), 1 );
+    QCOMPARE( atlas.evictionCount(), qint64( 1 ) );
+    QVERIFY( atlas.byteCount() <= qint64( 4 ) * LabelAtlas::pageSize().width() * LabelAtlas::pageSize().height() );
+}
+
+void LabelAtlasTest::keepPendingPages()
+{
+    LabelAtlas atlas( 0 );
+    const QSize half( LabelAtlas::pageSize().width() - 2, LabelAtlas::pageSize().height() / 2 - 2 );
+    QVERIFY( atlas.insert( QStringLiteral( "a" ), filledImage( half, Qt::red ) ) );
+    QVERIFY( atlas.insert( QStringLiteral( "b" ), filledImage( half, Qt::red ) ) );
+    QVERIFY( atlas.draw( QStringLiteral( "a" ), QPointF( 0, 0 ) ) );
+
+    // The only page is still needed for the pending fragment
+    QVERIFY( !atlas.insert( QStringLiteral( "c" ), filledImage( half, Qt::red ) ) );
+    QVERIFY( atlas.contains( QStringLiteral( "a" ) ) );
+
+    QImage target = filledImage( QSize( 10, 10 ), Qt::white );
+    QPainter painter( &target );
+    atlas.flush( &painter );
+    painter.end();
+
+    QVERIFY( atlas.insert( QStringLiteral( "c" ), filledImage( half, Qt::red ) ) );
+    QVERIFY( !atlas.contains( QStringLiteral( "a" ) ) );
+}
+
+void LabelAtlasTest::shrinkBudget()
+{
+    const qint64 pageBytes = qint64( 4 ) * LabelAtlas::pageSize().width() * LabelAtlas::pageSize().height();
+    LabelAtlas atlas( 3 * pageBytes );
+    const QSize full = LabelAtlas::pageSize() - QSize( 2, 2 );
+    for ( int i = 0; i < 3; ++i ) {
+        QVERIFY( atlas.insert( QString::number( i ), filledImage( full, Qt::red ) ) );
+    }
+    QCOMPARE( atlas.pageCount(), 3 );
+    QVERIFY( atlas.draw( QStringLiteral( "0" ), QPointF( 0, 0 ) ) );
+
+    atlas.setBudget( pageBytes );
+    QCOMPARE( atlas.budget(), pageBytes );
+    QCOMPARE( atlas.pageCount(), 1 );
+    QCOMPARE( atlas.labelCount(), 1 );
+    QVERIFY( atlas.contains( QStringLiteral( "0" ) ) );
+
+    QImage target = filledImage( LabelAtlas::pageSize(), Qt::white );
+    QPainter painter( &target );
+    atlas.flush( &painter );
+    painter.end();
+    QCOMPARE( target.pixel( 10, 10 ), QColor( Qt::red ).rgba() );
+}
+
+void LabelAtlasTest::benchmark_data()
+{
+    QTest::addColumn<bool>( "useAtlas" );
+    QTest::addColumn<qreal>( "rotation" );
+
+    QTest::newRow( "drawText" ) << false << 0.0;
+    QTest::newRow( "drawText rotated" ) << false << 30.0;
+    QTest::newRow( "atlas" ) << true << 0.0;
+    QTest::newRow( "atlas rotated" ) << true << 30.0;
+}
+
+void LabelAtlasTest::benchmark()
+{
+    QFETCH( bool, useAtlas );
+    QFETCH( qreal, rotation );
+
+    // 5000 labels per frame, spread over the screen
+    const int labelCount = 5000;
+    QImage target( 1920, 1080, QImage::Format_ARGB32_Premultiplied );
+    LabelAtlas atlas( 32 * 1024 * 1024 );
+
+    QBENCHMARK {
+        QPainter painter( &target );
+        painter.setFont( m_font );
+        for ( int i = 0; i < labelCount; ++i ) {
+            const QString &text = m_texts[i % m_texts.size()];
+            const QPointF center( ( 37 * i ) % target.width(), ( 11 * i ) % target.height() );
+            if ( useAtlas ) {
+                const QString key = LabelAtlas::key( text, m_font, Qt::black );
+                if ( !atlas.contains( key ) ) {
+                    atlas.insert( key, labelImage( text ) );
+                }
+                atlas.draw( key, center, rotation );
+            } else {
+                painter.save();
+                painter.translate( center );
+                painter.rotate( rotation );
+                painter.drawText( QPointF( 0, 0 ), text );
+                painter.restore();
+            }
+        }
+        atlas.flush( &painter );
+    }
+
+    if ( useAtlas ) {
+        QCOMPARE( atlas.labelCount(), m_texts.size() );
+    }
+}
+
+}
+
+QTEST_MAIN( Marble::LabelAtlasTest )
+
+#include "LabelAtlasTest.moc"
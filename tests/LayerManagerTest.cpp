@@ -0,0 +1,211 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "GeoPainter.h"
+#include "LayerInterface.h"
+#include "MarbleMap.h"
+#include "ViewportParams.h"
+
+#include <QImage>
+#include <QTest>
+
+namespace Marble
+{
+
+/**
+ * A retained layer filling the whole viewport with a single color
+ * and counting how often it is rendered.
+ */
+class ColorLayer : public QObject, public LayerInterface
+{
+    Q_OBJECT
+
+public:
+    ColorLayer( const QString &renderPosition, const QColor &color, qreal zValue ) :
+        m_renderPosition( renderPosition ),
+        m_color( color ),
+        m_zValue( zValue ),
+        m_renderCount( 0 )
+    {
+    }
+
+    QStringList renderPosition() const override
+    {
+        return QStringList() << m_renderPosition;
+    }
+
+    void setRenderPosition( const QString &renderPosition )
+    {
+        m_renderPosition = renderPosition;
+    }
+
+    qreal zValue() const override
+    {
+        return m_zValue;
+    }
+
+    void setZValue( qreal zValue )
+    {
+        m_zValue = zValue;
+    }
+
+    bool supportsRetainedRendering() const override
+    {
+        return true;
+    }
+
+    bool render( GeoPainter *painter, ViewportParams *viewport,
+                 const QString &renderPos, GeoSceneLayer *layer ) override
+    {
+        Q_UNUSED( renderPos )
+        Q_UNUSED( layer )
+
+        painter->fillRect( QRect( QPoint( 0, 0 ), viewport->size() ), m_color );
+        ++m_renderCount;
+
+        return true;
+    }
+
+    int renderCount() const
+    {
+        return m_renderCount;
+    }
+
+Q_SIGNALS:
+    void repaintNeeded();
+
+private:
+    QString m_renderPosition;
+    const QColor m_color;
+    qreal m_zValue;
+    int m_renderCount;
+};
+
+class LayerManagerTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void retainedBuffers();
+    void zValueChange();
+    void renderPositionChange();
+    void angleUnitChange();
+
+ private:
+    QRgb renderMap();
+
+    MarbleMap *m_map;
+    ColorLayer *m_red;
+    ColorLayer *m_blue;
+};
+
+void LayerManagerTest::init()
+{
+    m_map = new MarbleMap;
+    m_map->setMapThemeId( "earth/plain/plain.dgml" );
+    m_map->setSize( 200, 100 );
+
+    m_red = new ColorLayer( "ALWAYS_ON_TOP", Qt::red, 1.0 );
+    m_blue = new ColorLayer( "ALWAYS_ON_TOP", Qt::blue, 2.0 );
+    m_map->addLayer( m_red );
+    m_map->addLayer( m_blue );
+}
+
+void LayerManagerTest::cleanup()
+{
+    m_map->removeLayer( m_red );
+    m_map->removeLayer( m_blue );
+    delete m_red;
+    delete m_blue;
+    delete m_map;
+}
+
+QRgb LayerManagerTest::renderMap()
+{
+    QImage image( m_map->size(), QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+    GeoPainter painter( &image, m_map->viewport(), m_map->mapQuality() );
+    m_map->paint( painter, QRect() );
+    painter.end();
+
+    return image.pixel( image.width() / 2, image.height() / 2 );
+}
+
+void LayerManagerTest::retainedBuffers()
+{
+    QCOMPARE( renderMap(), QColor( Qt::blue ).rgb() );
+    QCOMPARE( m_red->renderCount(), 1 );
+    QCOMPARE( m_blue->renderCount(), 1 );
+
+    // the buffers of the previous frame are composited again
+    QCOMPARE( renderMap(), QColor( Qt::blue ).rgb() );
+    QCOMPARE( m_red->renderCount(), 1 );
+    QCOMPARE( m_blue->renderCount(), 1 );
+
+    // only the layer asking for it is repainted
+    emit m_red->repaintNeeded();
+    renderMap();
+    QCOMPARE( m_red->renderCount(), 2 );
+    QCOMPARE( m_blue->renderCount(), 1 );
+
+    // a new viewport invalidates all buffers
+    m_map->rotateBy( 10.0, 0.0 );
+    renderMap();
+    QCOMPARE( m_red->renderCount(), 3 );
+    QCOMPARE( m_blue->renderCount(), 2 );
+}
+
+void LayerManagerTest::zValueChange()
+{
+    QCOMPARE( renderMap(), QColor( Qt::blue ).rgb() );
+
+    // the new order is picked up with the repaint the layer asks for
+    m_red->setZValue( 3.0 );
+    emit m_red->repaintNeeded();
+    QCOMPARE( renderMap(), QColor( Qt::red ).rgb() );
+
+    // the order changed, not the content of the other layer
+    QCOMPARE( m_red->renderCount(), 2 );
+    QCOMPARE( m_blue->renderCount(), 1 );
+}
+
+void LayerManagerTest::renderPositionChange()
+{
+    QCOMPARE( renderMap(), QColor( Qt::blue ).rgb() );
+
+    m_blue->setRenderPosition( "SURFACE" );
+    emit m_blue->repaintNeeded();
+    QCOMPARE( renderMap(), QColor( Qt::red ).rgb() );
+
+    m_blue->setRenderPosition( "USER_TOOLS" );
+    emit m_blue->repaintNeeded();
+    QCOMPARE( renderMap(), QColor( Qt::blue ).rgb() );
+}
+
+}
+
+void LayerManagerTest::angleUnitChange()
+{
+    const AngleUnit angleUnit = m_map->defaultAngleUnit();
+    renderMap();
+
+    // layers may show coordinates in the default notation
+    m_map->setDefaultAngleUnit( angleUnit == DecimalDegree ? DMSDegree : DecimalDegree );
+    renderMap();
+    QCOMPARE( m_red->renderCount(), 2 );
+    QCOMPARE( m_blue->renderCount(), 2 );
+
+    m_map->setDefaultAngleUnit( angleUnit );
+}
+
+QTEST_MAIN( Marble::LayerManagerTest )
+
+#include "LayerManagerTest.moc"
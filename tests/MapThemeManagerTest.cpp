@@ -0,0 +1,199 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "MapThemeManager.h"
+#include "MarbleDirs.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QIcon>
+#include <QImage>
+#include <QStandardItemModel>
+#include <QTemporaryDir>
+#include <QTest>
+
+namespace Marble
+{
+
+class MapThemeManagerTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void initTestCase();
+    void init();
+
+    void cacheHit();
+    void themeChanged();
+    void iconChanged();
+    void iconRemoved();
+
+ private:
+    /** Writes a theme named @p name, which has the same size for names of the same length */
+    void writeTheme( const QString &name, const QDateTime &modified );
+    void writeIcon( const QColor &color, const QDateTime &modified );
+    static void setModified( const QString &path, const QDateTime &modified );
+
+    /** Lists the themes with a new manager, which reads the index written before. A missing icon is color 0. */
+    void listThemes( QString &name, QRgb &iconColor );
+
+    QTemporaryDir m_localDir;
+    QTemporaryDir m_systemDir;
+    QString m_themeDir;
+    const QDateTime m_created = QDateTime( QDate( 2020, 1, 1 ), QTime( 12, 0 ) );
+    const QDateTime m_changed = QDateTime( QDate( 2020, 1, 2 ), QTime( 12, 0 ) );
+};
+
+void MapThemeManagerTest::initTestCase()
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 10, 0)
+    QSKIP( "Setting file modification times needs Qt 5.10" );
+#endif
+    QVERIFY( m_localDir.isValid() );
+    QVERIFY( m_systemDir.isValid() );
+
+    // The index is written to the local path, keep it away from the user's one
+    qputenv( "XDG_DATA_HOME", QFile::encodeName( m_localDir.path() ) );
+    MarbleDirs::setMarbleDataPath( m_systemDir.path() );
+
+    m_themeDir = m_systemDir.path() + QLatin1String( "/maps/earth/test" );
+    QVERIFY( QDir().mkpath( m_themeDir ) );
+}
+
+void MapThemeManagerTest::init()
+{
+    QFile::remove( m_localDir.path() + QLatin1String( "/marble/mapthemes.index" ) );
+    writeTheme( "Theme A", m_created );
+    writeIcon( Qt::red, m_created );
+
+    QString name;
+    QRgb iconColor = 0;
+    listThemes( name, iconColor );
+    QCOMPARE( name, QString( "Theme A" ) );
+    QCOMPARE( iconColor, QColor( Qt::red ).rgb() );
+}
+
+void MapThemeManagerTest::writeTheme( const QString &name, const QDateTime &modified )
+{
+    const QString path = m_themeDir + QLatin1String( "/test.dgml" );
+    QFile file( path );
+    QVERIFY( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) );
+    file.write( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<dgml xmlns=\"http://edu.kde.org/marble/dgml/2.0\">\n"
+                "  <document>\n"
+                "    <head>\n"
+                "      <name>" + name.toUtf8() + "</name>\n"
+                "      <target>earth</target>\n"
+                "      <theme>test</theme>\n"
+                "      <icon pixmap=\"test-preview.png\"/>\n"
+                "      <visible>true</visible>\n"
+                "      <description>A test theme</description>\n"
+                "    </head>\n"
+                "    <map bgcolor=\"#000000\">\n"
+                "      <canvas/>\n"
+                "      <target/>\n"
+                "    </map>\n"
+                "  </document>\n"
+                "</dgml>\n" );
+    file.close();
+    setModified( path, modified );
+}
+
+void MapThemeManagerTest::writeIcon( const QColor &color, const QDateTime &modified )
+{
+    const QString path = m_themeDir + QLatin1String( "/test-preview.png" );
+    QImage icon( 136, 136, QImage::Format_ARGB32 );
+    icon.fill( color );
+    QVERIFY( icon.save( path ) );
+    setModified( path, modified );
+}
+
+void MapThemeManagerTest::setModified( const QString &path, const QDateTime &modified )
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+    QFile file( path );
+    QVERIFY( file.open( QIODevice::ReadWrite ) );
+    QVERIFY( file.setFileTime( modified, QFileDevice::FileModificationTime ) );
+#else
+    Q_UNUSED( path )
+    Q_UNUSED( modified )
+#endif
+}
+
+void MapThemeManagerTest::listThemes( QString &name, QRgb &iconColor )
+{
+    MapThemeManager manager;
+    QStandardItemModel *const model = manager.mapThemeModel();
+    QCOMPARE( model->rowCount(), 1 );
+
+    const QModelIndex index = model->index( 0, 0 );
+    QCOMPARE( index.data( Qt::UserRole + 1 ).toString(), QString( "earth/test/test.dgml" ) );
+    name = index.data( Qt::DisplayRole ).toString();
+    const QImage icon = index.data( Qt::DecorationRole ).value<QIcon>().pixmap( 136, 136 ).toImage();
+    iconColor = icon.isNull() ? 0 : icon.pixel( icon.width() / 2, icon.height() / 2 );
+}
+
+void MapThemeManagerTest::cacheHit()
+{
+    // Files changed behind the back of the index are not read again
+    writeTheme( "Theme B", m_created );
+    writeIcon( Qt::blue, m_created );
+
+    QString name;
+    QRgb iconColor = 0;
+    listThemes( name, iconColor );
+    QCOMPARE( name, QString( "Theme A" ) );
+    QCOMPARE( iconColor, QColor( Qt::red ).rgb() );
+}
+
+void MapThemeManagerTest::themeChanged()
+{
+    writeTheme( "Theme B", m_changed );
+
+    QString name;
+    QRgb iconColor = 0;
+    listThemes( name, iconColor );
+    QCOMPARE( name, QString( "Theme B" ) );
+    QCOMPARE( iconColor, QColor( Qt::red ).rgb() );
+}
+
+void MapThemeManagerTest::iconChanged()
+{
+    // An updated preview alone invalidates the entry
+    writeIcon( Qt::blue, m_changed );
+
+    QString name;
+    QRgb iconColor = 0;
+    listThemes( name, iconColor );
+    QCOMPARE( name, QString( "Theme A" ) );
+    QCOMPARE( iconColor, QColor( Qt::blue ).rgb() );
+
+    // And the new one is cached again
+    writeIcon( Qt::green, m_changed );
+    listThemes( name, iconColor );
+    QCOMPARE( iconColor, QColor( Qt::blue ).rgb() );
+}
+
+void MapThemeManagerTest::iconRemoved()
+{
+    QVERIFY( QFile::remove( m_themeDir + QLatin1String( "/test-preview.png" ) ) );
+
+    // The default icon is not part of the test data, so there is none at all
+    QString name;
+    QRgb iconColor = 0;
+    listThemes( name, iconColor );
+    QCOMPARE( name, QString( "Theme A" ) );
+    QCOMPARE( iconColor, QRgb( 0 ) );
+}
+
+}
+
+QTEST_MAIN( Marble::MapThemeManagerTest )
+
+#include "MapThemeManagerTest.moc"
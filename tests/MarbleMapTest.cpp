@@ -8,11 +8,17 @@
 // Copyright 2011       Bernhard Beschow <bbeschow@cs.tu-berlin.de>
 //
 
+#include "FileManager.h"
 #include "GeoPainter.h"
 #include "MarbleMap.h"
 #include "MarbleModel.h"
 #include "TestUtils.h"
 
+#include <QFile>
+#include <QImage>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTextStream>
 #include <QThreadPool>
 
 namespace Marble
@@ -66,6 +72,8 @@ class MarbleMapTest : public QObject
     void paint_data();
     void paint();
 
+    void openLargeFile();
+
  private:
     MarbleModel m_model;
 };
@@ -594,6 +602,55 @@ void MarbleMapTest::paint()
     QThreadPool::globalInstance()->waitForDone();  // wait for all runners to terminate
 }
 
+void MarbleMapTest::openLargeFile()
+{
+    const int folderCount = 200;
+    const int placemarksPerFolder = 250;
+
+    QTemporaryDir directory;
+    QVERIFY( directory.isValid() );
+    const QString fileName = directory.path() + QLatin1String( "/large.kml" );
+    {
+        QFile file( fileName );
+        QVERIFY( file.open( QFile::WriteOnly ) );
+        QTextStream stream( &file );
+        stream << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+               << "<kml xmlns=\"http://www.opengis.net/kml/2.2\"><Document>\n";
+        for ( int folder = 0; folder < folderCount; ++folder ) {
+            stream << "<Folder><name>Folder " << folder << "</name>\n";
+            for ( int i = 0; i < placemarksPerFolder; ++i ) {
+                const qreal lon = -180.0 + 360.0 * i / placemarksPerFolder;
+                const qreal lat = -80.0 + 160.0 * folder / folderCount;
+                stream << "<Placemark><name>" << folder << '/' << i << "</name>"
+                       << "<Point><coordinates>" << lon << ',' << lat << "</coordinates></Point></Placemark>\n";
+            }
+            stream << "</Folder>\n";
+        }
+        stream << "</Document></kml>\n";
+    }
+
+    MarbleModel model;
+    MarbleMap map( &model );
+    map.setMapThemeId( "earth/plain/plain.dgml" );
+    map.setSize( 800, 600 );
+    QImage image( map.size(), QImage::Format_ARGB32_Premultiplied );
+
+    QSignalSpy fileAddedSpy( model.fileManager(), SIGNAL(fileAdded(QString)) );
+
+    // From opening the file to the first frame showing its placemarks
+    QBENCHMARK_ONCE {
+        model.addGeoDataFile( fileName );
+        QVERIFY( fileAddedSpy.wait( 60000 ) );
+
+        GeoPainter painter( &image, map.viewport(), map.mapQuality() );
+        map.paint( painter, QRect() );
+    }
+
+    QVERIFY( model.placemarkModel()->rowCount() >= folderCount * placemarksPerFolder );
+
+    QThreadPool::globalInstance()->waitForDone();  // wait for all runners to terminate
+}
+
 }
 
 QTEST_MAIN( Marble::MarbleMapTest )
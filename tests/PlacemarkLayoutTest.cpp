@@ -0,0 +1,187 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "PlacemarkLayout.h"
+
+#include "GeoDataLabelStyle.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataStyle.h"
+#include "MarbleClock.h"
+#include "MarblePlacemarkModel.h"
+#include "StyleBuilder.h"
+#include "ViewportParams.h"
+#include "VisiblePlacemark.h"
+
+#include <QItemSelectionModel>
+#include <QStandardItemModel>
+#include <QTest>
+
+#include <algorithm>
+
+namespace Marble
+{
+
+class PlacemarkLayoutTest : public QObject
+{
+    Q_OBJECT
+
+ public:
+    PlacemarkLayoutTest();
+
+ private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void mergeOrder();
+
+    void seeds_data();
+    void seeds();
+
+ private:
+    /** Adds a city with a label centered above it, labels at the same position overlap */
+    GeoDataPlacemark *addPlacemark( const QString &name, qreal lon, qreal lat, int zoomLevel, qint64 popularity );
+
+    static QVector<const GeoDataPlacemark *> placemarks( const QVector<VisiblePlacemark *> &layout );
+
+    QStandardItemModel m_model;
+    QItemSelectionModel m_selectionModel;
+    MarbleClock m_clock;
+    StyleBuilder m_styleBuilder;
+    QVector<GeoDataPlacemark *> m_placemarks;
+    PlacemarkLayout *m_layout;
+};
+
+PlacemarkLayoutTest::PlacemarkLayoutTest() :
+    m_selectionModel( &m_model ),
+    m_layout( nullptr )
+{
+}
+
+void PlacemarkLayoutTest::init()
+{
+    m_layout = new PlacemarkLayout( &m_model, &m_selectionModel, &m_clock, &m_styleBuilder );
+    m_layout->setShowCities( true );
+}
+
+void PlacemarkLayoutTest::cleanup()
+{
+    delete m_layout;
+    m_layout = nullptr;
+    m_model.clear();
+    qDeleteAll( m_placemarks );
+    m_placemarks.clear();
+}
+
+GeoDataPlacemark *PlacemarkLayoutTest::addPlacemark( const QString &name, qreal lon, qreal lat, int zoomLevel, qint64 popularity )
+{
+    GeoDataStyle::Ptr style( new GeoDataStyle );
+    style->labelStyle().setAlignment( GeoDataLabelStyle::Center );
+
+    GeoDataPlacemark *placemark = new GeoDataPlacemark( name );
+    placemark->setCoordinate( lon, lat, 0.0, GeoDataCoordinates::Degree );
+    placemark->setVisualCategory( GeoDataPlacemark::SmallCity );
+    placemark->setZoomLevel( zoomLevel );
+    placemark->setPopularity( popularity );
+    placemark->setStyle( style );
+    m_placemarks << placemark;
+
+    QStandardItem *item = new QStandardItem( name );
+    item->setData( QVariant::fromValue<GeoDataObject *>( placemark ), MarblePlacemarkModel::ObjectPointerRole );
+    m_model.appendRow( item );
+
+    return placemark;
+}
+
+QVector<const GeoDataPlacemark *> PlacemarkLayoutTest::placemarks( const QVector<VisiblePlacemark *> &layout )
+{
+    QVector<const GeoDataPlacemark *> result;
+    for ( const VisiblePlacemark *mark: layout ) {
+        result << mark->placemark();
+    }
+    return result;
+}
+
+void PlacemarkLayoutTest::mergeOrder()
+{
+    // Far enough apart for all labels to fit, spread over many tiles and levels
+    for ( int lon = -40; lon <= 40; lon += 10 ) {
+        for ( int lat = -40; lat <= 40; lat += 10 ) {
+            const int i = m_placemarks.size();
+            addPlacemark( QString( "P%1" ).arg( i ), lon, lat, 1 + ( i * 7 ) % 5, ( i * 13 ) % 17 * 1000 );
+        }
+    }
+
+    QVector<const GeoDataPlacemark *> expected;
+    for ( const GeoDataPlacemark *placemark: m_placemarks ) {
+        expected << placemark;
+    }
+    std::sort( expected.begin(), expected.end(), GeoDataPlacemark::placemarkLayoutOrderCompare );
+
+    const ViewportParams viewport( Spherical, 0.0, 0.0, 1000, QSize( 2000, 2000 ) );
+    QCOMPARE( placemarks( m_layout->generateLayout( &viewport, 5 ) ), expected );
+
+    // Placemarks added later are sorted into their tiles
+    addPlacemark( "Added", 5.0, 5.0, 1, 100000 );
+    expected << m_placemarks.last();
+    std::sort( expected.begin(), expected.end(), GeoDataPlacemark::placemarkLayoutOrderCompare );
+    QCOMPARE( placemarks( m_layout->generateLayout( &viewport, 5 ) ), expected );
+}
+
+void PlacemarkLayoutTest::seeds_data()
+{
+    QTest::addColumn<bool>( "temporalCoherence" );
+    QTest::addColumn<int>( "zoomLevel" );
+    QTest::addColumn<QString>( "change" );
+    QTest::addColumn<bool>( "keepsLabel" );
+
+    QTest::newRow( "unchanged" ) << true << 3 << "none" << true;
+    QTest::newRow( "pan" ) << true << 3 << "pan" << true;
+    QTest::newRow( "zoom" ) << true << 3 << "zoom" << false;
+    QTest::newRow( "resize" ) << true << 3 << "resize" << false;
+    QTest::newRow( "tile level" ) << true << 3 << "tile level" << false;
+    QTest::newRow( "lower zoom level" ) << true << 2 << "pan" << false;
+    QTest::newRow( "disabled" ) << false << 3 << "pan" << false;
+}
+
+void PlacemarkLayoutTest::seeds()
+{
+    QFETCH( bool, temporalCoherence );
+    QFETCH( int, zoomLevel );
+    QFETCH( QString, change );
+    QFETCH( bool, keepsLabel );
+
+    m_layout->setTemporalCoherence( temporalCoherence );
+
+    ViewportParams viewport( Spherical, 0.0, 0.0, 1000, QSize( 800, 600 ) );
+    int tileLevel = 5;
+    const GeoDataPlacemark *shown = addPlacemark( "Shown", 1.0, 1.0, 3, 1000 );
+    QCOMPARE( placemarks( m_layout->generateLayout( &viewport, tileLevel ) ),
+              QVector<const GeoDataPlacemark *>() << shown );
+
+    // A more popular placemark at the same position competes for the room of the label
+    const GeoDataPlacemark *added = addPlacemark( "Added", 1.0, 1.0, zoomLevel, 1000000 );
+
+    if ( change == QLatin1String( "pan" ) ) {
+        viewport.centerOn( 0.01, 0.0 );
+    } else if ( change == QLatin1String( "zoom" ) ) {
+        viewport.setRadius( 1100 );
+    } else if ( change == QLatin1String( "resize" ) ) {
+        viewport.setSize( QSize( 900, 600 ) );
+    } else if ( change == QLatin1String( "tile level" ) ) {
+        tileLevel = 6;
+    }
+
+    QCOMPARE( placemarks( m_layout->generateLayout( &viewport, tileLevel ) ),
+              QVector<const GeoDataPlacemark *>() << ( keepsLabel ? shown : added ) );
+}
+
+}
+
+QTEST_MAIN( Marble::PlacemarkLayoutTest )
+
+#include "PlacemarkLayoutTest.moc"
@@ -10,25 +10,90 @@
 
 
 #include "MarbleDirs.h"
+#include "ParseRunnerPlugin.h"
 #include "PluginManager.h"
 
+#include <QFile>
+#include <QRunnable>
+#include <QTemporaryDir>
 #include <QTest>
+#include <QThreadPool>
 
 namespace Marble
 {
 
+/** Asks for the parse runner plugins like the file and tile loading threads do */
+class ParseRunnerPluginsJob : public QRunnable
+{
+public:
+    explicit ParseRunnerPluginsJob( const PluginManager *pluginManager ) :
+        m_pluginManager( pluginManager )
+    {
+        setAutoDelete( false );
+    }
+
+    void run() override
+    {
+        m_plugins = m_pluginManager->parsingRunnerPlugins();
+    }
+
+    QList<const ParseRunnerPlugin *> plugins() const
+    {
+        return m_plugins;
+    }
+
+private:
+    const PluginManager *const m_pluginManager;
+    QList<const ParseRunnerPlugin *> m_plugins;
+};
+
 class PluginManagerTest : public QObject
 {
     Q_OBJECT
     private Q_SLOTS:
+        void initTestCase();
         void loadPlugins();
+        void lazyLoading();
+        void concurrentLoading();
+
+        void startup_data();
+        void startup();
+
+    private:
+        static QList<int> pluginCounts( bool lazy );
+
+        QTemporaryDir m_localDir;
 };
 
-void PluginManagerTest::loadPlugins()
+void PluginManagerTest::initTestCase()
 {
+    // The plugin index is written to the local path, keep it away from the user's one
+    QVERIFY( m_localDir.isValid() );
+    qputenv( "XDG_DATA_HOME", QFile::encodeName( m_localDir.path() ) );
+
     MarbleDirs::setMarbleDataPath( DATA_PATH );
     MarbleDirs::setMarblePluginPath( PLUGIN_PATH );
+}
 
+QList<int> PluginManagerTest::pluginCounts( bool lazy )
+{
+    PluginManager::setLazyLoading( lazy );
+
+    PluginManager pm;
+    QList<int> counts;
+    counts << pm.renderPlugins().size()
+           << pm.positionProviderPlugins().size()
+           << pm.searchRunnerPlugins().size()
+           << pm.reverseGeocodingRunnerPlugins().size()
+           << pm.routingRunnerPlugins().size()
+           << pm.parsingRunnerPlugins().size();
+
+    PluginManager::setLazyLoading( true );
+    return counts;
+}
+
+void PluginManagerTest::loadPlugins()
+{
     const int pluginNumber = MarbleDirs::pluginEntryList( "", QDir::Files ).size();
 
     PluginManager pm;
@@ -44,6 +109,63 @@ void PluginManagerTest::loadPlugins()
     QCOMPARE( renderPlugins + positionPlugins + runnerPlugins, pluginNumber );
 }
 
+void PluginManagerTest::lazyLoading()
+{
+    const QList<int> eager = pluginCounts( false );
+
+    // The first lazy run fills the plugin index, the second one relies on it
+    QCOMPARE( pluginCounts( true ), eager );
+    QCOMPARE( pluginCounts( true ), eager );
+}
+
+void PluginManagerTest::concurrentLoading()
+{
+    const int parsingRunnerPlugins = pluginCounts( false ).last();
+
+    // None of the threads sees a partially loaded list
+    PluginManager pm;
+    QVector<ParseRunnerPluginsJob *> jobs;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount( 4 );
+    for ( int i = 0; i < 4; ++i ) {
+        jobs << new ParseRunnerPluginsJob( &pm );
+        threadPool.start( jobs.last() );
+    }
+    threadPool.waitForDone();
+
+    for ( const ParseRunnerPluginsJob *job: jobs ) {
+        QCOMPARE( job->plugins().size(), parsingRunnerPlugins );
+        for ( const ParseRunnerPlugin *plugin: job->plugins() ) {
+            QCOMPARE( plugin->thread(), pm.thread() );
+        }
+    }
+    qDeleteAll( jobs );
+}
+
+void PluginManagerTest::startup_data()
+{
+    QTest::addColumn<bool>( "lazy" );
+
+    QTest::newRow( "lazy" ) << true;
+    QTest::newRow( "eager" ) << false;
+}
+
+void PluginManagerTest::startup()
+{
+    QFETCH( bool, lazy );
+
+    // Plugins needed to show the first frame. Libraries stay loaded in this
+    // process once loaded, so this compares the discovery overhead of both modes
+    // rather than the cost of loading libraries that are not needed yet.
+    PluginManager::setLazyLoading( lazy );
+    QBENCHMARK {
+        PluginManager pm;
+        pm.renderPlugins();
+        pm.parsingRunnerPlugins();
+    }
+    PluginManager::setLazyLoading( true );
+}
+
 }
 
 QTEST_MAIN( Marble::PluginManagerTest )
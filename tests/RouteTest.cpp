@@ -0,0 +1,107 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include <QTest>
+
+#include "routing/Route.h"
+#include "MarbleGlobal.h"
+
+namespace Marble
+{
+
+class RouteTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void emptyRoute();
+    void positionOnRoute_data();
+    void positionOnRoute();
+
+private:
+    static Route zigZagRoute();
+};
+
+Route RouteTest::zigZagRoute()
+{
+    // A route running east with a zigzag every few hundred meters and a
+    // final leg back west, so that some segments are spatially close to
+    // segments far away in the segment order
+    Route route;
+    qreal lon = 10.0;
+    for ( int i=0; i<2000; ++i ) {
+        GeoDataLineString path;
+        path << GeoDataCoordinates( lon, 50.0 + ( i % 2 ) * 0.002, 0.0, GeoDataCoordinates::Degree );
+        lon += 0.004;
+        path << GeoDataCoordinates( lon, 50.0 + ( ( i + 1 ) % 2 ) * 0.002, 0.0, GeoDataCoordinates::Degree );
+        RouteSegment segment;
+        segment.setPath( path );
+        route.addRouteSegment( segment );
+    }
+    for ( int i=0; i<500; ++i ) {
+        GeoDataLineString path;
+        path << GeoDataCoordinates( lon, 50.01, 0.0, GeoDataCoordinates::Degree );
+        lon -= 0.016;
+        path << GeoDataCoordinates( lon, 50.01, 0.0, GeoDataCoordinates::Degree );
+        RouteSegment segment;
+        segment.setPath( path );
+        route.addRouteSegment( segment );
+    }
+    return route;
+}
+
+void RouteTest::emptyRoute()
+{
+    Route route;
+    route.setPosition( GeoDataCoordinates( 10.0, 50.0, 0.0, GeoDataCoordinates::Degree ) );
+    QVERIFY( !route.currentSegment().isValid() );
+    QVERIFY( route.distanceToRoute() < 0.0 );
+}
+
+void RouteTest::positionOnRoute_data()
+{
+    QTest::addColumn<qreal>( "lon" );
+    QTest::addColumn<qreal>( "lat" );
+
+    QTest::newRow( "start" ) << 10.0 << 50.0;
+    QTest::newRow( "near start" ) << 10.001 << 50.0015;
+    QTest::newRow( "middle" ) << 14.0 << 50.001;
+    QTest::newRow( "return leg" ) << 15.0 << 50.0095;
+    QTest::newRow( "between legs" ) << 12.0 << 50.006;
+    QTest::newRow( "far off" ) << 20.0 << 51.0;
+    QTest::newRow( "end" ) << 10.0 << 50.01;
+    QTest::newRow( "back to start" ) << 10.0 << 50.0;
+}
+
+void RouteTest::positionOnRoute()
+{
+    QFETCH( qreal, lon );
+    QFETCH( qreal, lat );
+
+    static Route route = zigZagRoute();
+    GeoDataCoordinates const position( lon, lat, 0.0, GeoDataCoordinates::Degree );
+    route.setPosition( position );
+
+    qreal expected = -1.0;
+    GeoDataCoordinates closest, interpolated;
+    for ( int i=0; i<route.size(); ++i ) {
+        qreal const distance = route.at( i ).distanceTo( position, closest, interpolated );
+        if ( expected < 0.0 || distance < expected ) {
+            expected = distance;
+        }
+    }
+
+    QCOMPARE( route.distanceToRoute(), expected );
+    QCOMPARE( route.currentSegment().distanceTo( position, closest, interpolated ), expected );
+}
+
+}
+
+QTEST_MAIN( Marble::RouteTest )
+
+#include "RouteTest.moc"
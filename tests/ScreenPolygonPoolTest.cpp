@@ -0,0 +1,212 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "GeoDataLineString.h"
+#include "GeoPainter.h"
+#include "ScreenPolygonPool.h"
+#include "ViewportParams.h"
+#include "TestUtils.h"
+
+#include <QImage>
+#include <QPolygonF>
+
+Q_DECLARE_METATYPE( Marble::Projection )
+
+namespace Marble
+{
+
+class ScreenPolygonPoolTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void initTestCase();
+
+    void reuse();
+    void limitCapacity();
+
+    void steadyState_data();
+    void steadyState();
+
+    void allocationsPerFrame_data();
+    void allocationsPerFrame();
+
+    void benchmark_data();
+    void benchmark();
+
+ private:
+    void addProjections();
+    void renderFrame( ViewportParams *viewport );
+
+    /** A dense grid of short streets around the globe */
+    QVector<GeoDataLineString> m_streets;
+};
+
+void ScreenPolygonPoolTest::initTestCase()
+{
+    for ( int i = 0; i < 200; ++i ) {
+        for ( int j = 0; j < 20; ++j ) {
+            const qreal lon = -180.0 + 1.8 * i;
+            const qreal lat = -60.0 + 6.0 * j;
+
+            GeoDataLineString street;
+            for ( int k = 0; k < 8; ++k ) {
+                street << GeoDataCoordinates( lon + 0.2 * k, lat + 0.5 * ( k % 2 ), 0.0, GeoDataCoordinates::Degree );
+            }
+            m_streets << street;
+        }
+    }
+}
+
+void ScreenPolygonPoolTest::reuse()
+{
+    ScreenPolygonPool pool;
+
+    QPolygonF *polygon = pool.acquire();
+    QCOMPARE( pool.allocationCount(), qint64( 1 ) );
+    for ( int i = 0; i < 1000; ++i ) {
+        *polygon << QPointF( i, i );
+    }
+    const int capacity = polygon->capacity();
+
+    pool.release( polygon );
+    QCOMPARE( pool.availableCount(), 1 );
+
+    QPolygonF *const reused = pool.acquire();
+    QCOMPARE( reused, polygon );
+    QVERIFY( reused->isEmpty() );
+    QCOMPARE( reused->capacity(), capacity );
+    QCOMPARE( pool.allocationCount(), qint64( 1 ) );
+    QCOMPARE( pool.availableCount(), 0 );
+
+    QVector<QPolygonF*> polygons;
+    polygons << reused << pool.acquire();
+    QCOMPARE( pool.allocationCount(), qint64( 2 ) );
+    pool.release( polygons );
+    QVERIFY( polygons.isEmpty() );
+    QCOMPARE( pool.availableCount(), 2 );
+
+    pool.clear();
+    QCOMPARE( pool.availableCount(), 0 );
+}
+
+void ScreenPolygonPoolTest::limitCapacity()
+{
+    ScreenPolygonPool pool;
+
+    // polygons of huge line strings are not kept around
+    QPolygonF *polygon = pool.acquire();
+    polygon->resize( 1000000 );
+    pool.release( polygon );
+    QCOMPARE( pool.availableCount(), 0 );
+    QCOMPARE( pool.availablePointCount(), qint64( 0 ) );
+
+    // neither are the polygons of a huge frame in total
+    QVector<QPolygonF*> polygons;
+    for ( int i = 0; i < 100; ++i ) {
+        polygons << pool.acquire();
+        polygons.last()->resize( 60000 );
+    }
+    pool.release( polygons );
+    QVERIFY( pool.availableCount() > 0 );
+    QVERIFY( pool.availableCount() < 100 );
+    QVERIFY( pool.availablePointCount() <= 1 << 20 );
+
+    // and the retained points are accounted for when reused
+    const qint64 points = pool.availablePointCount();
+    QPolygonF *const reused = pool.acquire();
+    QCOMPARE( pool.availablePointCount(), points - reused->capacity() );
+    pool.release( reused );
+    QCOMPARE( pool.availablePointCount(), points );
+
+    pool.clear();
+    QCOMPARE( pool.availablePointCount(), qint64( 0 ) );
+}
+
+void ScreenPolygonPoolTest::addProjections()
+{
+    QTest::addColumn<Marble::Projection>( "projection" );
+
+    QTest::newRow( "Spherical" ) << Spherical;
+    QTest::newRow( "Equirect" ) << Equirectangular;
+    QTest::newRow( "Mercator" ) << Mercator;
+}
+
+void ScreenPolygonPoolTest::renderFrame( ViewportParams *viewport )
+{
+    QImage image( viewport->size(), QImage::Format_ARGB32_Premultiplied );
+    GeoPainter painter( &image, viewport, NormalQuality );
+    for( const GeoDataLineString &street: m_streets ) {
+        painter.drawPolyline( street );
+    }
+}
+
+void ScreenPolygonPoolTest::steadyState_data()
+{
+    addProjections();
+}
+
+void ScreenPolygonPoolTest::steadyState()
+{
+    QFETCH( Marble::Projection, projection );
+
+    ViewportParams viewport( projection, 0.0, 0.0, 300, QSize( 800, 600 ) );
+    renderFrame( &viewport );
+    const qint64 allocations = viewport.polygonPool()->allocationCount();
+    QVERIFY( allocations > 0 );
+
+    // All polygons of the previous frame are reused
+    for ( int i = 0; i < 10; ++i ) {
+        renderFrame( &viewport );
+    }
+    QCOMPARE( viewport.polygonPool()->allocationCount(), allocations );
+}
+
+void ScreenPolygonPoolTest::allocationsPerFrame_data()
+{
+    addProjections();
+}
+
+void ScreenPolygonPoolTest::allocationsPerFrame()
+{
+    QFETCH( Marble::Projection, projection );
+
+    ViewportParams viewport( projection, 0.0, 0.0, 300, QSize( 800, 600 ) );
+
+    const int frames = 20;
+    for ( int i = 0; i < frames; ++i ) {
+        viewport.centerOn( viewport.centerLongitude() + 0.05, viewport.centerLatitude() );
+        renderFrame( &viewport );
+    }
+
+    // Without the pool, every projected polygon was a separate heap allocation
+    QTest::setBenchmarkResult( qreal( viewport.polygonPool()->allocationCount() ) / frames, QTest::Events );
+}
+
+void ScreenPolygonPoolTest::benchmark_data()
+{
+    addProjections();
+}
+
+void ScreenPolygonPoolTest::benchmark()
+{
+    QFETCH( Marble::Projection, projection );
+
+    ViewportParams viewport( projection, 0.0, 0.0, 300, QSize( 800, 600 ) );
+
+    QBENCHMARK {
+        viewport.centerOn( viewport.centerLongitude() + 0.01, viewport.centerLatitude() );
+        renderFrame( &viewport );
+    }
+}
+
+}
+
+QTEST_MAIN( Marble::ScreenPolygonPoolTest )
+
+#include "ScreenPolygonPoolTest.moc"
@@ -0,0 +1,258 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "StyleBuilder.h"
+#include "GeoDataLinearRing.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPoint.h"
+#include "GeoDataPolygon.h"
+#include "osm/OsmPlacemarkData.h"
+#include "TestUtils.h"
+
+#include <QSet>
+
+namespace Marble
+{
+
+class StyleBuilderTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void shareStyles();
+    void respectTags();
+    void respectTileLevel();
+    void reset();
+
+    void cityTileStyles();
+
+    void cityTile_data();
+    void cityTile();
+
+ private:
+    static GeoDataPlacemark *createPlacemark( GeoDataPlacemark::GeoDataVisualCategory category,
+                                              GeoDataGeometry *geometry,
+                                              const QHash<QString, QString> &tags = QHash<QString, QString>() );
+    static GeoDataLineString *createLine();
+    static GeoDataPolygon *createArea();
+
+    /** The placemarks of a vector tile covering the center of a city */
+    QVector<GeoDataPlacemark*> m_cityTile;
+};
+
+GeoDataPlacemark *StyleBuilderTest::createPlacemark( GeoDataPlacemark::GeoDataVisualCategory category,
+                                                     GeoDataGeometry *geometry,
+                                                     const QHash<QString, QString> &tags )
+{
+    GeoDataPlacemark *placemark = new GeoDataPlacemark;
+    placemark->setVisualCategory( category );
+    placemark->setGeometry( geometry );
+    for ( auto iter = tags.constBegin(), end = tags.constEnd(); iter != end; ++iter ) {
+        placemark->osmData().addTag( iter.key(), iter.value() );
+    }
+    return placemark;
+}
+
+GeoDataLineString *StyleBuilderTest::createLine()
+{
+    GeoDataLineString *line = new GeoDataLineString;
+    *line << GeoDataCoordinates( 8.40, 49.00, 0.0, GeoDataCoordinates::Degree )
+          << GeoDataCoordinates( 8.41, 49.01, 0.0, GeoDataCoordinates::Degree );
+    return line;
+}
+
+GeoDataPolygon *StyleBuilderTest::createArea()
+{
+    GeoDataLinearRing ring;
+    ring << GeoDataCoordinates( 8.40, 49.00, 0.0, GeoDataCoordinates::Degree )
+         << GeoDataCoordinates( 8.41, 49.00, 0.0, GeoDataCoordinates::Degree )
+         << GeoDataCoordinates( 8.41, 49.01, 0.0, GeoDataCoordinates::Degree );
+    GeoDataPolygon *polygon = new GeoDataPolygon;
+    polygon->setOuterBoundary( ring );
+    return polygon;
+}
+
+void StyleBuilderTest::initTestCase()
+{
+    const GeoDataPlacemark::GeoDataVisualCategory highways[] = {
+        GeoDataPlacemark::HighwayService, GeoDataPlacemark::HighwayResidential,
+        GeoDataPlacemark::HighwaySecondary, GeoDataPlacemark::HighwayPrimary
+    };
+
+    for ( int i = 0; i < 4000; ++i ) {
+        QHash<QString, QString> tags;
+        tags[QStringLiteral( "name" )] = QStringLiteral( "Street %1" ).arg( i % 700 );
+        if ( i % 7 == 0 ) {
+            tags[QStringLiteral( "oneway" )] = QStringLiteral( "yes" );
+        }
+        if ( i % 13 == 0 ) {
+            tags[QStringLiteral( "access" )] = QStringLiteral( "private" );
+        }
+        if ( i % 50 == 0 ) {
+            tags[QStringLiteral( "tunnel" )] = QStringLiteral( "yes" );
+        }
+        if ( i % 20 == 0 ) {
+            tags[QStringLiteral( "width" )] = QString::number( 4 + i % 5 );
+        }
+        m_cityTile << createPlacemark( highways[i % 4], createLine(), tags );
+    }
+
+    for ( int i = 0; i < 6000; ++i ) {
+        QHash<QString, QString> tags;
+        tags[QStringLiteral( "building" )] = QStringLiteral( "yes" );
+        tags[QStringLiteral( "addr:housenumber" )] = QString::number( i );
+        if ( i % 10 == 0 ) {
+            tags[QStringLiteral( "shop" )] = QStringLiteral( "supermarket" );
+        } else if ( i % 10 == 1 ) {
+            tags[QStringLiteral( "amenity" )] = QStringLiteral( "restaurant" );
+        }
+        m_cityTile << createPlacemark( GeoDataPlacemark::Building, createArea(), tags );
+    }
+
+    for ( int i = 0; i < 500; ++i ) {
+        QHash<QString, QString> tags;
+        tags[QStringLiteral( "landuse" )] = QStringLiteral( "residential" );
+        m_cityTile << createPlacemark( i % 2 ? GeoDataPlacemark::LanduseResidential : GeoDataPlacemark::LeisurePark,
+                                       createArea(), tags );
+    }
+
+    for ( int i = 0; i < 1000; ++i ) {
+        m_cityTile << createPlacemark( GeoDataPlacemark::NaturalTree,
+                                       new GeoDataPoint( 8.40 + 0.0001 * i, 49.0, 0.0, GeoDataCoordinates::Degree ) );
+    }
+
+    for ( int i = 0; i < 200; ++i ) {
+        QHash<QString, QString> tags;
+        if ( i % 3 == 0 ) {
+            tags[QStringLiteral( "width" )] = QStringLiteral( "3 m" );
+        }
+        m_cityTile << createPlacemark( GeoDataPlacemark::WaterwayStream, createLine(), tags );
+    }
+}
+
+void StyleBuilderTest::cleanupTestCase()
+{
+    qDeleteAll( m_cityTile );
+    m_cityTile.clear();
+}
+
+void StyleBuilderTest::shareStyles()
+{
+    StyleBuilder styleBuilder;
+    QHash<QString, QString> tags;
+    tags[QStringLiteral( "name" )] = QStringLiteral( "Main Street" );
+    QScopedPointer<GeoDataPlacemark> first( createPlacemark( GeoDataPlacemark::HighwayResidential, createLine(), tags ) );
+    tags[QStringLiteral( "name" )] = QStringLiteral( "Side Street" );
+    QScopedPointer<GeoDataPlacemark> second( createPlacemark( GeoDataPlacemark::HighwayResidential, createLine(), tags ) );
+
+    const GeoDataStyle::ConstPtr style = styleBuilder.createStyle( StyleParameters( first.data(), 16 ) );
+    QVERIFY( style );
+    QCOMPARE( styleBuilder.createStyle( StyleParameters( second.data(), 16 ) ), style );
+    QCOMPARE( styleBuilder.createStyle( StyleParameters( first.data(), 16 ) ), style );
+}
+
+void StyleBuilderTest::respectTags()
+{
+    StyleBuilder styleBuilder;
+    QHash<QString, QString> tags;
+    QScopedPointer<GeoDataPlacemark> street( createPlacemark( GeoDataPlacemark::HighwayResidential, createLine(), tags ) );
+    tags[QStringLiteral( "tunnel" )] = QStringLiteral( "yes" );
+    QScopedPointer<GeoDataPlacemark> tunnel( createPlacemark( GeoDataPlacemark::HighwayResidential, createLine(), tags ) );
+
+    const GeoDataStyle::ConstPtr streetStyle = styleBuilder.createStyle( StyleParameters( street.data(), 16 ) );
+    const GeoDataStyle::ConstPtr tunnelStyle = styleBuilder.createStyle( StyleParameters( tunnel.data(), 16 ) );
+    QVERIFY( streetStyle != tunnelStyle );
+    QVERIFY( streetStyle->lineStyle().color() != tunnelStyle->lineStyle().color() );
+
+    tags.clear();
+    tags[QStringLiteral( "building" )] = QStringLiteral( "yes" );
+    QScopedPointer<GeoDataPlacemark> building( createPlacemark( GeoDataPlacemark::Building, createArea(), tags ) );
+    tags[QStringLiteral( "shop" )] = QStringLiteral( "supermarket" );
+    QScopedPointer<GeoDataPlacemark> supermarket( createPlacemark( GeoDataPlacemark::Building, createArea(), tags ) );
+    QVERIFY( styleBuilder.createStyle( StyleParameters( building.data() ) ) != styleBuilder.createStyle( StyleParameters( supermarket.data() ) ) );
+}
+
+void StyleBuilderTest::respectTileLevel()
+{
+    StyleBuilder styleBuilder;
+    QScopedPointer<GeoDataPlacemark> street( createPlacemark( GeoDataPlacemark::HighwayPrimary, createLine() ) );
+    const GeoDataStyle::ConstPtr low = styleBuilder.createStyle( StyleParameters( street.data(), 8 ) );
+    const GeoDataStyle::ConstPtr high = styleBuilder.createStyle( StyleParameters( street.data(), 16 ) );
+    QVERIFY( low != high );
+    QCOMPARE( low->lineStyle().width(), 2.0f );
+    QVERIFY( high->lineStyle().physicalWidth() > 0.0f );
+
+    // Styles of other categories don't depend on the tile level
+    QScopedPointer<GeoDataPlacemark> park( createPlacemark( GeoDataPlacemark::LeisurePark, createArea() ) );
+    QCOMPARE( styleBuilder.createStyle( StyleParameters( park.data(), 8 ) ),
+              styleBuilder.createStyle( StyleParameters( park.data(), 16 ) ) );
+}
+
+void StyleBuilderTest::reset()
+{
+    StyleBuilder styleBuilder;
+    QScopedPointer<GeoDataPlacemark> street( createPlacemark( GeoDataPlacemark::HighwayResidential, createLine() ) );
+    const GeoDataStyle::ConstPtr style = styleBuilder.createStyle( StyleParameters( street.data(), 16 ) );
+
+    styleBuilder.setDefaultLabelColor( Qt::red );
+    const GeoDataStyle::ConstPtr resetStyle = styleBuilder.createStyle( StyleParameters( street.data(), 16 ) );
+    QVERIFY( resetStyle != style );
+    QCOMPARE( styleBuilder.createStyle( StyleParameters( street.data(), 16 ) ), resetStyle );
+}
+
+void StyleBuilderTest::cityTileStyles()
+{
+    StyleBuilder styleBuilder;
+    QSet<const GeoDataStyle*> styles;
+    for( const GeoDataPlacemark *placemark: m_cityTile ) {
+        styles << styleBuilder.createStyle( StyleParameters( placemark, 16 ) ).data();
+    }
+
+    // Placemarks differing only in tags like names and addresses share their style
+    QVERIFY( styles.size() < m_cityTile.size() / 50 );
+    QTest::setBenchmarkResult( styles.size(), QTest::Events );
+}
+
+void StyleBuilderTest::cityTile_data()
+{
+    QTest::addColumn<bool>( "warm" );
+
+    QTest::newRow( "first load" ) << false;
+    QTest::newRow( "cached" ) << true;
+}
+
+void StyleBuilderTest::cityTile()
+{
+    QFETCH( bool, warm );
+
+    StyleBuilder styleBuilder;
+    if ( warm ) {
+        for( const GeoDataPlacemark *placemark: m_cityTile ) {
+            styleBuilder.createStyle( StyleParameters( placemark, 16 ) );
+        }
+    }
+
+    QBENCHMARK {
+        if ( !warm ) {
+            styleBuilder.reset();
+        }
+        for( const GeoDataPlacemark *placemark: m_cityTile ) {
+            styleBuilder.createStyle( StyleParameters( placemark, 16 ) );
+        }
+    }
+}
+
+}
+
+QTEST_MAIN( Marble::StyleBuilderTest )
+
+#include "StyleBuilderTest.moc"
@@ -12,6 +12,7 @@
 
 #include "GeoDataPoint.h"
 #include "GeoDataLinearRing.h"
+#include "GeoDataLatLonAltBox.h"
 #include <GeoDataDocument.h>
 #include <GeoDataPlacemark.h>
 #include <MarbleDebug.h>
@@ -33,6 +34,7 @@ private Q_SLOTS:
     void initTestCase();
     void defaultConstructor();
     void interpolate();
+    void appendPoints();
     void simpleParseTest();
     void removeBeforeTest();
     void removeAfterTest();
@@ -108,6 +110,38 @@ void TestGeoDataTrack::interpolate()
 "</Folder>"
 "</kml>" );
 
+void TestGeoDataTrack::appendPoints()
+{
+    GeoDataTrack track;
+    const QDateTime start( QDate( 2014, 8, 16 ), QTime( 8, 0, 0 ) );
+
+    // Heading east across the IDL, box and line string are updated while appending
+    for ( int i = 0; i < 400; ++i ) {
+        const GeoDataCoordinates coordinates( 170.0 + 0.05 * i, 10.0 + 0.01 * ( i % 37 ), i % 11, GeoDataCoordinates::Degree );
+        track.addPoint( start.addSecs( i ), coordinates );
+
+        if ( i % 50 == 0 ) {
+            GeoDataLineString expected;
+            expected.append( track.coordinatesList() );
+            QCOMPARE( track.lineString()->size(), i + 1 );
+            QCOMPARE( *track.lineString(), expected );
+            QCOMPARE( track.latLonAltBox(), GeoDataLatLonAltBox::fromLineString( expected ) );
+        }
+    }
+
+    // An out of order point is inserted at its position
+    const GeoDataCoordinates early( 160.0, 5.0, 0.0, GeoDataCoordinates::Degree );
+    track.addPoint( start.addSecs( -1 ), early );
+    QCOMPARE( track.size(), 401 );
+    QCOMPARE( track.coordinatesAt( 0 ), early );
+    QCOMPARE( track.lineString()->first(), early );
+    QCOMPARE( track.latLonAltBox().south( GeoDataCoordinates::Degree ), 5.0 );
+
+    track.removeBefore( start );
+    QCOMPARE( track.lineString()->size(), 400 );
+    QCOMPARE( track.latLonAltBox().south( GeoDataCoordinates::Degree ), 10.0 );
+}
+
 void TestGeoDataTrack::simpleParseTest()
 {
     GeoDataDocument* dataDocument = parseKml( simpleExampleContent );
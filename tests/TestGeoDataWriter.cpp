@@ -13,6 +13,8 @@
 #include "GeoDataParser.h"
 #include "GeoDataDocument.h"
 #include "GeoDataColorStyle.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
 #include "GeoWriter.h"
 #include <geodata/handlers/kml/KmlElementDictionary.h>
 
@@ -38,6 +40,9 @@ private Q_SLOTS:
     void saveAndCompare();
     void saveAndCompareEquality_data();
     void saveAndCompareEquality();
+    void writeCoordinates_data();
+    void writeCoordinates();
+    void writeLargeDocument();
     void cleanupTestCase();
 private:
     QDir dataDir;
@@ -47,6 +52,22 @@ private:
 
 Q_DECLARE_METATYPE( QSharedPointer<GeoDataParser> )
 
+/** Counts and discards all data written to it */
+class NullDevice : public QIODevice
+{
+public:
+    NullDevice() : m_size( 0 ) {}
+
+    qint64 size() const override { return m_size; }
+
+protected:
+    qint64 readData( char *, qint64 ) override { return -1; }
+    qint64 writeData( const char *, qint64 length ) override { m_size += length; return length; }
+
+private:
+    qint64 m_size;
+};
+
 void TestGeoDataWriter::initTestCase()
 {
     dataDir = QDir( TESTSRCDIR );
@@ -209,6 +230,82 @@ void TestGeoDataWriter::saveAndCompareEquality()
     QVERIFY( *initialDoc == *otherDoc );
 }
 
+void TestGeoDataWriter::writeCoordinates_data()
+{
+    QTest::addColumn<qreal>( "lon" );
+    QTest::addColumn<qreal>( "lat" );
+    QTest::addColumn<qreal>( "alt" );
+
+    QTest::newRow( "integral" ) << qreal( 8.0 ) << qreal( 49.0 ) << qreal( 120.0 );
+    QTest::newRow( "fraction" ) << qreal( 8.4037565 ) << qreal( 49.0069 ) << qreal( 115.25 );
+    QTest::newRow( "negative" ) << qreal( -179.9999999999 ) << qreal( -89.123456789012 ) << qreal( -2.005 );
+    QTest::newRow( "tiny" ) << qreal( -0.00000000001 ) << qreal( 0.000000000049 ) << qreal( -0.001 );
+    QTest::newRow( "huge altitude" ) << qreal( 0.5 ) << qreal( -0.5 ) << qreal( 1.0e20 );
+}
+
+void TestGeoDataWriter::writeCoordinates()
+{
+    QFETCH( qreal, lon );
+    QFETCH( qreal, lat );
+    QFETCH( qreal, alt );
+
+    const GeoDataCoordinates coordinates( lon, lat, alt, GeoDataCoordinates::Degree );
+    GeoDataLineString lineString;
+    lineString << coordinates << coordinates;
+
+    QByteArray data;
+    QBuffer buffer( &data );
+    QVERIFY( buffer.open( QIODevice::WriteOnly ) );
+
+    GeoWriter writer;
+    writer.setDevice( &buffer );
+    writer.writeStartElement( "coordinates" );
+    writer.writeCoordinates( lineString, true, 2 );
+    writer.writeEndElement();
+    writer.writeStartElement( "coord" );
+    writer.writeCoordinates( coordinates, ' ', true, 10 );
+    writer.writeEndElement();
+    buffer.close();
+
+    // The fast formatting must match QString::number()
+    const QString tuple = QString::number( coordinates.longitude( GeoDataCoordinates::Degree ), 'f', 10 ) + QLatin1Char( ',' )
+                          + QString::number( coordinates.latitude( GeoDataCoordinates::Degree ), 'f', 10 ) + QLatin1Char( ',' )
+                          + QString::number( alt, 'f', 2 );
+    const QString coord = QString::number( coordinates.longitude( GeoDataCoordinates::Degree ), 'f', 10 ) + QLatin1Char( ' ' )
+                          + QString::number( coordinates.latitude( GeoDataCoordinates::Degree ), 'f', 10 ) + QLatin1Char( ' ' )
+                          + QString::number( alt, 'f', 10 );
+    const QString expected = QLatin1String( "<coordinates>" ) + tuple + QLatin1Char( ' ' ) + tuple
+                             + QLatin1String( "</coordinates><coord>" ) + coord + QLatin1String( "</coord>" );
+
+    QCOMPARE( QString::fromUtf8( data ), expected );
+}
+
+void TestGeoDataWriter::writeLargeDocument()
+{
+    // 10 million vertices, all placemarks share the data of one line string
+    GeoDataLineString lineString;
+    for ( int i = 0; i < 100000; ++i ) {
+        lineString << GeoDataCoordinates( -180.0 + 0.0036 * i, 0.0009 * i - 45.0, 0.0, GeoDataCoordinates::Degree );
+    }
+
+    GeoDataDocument document;
+    for ( int i = 0; i < 100; ++i ) {
+        GeoDataPlacemark *placemark = new GeoDataPlacemark;
+        placemark->setGeometry( new GeoDataLineString( lineString ) );
+        document.append( placemark );
+    }
+
+    QBENCHMARK {
+        NullDevice device;
+        QVERIFY( device.open( QIODevice::WriteOnly ) );
+
+        GeoWriter writer;
+        writer.setDocumentType( kml::kmlTag_nameSpaceOgc22 );
+        QVERIFY( writer.write( &device, &document ) );
+        QVERIFY( device.size() > qint64( 100 ) * 100000 * 20 );
+    }
+}
+
 void TestGeoDataWriter::cleanupTestCase()
 {
     QMap<QString, QSharedPointer<GeoDataParser> >::iterator itpoint = parsers.begin();
@@ -0,0 +1,121 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "TileCreator.h"
+#include "MarbleGlobal.h"
+#include "MarbleZipReader.h"
+#include "TestUtils.h"
+
+#include <QDir>
+#include <QImage>
+#include <QSize>
+#include <QTemporaryDir>
+
+namespace Marble
+{
+
+/** Creates tiles of two levels whose pixels encode their position */
+class GradientSource : public TileCreatorSource
+{
+public:
+    GradientSource() : m_tileCount( 0 ) {}
+
+    QSize fullImageSize() const override
+    {
+        return QSize( 4 * c_defaultTileSize, 2 * c_defaultTileSize );
+    }
+
+    QImage tile( int n, int m, int tileLevel ) override
+    {
+        Q_UNUSED( tileLevel );
+        ++m_tileCount;
+        QImage image( c_defaultTileSize, c_defaultTileSize, QImage::Format_ARGB32 );
+        for ( int y = 0; y < image.height(); ++y ) {
+            for ( int x = 0; x < image.width(); ++x ) {
+                image.setPixel( x, y, pixel( m * c_defaultTileSize + x, n * c_defaultTileSize + y ) );
+            }
+        }
+        return image;
+    }
+
+    static QRgb pixel( int x, int y )
+    {
+        return qRgb( x % 256, y % 256, ( x / 256 ) * 16 + y / 256 );
+    }
+
+    int m_tileCount;
+};
+
+class TileCreatorTest : public QObject
+{
+    Q_OBJECT
+
+ private Q_SLOTS:
+    void createTiles();
+    void createArchive();
+};
+
+void TileCreatorTest::createTiles()
+{
+    QTemporaryDir targetDir;
+    QVERIFY( targetDir.isValid() );
+
+    GradientSource *source = new GradientSource;
+    TileCreator creator( source, QStringLiteral( "false" ), targetDir.path() );
+    creator.setTileFormat( QStringLiteral( "png" ) );
+    creator.setVerifyExactResult( true );
+    creator.start();
+    QVERIFY( creator.wait() );
+
+    // Only the tiles of the highest level are taken from the source
+    QCOMPARE( source->m_tileCount, 8 );
+
+    QDir dir( targetDir.path() );
+    QVERIFY( dir.exists( QStringLiteral( "1/000001/000001_000003.png" ) ) );
+    QVERIFY( dir.exists( QStringLiteral( "0/000000/000000_000001.png" ) ) );
+
+    const QImage child( dir.filePath( QStringLiteral( "1/000001/000001_000002.png" ) ) );
+    QCOMPARE( child.pixel( 100, 200 ), GradientSource::pixel( 2 * c_defaultTileSize + 100, c_defaultTileSize + 200 ) );
+
+    // Upper levels take every second pixel of the four tiles below
+    const QImage parent( dir.filePath( QStringLiteral( "0/000000/000000_000001.png" ) ) );
+    const int half = c_defaultTileSize / 2;
+    QCOMPARE( parent.size(), QSize( c_defaultTileSize, c_defaultTileSize ) );
+    QCOMPARE( parent.pixel( 10, 20 ), GradientSource::pixel( 2 * c_defaultTileSize + 20, 40 ) );
+    QCOMPARE( parent.pixel( half + 10, half + 20 ), GradientSource::pixel( 3 * c_defaultTileSize + 20, c_defaultTileSize + 40 ) );
+}
+
+void TileCreatorTest::createArchive()
+{
+    QTemporaryDir targetDir;
+    QVERIFY( targetDir.isValid() );
+    const QString archiveFile = targetDir.path() + QLatin1String( "/tiles.zip" );
+
+    TileCreator creator( new GradientSource, QStringLiteral( "false" ), targetDir.path() );
+    creator.setTileFormat( QStringLiteral( "png" ) );
+    creator.setArchiveFile( archiveFile );
+    QCOMPARE( creator.archiveFile(), archiveFile );
+    creator.start();
+    QVERIFY( creator.wait() );
+
+    // No tiles are written besides the archive
+    QVERIFY( !QDir( targetDir.path() ).exists( QStringLiteral( "1" ) ) );
+
+    MarbleZipReader reader( archiveFile );
+    QCOMPARE( reader.count(), 10 );
+
+    const QImage parent = QImage::fromData( reader.fileData( QStringLiteral( "0/000000/000000_000000.png" ) ) );
+    QCOMPARE( parent.size(), QSize( c_defaultTileSize, c_defaultTileSize ) );
+    QCOMPARE( parent.pixel( 10, 20 ), GradientSource::pixel( 20, 40 ) );
+}
+
+}
+
+QTEST_MAIN( Marble::TileCreatorTest )
+
+#include "TileCreatorTest.moc"
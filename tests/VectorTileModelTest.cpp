@@ -0,0 +1,200 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "VectorTileModel.h"
+
+#include "GeoDataDocument.h"
+#include "GeoDataLatLonBox.h"
+#include "GeoDataLineString.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataTreeModel.h"
+#include "GeoSceneAbstractTileProjection.h"
+#include "GeoSceneVectorTileDataset.h"
+#include "MarbleModel.h"
+#include "StyleBuilder.h"
+#include "TileLoader.h"
+#include "layers/GeometryLayer.h"
+#include "layers/PlacemarkLayer.h"
+
+#include <QRect>
+#include <QTest>
+#include <QThreadPool>
+
+namespace Marble
+{
+
+class VectorTileModelTest : public QObject
+{
+    Q_OBJECT
+
+ public:
+    VectorTileModelTest();
+
+ private Q_SLOTS:
+    void init();
+    void cleanup();
+
+    void leastRecentlyUsedEviction();
+    void overzoom();
+
+ private:
+    /** A document of a line with 1000 points, estimated to take about 64 KB */
+    static GeoDataDocument *createTile();
+
+    /** A viewport of 0.25 x 0.25 radian around @p center, which is shown with tiles of level 6 */
+    static GeoDataLatLonBox viewport( const GeoDataCoordinates &center, qreal size = 0.25 );
+
+    QRect tileIndexes( const GeoDataLatLonBox &viewport, int level ) const;
+
+    MarbleModel m_marbleModel;
+    StyleBuilder m_styleBuilder;
+    GeoSceneVectorTileDataset m_dataset;
+    TileLoader m_loader;
+    GeometryLayer m_geometryLayer;
+    PlacemarkLayer m_placemarkLayer;
+    QThreadPool m_threadPool;
+    VectorTileModel *m_model;
+};
+
+VectorTileModelTest::VectorTileModelTest() :
+    m_dataset( "test" ),
+    m_loader( m_marbleModel.downloadManager(), m_marbleModel.pluginManager() ),
+    m_geometryLayer( m_marbleModel.treeModel(), &m_styleBuilder ),
+    m_placemarkLayer( m_marbleModel.placemarkModel(), m_marbleModel.placemarkSelectionModel(),
+                      m_marbleModel.clock(), &m_styleBuilder ),
+    m_model( nullptr )
+{
+    // No tiles are available, and none are downloaded
+    m_dataset.setSourceDir( "earth/vectortilemodeltest" );
+    m_dataset.setFileFormat( "o5m" );
+    m_dataset.setLevelZeroColumns( 1 );
+    m_dataset.setLevelZeroRows( 1 );
+    m_dataset.setMaximumTileLevel( 0 );
+    m_dataset.setTileLevels( "2,4,6" );
+    m_dataset.setTileProjection( GeoSceneAbstractTileProjection::Mercator );
+}
+
+void VectorTileModelTest::init()
+{
+    m_model = new VectorTileModel( &m_loader, &m_dataset, &m_geometryLayer, &m_placemarkLayer, &m_threadPool );
+}
+
+void VectorTileModelTest::cleanup()
+{
+    // Requested tiles are never loaded, the test does not run the event loop
+    m_threadPool.waitForDone();
+    delete m_model;
+    m_model = nullptr;
+}
+
+GeoDataDocument *VectorTileModelTest::createTile()
+{
+    GeoDataLineString *line = new GeoDataLineString;
+    for ( int i = 0; i < 1000; ++i ) {
+        *line << GeoDataCoordinates( 0.001 * i, 0.0 );
+    }
+
+    GeoDataPlacemark *placemark = new GeoDataPlacemark;
+    placemark->setGeometry( line );
+
+    GeoDataDocument *document = new GeoDataDocument;
+    document->append( placemark );
+    return document;
+}
+
+GeoDataLatLonBox VectorTileModelTest::viewport( const GeoDataCoordinates &center, qreal size )
+{
+    return GeoDataLatLonBox( center.latitude() + size / 2, center.latitude() - size / 2,
+                             center.longitude() + size / 2, center.longitude() - size / 2 );
+}
+
+QRect VectorTileModelTest::tileIndexes( const GeoDataLatLonBox &viewport, int level ) const
+{
+    return m_dataset.tileProjection()->tileIndexes( viewport, level );
+}
+
+void VectorTileModelTest::leastRecentlyUsedEviction()
+{
+    // Room for two tiles
+    m_model->setCacheLimit( 150 );
+
+    const GeoDataLatLonBox first = viewport( GeoDataCoordinates( -2.0, 0.5 ) );
+    const GeoDataLatLonBox second = viewport( GeoDataCoordinates( 0.0, 0.5 ) );
+    const GeoDataLatLonBox third = viewport( GeoDataCoordinates( 2.0, 0.5 ) );
+
+    // Tiles loaded before any viewport was set are kept for later
+    for ( const GeoDataLatLonBox &box: QVector<GeoDataLatLonBox>() << first << second << third ) {
+        const QPoint tile = tileIndexes( box, 6 ).topLeft();
+        m_model->updateTile( TileId( 0, 6, tile.x(), tile.y() ), createTile() );
+    }
+    QCOMPARE( m_model->cachedDocuments(), 0 );
+
+    // The first tile was discarded for the third one
+    m_model->setViewport( first );
+    QCOMPARE( m_model->tileZoomLevel(), 6 );
+    QCOMPARE( m_model->cacheHits(), 0 );
+    QCOMPARE( m_model->cacheMisses(), tileIndexes( first, 6 ).width() * tileIndexes( first, 6 ).height() );
+    QCOMPARE( m_model->cachedDocuments(), 0 );
+
+    m_model->setViewport( second );
+    QCOMPARE( m_model->cacheHits(), 1 );
+    QCOMPARE( m_model->cachedDocuments(), 1 );
+
+    // Displayed tiles leaving the view are kept again
+    m_model->setViewport( third );
+    QCOMPARE( m_model->cacheHits(), 2 );
+    m_model->setViewport( second );
+    QCOMPARE( m_model->cacheHits(), 3 );
+}
+
+void VectorTileModelTest::overzoom()
+{
+    const TileId parent( 0, 4, 8, 8 );
+    const GeoDataLatLonBox parentBox = m_dataset.tileProjection()->geoCoordinates( parent );
+    m_model->updateTile( parent, createTile() );
+
+    // The parent tile is shown until the tiles of the current level are loaded
+    const GeoDataLatLonBox zoomedIn = viewport( parentBox.center() );
+    const QRect tiles = tileIndexes( zoomedIn, 6 );
+    QCOMPARE( tiles.left() >> 2, parent.x() );
+    QCOMPARE( tiles.right() >> 2, parent.x() );
+    QCOMPARE( tiles.top() >> 2, parent.y() );
+    QCOMPARE( tiles.bottom() >> 2, parent.y() );
+
+    m_model->setViewport( zoomedIn );
+    QCOMPARE( m_model->tileZoomLevel(), 6 );
+    QCOMPARE( m_model->cachedDocuments(), 1 );
+    QCOMPARE( m_model->pendingDocuments(), tiles.width() * tiles.height() );
+
+    for ( int x = tiles.left(); x <= tiles.right(); ++x ) {
+        for ( int y = tiles.top(); y <= tiles.bottom(); ++y ) {
+            QCOMPARE( m_model->cachedDocuments(), 1 + ( x - tiles.left() ) * tiles.height() + y - tiles.top() );
+            m_model->updateTile( TileId( 0, 6, x, y ), createTile() );
+        }
+    }
+    QCOMPARE( m_model->pendingDocuments(), 0 );
+    QCOMPARE( m_model->cachedDocuments(), tiles.width() * tiles.height() );
+    QCOMPARE( m_model->cacheHits(), 0 );
+
+    // Zooming out shows the parent tile again without loading it
+    m_model->setViewport( viewport( parentBox.center(), 1.0 ) );
+    QCOMPARE( m_model->tileZoomLevel(), 4 );
+    QCOMPARE( m_model->cacheHits(), 1 );
+
+    // And zooming in the tiles of level 6
+    const int misses = m_model->cacheMisses();
+    m_model->setViewport( zoomedIn );
+    QCOMPARE( m_model->cacheHits(), 1 + tiles.width() * tiles.height() );
+    QCOMPARE( m_model->cacheMisses(), misses );
+}
+
+}
+
+QTEST_MAIN( Marble::VectorTileModelTest )
+
+#include "VectorTileModelTest.moc"
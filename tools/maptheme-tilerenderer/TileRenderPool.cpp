@@ -0,0 +1,205 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "TileRenderPool.h"
+
+#include "GeoDataLatLonBox.h"
+#include "GeoSceneMercatorTileProjection.h"
+#include "MbTileWriter.h"
+#include "TileRenderer.h"
+
+#include <QBuffer>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QMetaObject>
+#include <QThread>
+
+#include <iostream>
+
+namespace Marble {
+
+namespace {
+    // Edge length of the square tile clusters handed to a renderer at once
+    int const clusterSize = 4;
+}
+
+TileRenderPool::TileRenderPool(const QString &mapThemeId, int tileSize, QObject *parent) :
+    QObject(parent),
+    m_mapThemeId(mapThemeId),
+    m_tileSize(tileSize),
+    m_threadCount(qMax(1, QThread::idealThreadCount())),
+    m_timeout(30000),
+    m_mbTileWriter(nullptr),
+    m_reportProgress(true),
+    m_nextCluster(0),
+    m_busyRenderers(0),
+    m_totalTiles(0),
+    m_renderedTiles(0),
+    m_incompleteTiles(0)
+{
+}
+
+TileRenderPool::~TileRenderPool()
+{
+    stopThreads();
+}
+
+void TileRenderPool::setThreadCount(int threadCount)
+{
+    m_threadCount = qMax(1, threadCount);
+}
+
+void TileRenderPool::setTimeout(int timeout)
+{
+    m_timeout = timeout;
+}
+
+void TileRenderPool::setOutputDirectory(const QString &directory)
+{
+    m_outputDirectory = directory;
+}
+
+void TileRenderPool::setMbTileWriter(MbTileWriter *writer)
+{
+    m_mbTileWriter = writer;
+}
+
+void TileRenderPool::setReportProgress(bool report)
+{
+    m_reportProgress = report;
+}
+
+void TileRenderPool::start(const GeoDataLatLonBox &latLonBox, int minZoomLevel, int maxZoomLevel)
+{
+    GeoSceneMercatorTileProjection const tileProjection;
+    m_clusters.clear();
+    m_totalTiles = 0;
+    for (int zoomLevel = minZoomLevel; zoomLevel <= maxZoomLevel; ++zoomLevel) {
+        QRect const tiles = tileProjection.tileIndexes(latLonBox, zoomLevel);
+        m_totalTiles += qint64(tiles.width()) * tiles.height();
+        for (int y = tiles.top(); y <= tiles.bottom(); y += clusterSize) {
+            for (int x = tiles.left(); x <= tiles.right(); x += clusterSize) {
+                m_clusters << qMakePair(zoomLevel, QRect(x, y, clusterSize, clusterSize) & tiles);
+            }
+        }
+    }
+
+    m_nextCluster = 0;
+    m_renderedTiles = 0;
+    m_incompleteTiles = 0;
+    m_timer.start();
+
+    int const threadCount = qMin(m_threadCount, m_clusters.size());
+    if (threadCount == 0) {
+        QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
+        return;
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        TileRenderer *renderer = new TileRenderer(m_mapThemeId, m_tileSize);
+        renderer->setTimeout(m_timeout);
+        QThread *thread = new QThread;
+        renderer->moveToThread(thread);
+        connect(thread, SIGNAL(finished()), renderer, SLOT(deleteLater()));
+        connect(renderer, SIGNAL(tileRendered(int,int,int,QByteArray,bool)),
+                this, SLOT(writeTile(int,int,int,QByteArray,bool)));
+        connect(renderer, SIGNAL(tilesRendered()), this, SLOT(continueRendering()));
+        thread->start();
+        m_threads << thread;
+        assignNextCluster(renderer);
+    }
+}
+
+qint64 TileRenderPool::renderedTiles() const
+{
+    return m_renderedTiles;
+}
+
+qint64 TileRenderPool::incompleteTiles() const
+{
+    return m_incompleteTiles;
+}
+
+qint64 TileRenderPool::elapsed() const
+{
+    return m_timer.elapsed();
+}
+
+void TileRenderPool::writeTile(int zoomLevel, int x, int y, const QByteArray &data, bool complete)
+{
+    if (m_mbTileWriter) {
+        QBuffer buffer;
+        buffer.setData(data);
+        buffer.open(QBuffer::ReadOnly);
+        m_mbTileWriter->addTile(&buffer, x, y, zoomLevel);
+    } else {
+        QString const path = QString("%1/%2/%3").arg(m_outputDirectory).arg(zoomLevel).arg(x);
+        QDir().mkpath(path);
+        QFile file(QString("%1/%2.png").arg(path).arg(y));
+        if (!file.open(QFile::WriteOnly) || file.write(data) != data.size()) {
+            qWarning() << "Failed to write tile" << file.fileName();
+        }
+    }
+
+    ++m_renderedTiles;
+    if (!complete) {
+        ++m_incompleteTiles;
+    }
+
+    if (m_reportProgress) {
+        double const tilesPerSecond = m_renderedTiles / qMax(0.001, m_timer.elapsed() / 1000.0);
+        std::cout << "Tile " << m_renderedTiles << "/" << m_totalTiles;
+        std::cout << " (" << zoomLevel << '/' << x << '/' << y << ")";
+        std::cout << " " << qRound(tilesPerSecond) << " tiles/s" << std::string(10, ' ') << '\r';
+        std::cout.flush();
+    }
+}
+
+void TileRenderPool::continueRendering()
+{
+    --m_busyRenderers;
+    TileRenderer *renderer = qobject_cast<TileRenderer*>(sender());
+    if (renderer) {
+        assignNextCluster(renderer);
+    }
+
+    if (m_busyRenderers == 0) {
+        stopThreads();
+        if (m_reportProgress) {
+            std::cout << std::endl;
+        }
+        emit finished();
+    }
+}
+
+bool TileRenderPool::assignNextCluster(TileRenderer *renderer)
+{
+    if (m_nextCluster >= m_clusters.size()) {
+        return false;
+    }
+
+    QPair<int, QRect> const &cluster = m_clusters[m_nextCluster];
+    ++m_nextCluster;
+    ++m_busyRenderers;
+    QMetaObject::invokeMethod(renderer, "renderTiles", Qt::QueuedConnection,
+                              Q_ARG(int, cluster.first), Q_ARG(QRect, cluster.second));
+    return true;
+}
+
+void TileRenderPool::stopThreads()
+{
+    for (QThread *thread: m_threads) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+    m_threads.clear();
+}
+
+}
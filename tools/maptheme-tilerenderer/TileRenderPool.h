@@ -0,0 +1,86 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_TILERENDERPOOL_H
+#define MARBLE_TILERENDERPOOL_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QPair>
+#include <QRect>
+#include <QVector>
+
+class QThread;
+
+namespace Marble {
+
+class GeoDataLatLonBox;
+class MbTileWriter;
+class TileRenderer;
+
+/**
+ * Distributes the tiles of a bounding box to a number of TileRenderer threads
+ * and writes the rendered tiles in the calling thread, either to a z/x/y.png
+ * directory structure or to a MBTiles database.
+ *
+ * Tiles are handed out in square clusters so that each renderer reuses the
+ * texture and vector tiles it loaded for the previous tile.
+ */
+class TileRenderPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    TileRenderPool(const QString &mapThemeId, int tileSize, QObject *parent = nullptr);
+    ~TileRenderPool() override;
+
+    void setThreadCount(int threadCount);
+    void setTimeout(int timeout);
+    void setOutputDirectory(const QString &directory);
+    void setMbTileWriter(MbTileWriter *writer);
+    void setReportProgress(bool report);
+
+    void start(const GeoDataLatLonBox &latLonBox, int minZoomLevel, int maxZoomLevel);
+
+    qint64 renderedTiles() const;
+    qint64 incompleteTiles() const;
+    qint64 elapsed() const;
+
+Q_SIGNALS:
+    void finished();
+
+private Q_SLOTS:
+    void writeTile(int zoomLevel, int x, int y, const QByteArray &data, bool complete);
+    void continueRendering();
+
+private:
+    bool assignNextCluster(TileRenderer *renderer);
+    void stopThreads();
+
+    QString const m_mapThemeId;
+    int const m_tileSize;
+    int m_threadCount;
+    int m_timeout;
+    QString m_outputDirectory;
+    MbTileWriter *m_mbTileWriter;
+    bool m_reportProgress;
+
+    QVector<QPair<int, QRect> > m_clusters;
+    int m_nextCluster;
+    int m_busyRenderers;
+    QVector<QThread*> m_threads;
+
+    qint64 m_totalTiles;
+    qint64 m_renderedTiles;
+    qint64 m_incompleteTiles;
+    QElapsedTimer m_timer;
+};
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "TileRenderer.h"
+
+#include "AbstractFloatItem.h"
+#include "GeoPainter.h"
+#include "MarbleGlobal.h"
+#include "MarbleMap.h"
+#include "MarbleMath.h"
+#include "MarbleModel.h"
+#include "ViewportParams.h"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QTimer>
+
+namespace Marble {
+
+TileRenderer::TileRenderer(const QString &mapThemeId, int tileSize, QObject *parent) :
+    QObject(parent),
+    m_mapThemeId(mapThemeId),
+    m_tileSize(tileSize),
+    m_timeout(30000),
+    m_model(nullptr),
+    m_map(nullptr)
+{
+}
+
+TileRenderer::~TileRenderer()
+{
+    delete m_map;
+    delete m_model;
+}
+
+void TileRenderer::setTimeout(int timeout)
+{
+    m_timeout = timeout;
+}
+
+void TileRenderer::renderTiles(int zoomLevel, const QRect &tiles)
+{
+    if (!m_map) {
+        createMap();
+    }
+
+    for (int y = tiles.top(); y <= tiles.bottom(); ++y) {
+        for (int x = tiles.left(); x <= tiles.right(); ++x) {
+            bool complete = false;
+            QImage const image = renderTile(zoomLevel, x, y, complete);
+
+            QByteArray data;
+            QBuffer buffer(&data);
+            buffer.open(QBuffer::WriteOnly);
+            image.save(&buffer, "PNG");
+            emit tileRendered(zoomLevel, x, y, data, complete);
+        }
+    }
+
+    emit tilesRendered();
+}
+
+void TileRenderer::createMap()
+{
+    m_model = new MarbleModel;
+    m_map = new MarbleMap(m_model);
+    m_map->setMapThemeId(m_mapThemeId);
+    m_map->setProjection(Mercator);
+    m_map->setSize(m_tileSize, m_tileSize);
+    m_map->setViewContext(Still);
+    m_map->setMapQualityForViewContext(HighQuality, Still);
+    m_map->setShowCrosshairs(false);
+    for (AbstractFloatItem *floatItem: m_map->floatItems()) {
+        floatItem->setVisible(false);
+    }
+}
+
+QImage TileRenderer::renderTile(int zoomLevel, int x, int y, bool &complete)
+{
+    // The mercator projection of Marble maps the equator to four times the radius
+    int const tileCount = 1 << zoomLevel;
+    qreal const lon = 360.0 * (x + 0.5) / tileCount - 180.0;
+    qreal const lat = gd(M_PI * (1.0 - 2.0 * (y + 0.5) / tileCount)) * RAD2DEG;
+    m_map->setRadius(m_tileSize * tileCount / 4);
+    m_map->centerOn(lon, lat);
+
+    QImage::Format const format = m_map->viewport()->mapCoversViewport()
+                                  ? QImage::Format_RGB32
+                                  : QImage::Format_ARGB32_Premultiplied;
+    QImage image(m_tileSize, m_tileSize, format);
+
+    // Tiles and documents are loaded asynchronously, repaint whenever new data arrived
+    QElapsedTimer timer;
+    timer.start();
+    while (true) {
+        image.fill(Qt::transparent);
+        {
+            GeoPainter painter(&image, m_map->viewport(), m_map->mapQuality());
+            m_map->paint(painter, image.rect());
+        }
+
+        RenderStatus const status = m_map->renderStatus();
+        qint64 const remaining = m_timeout - timer.elapsed();
+        if (status != WaitingForData || remaining <= 0) {
+            complete = status == Complete || status == WaitingForUpdate;
+            return image;
+        }
+
+        QEventLoop loop;
+        connect(m_map, SIGNAL(repaintNeeded(QRegion)), &loop, SLOT(quit()));
+        QTimer::singleShot(remaining, &loop, SLOT(quit()));
+        loop.exec();
+    }
+}
+
+}
@@ -0,0 +1,70 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#ifndef MARBLE_TILERENDERER_H
+#define MARBLE_TILERENDERER_H
+
+#include <QImage>
+#include <QObject>
+#include <QRect>
+
+namespace Marble {
+
+class MarbleMap;
+class MarbleModel;
+
+/**
+ * Renders slippy map tiles of a map theme with its own MarbleMap. Each renderer
+ * is meant to live in a thread of its own: the map and its model are created
+ * lazily by the first renderTiles() call, so they belong to the thread the
+ * renderer was moved to. Tile images downloaded by any renderer end up in the
+ * common persistent tile cache and are picked up from there by the others.
+ */
+class TileRenderer : public QObject
+{
+    Q_OBJECT
+
+public:
+    TileRenderer(const QString &mapThemeId, int tileSize, QObject *parent = nullptr);
+    ~TileRenderer() override;
+
+    /**
+     * Maximum time in milliseconds to wait for missing map data of a tile
+     */
+    void setTimeout(int timeout);
+
+public Q_SLOTS:
+    /**
+     * Renders the tiles @p tiles of the given zoom level. Emits tileRendered()
+     * for each of them and tilesRendered() at the end.
+     */
+    void renderTiles(int zoomLevel, const QRect &tiles);
+
+Q_SIGNALS:
+    /**
+     * A tile was rendered to PNG @p data. @p complete is false if its map
+     * data did not arrive in time or failed to load.
+     */
+    void tileRendered(int zoomLevel, int x, int y, const QByteArray &data, bool complete);
+
+    void tilesRendered();
+
+private:
+    void createMap();
+    QImage renderTile(int zoomLevel, int x, int y, bool &complete);
+
+    QString const m_mapThemeId;
+    int const m_tileSize;
+    int m_timeout;
+    MarbleModel *m_model;
+    MarbleMap *m_map;
+};
+
+}
+
+#endif
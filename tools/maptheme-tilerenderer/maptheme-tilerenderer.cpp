@@ -0,0 +1,138 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include "GeoDataLatLonBox.h"
+#include "MarbleDirs.h"
+#include "MbTileWriter.h"
+#include "TileRenderPool.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QDir>
+#include <QScopedPointer>
+#include <QThread>
+
+#include <iostream>
+
+using namespace Marble;
+
+int main(int argc, char** argv)
+{
+    // Maps are rendered into images only, no need for a display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("maptheme-tilerenderer");
+    QCoreApplication::setApplicationVersion("0.1");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Render slippy map tiles of a map theme to a z/x/y.png directory structure or a .mbtiles SQLite database.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("maptheme", "Map theme id a la 'earth/openstreetmap/openstreetmap.dgml'");
+    parser.addPositionalArgument("output", "Destination directory or .mbtiles file");
+
+    parser.addOptions({
+                          {{"b", "bbox"}, "Render tiles covering <bbox> given as west,south,east,north in degree", "bbox", "-180,-85.0511,180,85.0511"},
+                          {{"t", "tilelevels"}, "Render tile levels <tilelevels>", "tilelevels", "0-5"},
+                          {{"s", "tilesize"}, "Edge length of the tiles in pixels, 256 or 512", "tilesize", "256"},
+                          {{"j", "jobs"}, "Number of tiles to render in parallel", "jobs", QString::number(qMax(1, QThread::idealThreadCount()))},
+                          {"timeout", "Wait at most <timeout> milliseconds for the map data of a tile", "timeout", "30000"},
+                          {{"q", "quiet"}, "No progress report to stdout"},
+                      });
+
+    parser.process(app);
+
+    const QStringList positionalArguments = parser.positionalArguments();
+    if (positionalArguments.size() != 2) {
+        parser.showHelp(positionalArguments.isEmpty() ? 0 : 1);
+    }
+
+    QString const mapThemeId = positionalArguments[0];
+    if (MarbleDirs::path(QString("maps/%1").arg(mapThemeId)).isEmpty()) {
+        qDebug() << "Unknown map theme" << mapThemeId;
+        return 2;
+    }
+
+    QStringList const bbox = parser.value("bbox").split(QLatin1Char(','));
+    QVector<double> coordinates;
+    for (const QString &value: bbox) {
+        bool ok;
+        coordinates << value.toDouble(&ok);
+        if (!ok) {
+            coordinates.clear();
+            break;
+        }
+    }
+    if (coordinates.size() != 4 || coordinates[1] >= coordinates[3]) {
+        qDebug() << "Cannot parse bounding box. Expecting format 'west,south,east,north', e.g. '8.3,48.9,8.5,49.1'.";
+        return 3;
+    }
+    GeoDataLatLonBox const latLonBox(coordinates[3], coordinates[1], coordinates[2], coordinates[0], GeoDataCoordinates::Degree);
+
+    QStringList const tileLevels = parser.value("tilelevels").split(QLatin1Char('-'));
+    QPair<int, int> tileLevelRange = QPair<int, int>(0, 5);
+    bool haveValidRange = false;
+    if (tileLevels.size() == 2) {
+        bool ok;
+        tileLevelRange.first = tileLevels[0].toInt(&ok);
+        if (ok) {
+            tileLevelRange.second = tileLevels[1].toInt(&ok);
+            if (ok) {
+                haveValidRange = tileLevelRange.first >= 0 && tileLevelRange.first <= tileLevelRange.second && tileLevelRange.second <= 20;
+            }
+        }
+    }
+    if (!haveValidRange) {
+        qDebug() << "Cannot parse tile level range. Expecting format 'minLevel-maxLevel' up to level 20, e.g. '3-7'.";
+        return 4;
+    }
+
+    int const tileSize = parser.value("tilesize").toInt();
+    if (tileSize != 256 && tileSize != 512) {
+        qDebug() << "Tile size must be 256 or 512";
+        return 5;
+    }
+
+    QString const output = positionalArguments[1];
+    QScopedPointer<MbTileWriter> mbTileWriter;
+    if (output.endsWith(QLatin1String(".mbtiles"))) {
+        mbTileWriter.reset(new MbTileWriter(output, "png"));
+        mbTileWriter->setReportProgress(false);
+        mbTileWriter->setCommitInterval(500);
+    } else if (!QDir().mkpath(output)) {
+        qDebug() << "Cannot create output directory" << output;
+        return 6;
+    }
+
+    bool const reportProgress = !parser.isSet("quiet");
+    TileRenderPool renderPool(mapThemeId, tileSize);
+    renderPool.setThreadCount(parser.value("jobs").toInt());
+    renderPool.setTimeout(parser.value("timeout").toInt());
+    renderPool.setOutputDirectory(output);
+    renderPool.setMbTileWriter(mbTileWriter.data());
+    renderPool.setReportProgress(reportProgress);
+    QObject::connect(&renderPool, SIGNAL(finished()), &app, SLOT(quit()));
+
+    renderPool.start(latLonBox, tileLevelRange.first, tileLevelRange.second);
+    app.exec();
+
+    if (reportProgress) {
+        double const seconds = renderPool.elapsed() / 1000.0;
+        std::cout << "Rendered " << renderPool.renderedTiles() << " tiles in " << seconds << " s, ";
+        std::cout << renderPool.renderedTiles() / qMax(0.001, seconds) << " tiles/s." << std::endl;
+        if (renderPool.incompleteTiles() > 0) {
+            std::cout << renderPool.incompleteTiles() << " tiles are missing map data." << std::endl;
+        }
+    }
+
+    return 0;
+}
@@ -16,6 +16,9 @@
 #include "PeakAnalyzer.h"
 #include "TileCoordsPyramid.h"
 #include "StyleBuilder.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPolygon.h"
+#include "OsmPlacemarkData.h"
 
 #include <QFileInfo>
 #include <QDebug>
@@ -129,6 +132,12 @@ void TileDirectory::setInputFile(const QString &filename)
 }
 
 GeoDataDocument* TileDirectory::clip(int zoomLevel, int tileX, int tileY)
+{
+    auto const tileClipper = clipper(zoomLevel, tileX, tileY);
+    return tileClipper ? tileClipper->clipTo(zoomLevel, tileX, tileY) : nullptr;
+}
+
+QSharedPointer<VectorClipper> TileDirectory::clipper(int zoomLevel, int tileX, int tileY)
 {
     QSharedPointer<GeoDataDocument> oldMap = m_landmass;
     load(zoomLevel, tileX, tileY);
@@ -139,7 +148,7 @@ GeoDataDocument* TileDirectory::clip(int zoomLevel, int tileX, int tileY)
             m_clipper = QSharedPointer<VectorClipper>(new VectorClipper(input, m_maxZoomLevel));
         }
     }
-    return m_clipper ? m_clipper->clipTo(zoomLevel, tileX, tileY) : nullptr;
+    return m_clipper;
 }
 
 QString TileDirectory::name() const
@@ -158,6 +167,37 @@ QSharedPointer<GeoDataDocument> TileDirectory::open(const QString &filename, Par
     return result;
 }
 
+QSharedPointer<GeoDataDocument> TileDirectory::mergeBoundaryTiles(const QSharedPointer<GeoDataDocument> &background, ParsingRunnerManager &manager,
+                                                                  const QString &cacheDir, const QString &extension,
+                                                                  int zoomLevel, int tileX, int tileY)
+{
+    GeoDataDocument* mergedMap = new GeoDataDocument;
+    // Tile writers like the vector tile one derive the tile id from the name
+    mergedMap->setName(QString("%1/%2/%3").arg(zoomLevel).arg(tileX).arg(tileY));
+    OsmPlacemarkData marbleLand;
+    marbleLand.addTag("marble_land","landmass");
+    for (auto placemark: background->placemarkList()) {
+        GeoDataPlacemark* land = new GeoDataPlacemark(*placemark);
+        if (geodata_cast<GeoDataPolygon>(land->geometry())) {
+            land->setOsmData(marbleLand);
+        }
+        mergedMap->append(land);
+    }
+    QString const boundaryDir = QString("%1/boundaries").arg(cacheDir);
+    for(auto const &dir: QDir(boundaryDir).entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QString const file = QString("%1/%2/%3/%4/%5.%6").arg(boundaryDir).arg(dir).arg(zoomLevel).arg(tileX).arg(tileY).arg(extension);
+        if (QFileInfo(file).exists()) {
+            auto tile = open(file, manager);
+            if (tile) {
+                for (auto placemark: tile->placemarkList()) {
+                    mergedMap->append(placemark->clone());
+                }
+            }
+        }
+    }
+    return QSharedPointer<GeoDataDocument>(mergedMap);
+}
+
 TagsFilter::Tags TileDirectory::tagsFilteredIn(int zoomLevel) const
 {
     if (m_tags.isEmpty()) {
@@ -63,9 +63,24 @@ public:
 
     TileId tileFor(int zoomLevel, int tileX, int tileY) const;
     GeoDataDocument *clip(int zoomLevel, int tileX, int tileY);
+
+    /**
+     * Returns the clipper for the given tile, loading the cache tile it belongs to.
+     * The clipper can be used from several threads, but stays valid only until
+     * the next call of clip() or clipper() with another cache tile or zoom level.
+     */
+    QSharedPointer<VectorClipper> clipper(int zoomLevel, int tileX, int tileY);
     QString name() const;
 
     static QSharedPointer<GeoDataDocument> open(const QString &filename, ParsingRunnerManager &manager);
+
+    /**
+     * Returns the land of @p background combined with the boundary tiles of all regions
+     * cached below @p cacheDir for the given tile. The result is named zoomLevel/x/y.
+     */
+    static QSharedPointer<GeoDataDocument> mergeBoundaryTiles(const QSharedPointer<GeoDataDocument> &background, ParsingRunnerManager &manager,
+                                                              const QString &cacheDir, const QString &extension,
+                                                              int zoomLevel, int tileX, int tileY);
     GeoDataLatLonBox boundingBox(const QString &filename) const;
     GeoDataLatLonBox boundingBox() const;
     void setBoundingBox(const GeoDataLatLonBox &boundingBox);
@@ -26,6 +26,7 @@
 
 #include "clipper/clipper.hpp"
 #include <QMap>
+#include <QMutex>
 #include <QSet>
 
 namespace Marble {
@@ -33,6 +34,11 @@ namespace Marble {
 class GeoDataLinearRing;
 class GeoDataRelation;
 
+/**
+ * Clips the placemarks of a document to tiles. Once constructed, clipTo() can
+ * be called concurrently from several threads as long as the document is not
+ * modified.
+ */
 class VectorClipper
 {
 public:
@@ -46,6 +52,7 @@ private:
     QVector<GeoDataPlacemark*> potentialIntersections(const GeoDataLatLonBox &box) const;
     ClipperLib::Path clipPath(const GeoDataLatLonBox &box, int zoomLevel) const;
     qreal area(const GeoDataLinearRing &ring);
+    static qreal ringArea(const GeoDataLinearRing &ring);
     void getBounds(const ClipperLib::Path &path, ClipperLib::cInt &minX, ClipperLib::cInt &maxX, ClipperLib::cInt &minY, ClipperLib::cInt &maxY) const;
 
     template<class T>
@@ -53,13 +60,12 @@ private:
                     GeoDataDocument* document, QSet<qint64> &osmIds)
     {
         bool isBuilding = false;
-        T* ring;
+        const T* ring;
         if (const auto building = geodata_cast<GeoDataBuilding>(placemark->geometry())) {
             ring = geodata_cast<T>(&building->multiGeometry()->at(0));
             isBuilding = true;
         } else {
-            GeoDataPlacemark* copyPlacemark = new GeoDataPlacemark(*placemark);
-            ring = geodata_cast<T>(copyPlacemark->geometry());
+            ring = geodata_cast<T>(placemark->geometry());
         }
         bool const isClosed = ring->isClosed() && canBeArea(placemark->visualCategory());
         if (isClosed && minArea > 0.0 && area(*static_cast<const GeoDataLinearRing*>(ring)) < minArea) {
@@ -131,6 +137,7 @@ private:
     int m_maxZoomLevel;
     GeoSceneMercatorTileProjection m_tileProjection;
     QHash<const GeoDataLinearRing*, qreal> m_areas;
+    QMutex m_areasMutex;
     QSet<GeoDataRelation*> m_relations;
 };
 
@@ -0,0 +1,78 @@
+//
+// This file is part of the Marble Virtual Globe.
+//
+// This program is free software licensed under the GNU LGPL. You can
+// find a copy of this license in LICENSE.txt in the top directory of
+// the source code.
+//
+
+#include <QBuffer>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include "GeoDataDocument.h"
+#include "GeoDataDocumentWriter.h"
+#include "GeoDataLinearRing.h"
+#include "GeoDataPlacemark.h"
+#include "GeoDataPolygon.h"
+#include "OsmPlacemarkData.h"
+#include "ParsingRunnerManager.h"
+#include "PluginManager.h"
+#include "MvtParser.h"
+#include "MvtTile.h"
+#include "TileDirectory.h"
+
+using namespace Marble;
+
+class TestMergeBoundaryTiles : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void writeAsVectorTile();
+};
+
+void TestMergeBoundaryTiles::writeAsVectorTile()
+{
+    MvtTile const tile( 14, 8529, 5645 );
+
+    GeoDataLinearRing ring;
+    ring << tile.coordinates( QPoint( 500, 500 ), Mvt::defaultExtent )
+         << tile.coordinates( QPoint( 1500, 500 ), Mvt::defaultExtent )
+         << tile.coordinates( QPoint( 1500, 1500 ), Mvt::defaultExtent )
+         << tile.coordinates( QPoint( 500, 1500 ), Mvt::defaultExtent );
+    GeoDataPolygon *polygon = new GeoDataPolygon;
+    polygon->setOuterBoundary( ring );
+    GeoDataPlacemark *land = new GeoDataPlacemark;
+    land->setGeometry( polygon );
+
+    // The background is unnamed, the merged tile is named after the tile it covers nevertheless
+    QSharedPointer<GeoDataDocument> background( new GeoDataDocument );
+    background->append( land );
+
+    // No region has a boundary tile here, so only the background is merged
+    QTemporaryDir cacheDir;
+    QVERIFY( cacheDir.isValid() );
+    PluginManager pluginManager;
+    ParsingRunnerManager manager( &pluginManager );
+    QSharedPointer<GeoDataDocument> const merged =
+            TileDirectory::mergeBoundaryTiles( background, manager, cacheDir.path(), "mvt", 14, 8529, 5645 );
+    QCOMPARE( merged->name(), tile.name() );
+    QCOMPARE( merged->placemarkList().size(), 1 );
+
+    QBuffer buffer;
+    buffer.open( QBuffer::WriteOnly );
+    QVERIFY( GeoDataDocumentWriter::write( &buffer, *merged, "mvt" ) );
+
+    QString error;
+    QScopedPointer<GeoDataDocument> parsed( MvtParser::parse( buffer.data(), tile, error ) );
+    QVERIFY( parsed );
+    QVector<GeoDataPlacemark*> const placemarks = parsed->placemarkList();
+    QCOMPARE( placemarks.size(), 1 );
+    QCOMPARE( placemarks.first()->osmData().tagValue( "marble_land" ), QString( "landmass" ) );
+    QVERIFY( geodata_cast<GeoDataPolygon>( placemarks.first()->geometry() ) );
+}
+
+QTEST_MAIN( TestMergeBoundaryTiles )
+
+#include "TestMergeBoundaryTiles.moc"
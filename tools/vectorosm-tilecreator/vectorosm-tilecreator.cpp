@@ -32,6 +32,8 @@
 
 #include <QMessageLogContext>
 #include <QProcess>
+#include <QThreadPool>
+#include <QtConcurrentMap>
 
 #include "VectorClipper.h"
 #include "NodeReducer.h"
@@ -41,10 +43,36 @@
 #include "MbTileWriter.h"
 #include "SpellChecker.h"
 
+#include <functional>
 #include <iostream>
 
 using namespace Marble;
 
+struct TileResult
+{
+    enum Status {
+        Written,
+        EmptyTile,
+        SeaTile,
+        Failed
+    };
+
+    TileResult() : status(Failed), removedNodes(0), remainingNodes(0), originalWays(0), mergedWays(0) {}
+
+    TileId tileId;
+    Status status;
+    QString name;
+    // The encoded tile if it goes into the mbtile database
+    QByteArray data;
+    qint64 removedNodes;
+    qint64 remainingNodes;
+    int originalWays;
+    int mergedWays;
+};
+
+typedef std::function<TileResult(const TileId &)> TileProcessor;
+typedef std::function<bool(const TileResult &)> TileHandler;
+
 GeoDataDocument* mergeDocuments(GeoDataDocument* map1, GeoDataDocument* map2)
 {
     GeoDataDocument* mergedMap = new GeoDataDocument(*map1);
@@ -80,42 +108,44 @@ void writeBoundaryTile(GeoDataDocument* tile, const QString &region, const QComm
     GeoDataDocumentWriter::write(outputFile, *tile);
 }
 
-QSharedPointer<GeoDataDocument> mergeBoundaryTiles(const QSharedPointer<GeoDataDocument> &background, ParsingRunnerManager &manager, const QCommandLineParser &parser, int x, int y, int zoomLevel)
+bool writeTile(GeoDataDocument* tile, const QString &outputFile)
 {
-    GeoDataDocument* mergedMap = new GeoDataDocument;
-    OsmPlacemarkData marbleLand;
-    marbleLand.addTag("marble_land","landmass");
-    for (auto placemark: background->placemarkList()) {
-        GeoDataPlacemark* land = new GeoDataPlacemark(*placemark);
-        if (geodata_cast<GeoDataPolygon>(land->geometry())) {
-            land->setOsmData(marbleLand);
-        }
-        mergedMap->append(land);
+    QDir().mkpath(QFileInfo(outputFile).path());
+    if (!GeoDataDocumentWriter::write(outputFile, *tile)) {
+        qWarning() << "Could not write the file " << outputFile;
+        return false;
     }
+    return true;
+}
 
-    QString const extension = parser.value("extension");
-    QString const boundaryDir = QString("%1/boundaries").arg(parser.value("cache-directory"));
-    for(auto const &dir: QDir(boundaryDir).entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
-        QString const file = QString("%1/%2/%3/%4/%5.%6").arg(boundaryDir).arg(dir).arg(zoomLevel).arg(x).arg(y).arg(extension);
-        if (QFileInfo(file).exists()) {
-            auto tile = TileDirectory::open(file, manager);
-            if (tile) {
-                for (auto placemark: tile->placemarkList()) {
-                    mergedMap->append(placemark->clone());
-                }
+/**
+ * Runs process on all tiles using the global thread pool and passes the results to
+ * handle in the calling thread, in the order of the tiles. Returns false as soon as
+ * handle fails.
+ */
+bool processTiles(const QVector<TileId> &tiles, int jobs, const TileProcessor &process, const TileHandler &handle)
+{
+    if (jobs < 2) {
+        for (auto const &tileId: tiles) {
+            if (!handle(process(tileId))) {
+                return false;
             }
         }
+        return true;
     }
 
-    return QSharedPointer<GeoDataDocument>(mergedMap);
-}
-
-bool writeTile(GeoDataDocument* tile, const QString &outputFile)
-{
-    QDir().mkpath(QFileInfo(outputFile).path());
-    if (!GeoDataDocumentWriter::write(outputFile, *tile)) {
-        qWarning() << "Could not write the file " << outputFile;
-        return false;
+    // Finished tiles wait for the handler in memory, so only queue a few at a time
+    int const batchSize = 64 * jobs;
+    for (int i = 0; i < tiles.size(); i += batchSize) {
+        QVector<TileId> const batch = tiles.mid(i, batchSize);
+        QFuture<TileResult> future = QtConcurrent::mapped(batch, process);
+        for (int j = 0; j < batch.size(); ++j) {
+            if (!handle(future.resultAt(j))) {
+                future.cancel();
+                future.waitForFinished();
+                return false;
+            }
+        }
     }
     return true;
 }
@@ -144,7 +174,8 @@ int main(int argc, char *argv[])
                           {{"d", "development"}, "Use local development vector osm map theme as output storage"},
                           {{"z", "zoom-level"}, "Zoom level according to which OSM information has to be processed.", "levels", "11,13,15,17"},
                           {{"o", "output"}, "Output file or directory", "output", QString("%1/maps/earth/vectorosm").arg(MarbleDirs::localPath())},
-                          {{"e", "extension"}, "Output file type: o5m (default), osm or kml", "file extension", "o5m"}
+                          {{"e", "extension"}, "Output file type: o5m (default), osm, kml or mvt", "file extension", "o5m"},
+                          {{"j", "jobs"}, "Number of tiles to create in parallel.", "jobs", "1"}
                       });
 
     // Process the actual command line arguments given by the user
@@ -184,6 +215,16 @@ int main(int argc, char *argv[])
         mbtileWriter->setCommitInterval(500);
     }
 
+    int jobs = qMax(1, parser.value("jobs").toInt());
+    if (jobs > 1 && mergeTiles) {
+        // Merging reads boundary tiles through the parsing runners, which only work in the main thread
+        qWarning() << "conflict-resolution=merge does not support parallel jobs, using a single job.";
+        jobs = 1;
+    }
+    if (jobs > 1) {
+        QThreadPool::globalInstance()->setMaxThreadCount(jobs);
+    }
+
     MarbleModel model;
     ParsingRunnerManager manager(model.pluginManager());
     QString const cacheDirectory = parser.value("cache-directory");
@@ -193,6 +234,48 @@ int main(int argc, char *argv[])
         parser.showHelp(1);
     }
 
+    qint64 count = 0;
+    qint64 total = 0;
+    qint64 processed = 0;
+    QElapsedTimer timer;
+    auto const tilesPerSecond = [&]() {
+        return processed / qMax(0.001, timer.elapsed() / 1000.0);
+    };
+
+    TileHandler const handleTile = [&](const TileResult &result) {
+        if (result.status == TileResult::Failed) {
+            return false;
+        }
+
+        ++count;
+        ++processed;
+        TileDirectory::printProgress(count / double(total));
+        if (result.status == TileResult::Written) {
+            if (!result.data.isEmpty()) {
+                QBuffer buffer;
+                buffer.setData(result.data);
+                buffer.open(QBuffer::ReadOnly);
+                mbtileWriter->addTile(&buffer, result.tileId.x(), result.tileId.y(), result.tileId.zoomLevel());
+            }
+
+            std::cout << "  Tile " << count << "/" << total << " (" << result.name.toStdString() << ").";
+            double const reduction = result.removedNodes / qMax(1.0, double(result.remainingNodes + result.removedNodes));
+            std::cout << " Node reduction: " << qRound(reduction * 100.0) << "%";
+            if (result.originalWays > 0) {
+                std::cout << " , " << result.originalWays << " ways merged to " << result.mergedWays;
+            }
+        } else if (result.status == TileResult::EmptyTile) {
+            std::cout << "  Skipping empty tile " << count << "/" << total << " (" << result.name.toStdString() << ").";
+        } else {
+            std::cout << "  Skipping sea tile " << count << "/" << total << " (" << result.name.toStdString() << ").";
+        }
+        std::cout << " " << qRound(tilesPerSecond()) << " tiles/s";
+
+        std::cout << std::string(20, ' ') << '\r';
+        std::cout.flush();
+        return true;
+    };
+
     if (*zoomLevels.cbegin() <= 9) {
         auto map = TileDirectory::open(inputFileName, manager);
         VectorClipper processor(map.data(), maxZoomLevel);
@@ -202,33 +285,45 @@ int main(int argc, char *argv[])
             spellChecker.setVerbose(parser.isSet("verbose"));
             spellChecker.correctPlaceLabels(map.data()->placemarkList());
         }
+
+        TileProcessor const processTile = [&](const TileId &tileId) {
+            TileResult result;
+            result.tileId = tileId;
+            int const zoomLevel = tileId.zoomLevel();
+            QSharedPointer<GeoDataDocument> const tile(processor.clipTo(zoomLevel, tileId.x(), tileId.y()));
+            result.name = tile->name();
+            if (tile->isEmpty()) {
+                result.status = TileResult::EmptyTile;
+                return result;
+            }
+
+            NodeReducer nodeReducer(tile.data(), tileId);
+            result.removedNodes = nodeReducer.removedNodes();
+            result.remainingNodes = nodeReducer.remainingNodes();
+            if (writeTile(tile.data(), tileFileName(parser, tileId.x(), tileId.y(), zoomLevel))) {
+                result.status = TileResult::Written;
+            }
+            return result;
+        };
+
         for(auto zoomLevel: zoomLevels) {
             TileIterator iter(world, zoomLevel);
-            qint64 count = 0;
-            qint64 const total = iter.total();
+            count = 0;
+            total = iter.total();
+            processed = 0;
+            timer.start();
+            QVector<TileId> pendingTiles;
             for(auto const &tileId: iter) {
-                ++count;
                 QString const filename = tileFileName(parser, tileId.x(), tileId.y(), zoomLevel);
                 if (!overwriteTiles && QFileInfo(filename).exists()) {
+                    ++count;
                     continue;
                 }
-                GeoDataDocument* tile = processor.clipTo(zoomLevel, tileId.x(), tileId.y());
-                if (!tile->isEmpty()) {
-                    NodeReducer nodeReducer(tile, TileId(0, zoomLevel, tileId.x(), tileId.y()));
-                    if (!writeTile(tile, filename)) {
-                        return 4;
-                    }
-                    TileDirectory::printProgress(count / double(total));
-                    std::cout << " Tile " << count << "/" << total << " (" << tile->name().toStdString() << ") done.";
-                    double const reduction = nodeReducer.removedNodes() / qMax(1.0, double(nodeReducer.remainingNodes() + nodeReducer.removedNodes()));
-                    std::cout << " Node reduction: " << qRound(reduction * 100.0) << "%";
-                } else {
-                    TileDirectory::printProgress(count / double(total));
-                    std::cout << " Skipping empty tile " << count << "/" << total << " (" << tile->name().toStdString() << ").";
-                }
-                std::cout << std::string(20, ' ') << '\r';
-                std::cout.flush();
-                delete tile;
+                pendingTiles << TileId(0, zoomLevel, tileId.x(), tileId.y());
+            }
+
+            if (!processTiles(pendingTiles, jobs, processTile, handleTile)) {
+                return 4;
             }
         }
     } else {
@@ -246,7 +341,6 @@ int main(int argc, char *argv[])
         typedef QMap<QString, QVector<TileId> > Tiles;
         Tiles tiles;
 
-        qint64 total = 0;
         QSet<QString> boundaryTiles;
         for(auto zoomLevel: zoomLevels) {
             TileIterator iter(mapTiles.boundingBox(), zoomLevel);
@@ -267,81 +361,102 @@ int main(int argc, char *argv[])
             }
         }
 
-        qint64 count = 0;
+        // The clippers are prepared in the main thread for each group of tiles sharing
+        // both cache tiles and the zoom level, and stay unchanged while it is processed
+        QSharedPointer<VectorClipper> landClipper;
+        QSharedPointer<VectorClipper> mapClipper;
+        bool isBoundaryTile = false;
+
+        TileProcessor const processTile = [&](const TileId &tileId) {
+            TileResult result;
+            result.tileId = tileId;
+            int const zoomLevel = tileId.zoomLevel();
+
+            typedef QSharedPointer<GeoDataDocument> GeoDocPtr;
+            GeoDocPtr tile2 = GeoDocPtr(landClipper->clipTo(zoomLevel, tileId.x(), tileId.y()));
+            if (tile2->isEmpty()) {
+                result.status = TileResult::SeaTile;
+                result.name = tile2->name();
+                return result;
+            }
+
+            GeoDocPtr tile1 = GeoDocPtr(mapClipper->clipTo(zoomLevel, tileId.x(), tileId.y()));
+            TagsFilter::removeAnnotationTags(tile1.data());
+            if (zoomLevel < 17) {
+                WayConcatenator concatenator(tile1.data());
+                result.originalWays = concatenator.originalWays();
+                result.mergedWays = concatenator.mergedWays();
+            }
+            NodeReducer nodeReducer(tile1.data(), tileId);
+            result.removedNodes = nodeReducer.removedNodes();
+            result.remainingNodes = nodeReducer.remainingNodes();
+            if (tile1->isEmpty()) {
+                result.status = TileResult::EmptyTile;
+                result.name = tile1->name();
+                return result;
+            }
+
+            GeoDocPtr combined = GeoDocPtr(mergeDocuments(tile1.data(), tile2.data()));
+            if (writeBoundaries && isBoundaryTile) {
+                writeBoundaryTile(tile1.data(), region, parser, tileId.x(), tileId.y(), zoomLevel);
+                if (mergeTiles) {
+                    combined = TileDirectory::mergeBoundaryTiles(tile2, manager, cacheDirectory, extension, zoomLevel, tileId.x(), tileId.y());
+                }
+            }
+            result.name = combined->name();
+
+            if (zoomLevel > 13 && mbtileWriter) {
+                QBuffer buffer(&result.data);
+                buffer.open(QBuffer::WriteOnly);
+                if (!GeoDataDocumentWriter::write(&buffer, *combined, extension)) {
+                    qWarning() << "Could not write the tile " << combined->name();
+                    result.data.clear();
+                }
+            } else if (!writeTile(combined.data(), tileFileName(parser, tileId.x(), tileId.y(), zoomLevel))) {
+                return result;
+            }
+            result.status = TileResult::Written;
+            return result;
+        };
+
+        timer.start();
         for (auto iter = tiles.begin(), end = tiles.end(); iter != end; ++iter) {
-            for(auto const &tileId: iter.value()) {
-                ++count;
+            isBoundaryTile = boundaryTiles.contains(iter.key());
+            QVector<TileId> pendingTiles;
+            for (int i = 0, n = iter.value().size(); i <= n; ++i) {
+                bool const levelDone = !pendingTiles.isEmpty() &&
+                        (i == n || iter.value()[i].zoomLevel() != pendingTiles.first().zoomLevel());
+                if (levelDone) {
+                    auto const &first = pendingTiles.first();
+                    landClipper = loader.clipper(first.zoomLevel(), first.x(), first.y());
+                    mapClipper = mapTiles.clipper(first.zoomLevel(), first.x(), first.y());
+                    if (!processTiles(pendingTiles, jobs, processTile, handleTile)) {
+                        return 4;
+                    }
+                    pendingTiles.clear();
+                }
+                if (i == n) {
+                    break;
+                }
+
+                auto const &tileId = iter.value()[i];
                 int const zoomLevel = tileId.zoomLevel();
                 QString const filename = tileFileName(parser, tileId.x(), tileId.y(), zoomLevel);
                 if (!overwriteTiles) {
                     if (zoomLevel > 13 && mbtileWriter && mbtileWriter->hasTile(tileId.x(), tileId.y(), zoomLevel)) {
+                        ++count;
                         continue;
                     } else if (QFileInfo(filename).exists()) {
+                        ++count;
                         continue;
                     }
                 }
-
-                typedef QSharedPointer<GeoDataDocument> GeoDocPtr;
-                GeoDocPtr tile2 = GeoDocPtr(loader.clip(zoomLevel, tileId.x(), tileId.y()));
-                if (!tile2->isEmpty()) {
-                    GeoDocPtr tile1 = GeoDocPtr(mapTiles.clip(zoomLevel, tileId.x(), tileId.y()));
-                    TagsFilter::removeAnnotationTags(tile1.data());
-                    int originalWays = 0;
-                    int mergedWays = 0;
-                    if (zoomLevel < 17) {
-                        WayConcatenator concatenator(tile1.data());
-                        originalWays = concatenator.originalWays();
-                        mergedWays = concatenator.mergedWays();
-                    }
-                    NodeReducer nodeReducer(tile1.data(), tileId);
-                    if (!tile1->isEmpty() && !tile2->isEmpty()) {
-                        GeoDocPtr combined = GeoDocPtr(mergeDocuments(tile1.data(), tile2.data()));
-
-                        if (writeBoundaries && boundaryTiles.contains(iter.key())) {
-                            writeBoundaryTile(tile1.data(), region, parser, tileId.x(), tileId.y(), zoomLevel);
-                            if (mergeTiles) {
-                                combined = mergeBoundaryTiles(tile2, manager, parser, tileId.x(), tileId.y(), zoomLevel);
-                            }
-                        }
-
-                        if (zoomLevel > 13 && mbtileWriter) {
-                            QBuffer buffer;
-                            buffer.open(QBuffer::ReadWrite);
-                            if (GeoDataDocumentWriter::write(&buffer, *combined, extension)) {
-                                buffer.seek(0);
-                                mbtileWriter->addTile(&buffer, tileId.x(), tileId.y(), zoomLevel);
-                            } else {
-                                qWarning() << "Could not write the tile " << combined->name();
-                            }
-                        } else {
-                            if (!writeTile(combined.data(), filename)) {
-                                return 4;
-                            }
-                        }
-
-                        TileDirectory::printProgress(count / double(total));
-                        std::cout << "  Tile " << count << "/" << total << " (";
-                        std::cout << combined->name().toStdString() << ").";
-                        double const reduction = nodeReducer.removedNodes() / qMax(1.0, double(nodeReducer.remainingNodes() + nodeReducer.removedNodes()));
-                        std::cout << " Node reduction: " << qRound(reduction * 100.0) << "%";
-                        if (originalWays > 0) {
-                            std::cout << " , " << originalWays << " ways merged to " << mergedWays;
-                        }
-                    } else {
-                        TileDirectory::printProgress(count / double(total));
-                        std::cout << "  Skipping empty tile " << count << "/" << total << " (" << tile1->name().toStdString() << ").";
-                    }
-                } else {
-                    TileDirectory::printProgress(count / double(total));
-                    std::cout << "  Skipping sea tile " << count << "/" << total << " (" << tile2->name().toStdString() << ").";
-                }
-
-                std::cout << std::string(20, ' ') << '\r';
-                std::cout.flush();
+                pendingTiles << tileId;
             }
         }
         TileDirectory::printProgress(1.0);
-        std::cout << "  Vector OSM tiles complete." << std::string(30, ' ') << std::endl;
+        std::cout << "  Vector OSM tiles complete, " << processed << " tiles at " << qRound(tilesPerSecond()) << " tiles/s.";
+        std::cout << std::string(30, ' ') << std::endl;
     }
 
     return 0;